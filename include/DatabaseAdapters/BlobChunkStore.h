@@ -0,0 +1,119 @@
+/**
+ * @file BlobChunkStore.h
+ * @brief Declaration of the BlobChunkStore class, a chunk store backed by a persisted resource blob.
+ */
+
+#ifndef database_adapters_blobchunkstore_h
+#define database_adapters_blobchunkstore_h
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DatabaseAdapters/config.h"
+#include "DatabaseAdapters/Sqlite.h"
+#include "Resources/DataType.h"
+#include "Resources/IChunkStore.h"
+
+namespace database_adapters
+{
+
+    /**
+     * @class BlobChunkStore
+     * @brief Reads and writes the blob of a resource persisted by ResourcePersister in place through incremental blob I/O.
+     *
+     * Only dense row-major rows can be chunked. Rows without a persisted shape keep the M x N shape they were
+     * persisted with. The database must stay open for the lifetime of the store.
+     */
+    class DATABASE_ADAPTERS_DLL_EXPORT BlobChunkStore : public resource::IChunkStore
+    {
+    public:
+        /**
+         * @brief Constructor for the BlobChunkStore class.
+         * @param db The open database holding the resource.
+         * @param key The key the resource was persisted with.
+         * @throw std::runtime_error If the resource does not exist, is sparse, is not row-major or was persisted as a delta or quantized.
+         */
+        BlobChunkStore(Sqlite &db, const std::string_view key);
+
+        /**
+         * @brief Destructor for the BlobChunkStore class.
+         */
+        virtual ~BlobChunkStore() noexcept;
+
+        /**
+         * @brief Deleted copy constructor.
+         */
+        BlobChunkStore(const BlobChunkStore &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator.
+         * @return Reference to the updated instance (not used).
+         */
+        BlobChunkStore &operator=(const BlobChunkStore &) = delete;
+
+        /**
+         * @brief Get the extent of each dimension of the persisted resource.
+         * @return The shape.
+         */
+        std::vector<size_t> GetShape() const override;
+
+        /**
+         * @brief Get the element type of the persisted resource.
+         * @return The element type, Unknown if the row has none.
+         */
+        resource::DataType GetDataType() const override;
+
+        /**
+         * @brief Get the size of the blob.
+         * @return The size in bytes.
+         */
+        size_t GetSize() const override;
+
+        /**
+         * @brief Read part of the blob.
+         * @param offset The offset of the first byte.
+         * @param buff The destination buffer.
+         * @param n The number of bytes to read.
+         */
+        void Read(const size_t offset, char *buff, const size_t n) override;
+
+        /**
+         * @brief Write part of the blob in place, updating the statistics and zone map of the row.
+         * @param offset The offset of the first byte.
+         * @param buff The source buffer.
+         * @param n The number of bytes to write.
+         */
+        void Write(const size_t offset, const char *buff, const size_t n) override;
+
+    private:
+        /**
+         * @brief Recompute the statistics of the zone map blocks that overlap a written range.
+         * @param offset The offset of the first written byte.
+         * @param n The number of written bytes.
+         */
+        void UpdateZoneMap(const size_t offset, const size_t n);
+
+        /** @brief The database holding the resource. */
+        Sqlite &db_;
+
+        /** @brief The row of the resource. */
+        sqlite3_int64 iRow_{-1};
+
+        /** @brief The extent of each dimension. */
+        std::vector<size_t> shape_;
+
+        /** @brief The element type. */
+        resource::DataType dataType_{resource::DataType::Unknown};
+
+        /** @brief The size of the blob in bytes. */
+        size_t size_{0};
+
+        /** @brief The size of the zone map blob in bytes, 0 if the row has no statistics. */
+        size_t zoneMapSize_{0};
+    };
+
+} // end namespace database_adapters
+
+#endif // end database_adapters_blobchunkstore_h
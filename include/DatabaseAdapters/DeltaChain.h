@@ -0,0 +1,79 @@
+/**
+ * @file DeltaChain.h
+ * @brief Declaration of the DeltaChain class, the rows a delta-encoded resource row is rebuilt from.
+ */
+
+#ifndef database_adapters_deltachain_h
+#define database_adapters_deltachain_h
+
+#include <cstddef>
+#include <vector>
+
+#include "DatabaseAdapters/config.h"
+#include "DatabaseAdapters/Sqlite.h"
+
+#include "sqlite3.h"
+
+namespace database_adapters
+{
+
+    /**
+     * @class DeltaChain
+     * @brief Follows the delta_base column of a row of the resources table back to a row holding a full payload.
+     *
+     * Rows persisted as deltas hold a resource::DeltaCodec delta against the payload of the row named by their
+     * delta_base column. The chain lists the base row first and the requested row last.
+     */
+    class DATABASE_ADAPTERS_DLL_EXPORT DeltaChain
+    {
+    public:
+        /**
+         * @brief Constructor for the DeltaChain class.
+         * @param db The open database holding the rows.
+         * @param iRow The row to rebuild.
+         * @throw std::runtime_error If a row of the chain does not exist.
+         */
+        DeltaChain(Sqlite &db, const sqlite3_int64 iRow);
+
+        /**
+         * @brief Destructor for the DeltaChain class.
+         */
+        virtual ~DeltaChain() noexcept;
+
+        /**
+         * @brief Deleted copy constructor.
+         */
+        DeltaChain(const DeltaChain &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator.
+         * @return Reference to the updated instance (not used).
+         */
+        DeltaChain &operator=(const DeltaChain &) = delete;
+
+        /**
+         * @brief Get the number of deltas between the base row and the requested row.
+         * @return The number of deltas, 0 if the requested row holds a full payload.
+         */
+        size_t GetLength() const;
+
+        /**
+         * @brief Read the base payload and apply every delta of the chain.
+         * @return The payload of the requested row.
+         */
+        std::vector<char> Read() const;
+
+    private:
+        /** @brief The database holding the rows. */
+        Sqlite &db_;
+
+        /** @brief The rows of the chain, base first. */
+        std::vector<sqlite3_int64> rows_;
+
+        /** @brief The size of the blob of each row of the chain. */
+        std::vector<size_t> sizes_;
+    };
+
+} // end namespace database_adapters
+
+#endif // database_adapters_deltachain_h
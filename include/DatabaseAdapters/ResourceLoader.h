@@ -10,16 +10,23 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 #include "Config/filesystem.h"
 
+#include <boost/optional.hpp>
+
 #include "DatabaseAdapters/config.h"
 
 #include "DatabaseAdapters/IPersistableResource.h"
 #include "DatabaseAdapters/Sqlite.h"
+#include "Resources/DataType.h"
+#include "Resources/SparseResource.h"
+#include "Resources/ZoneMap.h"
 
 namespace database_adapters
 {
@@ -31,6 +38,11 @@ namespace database_adapters
     class DATABASE_ADAPTERS_DLL_EXPORT ResourceLoader
     {
     public:
+        /**
+         * @brief A resource constructor that allocates from the given memory resource.
+         */
+        using AllocatingConstructorType = std::function<std::unique_ptr<IPersistableResource>(std::pmr::memory_resource *)>;
+
         /**
          * @brief Destructor for the ResourceLoader class.
          */
@@ -73,6 +85,15 @@ namespace database_adapters
         template <typename T>
         void RegisterResource(const std::string_view key, std::function<std::unique_ptr<IPersistableResource>(void)> constructor);
 
+        /**
+         * @brief Register a resource type with a key and an allocating constructor.
+         * @tparam T The resource type to register.
+         * @param key The key associated with the resource type.
+         * @param constructor The constructor function, given the memory resource passed to Load.
+         */
+        template <typename T>
+        void RegisterResource(const std::string_view key, AllocatingConstructorType constructor);
+
         /**
          * @brief Unregister a resource type by its key.
          * @param key The key of the resource type to unregister.
@@ -94,16 +115,35 @@ namespace database_adapters
         /**
          * @brief Load a resource by its key.
          * @param key The key of the resource to load.
+         * @param memory The memory resource for staging buffers and allocating constructors.
          * @return A unique pointer to the loaded resource.
          */
-        std::unique_ptr<IPersistableResource> Load(const std::string_view key);
+        std::unique_ptr<IPersistableResource> Load(const std::string_view key, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
         /**
          * @brief Generate a resource instance by its key.
          * @param key The key of the resource to generate.
+         * @param memory The memory resource passed to an allocating constructor.
          * @return A unique pointer to the generated resource.
          */
-        std::unique_ptr<IPersistableResource> GenerateResource(const std::string_view key) const;
+        std::unique_ptr<IPersistableResource> GenerateResource(const std::string_view key, std::pmr::memory_resource *memory = std::pmr::get_default_resource()) const;
+
+        /**
+         * @brief Find the resources that may hold a value within a closed range without reading their payloads.
+         *
+         * Only rows persisted with statistics are considered; see ResourcePersister::SetZoneMapBlockSize.
+         * @param low The lower bound.
+         * @param high The upper bound.
+         * @return The keys of the candidate resources.
+         */
+        std::vector<std::string> FindKeys(const double low, const double high);
+
+        /**
+         * @brief Load the zone map persisted with a resource.
+         * @param key The key of the resource.
+         * @return The zone map, none if the resource was persisted without one.
+         */
+        boost::optional<resource::ZoneMap> LoadZoneMap(const std::string_view key);
 
     private:
         /**
@@ -135,11 +175,31 @@ namespace database_adapters
          */
         ResourceLoader &operator=(ResourceLoader &&) = delete;
 
+        /**
+         * @brief Load a persisted row into a sparse resource.
+         * @param sparse The sparse resource to load into, with its dimensions already set.
+         * @param iRow The row of the resource in the database table.
+         * @param nnz The non-zero count, or none if the row was persisted densely.
+         * @param dataType The element type the row was persisted with.
+         * @param isDelta Whether the row was persisted as a delta against an earlier row.
+         * @param memory The memory resource for staging buffers.
+         */
+        void LoadSparse(resource::SparseResource &sparse, const int iRow, const boost::optional<size_t> nnz, const resource::DataType dataType, const bool isDelta, std::pmr::memory_resource *memory);
+
+        /**
+         * @brief Read the payload of a densely persisted row, applying its delta chain if it has one.
+         * @param iRow The row of the resource in the database table.
+         * @param isDelta Whether the row was persisted as a delta against an earlier row.
+         * @param blob The destination, sized to the payload.
+         * @throw std::runtime_error If the rebuilt payload does not match the size of the destination.
+         */
+        void ReadDense(const int iRow, const bool isDelta, std::pmr::vector<char> &blob);
+
         /** @brief Pointer to the singleton instance of the ResourceLoader. */
         static ResourceLoader *instance_;
 
         /** @brief Map of keys to resource constructor functions. */
-        mutable std::map<std::string, std::function<std::unique_ptr<IPersistableResource>(void)>, std::less<>> keyToResourceMap_;
+        mutable std::map<std::string, AllocatingConstructorType, std::less<>> keyToResourceMap_;
 
         /** @brief SQLite database adapter. */
         Sqlite databaseAdapter_;
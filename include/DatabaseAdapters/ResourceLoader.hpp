@@ -1,6 +1,14 @@
 
 template<typename T>
 void ResourceLoader::RegisterResource(const std::string_view key, std::function<std::unique_ptr<IPersistableResource>(void)> constructor)
+{
+	auto allocatingConstructor = [constructor](std::pmr::memory_resource *)
+	{ return constructor(); };
+	RegisterResource<T>(key, AllocatingConstructorType(allocatingConstructor));
+}
+
+template<typename T>
+void ResourceLoader::RegisterResource(const std::string_view key, AllocatingConstructorType constructor)
 {
 	if (!std::is_arithmetic<T>::value)
 		throw std::runtime_error("Type (" + std::string(typeid(T).name()) + ") is not an arithmetic container when registering resource with ResourceDeserializer");
@@ -6,6 +6,9 @@
 #ifndef database_adapters_resourcepersister_h
 #define database_adapters_resourcepersister_h
 
+#include <cstddef>
+#include <functional>
+#include <map>
 #include <string>
 #include <string_view>
 #include "Config/filesystem.h"
@@ -14,6 +17,9 @@
 
 #include "DatabaseAdapters/IPersistableResource.h"
 #include "DatabaseAdapters/Sqlite.h"
+#include "Resources/Encoding.h"
+#include "Resources/ResourceView.h"
+#include "Resources/SparseResource.h"
 
 namespace database_adapters
 {
@@ -48,6 +54,16 @@ namespace database_adapters
          */
         void Persist(const IPersistableResource &resource, const std::string_view key);
 
+        /**
+         * @brief Persist a view of a resource into the database without materializing it.
+         *
+         * The view is stored as a packed GetColumnSize() x GetRowSize() resource and streamed into the
+         * blob one row at a time.
+         * @param view The view to save as a database table.
+         * @param key The key associated with the resource.
+         */
+        void Persist(const resource::ResourceView &view, const std::string_view key);
+
         /**
          * @brief Remove a resource from the database by its key.
          * @param key The key associated with the resource to remove.
@@ -71,6 +87,55 @@ namespace database_adapters
          */
         Sqlite &GetDatabase();
 
+        /**
+         * @brief Set the number of elements per block of the zone maps stored with dense resources.
+         *
+         * Rows of dense resources with a known element type then also hold the minimum, maximum, sum, count and
+         * NaN count of the payload, which ResourceLoader::FindKeys uses to skip rows without reading their blobs.
+         * @param blockSize The block size, 0 to store no statistics.
+         */
+        void SetZoneMapBlockSize(const size_t blockSize);
+
+        /**
+         * @brief Get the number of elements per block of the zone maps stored with dense resources.
+         * @return The block size, 0 if no statistics are stored.
+         */
+        size_t GetZoneMapBlockSize() const;
+
+        /**
+         * @brief Set the number of delta rows persisted after a full row of a dense resource before the next full row.
+         *
+         * When enabled, persisting a dense resource whose key already has a dense row stores a delta against the
+         * payload of that row, unless the delta is more than half the size of the payload. The row it applies to
+         * is kept in the delta_base column. Longer chains store less but make loads apply more deltas.
+         * @param chainLength The maximum number of deltas, 0 to always persist full payloads.
+         */
+        void SetDeltaChainLength(const size_t chainLength);
+
+        /**
+         * @brief Get the number of delta rows persisted after a full row of a dense resource before the next full row.
+         * @return The maximum number of deltas, 0 if full payloads are always persisted.
+         */
+        size_t GetDeltaChainLength() const;
+
+        /**
+         * @brief Set the storage encoding of the resource with the specified key.
+         *
+         * Dense float32 and float64 resources are then persisted with fewer bytes per element; the dtype and sizeof
+         * columns describe the stored elements and quantized encodings keep their scale and offset in the
+         * quant_scale and quant_offset columns. Sparse resources and views are persisted as they are.
+         * @param key The key associated with the resource.
+         * @param encoding The storage encoding, EncodingType::None to persist the payload as it is.
+         */
+        void SetEncoding(const std::string_view key, const resource::Encoding &encoding);
+
+        /**
+         * @brief Get the storage encoding of the resource with the specified key.
+         * @param key The key associated with the resource.
+         * @return The storage encoding, EncodingType::None if none was set.
+         */
+        resource::Encoding GetEncoding(const std::string_view key) const;
+
     private:
         /**
          * @brief Default constructor for the ResourcePersister class.
@@ -101,11 +166,34 @@ namespace database_adapters
          */
         ResourcePersister &operator=(ResourcePersister &&) = delete;
 
+        /**
+         * @brief Persist the CSR structure and non-zero values of a sparse resource.
+         * @param sparse The sparse resource to persist.
+         * @param key The key associated with the resource.
+         */
+        void PersistSparse(const resource::SparseResource &sparse, const std::string_view key);
+
+        /**
+         * @brief Get the latest row persisted with a key if it holds a dense resource.
+         * @param key The key associated with the resource.
+         * @return The row, -1 if the key has no rows or its latest row is sparse.
+         */
+        sqlite3_int64 GetLatestDenseRow(const std::string_view key);
+
         /** @brief Pointer to the singleton instance of the ResourcePersister. */
         static ResourcePersister *instance_;
 
         /** @brief SQLite database adapter. */
         Sqlite databaseAdapter_;
+
+        /** @brief The number of elements per zone map block, 0 if statistics are not stored. */
+        size_t zoneMapBlockSize_{0};
+
+        /** @brief The maximum number of delta rows after a full row, 0 if full payloads are always persisted. */
+        size_t deltaChainLength_{0};
+
+        /** @brief The storage encodings of resources that are not persisted as they are. */
+        std::map<std::string, resource::Encoding, std::less<>> keyToEncodingMap_;
     };
 
 } // end namespace database_adapters
@@ -0,0 +1,77 @@
+/**
+ * @file ResourceTable.h
+ * @brief Declaration of the schema of the resources table shared by the persister, the loader and the row readers.
+ */
+
+#ifndef database_adapters_resourcetable_h
+#define database_adapters_resourcetable_h
+
+#include <string>
+#include <vector>
+
+#include "DatabaseAdapters/config.h"
+#include "DatabaseAdapters/Sqlite.h"
+
+namespace database_adapters
+{
+
+    /**
+     * @brief The names of the resources table and of its columns.
+     */
+    namespace resource_table
+    {
+        inline const std::string TABLE_NAME = "resources";
+        inline const std::string ROW_KEY = "row";
+        inline const std::string P_KEY = "resource_key";
+        inline const std::string M_KEY = "m";
+        inline const std::string N_KEY = "n";
+        inline const std::string SIZE_OF_KEY = "sizeof";
+        inline const std::string DATA_KEY = "data";
+        inline const std::string NNZ_KEY = "nnz";
+        inline const std::string SHAPE_KEY = "shape";
+        inline const std::string LAYOUT_KEY = "layout";
+        inline const std::string TILE_KEY = "tile";
+        inline const std::string DTYPE_KEY = "dtype";
+        inline const std::string STAT_MIN_KEY = "stat_min";
+        inline const std::string STAT_MAX_KEY = "stat_max";
+        inline const std::string STAT_SUM_KEY = "stat_sum";
+        inline const std::string STAT_COUNT_KEY = "stat_count";
+        inline const std::string STAT_NAN_KEY = "stat_nan";
+        inline const std::string ZONE_MAP_KEY = "zone_map";
+        inline const std::string DELTA_BASE_KEY = "delta_base";
+        inline const std::string QUANT_SCALE_KEY = "quant_scale";
+        inline const std::string QUANT_OFFSET_KEY = "quant_offset";
+
+        /**
+         * @brief Format extents as the text of the shape and tile columns.
+         * @param extents The extents.
+         * @return The extents separated by commas, e.g. "2,3,4".
+         */
+        DATABASE_ADAPTERS_DLL_EXPORT std::string JoinExtents(const std::vector<size_t> &extents);
+
+        /**
+         * @brief Parse the text of the shape and tile columns.
+         * @param text The extents separated by commas, e.g. "2,3,4".
+         * @return The extents.
+         * @throw std::invalid_argument If an extent is not a number.
+         */
+        DATABASE_ADAPTERS_DLL_EXPORT std::vector<size_t> SplitExtents(const std::string &text);
+
+        /**
+         * @brief Format a value of a REAL column as an SQL literal, with full precision so that no bound is rounded.
+         * @param value The value.
+         * @return The literal; NULL if the value is not finite, as for the statistics of empty or all-NaN payloads.
+         */
+        DATABASE_ADAPTERS_DLL_EXPORT std::string RealValue(const double value);
+    } // end namespace resource_table
+
+    /**
+     * @brief Create the resources table if it does not exist and add the columns that databases of earlier releases lack.
+     * @param db The open database.
+     * @throw std::runtime_error If a statement fails.
+     */
+    DATABASE_ADAPTERS_DLL_EXPORT void CreateResourceTable(Sqlite &db);
+
+} // end namespace database_adapters
+
+#endif // database_adapters_resourcetable_h
@@ -74,6 +74,14 @@ namespace database_adapters
          */
         void Execute(const std::string &sql, boost::optional<RowCallbackType> rowCallback = boost::none);
 
+        /**
+         * @brief Check if a table has a column.
+         * @param tableName The name of the table.
+         * @param columnName The name of the column.
+         * @return True if the column exists, false otherwise.
+         */
+        bool HasColumn(const std::string &tableName, const std::string &columnName);
+
         /**
          * @brief Check if a database is currently open.
          * @return True if the database is open, false otherwise.
@@ -75,6 +75,14 @@ public:
      */
     std::vector<char> Read(const size_t numBytes, const int offset) const;
 
+    /**
+     * @brief Read data from the BLOB into a caller-provided buffer.
+     * @param buff Pointer to a buffer of at least numBytes bytes.
+     * @param numBytes The number of bytes to read.
+     * @param offset The offset from which to start reading.
+     */
+    void Read(char* buff, const size_t numBytes, const int offset) const;
+
     /**
      * @brief Write data to the BLOB.
      * @param buff Pointer to the data buffer to write.
@@ -7,6 +7,7 @@
 #define entity_entityhierarchy_h
 
 #include <string>
+#include <vector>
 #include "Config/filesystem.h"
 #include "Entities/config.h"
 #include <boost/property_tree/ptree.hpp>
@@ -19,6 +20,10 @@ namespace entity
      * @brief A class that manages the serialization structure of runtime objects.
      *
      * Provides methods to load, manage, and query the serialization structure for runtime entities.
+     *
+     * Changes to single nodes are appended to a log next to the JSON file, one compact JSON record per line, so
+     * that saving them costs as much as the nodes that changed. Loading the structure replays the log, ignoring a
+     * line cut short by a crash, and saving the whole structure removes it.
      */
     class ENTITY_DLL_EXPORT EntityHierarchy
     {
@@ -65,6 +70,33 @@ namespace entity
          */
         void LoadSerializationStructure(const Path &pathToJSON);
 
+        /**
+         * @brief Write the whole serialization structure to its JSON file and remove the log.
+         * @throw std::runtime_error If there is no serialization path or the file cannot be written.
+         */
+        void SaveSerializationStructure();
+
+        /**
+         * @brief Replace the fields of a node, keeping the subtrees of its members, and queue the change for SaveUpdates.
+         * @param keyPath The dot-separated keys from the root to the node.
+         * @param fields The fields of the node, without the subtrees of its members.
+         * @param memberKeys The keys of the members of the node; the subtrees of other keys are dropped.
+         */
+        void UpdateNode(const std::string &keyPath, const boost::property_tree::ptree &fields, const std::vector<std::string> &memberKeys);
+
+        /**
+         * @brief Append the queued node changes to the log, or write the whole structure if it has no file yet or the log outgrew it.
+         * @throw std::runtime_error If there is no serialization path or a file cannot be written.
+         */
+        void SaveUpdates();
+
+        /**
+         * @brief Get the path of the log of node changes of a serialization structure.
+         * @param pathToJSON The path to the JSON file containing the serialization structure.
+         * @return The path of the log.
+         */
+        static Path GetLogPath(const Path &pathToJSON);
+
         /**
          * @brief Check if the serialization structure is loaded.
          * @return True if the serialization structure is loaded, false otherwise.
@@ -90,11 +122,20 @@ namespace entity
         Path GetSerializationPath() const;
 
     private:
+        /**
+         * @brief Replace the fields of a node, keeping the subtrees of its members.
+         * @param update A log record of the key path, fields and member keys of the node.
+         */
+        void ApplyUpdate(const boost::property_tree::ptree &update);
+
         /** @brief Path to the JSON file containing the serialization structure. */
         Path serializationPath_;
 
         /** @brief Property tree representing the serialization structure. */
         boost::property_tree::ptree serializationStructure_;
+
+        /** @brief The log records of the node changes that are not saved yet. */
+        std::vector<boost::property_tree::ptree> pendingUpdates_;
     };
 
 } // end namespace entity
@@ -0,0 +1,147 @@
+/**
+ * @file AlignedFile.h
+ * @brief Declaration of the AlignedFile class for sequential file I/O in large aligned blocks.
+ */
+
+#ifndef filesystem_adapters_alignedfile_h
+#define filesystem_adapters_alignedfile_h
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "FilesystemAdapters/config.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @class AlignedFile
+     * @brief A file read or written sequentially in blocks, optionally bypassing the page cache.
+     *
+     * Direct I/O (`O_DIRECT` on Linux, `F_NOCACHE` on macOS) keeps cold data out of the page cache. It requires
+     * buffers, sizes and offsets that are multiples of ALIGNMENT, which AllocateBuffer and RoundUp provide. File
+     * systems without direct I/O, and Windows, fall back to buffered I/O.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT AlignedFile
+    {
+    public:
+        /** @brief The alignment of buffers, sizes and offsets for direct I/O. */
+        static constexpr size_t ALIGNMENT = 4096;
+
+        /** @brief The default size of the chunks payloads are streamed in. */
+        static constexpr size_t CHUNK_SIZE = size_t(8) << 20;
+
+        /**
+         * @brief Frees buffers returned by AllocateBuffer.
+         */
+        struct BufferDeleter
+        {
+            void operator()(char *buff) const;
+        };
+
+        /** @brief A buffer aligned for direct I/O. */
+        using BufferType = std::unique_ptr<char[], BufferDeleter>;
+
+        /**
+         * @brief Constructor for the AlignedFile class.
+         * @param filePath The path of the file.
+         * @param write True to create or truncate the file for writing, false to open it for reading.
+         * @param direct True to bypass the page cache where supported.
+         * @throw std::runtime_error If the file cannot be opened.
+         */
+        AlignedFile(const std::string_view filePath, const bool write, const bool direct = false);
+
+        /**
+         * @brief Destructor for the AlignedFile class; closes the file.
+         */
+        virtual ~AlignedFile() noexcept;
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        AlignedFile(const AlignedFile &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        AlignedFile &operator=(const AlignedFile &) = delete;
+
+        /**
+         * @brief Deleted move constructor to prevent moving.
+         */
+        AlignedFile(AlignedFile &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator to prevent moving.
+         * @return Reference to the updated instance (not used).
+         */
+        AlignedFile &operator=(AlignedFile &&) = delete;
+
+        /**
+         * @brief Allocate a buffer aligned for direct I/O.
+         * @param size The size of the buffer in bytes.
+         * @return The buffer.
+         */
+        static BufferType AllocateBuffer(const size_t size);
+
+        /**
+         * @brief Round a size up to a multiple of ALIGNMENT.
+         * @param size The size in bytes.
+         * @return The rounded size.
+         */
+        static size_t RoundUp(const size_t size);
+
+        /**
+         * @brief Check if the file bypasses the page cache.
+         * @return True if direct I/O was requested and is supported, false otherwise.
+         */
+        bool IsDirect() const;
+
+        /**
+         * @brief Read the next bytes of the file.
+         * @param buff The destination buffer; aligned when direct.
+         * @param n The number of bytes to read; a multiple of ALIGNMENT when direct.
+         * @return The number of bytes read, less than n only at the end of the file.
+         * @throw std::runtime_error If the file cannot be read.
+         */
+        size_t Read(char *buff, const size_t n);
+
+        /**
+         * @brief Append bytes to the file.
+         * @param buff The source buffer; aligned when direct.
+         * @param n The number of bytes to write; a multiple of ALIGNMENT when direct.
+         * @throw std::runtime_error If the file cannot be written.
+         */
+        void Write(const char *buff, const size_t n);
+
+        /**
+         * @brief Set the size of the file, e.g. to cut the padding of the last direct write.
+         * @param size The size in bytes.
+         * @throw std::runtime_error If the size cannot be set.
+         */
+        void Truncate(const size_t size);
+
+        /**
+         * @brief Flush and close the file.
+         * @throw std::runtime_error If the file cannot be closed.
+         */
+        void Close();
+
+    private:
+        /** @brief The path of the file. */
+        std::string filePath_;
+
+        /** @brief The file descriptor, -1 once closed. */
+        int fd_{-1};
+
+        /** @brief True if the file bypasses the page cache. */
+        bool direct_{false};
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_alignedfile_h
@@ -0,0 +1,153 @@
+/**
+ * @file AsyncFileIO.h
+ * @brief Declaration of the AsyncFileIO class for reading and writing many files at once.
+ */
+
+#ifndef filesystem_adapters_asyncfileio_h
+#define filesystem_adapters_asyncfileio_h
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+#include "Intraprocess/ThreadPool.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @brief The mechanism that performs asynchronous file I/O.
+     */
+    enum class AsyncBackend
+    {
+        IoUring,   /**< Linux io_uring: a single thread keeps up to the queue depth of reads and writes in flight. */
+        ThreadPool /**< Blocking reads and writes on a pool of threads, where io_uring is not available. */
+    };
+
+    /**
+     * @class AsyncFileIO
+     * @brief Reads and writes whole files asynchronously, many at a time.
+     *
+     * On Linux, requests go through an io_uring submission queue, so a batch of reads reaches the device as one
+     * deep queue instead of one blocking call per file. Elsewhere, or if the kernel refuses io_uring, requests
+     * run on an intraprocess::ThreadPool. If io_uring fails later, the requests the kernel holds fail, and the
+     * others and every later request run on the thread pool. Files are opened with their requests; writes create
+     * or truncate the file and do not replace it atomically.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT AsyncFileIO
+    {
+    public:
+        /** @brief The default number of requests in flight. */
+        static constexpr size_t QUEUE_DEPTH = 64;
+
+        /**
+         * @brief Constructor for the AsyncFileIO class.
+         * @param queueDepth The number of requests in flight; the number of threads of the fallback is capped at the hardware concurrency.
+         * @param backend The preferred backend; io_uring falls back to the thread pool where it is not available.
+         * @throw std::runtime_error If the queue depth is 0.
+         */
+        AsyncFileIO(const size_t queueDepth = QUEUE_DEPTH, const AsyncBackend backend = AsyncBackend::IoUring);
+
+        /**
+         * @brief Destructor for the AsyncFileIO class; completes every pending request.
+         */
+        virtual ~AsyncFileIO() noexcept;
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        AsyncFileIO(const AsyncFileIO &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        AsyncFileIO &operator=(const AsyncFileIO &) = delete;
+
+        /**
+         * @brief Deleted move constructor to prevent moving.
+         */
+        AsyncFileIO(AsyncFileIO &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator to prevent moving.
+         * @return Reference to the updated instance (not used).
+         */
+        AsyncFileIO &operator=(AsyncFileIO &&) = delete;
+
+        /**
+         * @brief Get the backend in use.
+         * @return The backend; ThreadPool once io_uring has failed.
+         */
+        AsyncBackend GetBackend() const;
+
+        /**
+         * @brief Get the number of requests in flight.
+         * @return The queue depth.
+         */
+        size_t GetQueueDepth() const;
+
+        /**
+         * @brief Read a whole file.
+         * @param filePath The path of the file.
+         * @return The contents of the file; holds a std::runtime_error if the file cannot be read.
+         */
+        std::future<std::vector<char>> Read(const std::string_view filePath);
+
+        /**
+         * @brief Write a whole file, creating or truncating it.
+         * @param filePath The path of the file.
+         * @param data The contents of the file.
+         * @return Ready once the file is written; holds a std::runtime_error if the file cannot be written.
+         */
+        std::future<void> Write(const std::string_view filePath, std::vector<char> data);
+
+        /**
+         * @brief Read many files, submitted together.
+         * @param filePaths The paths of the files.
+         * @return The contents of each file, in the order of the paths.
+         */
+        std::vector<std::future<std::vector<char>>> ReadBatch(const std::span<const std::string> filePaths);
+
+        /**
+         * @brief Write many files, submitted together.
+         * @param filePaths The paths of the files.
+         * @param data The contents of each file, in the order of the paths.
+         * @return Ready once each file is written, in the order of the paths.
+         * @throw std::runtime_error If the number of paths and contents differ.
+         */
+        std::vector<std::future<void>> WriteBatch(const std::span<const std::string> filePaths, std::vector<std::vector<char>> data);
+
+    private:
+        struct Request;
+        struct Ring;
+
+        /**
+         * @brief Hand requests to the backend.
+         * @param requests The requests.
+         */
+        void Submit(std::vector<std::unique_ptr<Request>> requests);
+
+        /**
+         * @brief Keep the ring full and complete requests until stopped and drained; runs on its own thread.
+         */
+        void RunRing();
+
+        /** @brief The number of requests in flight. */
+        size_t queueDepth_;
+
+        /** @brief The io_uring, null when the thread pool is used. */
+        std::unique_ptr<Ring> ring_;
+
+        /** @brief The threads of the fallback, null while io_uring is used. */
+        std::unique_ptr<intraprocess::ThreadPool> pool_;
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_asyncfileio_h
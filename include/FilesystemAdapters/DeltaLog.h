@@ -0,0 +1,91 @@
+/**
+ * @file DeltaLog.h
+ * @brief Declaration of the DeltaLog class, the chain of deltas written after the base image of a resource file.
+ */
+
+#ifndef filesystem_adapters_deltalog_h
+#define filesystem_adapters_deltalog_h
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @class DeltaLog
+     * @brief The deltas that turn the base image of a `.bin` file into the latest version of the resource.
+     *
+     * The log lives next to the base image with the `.delta` extension. It starts with an 8-byte magic followed
+     * by records of an 8-byte size and a resource::DeltaCodec delta, each encoded against the image the previous
+     * records produce. A record cut short by a crash is ignored and overwritten by the next append.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT DeltaLog
+    {
+    public:
+        /**
+         * @brief Constructor for the DeltaLog class; scans the log of a file if it has one.
+         * @param filePath The path of the base image.
+         * @throw std::runtime_error If the log exists but does not start with the magic.
+         */
+        DeltaLog(const std::string_view filePath);
+
+        /**
+         * @brief Destructor for the DeltaLog class.
+         */
+        virtual ~DeltaLog() noexcept;
+
+        /**
+         * @brief Get the path of the log of a file.
+         * @param filePath The path of the base image.
+         * @return The path of the log.
+         */
+        static std::string GetLogPath(const std::string_view filePath);
+
+        /**
+         * @brief Get the number of deltas in the log.
+         * @return The number of complete records, 0 if there is no log.
+         */
+        size_t GetLength() const;
+
+        /**
+         * @brief Read the base image and apply every delta in the log.
+         * @return The latest version of the file.
+         * @throw std::runtime_error If the base image cannot be read.
+         */
+        std::vector<char> ReadImage() const;
+
+        /**
+         * @brief Append a delta against the image ReadImage() returns, creating the log if needed.
+         * @param delta The delta.
+         * @throw std::runtime_error If the log cannot be written.
+         */
+        void Append(const std::vector<char> &delta);
+
+        /**
+         * @brief Remove the log, so that the base image is the latest version again.
+         * @throw std::runtime_error If the log cannot be removed.
+         */
+        void Remove();
+
+    private:
+        /** @brief The path of the base image. */
+        std::string filePath_;
+
+        /** @brief The path of the log. */
+        std::string logPath_;
+
+        /** @brief The number of complete records. */
+        size_t length_{0};
+
+        /** @brief The offset of the end of the last complete record. */
+        size_t end_{0};
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_deltalog_h
@@ -23,7 +23,10 @@ namespace filesystem_adapters
      * @class EntitySerializer
      * @brief A singleton class responsible for serializing entities.
      *
-     * Provides methods to serialize entities and manage their hierarchy.
+     * Provides methods to serialize entities and manage their hierarchy. By default every entity is saved and the
+     * hierarchy file is rewritten. In incremental mode only dirty entities, and entities missing from the hierarchy,
+     * are saved and the nodes they change are appended to the log of the hierarchy file; it is only safe for
+     * entities that call MarkDirty whenever the data they save changes.
      */
     class FILESYSTEM_ADAPTERS_DLL_EXPORT EntitySerializer
     {
@@ -45,11 +48,24 @@ namespace filesystem_adapters
         static void ResetInstance();
 
         /**
-         * @brief Serialize an entity.
+         * @brief Serialize the changed entities of a tree and save the hierarchy.
          * @param entity The serializable entity to serialize.
+         * @throw std::runtime_error If the entity has no key or the hierarchy cannot be saved.
          */
         void Serialize(const ISerializableEntity &entity);
 
+        /**
+         * @brief Choose between saving every entity and saving only the dirty ones.
+         * @param incremental True to save only dirty entities and log their nodes, false to save every entity.
+         */
+        void SetIncremental(const bool incremental);
+
+        /**
+         * @brief Check if only dirty entities are saved.
+         * @return True in incremental mode, false otherwise.
+         */
+        bool GetIncremental() const;
+
         /**
          * @brief Get the hierarchy of serialized entities.
          * @return Reference to the EntityHierarchy.
@@ -87,7 +103,9 @@ namespace filesystem_adapters
         EntitySerializer &operator=(EntitySerializer &&) = delete;
 
         /**
-         * @brief Serialize an entity with an optional parent key.
+         * @brief Serialize an entity and its loaded members with an optional parent key.
+         *
+         * In incremental mode, clean entities that are already in the hierarchy are skipped.
          * @param entity The entity to serialize.
          * @param parentKey The key of the parent entity (default is an empty string).
          */
@@ -98,6 +116,9 @@ namespace filesystem_adapters
 
         /** @brief Hierarchy of serialized entities. */
         entity::EntityHierarchy hierarchy_;
+
+        /** @brief True to save only dirty entities. */
+        bool incremental_{false};
     };
 
 } // end namespace filesystem_adapters
@@ -0,0 +1,123 @@
+/**
+ * @file FileChunkStore.h
+ * @brief Declaration of the FileChunkStore class, a chunk store backed by a serialized resource file.
+ */
+
+#ifndef filesystem_adapters_filechunkstore_h
+#define filesystem_adapters_filechunkstore_h
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "Resources/DataType.h"
+#include "Resources/IChunkStore.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @class FileChunkStore
+     * @brief Reads and writes the payload of a `.bin` file written by ResourceSerializer in place.
+     *
+     * Only dense row-major files can be chunked. Files that cannot be opened for writing are opened read-only,
+     * in which case writing back a modified chunk throws.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT FileChunkStore : public resource::IChunkStore
+    {
+    public:
+        /**
+         * @brief Constructor for the FileChunkStore class.
+         * @param filePath The path of the file.
+         * @throw std::runtime_error If the file cannot be opened, has no valid header, is not row-major, is quantized or has pending deltas.
+         */
+        FileChunkStore(const std::string_view filePath);
+
+        /**
+         * @brief Destructor for the FileChunkStore class.
+         */
+        virtual ~FileChunkStore() noexcept;
+
+        /**
+         * @brief Deleted copy constructor; the store owns its file stream.
+         */
+        FileChunkStore(const FileChunkStore &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator; the store owns its file stream.
+         * @return Reference to the updated instance (not used).
+         */
+        FileChunkStore &operator=(const FileChunkStore &) = delete;
+
+        /**
+         * @brief Get the header of the file.
+         * @return The header.
+         */
+        const ResourceHeader &GetHeader() const;
+
+        /**
+         * @brief Get the extent of each dimension recorded in the header.
+         * @return The shape.
+         */
+        std::vector<size_t> GetShape() const override;
+
+        /**
+         * @brief Get the element type recorded in the header.
+         * @return The element type.
+         */
+        resource::DataType GetDataType() const override;
+
+        /**
+         * @brief Get the size of the payload that follows the header.
+         * @return The size in bytes.
+         */
+        size_t GetSize() const override;
+
+        /**
+         * @brief Read part of the payload.
+         * @param offset The offset of the first byte after the header.
+         * @param buff The destination buffer.
+         * @param n The number of bytes to read.
+         */
+        void Read(const size_t offset, char *buff, const size_t n) override;
+
+        /**
+         * @brief Write part of the payload in place, updating the zone map of the blocks it touches.
+         * @param offset The offset of the first byte after the header.
+         * @param buff The source buffer.
+         * @param n The number of bytes to write.
+         * @throw std::runtime_error If the file is read-only.
+         */
+        void Write(const size_t offset, const char *buff, const size_t n) override;
+
+    private:
+        /**
+         * @brief Recompute the statistics of the zone map blocks that overlap a written range.
+         * @param offset The offset of the first written byte after the header.
+         * @param n The number of written bytes.
+         */
+        void UpdateZoneMap(const size_t offset, const size_t n);
+
+        /** @brief The path of the file. */
+        std::string filePath_;
+
+        /** @brief The file, open for reading and, if permitted, writing. */
+        std::fstream file_;
+
+        /** @brief Whether the file is open for writing. */
+        bool writable_{false};
+
+        /** @brief The header of the file. */
+        ResourceHeader header_;
+
+        /** @brief The size of the payload in bytes. */
+        size_t size_{0};
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // end filesystem_adapters_filechunkstore_h
@@ -1,15 +1,34 @@
 #ifndef filesystem_adapters_filelock_h
 #define filesystem_adapters_filelock_h
 
+#include <array>
+#include <cstddef>
+#include <functional>
 #include <mutex>
+#include <string>
+#include "Config/filesystem.h"
+#include "Config/filesystem.hpp"
 
 namespace filesystem_adapters
 {
-    inline std::recursive_mutex &GetGlobalFileLock()
+    /** @brief The number of locks files are spread over. */
+    inline constexpr size_t FILE_LOCK_STRIPES = 64;
+
+    /**
+     * @brief Get the lock guarding the resource file at a path.
+     *
+     * Paths are hashed onto a fixed table of locks, so reads and writes of different files usually proceed in
+     * parallel while every access to the same file is serialized. Relative paths are made absolute first, so a file
+     * reached through a relative and an absolute path gets the same lock. Hold at most one file lock at a time.
+     * @param path The path of the file.
+     * @return The lock of the file.
+     */
+    inline std::recursive_mutex &GetFileLock(const Path &path)
     {
-        static std::recursive_mutex mtx;
-        return mtx;
+        static std::array<std::recursive_mutex, FILE_LOCK_STRIPES> stripes;
+        const size_t hash = std::hash<std::string>()(fs::absolute(path).lexically_normal().string());
+        return stripes[hash % FILE_LOCK_STRIPES];
     }
 } // end namespace filesystem_adapters
 
-#endif // filesystem_adapters_filelock_h
\ No newline at end of file
+#endif // filesystem_adapters_filelock_h
@@ -0,0 +1,39 @@
+/**
+ * @file FileSync.h
+ * @brief Declaration of the functions that make files and directory entries durable.
+ */
+
+#ifndef filesystem_adapters_filesync_h
+#define filesystem_adapters_filesync_h
+
+#include <string>
+
+#include "FilesystemAdapters/config.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @brief Flush the data of an open file to the storage device; on macOS also out of the drive cache.
+     * @param fd The file descriptor.
+     * @return 0 on success, -1 otherwise.
+     */
+    FILESYSTEM_ADAPTERS_DLL_EXPORT int SyncFile(const int fd);
+
+    /**
+     * @brief Flush the data of a file to the storage device.
+     * @param filePath The path of the file.
+     * @return True if the file was opened and synced, false otherwise.
+     */
+    FILESYSTEM_ADAPTERS_DLL_EXPORT bool SyncPath(const std::string &filePath);
+
+    /**
+     * @brief Make the files created, renamed or removed in a directory durable.
+     * @param directory The directory, the working directory if empty.
+     * @return True if the directory was synced, false otherwise.
+     */
+    FILESYSTEM_ADAPTERS_DLL_EXPORT bool SyncDirectory(const std::string &directory);
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_filesync_h
@@ -24,7 +24,8 @@ namespace filesystem_adapters
      * @class ISerializableEntity
      * @brief An interface for entities that can be serialized and deserialized.
      *
-     * Inherits from the `entity::Entity` class and provides methods for saving and loading entity data.
+     * Inherits from the `entity::Entity` class and provides methods for saving and loading entity data. An entity
+     * is dirty until it is saved or loaded, and again after MarkDirty; an incremental EntitySerializer only saves dirty entities.
      */
     class FILESYSTEM_ADAPTERS_DLL_EXPORT ISerializableEntity : public virtual entity::Entity
     {
@@ -86,13 +87,40 @@ namespace filesystem_adapters
          */
         virtual void Load(boost::property_tree::ptree &tree, const std::string &path) = 0;
 
+        /**
+         * @brief Mark the entity as changed since it was last saved; call it whenever the data Save writes changes.
+         */
+        void MarkDirty();
+
+        /**
+         * @brief Check if the entity changed since it was last saved or loaded.
+         * @return True if the entity is saved by the next serialization, false otherwise.
+         */
+        bool IsDirty() const;
+
     protected:
+        /**
+         * @brief Remove a member by its key and mark the entity as changed.
+         * @param key The key of the member to remove.
+         */
+        void RemoveMember(const Key &key);
+
+        /**
+         * @brief Remove a member by its shared pointer and mark the entity as changed.
+         * @param sharedObj A shared pointer to the member to remove.
+         */
+        void RemoveMember(SharedEntity sharedObj);
+
         /**
          * @brief Retrieve an aggregated member by its key.
          * @param key The key of the aggregated member to retrieve.
          * @return A shared pointer to the aggregated member.
          */
         SharedEntity &GetAggregatedMember(const Key &key) const override;
+
+    private:
+        /** @brief True if the entity changed since it was last saved or loaded; copies start dirty. */
+        mutable bool dirty_{true};
     };
 
 } // end namespace filesystem_adapters
@@ -6,11 +6,17 @@
 #ifndef filesystem_adapters_iserializableresource_h
 #define filesystem_adapters_iserializableresource_h
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #include "FilesystemAdapters/config.h"
+#include "FilesystemAdapters/ResourceSnapshot.h"
 #include "Resources/IResource.h"
+#include "Resources/Layout.h"
 
 namespace filesystem_adapters
 {
@@ -27,6 +33,10 @@ namespace filesystem_adapters
         /**
          * @class LockedResource
          * @brief A synchronization proxy using the monitor idiom.
+         *
+         * Holds either an exclusive lock, which allows the resource to be modified, or a shared lock, which allows
+         * any number of readers at once. Releasing an exclusive lock starts a new version of the resource and publishes
+         * the payload to the seqlock, if enabled.
          */
         class LockedResource
         {
@@ -37,12 +47,20 @@ namespace filesystem_adapters
             friend class ResourceSerializer;
             friend class ResourceDeserializer;
 
-            LockedResource(ISerializableResource &o);
+            LockedResource(ISerializableResource &o, const bool shared = false);
+            ~LockedResource();
+            LockedResource(LockedResource &&other) noexcept;
+            LockedResource &operator=(LockedResource &&other) noexcept;
 
+            bool IsShared() const;
             size_t GetColumnSize() const;
             size_t GetRowSize() const;
+            size_t GetRank() const;
+            std::vector<size_t> GetShape() const;
+            const resource::Layout &GetLayout() const;
             bool GetDirty() const;
             size_t GetElementSize() const;
+            resource::DataType GetDataType() const;
             void *Data();
             const void *Data() const;
             void Assign(const char *buff, const size_t n);
@@ -50,26 +68,99 @@ namespace filesystem_adapters
         protected:
             void SetColumnSize(const size_t size);
             void SetRowSize(const size_t size);
+            void SetShape(const std::vector<size_t> &shape);
+            void SetLayout(const resource::Layout &layout);
             bool UpdateChecksum() const;
+            int GetChecksum() const;
             int Checksum() const;
 
         private:
+            void ThrowIfShared() const;
+            void EndWrite();
+
             ISerializableResource *obj_;
-            std::unique_lock<std::mutex> lk_;
+            std::unique_lock<std::shared_mutex> lk_;
+            std::shared_lock<std::shared_mutex> sharedLk_;
+            std::shared_ptr<void> pin_;
         };
 
         /**
-         * @brief RAII lock for this resource.
+         * @brief RAII exclusive lock for this resource.
          * @return a lock.
          */
         LockedResource Lock();
 
         /**
-         * @brief RAII lock for this resource.
-         * @return a lock.
+         * @brief RAII shared lock for this resource.
+         * @return a lock that only allows reads.
          */
         const LockedResource Lock() const;
 
+        /**
+         * @brief RAII shared lock for this resource, also when called on a non-const resource.
+         * @return a lock that only allows reads.
+         */
+        const LockedResource LockShared() const;
+
+        /**
+         * @brief Copy the current version of the resource into an immutable snapshot.
+         *
+         * The copy is eager: the whole payload is copied under a shared lock on the first call after a change, so it
+         * costs a full copy of the resource and blocks writers while it is taken. It is then cached until the next
+         * exclusive lock is released, so readers of an unchanged resource share one snapshot. Holders use it without
+         * locks, so a long serialization of the snapshot does not block writers; a version is reclaimed when its last
+         * holder releases it.
+         * @return The snapshot.
+         */
+        std::shared_ptr<const ResourceSnapshot> CopySnapshot() const;
+
+        /**
+         * @brief Get the current version of the resource.
+         * @return The number of exclusive locks released so far.
+         */
+        uint64_t GetVersion() const;
+
+        /**
+         * @brief Enable optimistic reads through a seqlock.
+         *
+         * Keeps a copy of up to capacity bytes of the payload that is refreshed whenever an exclusive lock is released.
+         * Meant for small resources that are read much more often than written. The copy is allocated on the first call
+         * and kept until the resource is destroyed, so it may be enabled again only with the same capacity.
+         * @param capacity The largest payload in bytes that is published; larger payloads are read under a shared lock.
+         * @throw std::runtime_error If the resource is sparse, chunked or compressed, or the seqlock has another capacity.
+         */
+        void EnableSeqlock(const size_t capacity);
+
+        /**
+         * @brief Disable optimistic reads; readers fall back to a shared lock.
+         */
+        void DisableSeqlock();
+
+        /**
+         * @brief Check if optimistic reads are enabled.
+         * @return True if a seqlock is enabled, false otherwise.
+         */
+        bool IsSeqlockEnabled() const;
+
+        /**
+         * @brief Get the number of payloads published to the seqlock.
+         * @return The version, 0 if the seqlock is disabled.
+         */
+        uint64_t GetSeqlockVersion() const;
+
+        /**
+         * @brief Copy the payload without blocking writers.
+         *
+         * Reads the seqlock copy and retries if a writer published in the meantime. Falls back to a shared lock if the
+         * seqlock is disabled, the payload does not fit it, or writers keep interfering.
+         * @param buff The destination buffer.
+         * @param n The size of the destination buffer in bytes.
+         * @return The number of bytes copied.
+         * @throw std::runtime_error If the buffer is smaller than the payload, or the resource is sparse, chunked or
+         * compressed.
+         */
+        size_t ReadConsistent(char *buff, const size_t n) const;
+
         /**
          * @brief Default constructor for the ISerializableResource class.
          */
@@ -107,7 +198,18 @@ namespace filesystem_adapters
         ISerializableResource &operator=(ISerializableResource &&other) noexcept;
 
         /** @brief IO lock */
-        std::shared_ptr<std::mutex> mtx_;
+        std::shared_ptr<std::shared_mutex> mtx_;
+
+    private:
+        struct Seqlock;
+
+        void Publish() const;
+        size_t ReadLocked(char *buff, const size_t n) const;
+
+        std::atomic<Seqlock *> seqlock_{nullptr};
+        std::atomic<uint64_t> version_{0};
+        mutable std::mutex snapshotMtx_;
+        mutable std::shared_ptr<const ResourceSnapshot> snapshot_;
     };
 
 } // end namespace filesystem_adapters
@@ -0,0 +1,231 @@
+/**
+ * @file Journal.h
+ * @brief Declaration of the Journal class, a write-ahead log that makes many file writes durable with one sync.
+ */
+
+#ifndef filesystem_adapters_journal_h
+#define filesystem_adapters_journal_h
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @class Journal
+     * @brief Commits the images of files to a write-ahead log before the files are written, so that they survive a crash.
+     *
+     * The journal starts with an 8-byte magic followed by records of a 4-byte path size, a 4-byte CRC-32 of the
+     * path and image, an 8-byte image size, the path and the image; a removal has no image. Writers that commit
+     * at the same time share a single sync of the journal: the first one to find no sync in progress writes every
+     * queued record with one gathered write, straight from the writers' images, and syncs once, and the others
+     * wait for it. A file is written, without a sync, only after its
+     * record is durable. A checkpoint then syncs the files written since the previous one and empties the journal,
+     * either on demand or in the background once the journal grows past a size. Opening a journal replays the
+     * latest record of each file it holds, so the files a crash left behind are rewritten from their images. A
+     * record cut short by a crash was never acknowledged and is dropped. All members are thread safe, but a journal
+     * that fails to commit fails every later write.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT Journal
+    {
+    public:
+        /** @brief The default size at which a checkpoint is started in the background. */
+        static constexpr size_t CHECKPOINT_SIZE = size_t(64) << 20;
+
+        /**
+         * @brief Constructor for the Journal class; replays the records of an existing journal and empties it.
+         * @param filePath The path of the journal.
+         * @param checkpointSize The size of the journal at which a checkpoint is started in the background.
+         * @throw std::runtime_error If the path is empty, the journal does not start with the magic or cannot be replayed or opened.
+         */
+        Journal(const std::string_view filePath, const size_t checkpointSize = CHECKPOINT_SIZE);
+
+        /**
+         * @brief Destructor for the Journal class; waits for a background checkpoint and checkpoints once more.
+         */
+        virtual ~Journal() noexcept;
+
+        /**
+         * @brief Deleted copy constructor; the journal owns its file.
+         */
+        Journal(const Journal &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator; the journal owns its file.
+         * @return Reference to the updated instance (not used).
+         */
+        Journal &operator=(const Journal &) = delete;
+
+        /**
+         * @brief Get the path of the journal.
+         * @return The path.
+         */
+        const std::string &GetPath() const;
+
+        /**
+         * @brief Get the size of the journal, which grows with every commit and shrinks at every checkpoint.
+         * @return The size in bytes, including the magic.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Get the number of syncs of the journal, each of which commits a group of records.
+         * @return The number of commits since the journal was opened.
+         */
+        size_t GetCommitCount() const;
+
+        /**
+         * @brief Get the number of files replayed when the journal was opened.
+         * @return The number of files rewritten or removed.
+         */
+        size_t GetRecoveredCount() const;
+
+        /**
+         * @brief Commit the image of a file and write the file once the image is durable.
+         * @param filePath The path of the file.
+         * @param data The image.
+         * @param size The size of the image in bytes.
+         * @param apply Writes the file; it does not need to sync it. If it throws, the file is rewritten on replay.
+         * @throw std::runtime_error If the path is empty or the record cannot be committed.
+         */
+        void Write(const std::string_view filePath, const char *data, const size_t size, const std::function<void()> &apply);
+
+        /**
+         * @brief Commit the image of a file whose CRC-32 is already known and write the file once the image is durable.
+         * @param filePath The path of the file.
+         * @param data The image; it is written to the journal in place, so it is not copied.
+         * @param size The size of the image in bytes.
+         * @param checksum The CRC-32 of the image, as computed by resource::IResource::Crc32.
+         * @param apply Writes the file; it does not need to sync it. If it throws, the file is rewritten on replay.
+         * @throw std::runtime_error If the path is empty or the record cannot be committed.
+         */
+        void Write(const std::string_view filePath, const char *data, const size_t size, const uint32_t checksum, const std::function<void()> &apply);
+
+        /**
+         * @brief Commit the removal of a file and remove the file once the removal is durable.
+         * @param filePath The path of the file.
+         * @param apply Removes the file.
+         * @throw std::runtime_error If the path is empty or the record cannot be committed.
+         */
+        void Remove(const std::string_view filePath, const std::function<void()> &apply);
+
+        /**
+         * @brief Make a file written without the journal durable and checkpoint, so that no older record of the file is replayed over it.
+         * @param filePath The path of the file.
+         * @throw std::runtime_error If the file or the journal cannot be synced.
+         */
+        void Flush(const std::string_view filePath);
+
+        /**
+         * @brief Sync the files written since the previous checkpoint and their directories, then empty the journal.
+         *
+         * Waits for writers between their commit and their write, and blocks new commits until it is done.
+         * @throw std::runtime_error If a file or the journal cannot be synced.
+         */
+        void Checkpoint();
+
+        /**
+         * @brief Start a checkpoint on a background thread, unless one is running.
+         */
+        void StartCheckpoint();
+
+        /**
+         * @brief Wait for the checkpoint started by StartCheckpoint.
+         * @throw std::runtime_error If the checkpoint failed.
+         */
+        void WaitForCheckpoint();
+
+    private:
+        /**
+         * @struct Record
+         * @brief A record waiting to be committed.
+         */
+        struct Record
+        {
+            /** @brief The record header followed by the path. */
+            std::string head;
+
+            /** @brief The image, owned by the writer, which waits until the record is durable. */
+            const char *image{nullptr};
+
+            /** @brief The size of the image in bytes. */
+            size_t size{0};
+        };
+
+        /**
+         * @brief Append a record to the group being committed and wait until it is durable.
+         * @param record The record.
+         * @throw std::runtime_error If the group cannot be written or synced.
+         */
+        void Commit(Record record);
+
+        /**
+         * @brief Rewrite or remove the files of the records of a journal and sync them.
+         * @return The number of files replayed.
+         */
+        size_t Replay();
+
+        /** @brief The path of the journal. */
+        std::string filePath_;
+
+        /** @brief The size of the journal at which a checkpoint is started in the background. */
+        size_t checkpointSize_;
+
+        /** @brief The file descriptor of the journal, open for appending. */
+        int fd_{-1};
+
+        /** @brief The records waiting for the next commit. */
+        std::vector<Record> queue_;
+
+        /** @brief The number of records queued since the journal was opened. */
+        uint64_t queued_{0};
+
+        /** @brief The number of queued records that are durable. */
+        uint64_t durable_{0};
+
+        /** @brief True while a writer commits a group. */
+        bool committing_{false};
+
+        /** @brief True once a commit failed. */
+        bool failed_{false};
+
+        /** @brief The size of the journal in bytes. */
+        size_t size_{0};
+
+        /** @brief The number of commits since the journal was opened. */
+        size_t commitCount_{0};
+
+        /** @brief The number of files replayed when the journal was opened. */
+        size_t recoveredCount_{0};
+
+        /** @brief The files written or removed since the previous checkpoint. */
+        std::set<std::string> dirty_;
+
+        /** @brief Guards the queue, the counters and the files to checkpoint. */
+        mutable std::mutex lock_;
+
+        /** @brief Signals the end of a commit. */
+        std::condition_variable committed_;
+
+        /** @brief Shared by writers from their commit to the end of their write, taken exclusively by checkpoints. */
+        std::shared_mutex checkpointLock_;
+
+        /** @brief The checkpoint started by StartCheckpoint. */
+        std::future<void> checkpoint_;
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_journal_h
@@ -0,0 +1,176 @@
+/**
+ * @file MappedResource.h
+ * @brief Declaration of the MappedResource class for resources backed by a memory-mapped serialization file.
+ */
+
+#ifndef filesystem_adapters_mappedresource_h
+#define filesystem_adapters_mappedresource_h
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+#include "FilesystemAdapters/ISerializableResource.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @brief The access mode of a mapped resource.
+     */
+    enum class MapMode
+    {
+        ReadOnly,   /**< Pages are shared with every process mapping the file and cannot be written. */
+        CopyOnWrite /**< Pages are shared until written; writes stay private and never reach the file. */
+    };
+
+    /**
+     * @brief Access pattern hints forwarded to madvise.
+     */
+    enum class MapAdvice
+    {
+        Normal,
+        Sequential,
+        Random,
+        WillNeed,
+        DontNeed
+    };
+
+    /**
+     * @class MappedResource
+     * @brief A serializable resource whose Data() points directly into a memory map of a `.bin` file
+     * written by ResourceSerializer.
+     *
+     * Mapping is constant time regardless of the file size; pages are read on first access. When
+     * ResourceDeserializer generates a MappedResource, it maps the file instead of reading it. Assigning
+     * data that does not fit the current mapping replaces the mapping with an owned buffer. Derived
+     * classes provide GetElementSize().
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT MappedResource : public ISerializableResource
+    {
+    public:
+        /**
+         * @brief Constructor for the MappedResource class.
+         * @param mode The access mode used when the resource is mapped.
+         */
+        MappedResource(const MapMode mode = MapMode::ReadOnly);
+
+        /**
+         * @brief Destructor for the MappedResource class.
+         */
+        virtual ~MappedResource() noexcept;
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        MappedResource(const MappedResource &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        MappedResource &operator=(const MappedResource &) = delete;
+
+        /**
+         * @brief Move constructor.
+         * @param other The MappedResource instance to move from.
+         */
+        MappedResource(MappedResource &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The MappedResource instance to move from.
+         * @return Reference to the updated MappedResource instance.
+         */
+        MappedResource &operator=(MappedResource &&other) noexcept;
+
+        /**
+         * @brief Map a `.bin` file and take its dimensions.
+         * @param filePath The path of the file written by ResourceSerializer.
+         * @throw std::runtime_error If the file cannot be mapped, is quantized, compressed or truncated, holds another
+         * element type or has pending deltas.
+         */
+        void Map(const std::string_view filePath);
+
+        /**
+         * @brief Release the mapping or owned buffer; the dimensions are kept.
+         */
+        void Unmap();
+
+        /**
+         * @brief Check if the resource is backed by a file mapping.
+         * @return True if the resource is mapped, false otherwise.
+         */
+        bool IsMapped() const;
+
+        /**
+         * @brief Get the access mode used when the resource is mapped.
+         * @return The access mode.
+         */
+        MapMode GetMode() const;
+
+        /**
+         * @brief Get the path of the mapped file.
+         * @return The path, or an empty string if the resource is not mapped.
+         */
+        std::string GetFilePath() const;
+
+        /**
+         * @brief Advise the kernel of the expected access pattern of the mapped pages.
+         * @param advice The access pattern hint.
+         * @return True if the hint was accepted, false otherwise.
+         */
+        bool Advise(const MapAdvice advice) const;
+
+        /**
+         * @brief Access the resource data as a mutable pointer.
+         * @return A pointer to the data.
+         * @throw std::runtime_error If the resource is mapped read-only.
+         */
+        void *Data() override;
+
+        /**
+         * @brief Access the resource data as a constant pointer.
+         * @return A constant pointer to the data.
+         */
+        const void *Data() const override;
+
+        /**
+         * @brief Assign data to the resource.
+         * @param buff A pointer to the data.
+         * @param n The size of the data in bytes.
+         * @throw std::runtime_error If the resource is mapped read-only.
+         */
+        void Assign(const char *buff, const size_t n) override;
+
+    private:
+        /**
+         * @brief Get the number of payload bytes currently addressable through Data().
+         * @return The payload size in bytes.
+         */
+        size_t GetPayloadSize() const;
+
+        /** @brief The access mode used when the resource is mapped. */
+        MapMode mode_;
+
+        /** @brief The path of the mapped file. */
+        std::string filePath_;
+
+        /** @brief The mapped region of the file, including the header. */
+        std::unique_ptr<boost::interprocess::mapped_region> region_;
+
+        /** @brief The offset of the payload within the mapped region. */
+        size_t dataOffset_{0};
+
+        /** @brief The owned payload used once data is assigned outside of a mapping. */
+        std::vector<char> owned_;
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_mappedresource_h
@@ -0,0 +1,260 @@
+/**
+ * @file PackFile.h
+ * @brief Declaration of the PackFile class, a store of many small resource images in a few large segment files.
+ */
+
+#ifndef filesystem_adapters_packfile_h
+#define filesystem_adapters_packfile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @class PackFile
+     * @brief Appends resource images to large segment files instead of writing one file per resource.
+     *
+     * A pack is a directory of `<n>.pack` segments. Each segment starts with an 8-byte magic followed by records
+     * of a 4-byte key size, a 4-byte CRC-32 of the key and image, an 8-byte image size, the key and the image.
+     * Writing a key again appends a new record, and erasing one appends a tombstone, so the records they replace
+     * become dead bytes until Compact rewrites the live records of a segment and removes it. The index of each
+     * key's latest record is rebuilt when the pack is opened. The records of the newest segment are checked
+     * against their checksums, and the first one that was cut short or does not match ends the segment; it is
+     * ignored and overwritten by the next append. All members are thread safe.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT PackFile
+    {
+    public:
+        /** @brief The default size at which a new segment is started. */
+        static constexpr size_t SEGMENT_SIZE = size_t(64) << 20;
+
+        /** @brief The default fraction of dead bytes at which a segment is compacted. */
+        static constexpr double DEAD_RATIO = 0.5;
+
+        /**
+         * @struct Entry
+         * @brief The location of the latest image of a key.
+         */
+        struct Entry
+        {
+            /** @brief The number of the segment. */
+            uint32_t segment{0};
+
+            /** @brief The offset of the image in the segment. */
+            uint64_t offset{0};
+
+            /** @brief The size of the image in bytes. */
+            uint64_t length{0};
+
+            /** @brief The CRC-32 of the key followed by the image. */
+            uint32_t checksum{0};
+        };
+
+        /**
+         * @brief Constructor for the PackFile class; opens the pack in a directory, creating it if needed.
+         * @param directory The directory of the segments.
+         * @param segmentSize The size at which a new segment is started; larger images get a segment of their own.
+         * @throw std::runtime_error If the directory cannot be created or a segment does not start with the magic.
+         */
+        PackFile(const std::string_view directory, const size_t segmentSize = SEGMENT_SIZE);
+
+        /**
+         * @brief Destructor for the PackFile class; waits for a background compaction.
+         */
+        virtual ~PackFile() noexcept;
+
+        /**
+         * @brief Deleted copy constructor; the pack owns its segment files.
+         */
+        PackFile(const PackFile &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator; the pack owns its segment files.
+         * @return Reference to the updated instance (not used).
+         */
+        PackFile &operator=(const PackFile &) = delete;
+
+        /**
+         * @brief Get the directory of the segments.
+         * @return The directory.
+         */
+        const std::string &GetDirectory() const;
+
+        /**
+         * @brief Check if the pack holds an image for a key.
+         * @param key The key.
+         * @return True if the key has an image, false otherwise.
+         */
+        bool Contains(const std::string_view key) const;
+
+        /**
+         * @brief Look up the location of the image of a key.
+         * @param key The key.
+         * @return The location, empty if the key has no image.
+         */
+        std::optional<Entry> Find(const std::string_view key) const;
+
+        /**
+         * @brief Get the keys with an image.
+         * @return The keys, in no particular order.
+         */
+        std::vector<std::string> GetKeys() const;
+
+        /**
+         * @brief Get the number of segment files.
+         * @return The number of segments.
+         */
+        size_t GetSegmentCount() const;
+
+        /**
+         * @brief Get the fraction of the records of the pack that were replaced or erased.
+         * @return The number of dead bytes over the number of record bytes, 0 for an empty pack.
+         */
+        double GetDeadRatio() const;
+
+        /**
+         * @brief Append the image of a key, replacing any earlier image.
+         * @param key The key.
+         * @param data The image.
+         * @param size The size of the image in bytes.
+         * @throw std::runtime_error If the key is empty or the segment cannot be written.
+         */
+        void Put(const std::string_view key, const char *data, const size_t size);
+
+        /**
+         * @brief Read the image of a key.
+         * @param key The key.
+         * @return The image.
+         * @throw std::runtime_error If the key has no image or the image does not match its checksum.
+         */
+        std::vector<char> Get(const std::string_view key) const;
+
+        /**
+         * @brief Erase the image of a key by appending a tombstone.
+         * @param key The key.
+         * @return True if the key had an image, false otherwise.
+         * @throw std::runtime_error If the segment cannot be written.
+         */
+        bool Erase(const std::string_view key);
+
+        /**
+         * @brief Rewrite the live records of every full segment with at least a fraction of dead bytes and remove it.
+         *
+         * Segments are compacted one at a time, oldest first, and are read without blocking readers and writers,
+         * which wait only while a bounded batch of live records is appended. The segments holding the copies are
+         * synced before a segment is removed, so a crash leaves at least one copy of every record.
+         * @param deadRatio The fraction of dead bytes at which a segment is compacted.
+         * @return The number of segments removed.
+         * @throw std::runtime_error If a segment cannot be read, written or removed.
+         */
+        size_t Compact(const double deadRatio = DEAD_RATIO);
+
+        /**
+         * @brief Start a compaction on a background thread, unless one is running.
+         * @param deadRatio The fraction of dead bytes at which a segment is compacted.
+         */
+        void StartCompaction(const double deadRatio = DEAD_RATIO);
+
+        /**
+         * @brief Wait for the compaction started by StartCompaction.
+         * @return The number of segments removed, 0 if no compaction was started.
+         * @throw std::runtime_error If the compaction failed.
+         */
+        size_t WaitForCompaction();
+
+    private:
+        /**
+         * @struct Segment
+         * @brief An open segment file.
+         */
+        struct Segment
+        {
+            /** @brief The file, open for reading and appending. */
+            std::fstream file;
+
+            /** @brief The offset of the end of the last complete record. */
+            uint64_t size{0};
+
+            /** @brief The number of bytes of records that were replaced or erased. */
+            uint64_t deadBytes{0};
+        };
+
+        /**
+         * @brief Get the path of a segment.
+         * @param segment The number of the segment.
+         * @return The path.
+         */
+        std::string GetSegmentPath(const uint32_t segment) const;
+
+        /**
+         * @brief Create an empty segment and make it the newest; the lock must be held.
+         * @param segment The number of the segment.
+         */
+        void Create(const uint32_t segment);
+
+        /**
+         * @brief Open a segment and add its records to the index.
+         * @param segment The number of the segment.
+         * @param last True for the newest segment, whose records are checked and whose torn or corrupt tail is cut off.
+         */
+        void Open(const uint32_t segment, const bool last);
+
+        /**
+         * @brief Append a record to the newest segment, starting a new segment when it is full; the lock must be held.
+         * @param key The key.
+         * @param data The image, null for a tombstone.
+         * @param size The size of the image in bytes.
+         * @param checksum The CRC-32 of the key followed by the image.
+         * @return The location of the image.
+         */
+        Entry Append(const std::string_view key, const char *data, const size_t size, const uint32_t checksum);
+
+        /**
+         * @brief Mark the record of an entry as dead; the lock must be held.
+         * @param entry The entry.
+         * @param keySize The size of its key.
+         */
+        void Kill(const Entry &entry, const size_t keySize);
+
+        /** @brief The directory of the segments. */
+        std::string directory_;
+
+        /** @brief The size at which a new segment is started. */
+        size_t segmentSize_;
+
+        /** @brief The open segments by number. */
+        std::map<uint32_t, std::unique_ptr<Segment>> segments_;
+
+        /** @brief The number of the newest segment, the only one appended to. */
+        uint32_t active_{0};
+
+        /** @brief The location of the latest image of each key. */
+        std::unordered_map<std::string, Entry> index_;
+
+        /** @brief Guards the segments and the index. */
+        mutable std::mutex lock_;
+
+        /** @brief Serializes compactions. */
+        std::mutex compactLock_;
+
+        /** @brief The compaction started by StartCompaction. */
+        std::future<size_t> compaction_;
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // filesystem_adapters_packfile_h
@@ -10,15 +10,22 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <typeinfo>
+#include <vector>
 #include "Config/filesystem.h"
 
 #include "FilesystemAdapters/config.h"
-#include "FilesystemAdapters/FileLock.hpp"
+#include "FilesystemAdapters/AlignedFile.h"
 #include "FilesystemAdapters/ISerializableResource.h"
+#include "FilesystemAdapters/PackFile.h"
+#include "FilesystemAdapters/ResourceHeader.h"
 
 namespace filesystem_adapters
 {
@@ -28,10 +35,22 @@ namespace filesystem_adapters
      * @brief A singleton class responsible for deserializing resources.
      *
      * Provides methods for managing resource registrations and deserializing resources based on keys.
+     * Registrations are guarded by a reader-writer lock and files by a lock per path, so resources in
+     * different files are read in parallel.
      */
     class FILESYSTEM_ADAPTERS_DLL_EXPORT ResourceDeserializer
     {
     public:
+        /**
+         * @brief A resource constructor that allocates from the given memory resource.
+         */
+        using AllocatingConstructorType = std::function<std::unique_ptr<ISerializableResource>(std::pmr::memory_resource *)>;
+
+        /**
+         * @brief Receives a chunk of a streamed payload and its byte offset within the payload.
+         */
+        using ChunkCallbackType = std::function<void(const char *chunk, const size_t size, const size_t offset)>;
+
         /**
          * @brief Destructor for the ResourceDeserializer class.
          */
@@ -52,6 +71,15 @@ namespace filesystem_adapters
         template <typename T>
         void RegisterResource(const std::string_view key, std::function<std::unique_ptr<ISerializableResource>(void)> constructor);
 
+        /**
+         * @brief Register a resource type with a key and an allocating constructor.
+         * @tparam T The resource type to register.
+         * @param key The key associated with the resource type.
+         * @param constructor The constructor function, given the memory resource passed to Deserialize.
+         */
+        template <typename T>
+        void RegisterResource(const std::string_view key, AllocatingConstructorType constructor);
+
         /**
          * @brief Unregister a resource type by its key.
          * @param key The key of the resource type to unregister.
@@ -72,18 +100,90 @@ namespace filesystem_adapters
 
         /**
          * @brief Deserialize a resource by its key.
+         *
+         * The file is mapped and its payload copied into the resource in a single pass, or not at all for a
+         * MappedResource, which keeps the mapping as its data.
+         * Files written as a base image and a chain of deltas are rebuilt in memory first; they cannot be
+         * mapped until a full image is written again.
+         * Payloads stored with another element type, including reduced-precision and quantized encodings, are
+         * converted to the element type of the registered resource.
          * @param key The key of the resource to deserialize.
          * @param deserializationPath The path to deserialize from.
+         * @param memory The memory resource for staging buffers and allocating constructors.
          * @return A unique pointer to the deserialized resource.
          */
-        std::unique_ptr<ISerializableResource> Deserialize(const std::string_view key, const std::string_view deserializationPath);
+        std::unique_ptr<ISerializableResource> Deserialize(const std::string_view key, const std::string_view deserializationPath, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+        /**
+         * @brief Deserialize a resource with the specified key from a pack file.
+         * @param key The key associated with the resource.
+         * @param pack The pack file.
+         * @param memory The memory resource for staging buffers and allocating constructors.
+         * @return The resource.
+         * @throw std::runtime_error If the pack has no image for the key or the resource is a MappedResource.
+         */
+        std::unique_ptr<ISerializableResource> Deserialize(const std::string_view key, const PackFile &pack, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+        /**
+         * @brief Deserialize many resources from one directory, reading their files concurrently.
+         *
+         * Every file is requested from AsyncFileIO before the first is parsed, so on Linux the reads reach the
+         * device through a single io_uring queue. Files with pending deltas are read as Deserialize reads them.
+         * @param keys The keys of the resources.
+         * @param deserializationPath The path to deserialize from.
+         * @param memory The memory resource for allocating constructors.
+         * @return The resources, in the order of the keys.
+         * @throw std::runtime_error If any resource cannot be deserialized.
+         */
+        std::vector<std::unique_ptr<ISerializableResource>> DeserializeBatch(const std::span<const std::string> keys, const std::string_view deserializationPath, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+        /**
+         * @brief Stream the payload of a serialized resource in chunks without holding it in memory.
+         *
+         * The file is read in large aligned blocks into a single buffer of chunkSize bytes, and each chunk of the
+         * payload is handed to the callback before the next is read. Chunks are consecutive; the first and last
+         * can be shorter. The payload is passed as it is stored, so the header describes its element type and any
+         * encoding. The key does not need to be registered. The file is locked while it is streamed.
+         * @param key The key of the resource.
+         * @param deserializationPath The path to deserialize from.
+         * @param onChunk Called with each chunk of the payload.
+         * @param chunkSize The size of the read buffer, rounded up to AlignedFile::ALIGNMENT.
+         * @param direct True to bypass the page cache, for cold data read once.
+         * @return The header.
+         * @throw std::runtime_error If the file cannot be read or has pending deltas.
+         */
+        ResourceHeader DeserializeChunks(const std::string_view key, const std::string_view deserializationPath, const ChunkCallbackType &onChunk, const size_t chunkSize = AlignedFile::CHUNK_SIZE, const bool direct = false) const;
+
+        /**
+         * @brief Read and decompress a single frame of a compressed resource without reading the rest of the payload.
+         *
+         * The checksum of the header covers the whole payload, so a single frame is only checked by its codec.
+         * @param key The key of the resource.
+         * @param deserializationPath The path to deserialize from.
+         * @param frame The index of the frame, which starts at byte frame * GetFrameSize() of the stored payload.
+         * @return The uncompressed bytes of the frame.
+         * @throw std::runtime_error If the file is not compressed in frames, has no such frame or has pending deltas.
+         */
+        std::vector<char> DeserializeFrame(const std::string_view key, const std::string_view deserializationPath, const size_t frame) const;
+
+        /**
+         * @brief Read the header of a serialized resource without reading its payload.
+         *
+         * The header holds the zone map of the payload when one was written, so scans can skip resources
+         * whose values fall outside a range.
+         * @param key The key of the resource.
+         * @param deserializationPath The path to deserialize from.
+         * @return The header.
+         */
+        ResourceHeader ReadHeader(const std::string_view key, const std::string_view deserializationPath) const;
 
         /**
          * @brief Generate a resource instance by its key.
          * @param key The key of the resource to generate.
+         * @param memory The memory resource passed to an allocating constructor.
          * @return A unique pointer to the generated resource.
          */
-        std::unique_ptr<ISerializableResource> GenerateResource(const std::string_view key) const;
+        std::unique_ptr<ISerializableResource> GenerateResource(const std::string_view key, std::pmr::memory_resource *memory = std::pmr::get_default_resource()) const;
 
     private:
         /**
@@ -115,8 +215,23 @@ namespace filesystem_adapters
          */
         ResourceDeserializer &operator=(ResourceDeserializer &&) = delete;
 
+        /**
+         * @brief Build a resource from the image of its file.
+         * @param key The key of the resource.
+         * @param filePath The path of the file, mapped again by a MappedResource; empty for an image from a pack file.
+         * @param image The header and payload.
+         * @param size The size of the image in bytes.
+         * @param hasDeltas True if the image was rebuilt from deltas, which cannot be mapped.
+         * @param memory The memory resource for staging buffers and allocating constructors.
+         * @return The resource.
+         */
+        std::unique_ptr<ISerializableResource> ReadImage(const std::string_view key, const std::string &filePath, const char *image, const size_t size, const bool hasDeltas, std::pmr::memory_resource *memory);
+
         /** @brief Map of keys to resource constructor functions. */
-        mutable std::map<std::string, std::function<std::unique_ptr<ISerializableResource>(void)>, std::less<>> keyToResourceMap_;
+        std::map<std::string, AllocatingConstructorType, std::less<>> keyToResourceMap_;
+
+        /** @brief Guards the constructor registry; lookups share it and registrations take it exclusively. */
+        mutable std::shared_mutex registryLock_;
     };
 
 #include "FilesystemAdapters/ResourceDeserializer.hpp"
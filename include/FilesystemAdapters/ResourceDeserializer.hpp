@@ -1,13 +1,21 @@
 
 template <typename T>
 void ResourceDeserializer::RegisterResource(const std::string_view key, std::function<std::unique_ptr<ISerializableResource>(void)> constructor)
+{
+	auto allocatingConstructor = [constructor](std::pmr::memory_resource *)
+	{ return constructor(); };
+	RegisterResource<T>(key, AllocatingConstructorType(allocatingConstructor));
+}
+
+template <typename T>
+void ResourceDeserializer::RegisterResource(const std::string_view key, AllocatingConstructorType constructor)
 {
 	if (!std::is_arithmetic<T>::value)
 		throw std::runtime_error("Type (" + std::string(typeid(T).name()) + ") is not an arithmetic container when registering resource with ResourceDeserializer");
 	if (key.empty())
 		throw std::runtime_error("Key is empty when registering resource with ResourceDeserializer");
 
-	std::lock_guard<std::recursive_mutex> lock(filesystem_adapters::GetGlobalFileLock());
+	std::unique_lock<std::shared_mutex> lock(registryLock_);
 
 	if (keyToResourceMap_.find(key) != keyToResourceMap_.cend())
 		throw std::runtime_error("Key is already registered with the ResourceDeserializer");
@@ -0,0 +1,316 @@
+/**
+ * @file ResourceHeader.h
+ * @brief Declaration of the ResourceHeader class describing the header of a serialized resource file.
+ */
+
+#ifndef filesystem_adapters_resourceheader_h
+#define filesystem_adapters_resourceheader_h
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+#include "Resources/Codec.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/ZoneMap.h"
+
+namespace filesystem_adapters
+{
+
+    /**
+     * @class ResourceHeader
+     * @brief The header that precedes the payload of a serialized resource file.
+     *
+     * Files start with an 8-byte magic, a 4-byte version and the 4-byte size of the header, followed by the
+     * rank, the layout type, the element type, a set of flags, a byte order mark, the CRC-32 of the payload, the extents
+     * and, for tiled layouts, the tile extents. When flagged, the scale and offset of a quantized payload follow, then
+     * the index of a payload compressed in frames, then a zone map of the payload so that scans can be pruned without
+     * reading the payload; readers that predate them skip them using the header size. The header is padded to a multiple of ALIGNMENT, so a mapped payload can be used in
+     * place. Files written before the header was versioned hold only the column and row sizes and are read as
+     * two-dimensional row-major resources; other versions are rejected.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT ResourceHeader
+    {
+    public:
+        /** @brief The alignment of the payload of a file written in the current format. */
+        static constexpr size_t ALIGNMENT = 64;
+
+        /**
+         * @brief Default constructor for the ResourceHeader class; describes an empty two-dimensional resource.
+         */
+        ResourceHeader();
+
+        /**
+         * @brief Constructor for the ResourceHeader class.
+         * @param shape The extent of each dimension.
+         * @param layout The ordering of the payload.
+         * @param dataType The type of each element of the payload.
+         */
+        ResourceHeader(const std::vector<size_t> &shape, const resource::Layout &layout = resource::Layout(), const resource::DataType dataType = resource::DataType::Unknown);
+
+        /**
+         * @brief Destructor for the ResourceHeader class.
+         */
+        virtual ~ResourceHeader() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The ResourceHeader instance to copy from.
+         */
+        ResourceHeader(const ResourceHeader &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The ResourceHeader instance to copy from.
+         * @return Reference to the updated ResourceHeader instance.
+         */
+        ResourceHeader &operator=(const ResourceHeader &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The ResourceHeader instance to move from.
+         */
+        ResourceHeader(ResourceHeader &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The ResourceHeader instance to move from.
+         * @return Reference to the updated ResourceHeader instance.
+         */
+        ResourceHeader &operator=(ResourceHeader &&other) noexcept;
+
+        /**
+         * @brief Read a header, leaving the stream at the start of the payload.
+         * @param inFile The stream to read from.
+         * @return The header.
+         * @throw std::runtime_error If the header is truncated, has an unsupported version or another byte order.
+         */
+        static ResourceHeader Read(std::istream &inFile);
+
+        /**
+         * @brief Parse a header from the start of an in-memory file.
+         * @param buff The start of the file.
+         * @param size The size of the file in bytes.
+         * @return The header.
+         * @throw std::runtime_error If the header is truncated, has an unsupported version or another byte order.
+         */
+        static ResourceHeader Read(const char *buff, const size_t size);
+
+        /**
+         * @brief Write the header in the current format.
+         * @param outFile The stream to write to.
+         */
+        void Write(std::ostream &outFile) const;
+
+        /**
+         * @brief Get the format version the header was read with.
+         * @return The version, 0 for files without a versioned header.
+         */
+        uint32_t GetVersion() const;
+
+        /**
+         * @brief Get the size of the header in bytes, which is the offset of the payload.
+         * @return The header size.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Get the extent of each dimension.
+         * @return The shape.
+         */
+        const std::vector<size_t> &GetShape() const;
+
+        /**
+         * @brief Get the ordering of the payload.
+         * @return The layout.
+         */
+        const resource::Layout &GetLayout() const;
+
+        /**
+         * @brief Get the type of each element of the payload.
+         * @return The element type, Unknown for files written without one.
+         */
+        resource::DataType GetDataType() const;
+
+        /**
+         * @brief Get the number of elements described by the shape.
+         * @return The element count.
+         */
+        size_t GetElementCount() const;
+
+        /**
+         * @brief Attach the statistics of the payload, growing the header to hold them.
+         * @param zoneMap The zone map of the payload.
+         */
+        void SetZoneMap(const resource::ZoneMap &zoneMap);
+
+        /**
+         * @brief Check if the header holds the statistics of the payload.
+         * @return True if a zone map is attached, false otherwise.
+         */
+        bool HasZoneMap() const;
+
+        /**
+         * @brief Get the statistics of the payload.
+         * @return The zone map.
+         * @throw std::runtime_error If no zone map is attached.
+         */
+        const resource::ZoneMap &GetZoneMap() const;
+
+        /**
+         * @brief Mark the payload as quantized, growing the header to hold the map back to its values.
+         *
+         * The element type of the header is then the stored integer type.
+         * @param quantization The scale and offset of the payload.
+         */
+        void SetQuantization(const resource::Quantization &quantization);
+
+        /**
+         * @brief Check if the payload is quantized.
+         * @return True if a quantization is attached, false otherwise.
+         */
+        bool IsQuantized() const;
+
+        /**
+         * @brief Get the scale and offset of a quantized payload.
+         * @return The quantization.
+         * @throw std::runtime_error If the payload is not quantized.
+         */
+        const resource::Quantization &GetQuantization() const;
+
+        /**
+         * @brief Mark the payload as compressed in independent frames, growing the header to hold their index.
+         *
+         * Every frame but the last holds frameSize bytes of the uncompressed payload, so a single frame can be read
+         * and decompressed on its own.
+         * @param codecType The algorithm the frames are compressed with.
+         * @param frameSize The number of uncompressed bytes per frame.
+         * @param rawSize The size of the uncompressed payload in bytes.
+         * @param frameOffsets The offset of each frame in the stored payload, followed by the size of the stored payload.
+         * @throw std::runtime_error If the codec is CodecType::None or the offsets do not match the sizes.
+         */
+        void SetFrames(const resource::CodecType codecType, const size_t frameSize, const size_t rawSize, const std::vector<uint64_t> &frameOffsets);
+
+        /**
+         * @brief Check if the payload is compressed in frames.
+         * @return True if a frame index is attached, false otherwise.
+         */
+        bool IsCompressed() const;
+
+        /**
+         * @brief Get the algorithm the frames are compressed with.
+         * @return The codec type, CodecType::None if the payload is not compressed.
+         */
+        resource::CodecType GetCodecType() const;
+
+        /**
+         * @brief Get the number of uncompressed bytes per frame.
+         * @return The frame size, 0 if the payload is not compressed.
+         */
+        size_t GetFrameSize() const;
+
+        /**
+         * @brief Get the number of frames.
+         * @return The frame count, 0 if the payload is not compressed.
+         */
+        size_t GetFrameCount() const;
+
+        /**
+         * @brief Get the size of the uncompressed payload.
+         * @return The size in bytes, 0 if the payload is not compressed.
+         */
+        size_t GetRawSize() const;
+
+        /**
+         * @brief Get the offset of each frame in the stored payload, followed by the size of the stored payload.
+         * @return The frame offsets, empty if the payload is not compressed.
+         */
+        const std::vector<uint64_t> &GetFrameOffsets() const;
+
+        /**
+         * @brief Store the CRC-32 of the payload, so that readers detect a corrupt payload.
+         * @param checksum The checksum, as computed by resource::IResource::Crc32.
+         */
+        void SetChecksum(const uint32_t checksum);
+
+        /**
+         * @brief Drop the checksum of the payload, e.g. once the payload is modified in place.
+         */
+        void ClearChecksum();
+
+        /**
+         * @brief Check if the header holds the checksum of the payload.
+         * @return True if a checksum is stored, false otherwise.
+         */
+        bool HasChecksum() const;
+
+        /**
+         * @brief Get the CRC-32 of the payload.
+         * @return The checksum.
+         * @throw std::runtime_error If no checksum is stored.
+         */
+        uint32_t GetChecksum() const;
+
+        /**
+         * @brief Check a payload against the stored checksum.
+         * @param payload The payload.
+         * @param size The size of the payload in bytes.
+         * @return True if the checksums match or no checksum is stored, false otherwise.
+         */
+        bool MatchesChecksum(const char *payload, const size_t size) const;
+
+    private:
+        /** @brief The format version. */
+        uint32_t version_;
+
+        /** @brief The size of the header in bytes. */
+        size_t size_;
+
+        /** @brief The extent of each dimension. */
+        std::vector<size_t> shape_;
+
+        /** @brief The ordering of the payload. */
+        resource::Layout layout_;
+
+        /** @brief The type of each element of the payload. */
+        resource::DataType dataType_;
+
+        /** @brief Whether zoneMap_ describes the payload. */
+        bool hasZoneMap_{false};
+
+        /** @brief The statistics of the payload. */
+        resource::ZoneMap zoneMap_;
+
+        /** @brief Whether quantization_ maps the payload back to its values. */
+        bool isQuantized_{false};
+
+        /** @brief The scale and offset of a quantized payload. */
+        resource::Quantization quantization_;
+
+        /** @brief The algorithm the frames are compressed with, CodecType::None if the payload is not compressed. */
+        resource::CodecType codecType_{resource::CodecType::None};
+
+        /** @brief The number of uncompressed bytes per frame. */
+        size_t frameSize_{0};
+
+        /** @brief The size of the uncompressed payload in bytes. */
+        size_t rawSize_{0};
+
+        /** @brief The offset of each frame in the stored payload, followed by the size of the stored payload. */
+        std::vector<uint64_t> frameOffsets_;
+
+        /** @brief Whether checksum_ is the CRC-32 of the payload. */
+        bool hasChecksum_{false};
+
+        /** @brief The CRC-32 of the payload. */
+        uint32_t checksum_{0};
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // end filesystem_adapters_resourceheader_h
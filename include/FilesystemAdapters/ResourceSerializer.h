@@ -6,14 +6,32 @@
 #ifndef filesystem_adapters_resourceserializer_h
 #define filesystem_adapters_resourceserializer_h
 
+#include <atomic>
+#include <cstddef>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 #include "Config/filesystem.h"
 
 #include "FilesystemAdapters/config.h"
+#include "FilesystemAdapters/AlignedFile.h"
 #include "FilesystemAdapters/ISerializableResource.h"
+#include "FilesystemAdapters/Journal.h"
+#include "FilesystemAdapters/PackFile.h"
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "FilesystemAdapters/ResourceSnapshot.h"
+#include "Resources/Codec.h"
+#include "Resources/Encoding.h"
+#include "Resources/ResourceView.h"
 
 namespace filesystem_adapters
 {
@@ -21,10 +39,59 @@ namespace filesystem_adapters
     /**
      * @class ResourceSerializer
      * @brief A singleton class responsible for serializing and deserializing resources.
+     *
+     * Each file is guarded by its own lock, so resources written to different files are written in parallel.
      */
     class FILESYSTEM_ADAPTERS_DLL_EXPORT ResourceSerializer
     {
     public:
+        /** @brief The default number of uncompressed bytes per compressed frame. */
+        static constexpr size_t FRAME_SIZE = size_t(1) << 20;
+
+        /**
+         * @struct BatchItem
+         * @brief A resource to serialize as part of a batch.
+         */
+        struct BatchItem
+        {
+            /** @brief The resource; locked for reading while it is written. */
+            const ISerializableResource *resource{nullptr};
+
+            /** @brief The key associated with the resource. */
+            std::string key;
+
+            /** @brief The file system path to the resource. */
+            std::string serializationPath;
+        };
+
+        /**
+         * @brief The outcome of serializing an item of a batch.
+         */
+        enum class BatchStatus
+        {
+            Written,
+            Unchanged,
+            Failed
+        };
+
+        /**
+         * @brief Fills a chunk of a streamed payload and returns the number of bytes written, 0 at the end.
+         */
+        using ChunkProducerType = std::function<size_t(char *chunk, const size_t size, const size_t offset)>;
+
+        /**
+         * @struct BatchResult
+         * @brief The result of serializing an item of a batch.
+         */
+        struct BatchResult
+        {
+            /** @brief The outcome. */
+            BatchStatus status{BatchStatus::Failed};
+
+            /** @brief The reason the item failed, empty otherwise. */
+            std::string error;
+        };
+
         /**
          * @brief Destructor for the ResourceSerializer class.
          */
@@ -44,6 +111,67 @@ namespace filesystem_adapters
          */
         void Serialize(const ISerializableResource::LockedResource &resource, const std::string_view key, const std::string_view serializationPath);
 
+        /**
+         * @brief Serialize a resource with the specified key into a pack file instead of a file of its own.
+         *
+         * The image is the one written to a file, with zone maps and encodings, but is never written as a delta.
+         * @param resource The locked resource to serialize.
+         * @param key The key associated with the resource.
+         * @param pack The pack file.
+         */
+        void Serialize(const ISerializableResource::LockedResource &resource, const std::string_view key, PackFile &pack);
+
+        /**
+         * @brief Serialize a snapshot of a resource with the specified key.
+         *
+         * Writes without holding the resource lock, so writers are not blocked by the I/O. The snapshot is always
+         * written, since it does not track whether the resource changed since it was last serialized.
+         * @param snapshot The snapshot to serialize.
+         * @param key The key associated with the resource.
+         * @param serializationPath The file system path to the resource
+         */
+        void Serialize(const ResourceSnapshot &snapshot, const std::string_view key, const std::string_view serializationPath);
+
+        /**
+         * @brief Serialize a view of a resource with the specified key without materializing it.
+         *
+         * The view is written as a packed GetColumnSize() x GetRowSize() resource. The caller must hold
+         * the lock of the parent resource for the duration of the call.
+         * @param view The view to serialize.
+         * @param key The key associated with the resource.
+         * @param serializationPath The file system path to the resource
+         */
+        void Serialize(const resource::ResourceView &view, const std::string_view key, const std::string_view serializationPath);
+
+        /**
+         * @brief Serialize a payload produced in chunks without holding it in memory.
+         *
+         * The header is written as it is given, followed by the bytes of the producer, which is called with the
+         * free space of a single buffer of chunkSize bytes and the byte offset of the payload until it returns 0.
+         * The buffer is written in large aligned blocks. Zone maps, encodings and deltas do not apply, and any
+         * pending deltas are removed. The file is locked while it is streamed.
+         * @param header The header of the payload.
+         * @param key The key associated with the resource.
+         * @param serializationPath The file system path to the resource.
+         * @param produce Called to fill the buffer.
+         * @param chunkSize The size of the write buffer, rounded up to AlignedFile::ALIGNMENT.
+         * @param direct True to bypass the page cache, for data that will not be read back soon.
+         * @throw std::runtime_error If the header is compressed, the file cannot be written or the payload does not match a header with an element type.
+         */
+        void SerializeChunks(const ResourceHeader &header, const std::string_view key, const std::string_view serializationPath, const ChunkProducerType &produce, const size_t chunkSize = AlignedFile::CHUNK_SIZE, const bool direct = false);
+
+        /**
+         * @brief Serialize many resources at once.
+         *
+         * Each directory is created once, and the items are hashed and written in parallel on a ThreadPool. The items
+         * of one resource are written in turn by one thread; it is hashed once, and if it changed every item is written.
+         * A failing item does not stop the others; its error is reported in its result.
+         * @param items The resources to serialize.
+         * @param threadCount The number of threads, 0 for one per hardware thread.
+         * @return The result of each item, in the order of the items.
+         */
+        std::vector<BatchResult> SerializeBatch(const std::span<const BatchItem> items, const size_t threadCount = 0);
+
         /**
          * @brief Deserialize a resource with the specified key.
          * @param key The key associated with the resource to deserialize.
@@ -51,6 +179,113 @@ namespace filesystem_adapters
          */
         void Unserialize(const std::string_view key, const std::string_view serializationPath);
 
+        /**
+         * @brief Remove a resource with the specified key from a pack file.
+         * @param key The key associated with the resource.
+         * @param pack The pack file.
+         */
+        void Unserialize(const std::string_view key, PackFile &pack);
+
+        /**
+         * @brief Set the number of elements per block of the zone maps written into resource headers.
+         *
+         * Zone maps hold the minimum, maximum, sum, count and NaN count of the payload and of each block, and
+         * are written for dense resources with a known element type. Views are written without one.
+         * @param blockSize The block size, 0 to write no zone maps.
+         */
+        void SetZoneMapBlockSize(const size_t blockSize);
+
+        /**
+         * @brief Get the number of elements per block of the zone maps written into resource headers.
+         * @return The block size, 0 if no zone maps are written.
+         */
+        size_t GetZoneMapBlockSize() const;
+
+        /**
+         * @brief Set the number of deltas written after a base image before the next full image.
+         *
+         * When enabled, a resource whose file already exists is written as a delta against its latest version,
+         * appended to a `.delta` log next to the `.bin` file, unless the delta is more than half the size of the
+         * file. Longer chains write less but make reads apply more deltas.
+         * @param chainLength The maximum number of deltas, 0 to always write full images.
+         */
+        void SetDeltaChainLength(const size_t chainLength);
+
+        /**
+         * @brief Get the number of deltas written after a base image before the next full image.
+         * @return The maximum number of deltas, 0 if full images are always written.
+         */
+        size_t GetDeltaChainLength() const;
+
+        /**
+         * @brief Set the journal that makes resource files durable.
+         *
+         * With a journal, the image of each file written or removed is committed to it first, and concurrent
+         * writes share a single sync of the journal; the files themselves are synced by its checkpoints. Without
+         * one, files are replaced atomically but not synced. Streamed payloads are synced on their own, and pack
+         * files are not journaled.
+         * @param journal The journal, null to write files without one.
+         */
+        void SetJournal(std::shared_ptr<Journal> journal);
+
+        /**
+         * @brief Get the journal that makes resource files durable.
+         * @return The journal, null if none was set.
+         */
+        std::shared_ptr<Journal> GetJournal() const;
+
+        /**
+         * @brief Set the storage encoding of the resource with the specified key.
+         *
+         * Dense float32 and float64 resources are then written with fewer bytes per element and converted back to
+         * their element type when deserialized; quantized encodings keep their scale and offset in the header.
+         * Sparse resources and views are written as they are.
+         * @param key The key associated with the resource.
+         * @param encoding The storage encoding, EncodingType::None to write the payload as it is.
+         */
+        void SetEncoding(const std::string_view key, const resource::Encoding &encoding);
+
+        /**
+         * @brief Get the storage encoding of the resource with the specified key.
+         * @param key The key associated with the resource.
+         * @return The storage encoding, EncodingType::None if none was set.
+         */
+        resource::Encoding GetEncoding(const std::string_view key) const;
+
+        /**
+         * @brief Set the codec the payload of the resource with the specified key is compressed with.
+         *
+         * The stored payload, after any encoding, is split into frames of GetFrameSize() bytes that are compressed
+         * independently on an OpenMP team and decompressed in parallel by ResourceDeserializer, which can also read
+         * a single frame. Sparse resources, views and streamed payloads are written uncompressed.
+         * @param key The key associated with the resource.
+         * @param codec The codec, CodecType::None to write the payload uncompressed.
+         */
+        void SetCodec(const std::string_view key, const resource::Codec &codec);
+
+        /**
+         * @brief Get the codec the payload of the resource with the specified key is compressed with.
+         * @param key The key associated with the resource.
+         * @return The codec, CodecType::None if none was set.
+         */
+        resource::Codec GetCodec(const std::string_view key) const;
+
+        /**
+         * @brief Set the number of uncompressed bytes per compressed frame.
+         *
+         * Smaller frames decompress in parallel on more threads and make single frames cheaper to read, larger
+         * frames compress better.
+         * @param frameSize The frame size in bytes.
+         * @throw std::runtime_error If the frame size is 0.
+         */
+        void SetFrameSize(const size_t frameSize);
+
+        /**
+         * @brief Get the number of uncompressed bytes per compressed frame.
+         * @return The frame size in bytes.
+         */
+        size_t GetFrameSize() const;
+
     private:
         /**
          * @brief Default constructor for the ResourceSerializer class.
@@ -80,6 +315,77 @@ namespace filesystem_adapters
          * @return Reference to the updated instance (not used).
          */
         ResourceSerializer &operator=(ResourceSerializer &&) = delete;
+
+        /**
+         * @brief Serialize a locked resource into an existing directory.
+         * @param resource The locked resource to serialize.
+         * @param key The key associated with the resource.
+         * @param resourcePath The directory of the file.
+         * @return True if the file was written, false if the resource did not change since it was last written.
+         */
+        bool WriteResource(const ISerializableResource::LockedResource &resource, const std::string_view key, const Path &resourcePath);
+
+        /**
+         * @brief Write the file of a locked resource whose checksum is already up to date.
+         * @param resource The locked resource to write.
+         * @param key The key associated with the resource.
+         * @param resourcePath The directory of the file.
+         */
+        void WriteResourceFile(const ISerializableResource::LockedResource &resource, const std::string_view key, const Path &resourcePath);
+
+        /**
+         * @brief Write the header and payload of a locked resource.
+         * @param resource The locked resource to write.
+         * @param key The key associated with the resource, which selects its storage encoding.
+         * @param outfile The stream to write to.
+         */
+        void WriteImage(const ISerializableResource::LockedResource &resource, const std::string_view key, std::ostream &outfile) const;
+
+        /**
+         * @brief Write the file of a resource, committing its image to the journal first if there is one.
+         * @param resourcePath The directory of the file.
+         * @param key The key associated with the resource.
+         * @param writeImage Writes the header and payload of the resource to a stream.
+         */
+        void WriteFile(const Path &resourcePath, const std::string &key, const std::function<void(std::ostream &)> &writeImage);
+
+        /**
+         * @brief Replace the file of a resource, as a delta if the chain allows it and as a full image otherwise.
+         * @param resourcePath The directory of the file.
+         * @param key The key associated with the resource.
+         * @param writeImage Writes the header and payload of the resource to a stream.
+         */
+        void ReplaceFile(const Path &resourcePath, const std::string &key, const std::function<void(std::ostream &)> &writeImage);
+
+        /**
+         * @brief Remove the file of a resource and its deltas.
+         * @param resourcePath The path of the file.
+         */
+        void RemoveFile(const Path &resourcePath);
+
+        /** @brief The number of elements per zone map block, 0 if zone maps are not written. */
+        std::atomic<size_t> zoneMapBlockSize_{0};
+
+        /** @brief The maximum number of deltas after a base image, 0 if full images are always written. */
+        std::atomic<size_t> deltaChainLength_{0};
+
+        /** @brief The storage encodings of resources that are not written as they are. */
+        std::map<std::string, resource::Encoding, std::less<>> keyToEncodingMap_;
+
+        /** @brief The codecs of resources that are compressed. */
+        std::map<std::string, resource::Codec, std::less<>> keyToCodecMap_;
+
+        /** @brief The number of uncompressed bytes per compressed frame. */
+        std::atomic<size_t> frameSize_{FRAME_SIZE};
+
+        /** @brief Guards the storage encodings and codecs; lookups share it and updates take it exclusively. */
+        mutable std::shared_mutex encodingLock_;
+
+        /** @brief The journal that makes resource files durable, null if none was set. */
+        std::shared_ptr<Journal> journal_;
+
+        /** @brief Guards the journal. */
+        mutable std::mutex journalLock_;
     };
 
 } // end namespace filesystem_adapters
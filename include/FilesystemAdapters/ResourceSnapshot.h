@@ -0,0 +1,144 @@
+/**
+ * @file ResourceSnapshot.h
+ * @brief Declaration of the ResourceSnapshot class, an immutable version of a serializable resource.
+ */
+
+#ifndef filesystem_adapters_resourcesnapshot_h
+#define filesystem_adapters_resourcesnapshot_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FilesystemAdapters/config.h"
+#include "Resources/DataType.h"
+#include "Resources/Layout.h"
+
+namespace filesystem_adapters
+{
+
+    class ISerializableResource;
+
+    /**
+     * @class ResourceSnapshot
+     * @brief An immutable copy of a resource as of one version.
+     *
+     * Snapshots are copied eagerly and shared through std::shared_ptr by ISerializableResource::CopySnapshot(); readers
+     * and serializers use them without holding the resource lock and the last reference reclaims the version. Sparse resources keep their
+     * compressed sparse row arrays, in which case Data() holds only the non-zero values.
+     */
+    class FILESYSTEM_ADAPTERS_DLL_EXPORT ResourceSnapshot
+    {
+    public:
+        /**
+         * @brief Constructor for the ResourceSnapshot class. The caller must hold a lock of the resource.
+         * @param resource The resource to copy.
+         * @param version The version of the resource.
+         */
+        ResourceSnapshot(const ISerializableResource &resource, const uint64_t version);
+
+        /**
+         * @brief Destructor for the ResourceSnapshot class.
+         */
+        virtual ~ResourceSnapshot() noexcept;
+
+        /**
+         * @brief Deleted copy constructor; snapshots are shared, not copied.
+         */
+        ResourceSnapshot(const ResourceSnapshot &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator; snapshots are immutable.
+         * @return Reference to the updated instance (not used).
+         */
+        ResourceSnapshot &operator=(const ResourceSnapshot &) = delete;
+
+        /**
+         * @brief Get the version of the resource the snapshot was taken at.
+         * @return The version.
+         */
+        uint64_t GetVersion() const;
+
+        /**
+         * @brief Get the column size (M) of the resource.
+         * @return The column size.
+         */
+        size_t GetColumnSize() const;
+
+        /**
+         * @brief Get the row size (N) of the resource.
+         * @return The row size.
+         */
+        size_t GetRowSize() const;
+
+        /**
+         * @brief Get the extent of each dimension.
+         * @return The shape.
+         */
+        const std::vector<size_t> &GetShape() const;
+
+        /**
+         * @brief Get the ordering of the payload.
+         * @return The layout.
+         */
+        const resource::Layout &GetLayout() const;
+
+        /**
+         * @brief Get the type of each element.
+         * @return The element type.
+         */
+        resource::DataType GetDataType() const;
+
+        /**
+         * @brief Get the size of an element.
+         * @return The size in bytes.
+         */
+        size_t GetElementSize() const;
+
+        /**
+         * @brief Access the payload.
+         * @return A constant pointer to the payload.
+         */
+        const void *Data() const;
+
+        /**
+         * @brief Get the size of the payload.
+         * @return The size in bytes.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Check if the snapshot is of a sparse resource.
+         * @return True if the snapshot holds compressed sparse row arrays, false otherwise.
+         */
+        bool IsSparse() const;
+
+        /**
+         * @brief Get the row offsets of a sparse snapshot.
+         * @return The GetColumnSize() + 1 row offsets.
+         */
+        const std::vector<size_t> &GetRowOffsets() const;
+
+        /**
+         * @brief Get the column indices of a sparse snapshot.
+         * @return The column index of each non-zero value.
+         */
+        const std::vector<size_t> &GetColumnIndices() const;
+
+    private:
+        uint64_t version_;
+        size_t M_;
+        size_t N_;
+        std::vector<size_t> shape_;
+        resource::Layout layout_;
+        resource::DataType dataType_;
+        size_t elementSize_;
+        std::vector<char> payload_;
+        bool sparse_{false};
+        std::vector<size_t> rowOffsets_;
+        std::vector<size_t> columnIndices_;
+    };
+
+} // end namespace filesystem_adapters
+
+#endif // end filesystem_adapters_resourcesnapshot_h
@@ -0,0 +1,154 @@
+/**
+ * @file ArenaMemoryResource.h
+ * @brief Declaration of the ArenaMemoryResource class, a bump allocator for resource payloads.
+ */
+
+#ifndef resource_arenamemoryresource_h
+#define resource_arenamemoryresource_h
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @class ArenaMemoryResource
+     * @brief A memory resource that carves aligned blocks out of large chunks and frees them all at once.
+     *
+     * Deallocation is a no-op; memory is returned to the upstream resource by Release() or on destruction.
+     * Suited to loading a batch of resources that are unloaded together. Not thread-safe.
+     */
+    class RESOURCE_DLL_EXPORT ArenaMemoryResource : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @brief Constructor for the ArenaMemoryResource class.
+         * @param alignment The minimum alignment of every block, a power of two.
+         * @param chunkSize The size of the first chunk; later chunks double in size.
+         * @param upstream The resource that chunks are allocated from.
+         */
+        ArenaMemoryResource(const size_t alignment = 64, const size_t chunkSize = size_t(1) << 16, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+        /**
+         * @brief Destructor for the ArenaMemoryResource class; releases every chunk.
+         */
+        virtual ~ArenaMemoryResource() noexcept;
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        ArenaMemoryResource(const ArenaMemoryResource &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        ArenaMemoryResource &operator=(const ArenaMemoryResource &) = delete;
+
+        /**
+         * @brief Deleted move constructor to prevent moving.
+         */
+        ArenaMemoryResource(ArenaMemoryResource &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator to prevent moving.
+         * @return Reference to the updated instance (not used).
+         */
+        ArenaMemoryResource &operator=(ArenaMemoryResource &&) = delete;
+
+        /**
+         * @brief Get the minimum alignment of every block.
+         * @return The alignment in bytes.
+         */
+        size_t GetAlignment() const;
+
+        /**
+         * @brief Get the number of bytes handed out since the last release.
+         * @return The used bytes, including alignment padding.
+         */
+        size_t GetUsedBytes() const;
+
+        /**
+         * @brief Get the number of bytes allocated from the upstream resource.
+         * @return The reserved bytes.
+         */
+        size_t GetReservedBytes() const;
+
+        /**
+         * @brief Return every chunk to the upstream resource.
+         */
+        void Release();
+
+    protected:
+        /**
+         * @brief Allocate a block from the current chunk, starting a new chunk if it does not fit.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The requested alignment.
+         * @return A pointer to the block.
+         */
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        /**
+         * @brief Does nothing; blocks are freed by Release().
+         * @param p The block to deallocate.
+         * @param bytes The number of bytes originally requested.
+         * @param alignment The alignment originally requested.
+         */
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+
+        /**
+         * @brief Compare for equality with another memory resource.
+         * @param other The other memory resource.
+         * @return True if other is this arena, false otherwise.
+         */
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    private:
+        /**
+         * @struct Chunk
+         * @brief A block of memory allocated from the upstream resource.
+         */
+        struct Chunk
+        {
+            /** @brief The start of the chunk. */
+            char *data;
+
+            /** @brief The size of the chunk in bytes. */
+            size_t size;
+
+            /** @brief The alignment the chunk was allocated with. */
+            size_t alignment;
+        };
+
+        /** @brief The minimum alignment of every block. */
+        size_t alignment_;
+
+        /** @brief The size of the next chunk. */
+        size_t chunkSize_;
+
+        /** @brief The size of the first chunk. */
+        size_t initialChunkSize_;
+
+        /** @brief The resource that chunks are allocated from. */
+        std::pmr::memory_resource *upstream_;
+
+        /** @brief Every chunk allocated since the last release. */
+        std::vector<Chunk> chunks_;
+
+        /** @brief The offset of the next free byte in the last chunk. */
+        size_t offset_{0};
+
+        /** @brief The number of bytes handed out since the last release. */
+        size_t usedBytes_{0};
+
+        /** @brief The number of bytes allocated from the upstream resource. */
+        size_t reservedBytes_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_arenamemoryresource_h
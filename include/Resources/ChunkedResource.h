@@ -0,0 +1,210 @@
+/**
+ * @file ChunkedResource.h
+ * @brief Declaration of the ChunkedResource class for resources larger than memory.
+ */
+
+#ifndef resource_chunkedresource_h
+#define resource_chunkedresource_h
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "Resources/config.h"
+#include "Resources/IChunkStore.h"
+#include "Resources/IResource.h"
+
+namespace resource
+{
+
+    class PageCache;
+
+    /**
+     * @class ChunkedResource
+     * @brief A row-major resource whose payload stays in a backing store and is loaded one chunk at a time.
+     *
+     * Chunk c holds the GetChunkRows() consecutive slices of the first dimension starting at c * GetChunkRows(), each
+     * GetRowSize() elements long; the last chunk may be shorter. Chunks are kept resident by the PageCache, which
+     * bounds the memory of every chunked resource together and writes modified chunks back to their store on
+     * eviction. Data() is not available since the payload is never resident as a whole. Derived classes provide
+     * GetElementSize().
+     */
+    class RESOURCE_DLL_EXPORT ChunkedResource : public virtual IResource
+    {
+    public:
+        /**
+         * @brief Allows the PageCache to read and write the backing store of this resource.
+         */
+        friend class PageCache;
+
+        /**
+         * @brief Default constructor for the ChunkedResource class; the resource has no store until Open().
+         */
+        ChunkedResource();
+
+        /**
+         * @brief Destructor for the ChunkedResource class; writes back modified chunks.
+         */
+        virtual ~ChunkedResource() noexcept;
+
+        /**
+         * @brief Deleted copy constructor; the resource owns its store.
+         */
+        ChunkedResource(const ChunkedResource &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator; the resource owns its store.
+         * @return Reference to the updated instance (not used).
+         */
+        ChunkedResource &operator=(const ChunkedResource &) = delete;
+
+        /**
+         * @brief Deleted move constructor; the PageCache refers to resources by address.
+         */
+        ChunkedResource(ChunkedResource &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator; the PageCache refers to resources by address.
+         * @return Reference to the updated instance (not used).
+         */
+        ChunkedResource &operator=(ChunkedResource &&) = delete;
+
+        /**
+         * @brief Attach a backing store and take its shape.
+         * @param store The store holding the payload.
+         * @param chunkRows The number of slices of the first dimension per chunk.
+         * @throw std::runtime_error If the resource is already open, chunkRows is 0, or the store does not hold
+         * a payload of the element type and size of the resource.
+         */
+        void Open(std::unique_ptr<IChunkStore> store, const size_t chunkRows);
+
+        /**
+         * @brief Write back modified chunks, release every chunk and detach the store; the shape is cleared.
+         */
+        void Close();
+
+        /**
+         * @brief Check if the resource has a backing store.
+         * @return True if the resource is open, false otherwise.
+         */
+        bool IsOpen() const;
+
+        /**
+         * @brief Get the number of slices of the first dimension per chunk.
+         * @return The chunk rows.
+         */
+        size_t GetChunkRows() const;
+
+        /**
+         * @brief Get the number of chunks.
+         * @return The chunk count.
+         */
+        size_t GetChunkCount() const;
+
+        /**
+         * @brief Get the size of a chunk.
+         * @param chunk The index of the chunk.
+         * @return The size in bytes.
+         */
+        size_t GetChunkSize(const size_t chunk) const;
+
+        /**
+         * @brief Pin a chunk for reading.
+         * @param chunk The index of the chunk.
+         * @return A pointer to the chunk that keeps it resident until released; the resource must outlive it.
+         * @throw std::runtime_error If the resource is not open or the chunk does not exist.
+         */
+        std::shared_ptr<const void> ReadChunk(const size_t chunk) const;
+
+        /**
+         * @brief Pin a chunk for writing; it is written back to the store when evicted or flushed.
+         * @param chunk The index of the chunk.
+         * @return A pointer to the chunk that keeps it resident until released; the resource must outlive it.
+         * @throw std::runtime_error If the resource is not open or the chunk does not exist.
+         */
+        std::shared_ptr<void> WriteChunk(const size_t chunk);
+
+        /**
+         * @brief Check if a chunk is resident.
+         * @param chunk The index of the chunk.
+         * @return True if the chunk is resident, false otherwise.
+         */
+        bool IsResident(const size_t chunk) const;
+
+        /**
+         * @brief Copy consecutive slices of the first dimension out of the resource.
+         * @param first The first slice.
+         * @param count The number of slices.
+         * @param buff The destination buffer of count * GetRowSize() elements.
+         */
+        void ReadRows(const size_t first, const size_t count, char *buff) const;
+
+        /**
+         * @brief Copy consecutive slices of the first dimension into the resource.
+         * @param first The first slice.
+         * @param count The number of slices.
+         * @param buff The source buffer of count * GetRowSize() elements.
+         */
+        void WriteRows(const size_t first, const size_t count, const char *buff);
+
+        /**
+         * @brief Write back modified chunks to the store.
+         */
+        void Flush() const;
+
+        /**
+         * @brief Not available; the payload is never resident as a whole.
+         * @throw std::runtime_error Always.
+         */
+        void *Data() override;
+
+        /**
+         * @brief Not available; the payload is never resident as a whole.
+         * @throw std::runtime_error Always.
+         */
+        const void *Data() const override;
+
+        /**
+         * @brief Overwrite the whole payload through the page cache.
+         * @param buff A pointer to the new data.
+         * @param n The size of the new data in bytes; must match the size of the resource.
+         */
+        void Assign(const char *buff, const size_t n) override;
+
+    protected:
+        /**
+         * @brief Get the checksum of the resource data, computed one chunk at a time.
+         * @return The checksum value.
+         */
+        int Checksum() const override;
+
+    private:
+        /**
+         * @brief Get the offset of a chunk within the payload.
+         * @param chunk The index of the chunk.
+         * @return The offset in bytes.
+         */
+        size_t GetChunkOffset(const size_t chunk) const;
+
+        /**
+         * @brief Throw unless the resource is open and the chunk exists.
+         * @param chunk The index of the chunk.
+         */
+        void CheckChunk(const size_t chunk) const;
+
+        /** @brief The store holding the payload (accessed by the PageCache). */
+        std::unique_ptr<IChunkStore> store_;
+
+        /** @brief Mutex serializing the reads and writes of the PageCache on the store. */
+        mutable std::mutex storeMtx_;
+
+        /** @brief The number of slices of the first dimension per chunk. */
+        size_t chunkRows_{0};
+
+        /** @brief The size of one slice of the first dimension in bytes, cached so that the destructor can write back. */
+        size_t sliceSize_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_chunkedresource_h
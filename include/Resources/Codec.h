@@ -0,0 +1,131 @@
+/**
+ * @file Codec.h
+ * @brief Declaration of the Codec class for compressing and decompressing resource payloads.
+ */
+
+#ifndef resource_codec_h
+#define resource_codec_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @brief Supported compression algorithms.
+     *
+     * Zlib is always available. LZ4 (fast) and Zstd (high ratio) are available when the library was built
+     * against them.
+     */
+    enum class CodecType : uint32_t
+    {
+        None = 0,
+        Zlib = 1,
+        LZ4 = 2,
+        Zstd = 3
+    };
+
+    /**
+     * @class Codec
+     * @brief A lossless block codec for resource payloads.
+     */
+    class RESOURCE_DLL_EXPORT Codec
+    {
+    public:
+        /**
+         * @brief Constructor for the Codec class.
+         * @param type The compression algorithm.
+         * @param level The compression level (0 selects the algorithm default).
+         */
+        Codec(const CodecType type = CodecType::Zlib, const int level = 0);
+
+        /**
+         * @brief Destructor for the Codec class.
+         */
+        virtual ~Codec() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The Codec instance to copy from.
+         */
+        Codec(const Codec &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The Codec instance to copy from.
+         * @return Reference to the updated Codec instance.
+         */
+        Codec &operator=(const Codec &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The Codec instance to move from.
+         */
+        Codec(Codec &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The Codec instance to move from.
+         * @return Reference to the updated Codec instance.
+         */
+        Codec &operator=(Codec &&other) noexcept;
+
+        /**
+         * @brief Check if a compression algorithm was compiled into the library.
+         * @param type The compression algorithm.
+         * @return True if the algorithm is available, false otherwise.
+         */
+        static bool IsAvailable(const CodecType type);
+
+        /**
+         * @brief Get the name of a compression algorithm.
+         * @param type The compression algorithm.
+         * @return The algorithm name.
+         */
+        static std::string GetName(const CodecType type);
+
+        /**
+         * @brief Get the compression algorithm of this codec.
+         * @return The compression algorithm.
+         */
+        CodecType GetType() const;
+
+        /**
+         * @brief Get the compression level of this codec.
+         * @return The compression level.
+         */
+        int GetLevel() const;
+
+        /**
+         * @brief Compress a buffer.
+         * @param buff A pointer to the data to compress.
+         * @param n The size of the data in bytes.
+         * @return The compressed bytes.
+         */
+        std::vector<char> Compress(const char *buff, const size_t n) const;
+
+        /**
+         * @brief Decompress a buffer into a caller provided destination.
+         * @param buff A pointer to the compressed data.
+         * @param n The size of the compressed data in bytes.
+         * @param dest The destination buffer.
+         * @param destSize The exact decompressed size in bytes.
+         */
+        void Decompress(const char *buff, const size_t n, char *dest, const size_t destSize) const;
+
+    private:
+        /** @brief The compression algorithm. */
+        CodecType type_;
+
+        /** @brief The compression level. */
+        int level_;
+    };
+
+} // end namespace resource
+
+#endif // end resource_codec_h
@@ -0,0 +1,153 @@
+/**
+ * @file CompressedResource.h
+ * @brief Declaration of the CompressedResource class for resources that keep their payload compressed in memory.
+ */
+
+#ifndef resource_compressedresource_h
+#define resource_compressedresource_h
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Resources/config.h"
+#include "Resources/Codec.h"
+#include "Resources/IResource.h"
+
+namespace resource
+{
+
+    class DecompressionCache;
+
+    /**
+     * @class CompressedResource
+     * @brief A resource whose payload is held compressed and decompressed on access.
+     *
+     * Data() decompresses the payload into a buffer owned by the DecompressionCache, which releases the
+     * least recently used buffers once its memory budget is exceeded. Buffers obtained through the
+     * non-const Data() are compressed again before they are released. Pointers returned by Data() are
+     * only guaranteed to stay valid while the resource is pinned (see Pin()); locking a serializable
+     * resource pins it for the lifetime of the lock. Derived classes provide GetElementSize().
+     */
+    class RESOURCE_DLL_EXPORT CompressedResource : public virtual IResource
+    {
+    public:
+        /**
+         * @brief Allows the DecompressionCache to manage the residency of this resource.
+         */
+        friend class DecompressionCache;
+
+        /**
+         * @brief Constructor for the CompressedResource class.
+         * @param codec The codec used to compress the payload.
+         */
+        CompressedResource(const Codec &codec = Codec());
+
+        /**
+         * @brief Destructor for the CompressedResource class.
+         */
+        virtual ~CompressedResource() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The CompressedResource instance to copy from.
+         */
+        CompressedResource(const CompressedResource &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The CompressedResource instance to copy from.
+         * @return Reference to the updated CompressedResource instance.
+         */
+        CompressedResource &operator=(const CompressedResource &other);
+
+        /**
+         * @brief Move constructor; takes over the compressed payload and the resident buffer without compressing.
+         * @param other The CompressedResource instance to move from.
+         */
+        CompressedResource(CompressedResource &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator; takes over the compressed payload and the resident buffer without compressing.
+         * @param other The CompressedResource instance to move from.
+         * @return Reference to the updated CompressedResource instance.
+         */
+        CompressedResource &operator=(CompressedResource &&other) noexcept;
+
+        /**
+         * @brief Access the decompressed resource data as a mutable pointer.
+         * @return A pointer to the resource data.
+         */
+        void *Data() override;
+
+        /**
+         * @brief Access the decompressed resource data as a constant pointer.
+         * @return A constant pointer to the resource data.
+         */
+        const void *Data() const override;
+
+        /**
+         * @brief Compress and assign new data to the resource.
+         * @param buff A pointer to the new data.
+         * @param n The size of the new data in bytes.
+         */
+        void Assign(const char *buff, const size_t n) override;
+
+        /**
+         * @brief Make the payload resident and keep it resident until the returned token is released.
+         * @return A pin token; the resource must outlive it.
+         */
+        std::shared_ptr<void> Pin() const;
+
+        /**
+         * @brief Compress any modifications and release the decompressed buffer unless pinned.
+         */
+        void Evict() const;
+
+        /**
+         * @brief Check if the decompressed payload is resident.
+         * @return True if the payload is resident, false otherwise.
+         */
+        bool IsResident() const;
+
+        /**
+         * @brief Get the size of the compressed payload.
+         * @return The compressed size in bytes.
+         */
+        size_t GetCompressedSize() const;
+
+        /**
+         * @brief Get the size of the decompressed payload.
+         * @return The decompressed size in bytes.
+         */
+        size_t GetUncompressedSize() const;
+
+        /**
+         * @brief Get the codec used to compress the payload.
+         * @return The codec.
+         */
+        const Codec &GetCodec() const;
+
+    private:
+        /** @brief The codec used to compress the payload. */
+        Codec codec_;
+
+        /** @brief The compressed payload (guarded by the DecompressionCache). */
+        mutable std::vector<char> compressed_;
+
+        /** @brief The decompressed payload size in bytes. */
+        size_t size_{0};
+
+        /** @brief The decompressed payload while resident (guarded by the DecompressionCache). */
+        mutable std::unique_ptr<char[]> resident_;
+
+        /** @brief Whether the resident payload may differ from the compressed payload. */
+        mutable bool modified_{false};
+
+        /** @brief The number of outstanding pins. */
+        mutable size_t pins_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_compressedresource_h
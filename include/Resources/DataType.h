@@ -0,0 +1,134 @@
+/**
+ * @file DataType.h
+ * @brief Declaration of the DataType tag and the DataTypeConverter class for converting resource elements.
+ */
+
+#ifndef resource_datatype_h
+#define resource_datatype_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @brief The element types a resource payload can hold.
+     *
+     * Unknown marks payloads written without a tag; they are read back byte for byte.
+     */
+    enum class DataType : uint32_t
+    {
+        Unknown = 0,
+        Int8 = 1,
+        UInt8 = 2,
+        Int16 = 3,
+        UInt16 = 4,
+        Int32 = 5,
+        UInt32 = 6,
+        Int64 = 7,
+        UInt64 = 8,
+        Float16 = 9,
+        BFloat16 = 10,
+        Float32 = 11,
+        Float64 = 12
+    };
+
+    /**
+     * @class DataTypeConverter
+     * @brief Converts payloads between element types.
+     *
+     * Floating point types convert to one another with round-to-nearest-even, integers convert to floating point
+     * types and to integers that hold every value of the source. Other conversions lose information silently
+     * and are rejected.
+     */
+    class RESOURCE_DLL_EXPORT DataTypeConverter
+    {
+    public:
+        /**
+         * @brief Get the tag of an arithmetic type.
+         * @tparam T The element type.
+         * @return The tag, Unknown if the type has none.
+         */
+        template <typename T>
+        static constexpr DataType GetDataType();
+
+        /**
+         * @brief Get the size of an element.
+         * @param type The element type.
+         * @return The size in bytes, 0 for Unknown.
+         */
+        static size_t GetSize(const DataType type);
+
+        /**
+         * @brief Get the name of an element type.
+         * @param type The element type.
+         * @return The name, e.g. "float32".
+         */
+        static std::string GetName(const DataType type);
+
+        /**
+         * @brief Check if elements can be converted from one type to another.
+         * @param from The source element type.
+         * @param to The destination element type.
+         * @return True if the conversion is supported, false otherwise.
+         */
+        static bool IsConvertible(const DataType from, const DataType to);
+
+        /**
+         * @brief Check if a stored payload has to be converted before a resource can hold it.
+         * @param stored The element type of the stored payload.
+         * @param target The element type of the resource.
+         * @return True if both types are known and differ, false otherwise.
+         */
+        static bool RequiresConversion(const DataType stored, const DataType target);
+
+        /**
+         * @brief Convert elements from one type to another.
+         * @param src The source elements.
+         * @param from The source element type.
+         * @param dst The destination elements; must not overlap the source.
+         * @param to The destination element type.
+         * @param count The number of elements.
+         * @throw std::runtime_error If the conversion is not supported.
+         */
+        static void Convert(const void *src, const DataType from, void *dst, const DataType to, const size_t count);
+
+        /**
+         * @brief Round a float to IEEE 754 half precision.
+         * @param value The value.
+         * @return The half precision bits.
+         */
+        static uint16_t FloatToHalf(const float value);
+
+        /**
+         * @brief Widen IEEE 754 half precision to a float.
+         * @param bits The half precision bits.
+         * @return The value.
+         */
+        static float HalfToFloat(const uint16_t bits);
+
+        /**
+         * @brief Round a float to bfloat16.
+         * @param value The value.
+         * @return The bfloat16 bits.
+         */
+        static uint16_t FloatToBFloat16(const float value);
+
+        /**
+         * @brief Widen bfloat16 to a float.
+         * @param bits The bfloat16 bits.
+         * @return The value.
+         */
+        static float BFloat16ToFloat(const uint16_t bits);
+    };
+
+#include "Resources/DataType.hpp"
+
+} // end namespace resource
+
+#endif // end resource_datatype_h
@@ -0,0 +1,26 @@
+
+template <typename T>
+constexpr DataType DataTypeConverter::GetDataType()
+{
+	using U = std::remove_cv_t<T>;
+	if constexpr (std::is_same_v<U, double>)
+		return DataType::Float64;
+	else if constexpr (std::is_same_v<U, float>)
+		return DataType::Float32;
+	else if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool>)
+	{
+		constexpr bool isSigned = std::is_signed_v<U>;
+		if constexpr (sizeof(U) == 1)
+			return isSigned ? DataType::Int8 : DataType::UInt8;
+		else if constexpr (sizeof(U) == 2)
+			return isSigned ? DataType::Int16 : DataType::UInt16;
+		else if constexpr (sizeof(U) == 4)
+			return isSigned ? DataType::Int32 : DataType::UInt32;
+		else if constexpr (sizeof(U) == 8)
+			return isSigned ? DataType::Int64 : DataType::UInt64;
+		else
+			return DataType::Unknown;
+	}
+	else
+		return DataType::Unknown;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file DecompressionCache.h
+ * @brief Declaration of the DecompressionCache class for bounding the memory of decompressed resources.
+ */
+
+#ifndef resource_decompressioncache_h
+#define resource_decompressioncache_h
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    class CompressedResource;
+
+    /**
+     * @class DecompressionCache
+     * @brief A singleton LRU of decompressed CompressedResource buffers with a configurable memory budget.
+     *
+     * When the decompressed bytes exceed the budget, the least recently used buffers that are not pinned
+     * are written back (if modified) and released, leaving only the compressed payload in memory.
+     */
+    class RESOURCE_DLL_EXPORT DecompressionCache
+    {
+    public:
+        /**
+         * @brief Allows CompressedResource to manage its residency through the cache.
+         */
+        friend class CompressedResource;
+
+        /**
+         * @brief Destructor for the DecompressionCache class.
+         */
+        virtual ~DecompressionCache() noexcept;
+
+        /**
+         * @brief Get the singleton instance of the DecompressionCache.
+         * @return Pointer to the DecompressionCache instance.
+         */
+        static DecompressionCache *GetInstance();
+
+        /**
+         * @brief Set the maximum number of decompressed bytes kept resident.
+         * @param bytes The memory budget in bytes.
+         */
+        void SetBudget(const size_t bytes);
+
+        /**
+         * @brief Get the maximum number of decompressed bytes kept resident.
+         * @return The memory budget in bytes.
+         */
+        size_t GetBudget() const;
+
+        /**
+         * @brief Get the number of decompressed bytes currently resident.
+         * @return The resident bytes.
+         */
+        size_t GetResidentBytes() const;
+
+        /**
+         * @brief Get the number of resources currently resident.
+         * @return The resident resource count.
+         */
+        size_t GetResidentCount() const;
+
+        /**
+         * @brief Release every resident buffer that is not pinned.
+         */
+        void Clear();
+
+    private:
+        /**
+         * @brief Default constructor for the DecompressionCache class.
+         *
+         * Private to enforce the singleton pattern.
+         */
+        DecompressionCache();
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        DecompressionCache(const DecompressionCache &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        DecompressionCache &operator=(const DecompressionCache &) = delete;
+
+        /**
+         * @brief Deleted move constructor to prevent moving.
+         */
+        DecompressionCache(DecompressionCache &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator to prevent moving.
+         * @return Reference to the updated instance (not used).
+         */
+        DecompressionCache &operator=(DecompressionCache &&) = delete;
+
+        /**
+         * @brief Make a resource resident and mark it most recently used.
+         * @param resource The resource to acquire.
+         * @param modify Whether the caller may modify the decompressed buffer.
+         * @param pin Whether to pin the resource after acquiring it.
+         * @return A pointer to the decompressed buffer.
+         */
+        char *Acquire(const CompressedResource &resource, const bool modify, const bool pin);
+
+        /**
+         * @brief Check if a resource is resident.
+         * @param resource The resource to check.
+         * @return True if the resource is resident, false otherwise.
+         */
+        bool IsResident(const CompressedResource &resource) const;
+
+        /**
+         * @brief Unpin a resource previously pinned through Acquire.
+         * @param resource The resource to unpin.
+         */
+        void Unpin(const CompressedResource &resource);
+
+        /**
+         * @brief Write back the decompressed buffer of a resource if it was modified.
+         *
+         * The buffer is still written back when it is evicted, since it may be modified through a pointer taken before the flush.
+         * @param resource The resource to flush.
+         */
+        void Flush(const CompressedResource &resource);
+
+        /**
+         * @brief Write back and release the decompressed buffer of a resource.
+         * @param resource The resource to evict.
+         */
+        void Evict(const CompressedResource &resource);
+
+        /**
+         * @brief Hand the decompressed buffer of a resource to the resource it is moved into, without compressing it.
+         *
+         * The buffer keeps its place in the LRU and stays modified if it was; the target's own buffer is released
+         * without being written back. Neither compresses, so the move constructor and assignment cannot throw.
+         * @param from The resource moved from.
+         * @param to The resource moved into.
+         */
+        void Transfer(const CompressedResource &from, const CompressedResource &to);
+
+        /**
+         * @brief Release the decompressed buffer of a resource without writing it back.
+         * @param resource The resource to forget.
+         */
+        void Remove(const CompressedResource &resource);
+
+        /**
+         * @brief Evict least recently used buffers until the budget is met (lock must be held).
+         */
+        void EvictOverBudget();
+
+        /**
+         * @brief Write back and release the buffer of a resident resource (lock must be held).
+         * @param resource The resource to evict.
+         * @param writeBack Whether a modified buffer is compressed before release.
+         */
+        void EvictUnlocked(const CompressedResource &resource, const bool writeBack);
+
+        /** @brief Mutex guarding the cache and the residency state of every CompressedResource. */
+        mutable std::mutex mtx_;
+
+        /** @brief Resident resources ordered from most to least recently used. */
+        std::list<const CompressedResource *> lru_;
+
+        /** @brief Map of resident resources to their position in the LRU list. */
+        std::unordered_map<const CompressedResource *, std::list<const CompressedResource *>::iterator> index_;
+
+        /** @brief The maximum number of decompressed bytes kept resident. */
+        size_t budget_;
+
+        /** @brief The number of decompressed bytes currently resident. */
+        size_t residentBytes_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_decompressioncache_h
@@ -0,0 +1,62 @@
+/**
+ * @file DeltaCodec.h
+ * @brief Declaration of the DeltaCodec class for encoding one version of a payload against another.
+ */
+
+#ifndef resource_deltacodec_h
+#define resource_deltacodec_h
+
+#include <cstddef>
+#include <vector>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @class DeltaCodec
+     * @brief Encodes a payload as the byte ranges in which it differs from a previous version.
+     *
+     * A delta holds the size of the new version followed by runs of an offset, a length and the XOR of the
+     * new bytes with the previous ones; bytes past the end of the previous version are XORed with zero. Runs
+     * separated by fewer bytes than a run header are merged, so a delta is never much larger than the bytes that
+     * changed.
+     */
+    class RESOURCE_DLL_EXPORT DeltaCodec
+    {
+    public:
+        /**
+         * @brief Encode a payload against a previous version.
+         * @param base The previous version.
+         * @param baseSize The size of the previous version in bytes.
+         * @param target The new version.
+         * @param targetSize The size of the new version in bytes.
+         * @return The delta.
+         */
+        static std::vector<char> Encode(const char *base, const size_t baseSize, const char *target, const size_t targetSize);
+
+        /**
+         * @brief Apply a delta to the version it was encoded against.
+         * @param base The previous version.
+         * @param baseSize The size of the previous version in bytes.
+         * @param delta The delta.
+         * @param deltaSize The size of the delta in bytes.
+         * @return The new version.
+         * @throw std::runtime_error If the delta is malformed.
+         */
+        static std::vector<char> Apply(const char *base, const size_t baseSize, const char *delta, const size_t deltaSize);
+
+        /**
+         * @brief Get the size of the version a delta encodes.
+         * @param delta The delta.
+         * @param deltaSize The size of the delta in bytes.
+         * @return The size of the new version in bytes.
+         * @throw std::runtime_error If the delta is truncated.
+         */
+        static size_t GetTargetSize(const char *delta, const size_t deltaSize);
+    };
+
+} // end namespace resource
+
+#endif // end resource_deltacodec_h
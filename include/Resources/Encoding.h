@@ -0,0 +1,166 @@
+/**
+ * @file Encoding.h
+ * @brief Declaration of the Encoding class for storing floating point payloads with fewer bytes per element.
+ */
+
+#ifndef resource_encoding_h
+#define resource_encoding_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Resources/DataType.h"
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @brief Supported storage encodings.
+     *
+     * Float16 and BFloat16 round each element to a 16-bit floating point type. Int8 and Int16 map the range of
+     * the payload linearly onto the integers of the type.
+     */
+    enum class EncodingType : uint32_t
+    {
+        None = 0,
+        Float16 = 1,
+        BFloat16 = 2,
+        Int8 = 3,
+        Int16 = 4
+    };
+
+    /**
+     * @struct Quantization
+     * @brief The linear map from stored integers back to values: value = stored * scale + offset.
+     */
+    struct RESOURCE_DLL_EXPORT Quantization
+    {
+        /** @brief The value of one step of the stored integers. */
+        double scale{1.0};
+
+        /** @brief The value of a stored zero. */
+        double offset{0.0};
+    };
+
+    /**
+     * @class Encoding
+     * @brief A lossy storage encoding for float32 and float64 payloads.
+     *
+     * Payloads of other element types are stored as they are. Quantized encodings cannot represent non-finite
+     * values: infinities clamp to the range of the payload and NaN is stored as the value of a stored zero.
+     */
+    class RESOURCE_DLL_EXPORT Encoding
+    {
+    public:
+        /**
+         * @brief Constructor for the Encoding class.
+         * @param type The storage encoding.
+         */
+        Encoding(const EncodingType type = EncodingType::None);
+
+        /**
+         * @brief Destructor for the Encoding class.
+         */
+        virtual ~Encoding() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The Encoding instance to copy from.
+         */
+        Encoding(const Encoding &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The Encoding instance to copy from.
+         * @return Reference to the updated Encoding instance.
+         */
+        Encoding &operator=(const Encoding &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The Encoding instance to move from.
+         */
+        Encoding(Encoding &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The Encoding instance to move from.
+         * @return Reference to the updated Encoding instance.
+         */
+        Encoding &operator=(Encoding &&other) noexcept;
+
+        /**
+         * @brief Get the name of a storage encoding.
+         * @param type The storage encoding.
+         * @return The encoding name.
+         */
+        static std::string GetName(const EncodingType type);
+
+        /**
+         * @brief Get the storage encoding.
+         * @return The storage encoding.
+         */
+        EncodingType GetType() const;
+
+        /**
+         * @brief Check if the encoding stores integers that need a Quantization to be read back.
+         * @return True for Int8 and Int16, false otherwise.
+         */
+        bool IsQuantized() const;
+
+        /**
+         * @brief Check if payloads of an element type are encoded.
+         * @param dataType The element type of the payload.
+         * @return True if the encoding is not None and the type is float32 or float64, false otherwise.
+         */
+        bool AppliesTo(const DataType dataType) const;
+
+        /**
+         * @brief Get the element type payloads of a type are stored with.
+         * @param dataType The element type of the payload.
+         * @return The stored element type, dataType itself if the encoding does not apply.
+         */
+        DataType GetStoredType(const DataType dataType) const;
+
+        /**
+         * @brief Fit the quantization of a payload to the range of its finite values.
+         * @param src The elements.
+         * @param dataType The element type, float32 or float64.
+         * @param count The number of elements.
+         * @return The quantization, the identity if the encoding is not quantized.
+         */
+        Quantization Fit(const void *src, const DataType dataType, const size_t count) const;
+
+        /**
+         * @brief Encode elements.
+         * @param src The elements.
+         * @param dataType The element type, float32 or float64.
+         * @param dst The stored elements, GetStoredType(dataType) sized; must not overlap the source.
+         * @param count The number of elements.
+         * @param quantization The quantization returned by Fit; ignored if the encoding is not quantized.
+         * @throw std::runtime_error If the encoding does not apply to the element type.
+         */
+        void Encode(const void *src, const DataType dataType, void *dst, const size_t count, const Quantization &quantization) const;
+
+        /**
+         * @brief Restore quantized elements.
+         * @param src The stored elements.
+         * @param storedType The stored element type, int8 or int16.
+         * @param dst The elements; must not overlap the source.
+         * @param dataType The element type, float32 or float64.
+         * @param count The number of elements.
+         * @param quantization The quantization the elements were encoded with.
+         * @throw std::runtime_error If either element type is not supported.
+         */
+        static void Dequantize(const void *src, const DataType storedType, void *dst, const DataType dataType, const size_t count, const Quantization &quantization);
+
+    private:
+        /** @brief The storage encoding. */
+        EncodingType type_;
+    };
+
+} // end namespace resource
+
+#endif // end resource_encoding_h
@@ -0,0 +1,71 @@
+/**
+ * @file IChunkStore.h
+ * @brief Declaration of the IChunkStore interface for backing stores of chunked resources.
+ */
+
+#ifndef resource_ichunkstore_h
+#define resource_ichunkstore_h
+
+#include <cstddef>
+#include <vector>
+
+#include "Resources/config.h"
+#include "Resources/DataType.h"
+
+namespace resource
+{
+
+    /**
+     * @class IChunkStore
+     * @brief A row-major payload kept outside of memory that a ChunkedResource reads and writes piecewise.
+     *
+     * Offsets are relative to the start of the payload. Calls are serialized by the PageCache.
+     */
+    class RESOURCE_DLL_EXPORT IChunkStore
+    {
+    public:
+        /**
+         * @brief Destructor for the IChunkStore class.
+         */
+        virtual ~IChunkStore() noexcept;
+
+        /**
+         * @brief Get the extent of each dimension of the stored payload.
+         * @return The shape.
+         */
+        virtual std::vector<size_t> GetShape() const = 0;
+
+        /**
+         * @brief Get the type of each element of the stored payload.
+         * @return The element type, Unknown if the store does not record it.
+         */
+        virtual DataType GetDataType() const = 0;
+
+        /**
+         * @brief Get the size of the stored payload.
+         * @return The size in bytes.
+         */
+        virtual size_t GetSize() const = 0;
+
+        /**
+         * @brief Read part of the payload.
+         * @param offset The offset of the first byte.
+         * @param buff The destination buffer.
+         * @param n The number of bytes to read.
+         * @throw std::runtime_error If the bytes cannot be read.
+         */
+        virtual void Read(const size_t offset, char *buff, const size_t n) = 0;
+
+        /**
+         * @brief Write part of the payload in place.
+         * @param offset The offset of the first byte.
+         * @param buff The source buffer.
+         * @param n The number of bytes to write.
+         * @throw std::runtime_error If the bytes cannot be written.
+         */
+        virtual void Write(const size_t offset, const char *buff, const size_t n) = 0;
+    };
+
+} // end namespace resource
+
+#endif // end resource_ichunkstore_h
@@ -6,8 +6,13 @@
 #ifndef resource_iresource_h
 #define resource_iresource_h
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+#include "Resources/DataType.h"
+#include "Resources/Layout.h"
 #include "Resources/config.h"
 
 namespace resource
@@ -68,6 +73,27 @@ namespace resource
          */
         size_t GetRowSize() const;
 
+        /**
+         * @brief Get the number of dimensions of the resource data.
+         * @return The rank; two unless a shape of another rank was set.
+         */
+        size_t GetRank() const;
+
+        /**
+         * @brief Get the extent of each dimension of the resource data.
+         *
+         * The column size is the first extent and the row size is the product of the remaining extents,
+         * so the element count is always GetColumnSize() * GetRowSize().
+         * @return The shape; {column size, row size} unless a shape of another rank was set.
+         */
+        std::vector<size_t> GetShape() const;
+
+        /**
+         * @brief Get the ordering of the elements of the resource data.
+         * @return The layout.
+         */
+        const Layout &GetLayout() const;
+
         /**
          * @brief Check if the resource data has been modified.
          * @return True if the data is dirty, false otherwise.
@@ -80,6 +106,12 @@ namespace resource
          */
         virtual size_t GetElementSize() const = 0;
 
+        /**
+         * @brief Get the type of each element in the resource data.
+         * @return The element type, Unknown unless a derived class reports one.
+         */
+        virtual DataType GetDataType() const;
+
         /**
          * @brief Access the resource data as a mutable pointer.
          * @return A pointer to the resource data.
@@ -99,6 +131,27 @@ namespace resource
          */
         virtual void Assign(const char *buff, const size_t n) = 0;
 
+        /**
+         * @brief Compute the CRC-32 of a buffer, continuing from the CRC-32 of the bytes before it.
+         *
+         * Large buffers are split into fixed-size segments that are hashed on an OpenMP team; the segment CRCs are
+         * combined in order, so the result equals that of a sequential CRC-32 whatever the number of threads.
+         * @param buff The buffer.
+         * @param size The size of the buffer in bytes.
+         * @param crc The CRC-32 of the preceding bytes, 0 if there are none.
+         * @return The CRC-32 of the preceding bytes followed by the buffer.
+         */
+        static uint32_t Crc32(const void *buff, const size_t size, const uint32_t crc = 0);
+
+        /**
+         * @brief Compute the CRC-32 of two buffers one after the other from the CRC-32 of each.
+         * @param crc The CRC-32 of the first buffer.
+         * @param next The CRC-32 of the second buffer.
+         * @param nextSize The size of the second buffer in bytes.
+         * @return The CRC-32 of the first buffer followed by the second.
+         */
+        static uint32_t Crc32Combine(const uint32_t crc, const uint32_t next, const size_t nextSize);
+
     protected:
         /**
          * @brief Set the number of columns in the resource data.
@@ -112,17 +165,43 @@ namespace resource
          */
         void SetRowSize(const size_t size);
 
+        /**
+         * @brief Set the extent of each dimension of the resource data.
+         * @param shape The new shape; must agree with any column and row size already set.
+         */
+        void SetShape(const std::vector<size_t> &shape);
+
+        /**
+         * @brief Clear the dimensions and layout of the resource data, so that a new shape can be set.
+         */
+        void ClearShape();
+
+        /**
+         * @brief Set the ordering of the elements of the resource data.
+         * @param layout The new layout; must be valid for the shape.
+         */
+        void SetLayout(const Layout &layout);
+
         /**
          * @brief Update the checksum of the resource data.
+         *
+         * Safe to call from threads that share the resource for reading: of the callers that see the same change,
+         * only the one that stores the new checksum reports it.
          * @return True if the checksum was updated successfully, false otherwise.
          */
         bool UpdateChecksum() const;
 
         /**
-         * @brief Get the checksum of the resource data.
+         * @brief Get the checksum stored by the last UpdateChecksum.
+         * @return The checksum value, -1 if none was stored.
+         */
+        int GetChecksum() const;
+
+        /**
+         * @brief Get the checksum of the resource data; the CRC-32 of the bytes of Data() unless a derived class stores them differently.
          * @return The checksum value.
          */
-        int Checksum() const;
+        virtual int Checksum() const;
 
     private:
         /** @brief The number of columns in the resource data. */
@@ -131,11 +210,17 @@ namespace resource
         /** @brief The number of rows in the resource data. */
         size_t N_{0};
 
+        /** @brief The extent of each dimension, empty for two-dimensional resources. */
+        std::vector<size_t> shape_;
+
+        /** @brief The ordering of the elements of the resource data. */
+        Layout layout_;
+
         /** @brief The checksum of the resource data. */
-        mutable int checkSum_{-1};
+        mutable std::atomic<int> checkSum_{-1};
 
         /** @brief Flag indicating whether the resource data has been modified. */
-        mutable bool dirty_{true};
+        mutable std::atomic<bool> dirty_{true};
     };
 
 } // end namespace resource
@@ -0,0 +1,158 @@
+/**
+ * @file Layout.h
+ * @brief Declaration of the Layout class describing how N-dimensional resource data is ordered in memory.
+ */
+
+#ifndef resource_layout_h
+#define resource_layout_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @enum LayoutType
+     * @brief The element orderings a resource payload can have.
+     */
+    enum class LayoutType : uint32_t
+    {
+        RowMajor = 0,    /**< The last dimension varies fastest. */
+        ColumnMajor = 1, /**< The first dimension varies fastest. */
+        Tiled = 2        /**< Row-major tiles, each stored contiguously in row-major order. */
+    };
+
+    /**
+     * @class Layout
+     * @brief Describes the ordering of the elements of an N-dimensional resource.
+     *
+     * Tiled layouts split the shape into equally sized blocks; every extent must be a multiple of
+     * the matching tile extent so that the payload has no padding.
+     */
+    class RESOURCE_DLL_EXPORT Layout
+    {
+    public:
+        /**
+         * @brief Default constructor for the Layout class; the layout is row-major.
+         */
+        Layout();
+
+        /**
+         * @brief Destructor for the Layout class.
+         */
+        virtual ~Layout() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The Layout instance to copy from.
+         */
+        Layout(const Layout &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The Layout instance to copy from.
+         * @return Reference to the updated Layout instance.
+         */
+        Layout &operator=(const Layout &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The Layout instance to move from.
+         */
+        Layout(Layout &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The Layout instance to move from.
+         * @return Reference to the updated Layout instance.
+         */
+        Layout &operator=(Layout &&other) noexcept;
+
+        /**
+         * @brief Create a row-major layout.
+         * @return The layout.
+         */
+        static Layout RowMajor();
+
+        /**
+         * @brief Create a column-major layout.
+         * @return The layout.
+         */
+        static Layout ColumnMajor();
+
+        /**
+         * @brief Create a tiled layout.
+         * @param tileShape The extent of a tile in each dimension; every extent must be non-zero.
+         * @return The layout.
+         */
+        static Layout Tiled(const std::vector<size_t> &tileShape);
+
+        /**
+         * @brief Create a layout from its serialized form.
+         * @param type The layout type.
+         * @param tileShape The tile extents; must be empty unless the type is tiled.
+         * @return The layout.
+         */
+        static Layout Make(const LayoutType type, const std::vector<size_t> &tileShape = {});
+
+        /**
+         * @brief Get the layout type.
+         * @return The layout type.
+         */
+        LayoutType GetType() const;
+
+        /**
+         * @brief Get the tile extents of a tiled layout.
+         * @return The tile extents, empty for untiled layouts.
+         */
+        const std::vector<size_t> &GetTileShape() const;
+
+        /**
+         * @brief Check that the layout can order a resource of the given shape.
+         * @param shape The extent of each dimension.
+         * @throw std::runtime_error If the tile rank differs from the shape rank or a tile does not divide its extent.
+         */
+        void Validate(const std::vector<size_t> &shape) const;
+
+        /**
+         * @brief Get the position of an element within the payload.
+         * @param shape The extent of each dimension.
+         * @param index The index of the element in each dimension.
+         * @return The offset of the element, in elements.
+         * @throw std::runtime_error If the index rank differs from the shape rank or an index is out of bounds.
+         */
+        size_t GetOffset(const std::vector<size_t> &shape, const std::vector<size_t> &index) const;
+
+        /**
+         * @brief Reorder a payload from one layout into another.
+         * @param src The source payload.
+         * @param from The layout of the source payload.
+         * @param dst The destination payload; must not overlap the source.
+         * @param to The layout of the destination payload.
+         * @param shape The extent of each dimension.
+         * @param elementSize The size of an element in bytes.
+         */
+        static void Convert(const char *src, const Layout &from, char *dst, const Layout &to, const std::vector<size_t> &shape, const size_t elementSize);
+
+        /**
+         * @brief Compare two layouts for equality.
+         * @param other The layout to compare with.
+         * @return True if the type and tile extents match, false otherwise.
+         */
+        bool operator==(const Layout &other) const;
+
+    private:
+        /** @brief The layout type. */
+        LayoutType type_{LayoutType::RowMajor};
+
+        /** @brief The tile extents of a tiled layout. */
+        std::vector<size_t> tileShape_;
+    };
+
+} // end namespace resource
+
+#endif // end resource_layout_h
@@ -0,0 +1,234 @@
+/**
+ * @file PageCache.h
+ * @brief Declaration of the PageCache class for bounding the memory of chunked resources.
+ */
+
+#ifndef resource_pagecache_h
+#define resource_pagecache_h
+
+#include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    class ChunkedResource;
+
+    /**
+     * @class PageCache
+     * @brief A singleton LRU of ChunkedResource chunks with a configurable memory budget.
+     *
+     * Chunks are loaded from the backing store of their resource on first access. When the resident bytes exceed
+     * the budget, the least recently used chunks that are not pinned are written back (if modified) and released.
+     * Stores are read and written outside the lock of the cache, so a cold chunk only delays the threads that need
+     * it; accesses to the same chunk wait until it is loaded or written back.
+     */
+    class RESOURCE_DLL_EXPORT PageCache
+    {
+    public:
+        /**
+         * @brief Allows ChunkedResource to load and release its chunks through the cache.
+         */
+        friend class ChunkedResource;
+
+        /**
+         * @brief Destructor for the PageCache class.
+         */
+        virtual ~PageCache() noexcept;
+
+        /**
+         * @brief Get the singleton instance of the PageCache.
+         * @return Pointer to the PageCache instance.
+         */
+        static PageCache *GetInstance();
+
+        /**
+         * @brief Set the maximum number of chunk bytes kept resident.
+         * @param bytes The memory budget in bytes.
+         */
+        void SetBudget(const size_t bytes);
+
+        /**
+         * @brief Get the maximum number of chunk bytes kept resident.
+         * @return The memory budget in bytes.
+         */
+        size_t GetBudget() const;
+
+        /**
+         * @brief Get the number of chunk bytes currently resident.
+         * @return The resident bytes.
+         */
+        size_t GetResidentBytes() const;
+
+        /**
+         * @brief Get the number of chunks currently resident.
+         * @return The resident chunk count.
+         */
+        size_t GetResidentCount() const;
+
+        /**
+         * @brief Write back and release every resident chunk that is not pinned.
+         */
+        void Clear();
+
+    private:
+        /**
+         * @brief Whether a chunk is being read from or written back to its store.
+         */
+        enum class State
+        {
+            Loading,
+            Resident,
+            Evicting
+        };
+
+        /**
+         * @brief A resident chunk.
+         */
+        struct Page
+        {
+            const ChunkedResource *resource;
+            size_t chunk;
+            std::unique_ptr<char[]> data;
+            size_t size;
+            size_t pins;
+            bool dirty;
+            State state;
+        };
+
+        using Key = std::pair<const ChunkedResource *, size_t>;
+        using PageIterator = std::list<Page>::iterator;
+
+        /**
+         * @brief Default constructor for the PageCache class.
+         *
+         * Private to enforce the singleton pattern.
+         */
+        PageCache();
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        PageCache(const PageCache &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        PageCache &operator=(const PageCache &) = delete;
+
+        /**
+         * @brief Deleted move constructor to prevent moving.
+         */
+        PageCache(PageCache &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator to prevent moving.
+         * @return Reference to the updated instance (not used).
+         */
+        PageCache &operator=(PageCache &&) = delete;
+
+        /**
+         * @brief Make a chunk resident, pin it and mark it most recently used.
+         * @param resource The resource that owns the chunk.
+         * @param chunk The index of the chunk.
+         * @param modify Whether the caller may modify the chunk.
+         * @return A pointer to the chunk.
+         */
+        char *Acquire(const ChunkedResource &resource, const size_t chunk, const bool modify);
+
+        /**
+         * @brief Unpin a chunk previously pinned through Acquire.
+         * @param resource The resource that owns the chunk.
+         * @param chunk The index of the chunk.
+         */
+        void Unpin(const ChunkedResource &resource, const size_t chunk);
+
+        /**
+         * @brief Check if a chunk is resident.
+         * @param resource The resource that owns the chunk.
+         * @param chunk The index of the chunk.
+         * @return True if the chunk is resident, false otherwise.
+         */
+        bool IsResident(const ChunkedResource &resource, const size_t chunk) const;
+
+        /**
+         * @brief Write back the modified chunks of a resource.
+         * @param resource The resource to flush.
+         */
+        void Flush(const ChunkedResource &resource);
+
+        /**
+         * @brief Release every chunk of a resource.
+         * @param resource The resource to forget.
+         * @param writeBack Whether modified chunks are written back before release.
+         */
+        void Remove(const ChunkedResource &resource, const bool writeBack);
+
+        /**
+         * @brief Read a chunk that is not resident from its store, releasing the lock meanwhile.
+         * @param lock The held lock of the cache.
+         * @param resource The resource that owns the chunk.
+         * @param chunk The index of the chunk.
+         * @return The resident chunk.
+         */
+        PageIterator Load(std::unique_lock<std::mutex> &lock, const ChunkedResource &resource, const size_t chunk);
+
+        /**
+         * @brief Evict least recently used chunks until the budget is met.
+         * @param lock The held lock of the cache.
+         */
+        void EvictOverBudget(std::unique_lock<std::mutex> &lock);
+
+        /**
+         * @brief Mark a resident chunk for eviction, so that no other thread uses it (lock must be held).
+         * @param page The chunk to evict.
+         */
+        void MarkEvicting(PageIterator page);
+
+        /**
+         * @brief Write back and release chunks marked for eviction, releasing the lock meanwhile.
+         *
+         * If a write fails, the chunks that were not written back stay resident.
+         * @param lock The held lock of the cache.
+         * @param pages The chunks to evict.
+         * @param writeBack Whether modified chunks are written back before release.
+         */
+        void Evict(std::unique_lock<std::mutex> &lock, const std::vector<PageIterator> &pages, const bool writeBack);
+
+        /**
+         * @brief Forget a chunk (lock must be held).
+         * @param page The chunk to forget.
+         */
+        void Release(PageIterator page);
+
+        /** @brief Mutex guarding the cache; the stores are guarded by their resources. */
+        mutable std::mutex mtx_;
+
+        /** @brief Signalled whenever a chunk finishes loading or being written back. */
+        std::condition_variable settled_;
+
+        /** @brief Resident chunks ordered from most to least recently used. */
+        std::list<Page> lru_;
+
+        /** @brief Map of resident chunks to their position in the LRU list, ordered by resource. */
+        std::map<Key, std::list<Page>::iterator> index_;
+
+        /** @brief The maximum number of chunk bytes kept resident. */
+        size_t budget_;
+
+        /** @brief The number of chunk bytes currently resident, excluding chunks being evicted. */
+        size_t residentBytes_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_pagecache_h
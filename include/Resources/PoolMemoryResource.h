@@ -0,0 +1,150 @@
+/**
+ * @file PoolMemoryResource.h
+ * @brief Declaration of the PoolMemoryResource class, a size-class pool for resource payloads.
+ */
+
+#ifndef resource_poolmemoryresource_h
+#define resource_poolmemoryresource_h
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+#include "Resources/config.h"
+
+namespace resource
+{
+
+    /**
+     * @class PoolMemoryResource
+     * @brief A thread-safe memory resource that recycles blocks through power-of-two size classes.
+     *
+     * Every block is aligned to at least the pool alignment. Freed blocks are kept on a per-class free
+     * list and handed out again, so repeatedly loading and unloading same-sized resources does not go
+     * back to the upstream resource. Requests larger than the largest class go straight upstream.
+     * The pool must outlive every block allocated from it.
+     */
+    class RESOURCE_DLL_EXPORT PoolMemoryResource : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @brief Constructor for the PoolMemoryResource class.
+         * @param alignment The minimum alignment of every block, a power of two.
+         * @param maxBlockSize The largest pooled block size in bytes.
+         * @param upstream The resource that pooled blocks are allocated from.
+         */
+        PoolMemoryResource(const size_t alignment = 64, const size_t maxBlockSize = size_t(1) << 20, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+        /**
+         * @brief Destructor for the PoolMemoryResource class; returns every pooled block upstream.
+         */
+        virtual ~PoolMemoryResource() noexcept;
+
+        /**
+         * @brief Deleted copy constructor to prevent copying.
+         */
+        PoolMemoryResource(const PoolMemoryResource &) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator to prevent copying.
+         * @return Reference to the updated instance (not used).
+         */
+        PoolMemoryResource &operator=(const PoolMemoryResource &) = delete;
+
+        /**
+         * @brief Deleted move constructor to prevent moving.
+         */
+        PoolMemoryResource(PoolMemoryResource &&) = delete;
+
+        /**
+         * @brief Deleted move assignment operator to prevent moving.
+         * @return Reference to the updated instance (not used).
+         */
+        PoolMemoryResource &operator=(PoolMemoryResource &&) = delete;
+
+        /**
+         * @brief Get the minimum alignment of every block.
+         * @return The alignment in bytes.
+         */
+        size_t GetAlignment() const;
+
+        /**
+         * @brief Get the largest pooled block size.
+         * @return The block size in bytes.
+         */
+        size_t GetMaxBlockSize() const;
+
+        /**
+         * @brief Get the number of bytes held on the free lists.
+         * @return The pooled bytes.
+         */
+        size_t GetPooledBytes() const;
+
+        /**
+         * @brief Return every block on the free lists to the upstream resource.
+         */
+        void Release();
+
+    protected:
+        /**
+         * @brief Allocate a block from its size class or the upstream resource.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The requested alignment.
+         * @return A pointer to the block.
+         */
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        /**
+         * @brief Return a block to its size class or the upstream resource.
+         * @param p The block to deallocate.
+         * @param bytes The number of bytes originally requested.
+         * @param alignment The alignment originally requested.
+         */
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+
+        /**
+         * @brief Compare for equality with another memory resource.
+         * @param other The other memory resource.
+         * @return True if other is this pool, false otherwise.
+         */
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    private:
+        /**
+         * @brief Get the size class that serves an allocation.
+         * @param bytes The number of bytes requested.
+         * @param alignment The alignment requested.
+         * @return The size class index, or the class count if the request is not pooled.
+         */
+        size_t GetSizeClass(const size_t bytes, const size_t alignment) const;
+
+        /**
+         * @brief Get the block size of a size class.
+         * @param sizeClass The size class index.
+         * @return The block size in bytes.
+         */
+        size_t GetBlockSize(const size_t sizeClass) const;
+
+        /** @brief Mutex guarding the free lists. */
+        mutable std::mutex mtx_;
+
+        /** @brief The minimum alignment of every block. */
+        size_t alignment_;
+
+        /** @brief The largest pooled block size. */
+        size_t maxBlockSize_;
+
+        /** @brief The resource that pooled blocks are allocated from. */
+        std::pmr::memory_resource *upstream_;
+
+        /** @brief Heads of the intrusive free list of each size class. */
+        std::vector<void *> freeLists_;
+
+        /** @brief The number of bytes held on the free lists. */
+        size_t pooledBytes_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_poolmemoryresource_h
@@ -0,0 +1,352 @@
+/**
+ * @file ResourceExpression.h
+ * @brief Declaration of lazy element-wise expressions over resource data, evaluated in a single fused pass.
+ */
+
+#ifndef resource_resourceexpression_h
+#define resource_resourceexpression_h
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Resources/CompressedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/IResource.h"
+#include "Resources/Layout.h"
+#include "Resources/SparseResource.h"
+
+namespace resource
+{
+
+    /**
+     * @class Expression
+     * @brief The base of every element-wise expression.
+     *
+     * Expressions only record their operands; no element is computed until the expression is passed to
+     * Evaluate, which computes each element of the result once in a single loop. Elements are combined by their
+     * position in the payload, so every resource of an expression must have the same shape and layout. An
+     * expression holds pointers into the data of its resources and is only valid while they are alive and not resized.
+     * @tparam E The derived expression type.
+     */
+    template <typename E>
+    class Expression
+    {
+    public:
+        /**
+         * @brief Get the derived expression.
+         * @return Reference to the derived expression.
+         */
+        const E &Self() const;
+    };
+
+    /**
+     * @class ResourceOperand
+     * @brief The elements of a dense resource as the leaf of an expression.
+     * @tparam T The element type of the resource.
+     */
+    template <typename T>
+    class ResourceOperand : public Expression<ResourceOperand<T>>
+    {
+    public:
+        /** @brief The type of each element. */
+        using value_type = T;
+
+        /**
+         * @brief Constructor for the ResourceOperand class.
+         * @param resource The resource; must hold dense elements of type T. A compressed resource is pinned for the lifetime of the operand.
+         * @throw std::runtime_error If the resource is sparse or its elements are not of type T.
+         */
+        ResourceOperand(const IResource &resource);
+
+        /**
+         * @brief Check that a resource holds elements of type T.
+         * @param resource The resource.
+         * @throw std::runtime_error If the resource is sparse or its elements are not of type T.
+         */
+        static void CheckType(const IResource &resource);
+
+        /**
+         * @brief Get an element.
+         * @param i The index of the element.
+         * @return The element.
+         */
+        T operator[](const size_t i) const;
+
+        /**
+         * @brief Get the number of elements.
+         * @return The element count of the resource.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Get the extent of each dimension.
+         * @return The shape of the resource.
+         */
+        const std::vector<size_t> &GetShape() const;
+
+        /**
+         * @brief Get the ordering of the elements.
+         * @return The layout of the resource.
+         */
+        const Layout &GetLayout() const;
+
+    private:
+        /** @brief Keeps the payload of a compressed resource resident, so that data_ is not freed by an eviction. */
+        std::shared_ptr<void> pin_;
+
+        /** @brief The elements of the resource. */
+        const T *data_;
+
+        /** @brief The element count of the resource. */
+        size_t size_;
+
+        /** @brief The shape of the resource. */
+        std::vector<size_t> shape_;
+
+        /** @brief The layout of the resource. */
+        Layout layout_;
+    };
+
+    /**
+     * @class ScalarOperand
+     * @brief A value broadcast to every element of an expression.
+     * @tparam T The type of the value.
+     */
+    template <typename T>
+    class ScalarOperand : public Expression<ScalarOperand<T>>
+    {
+    public:
+        /** @brief The type of each element. */
+        using value_type = T;
+
+        /**
+         * @brief Constructor for the ScalarOperand class.
+         * @param value The value.
+         */
+        ScalarOperand(const T value);
+
+        /**
+         * @brief Get an element.
+         * @param i The index of the element (ignored).
+         * @return The value.
+         */
+        T operator[](const size_t i) const;
+
+        /**
+         * @brief Get the number of elements.
+         * @return 0, since a scalar matches expressions of any size.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Get the extent of each dimension.
+         * @return An empty shape, since a scalar matches expressions of any shape.
+         */
+        const std::vector<size_t> &GetShape() const;
+
+        /**
+         * @brief Get the ordering of the elements.
+         * @return The default layout, which is not compared since the size is 0.
+         */
+        const Layout &GetLayout() const;
+
+    private:
+        /** @brief The value. */
+        T value_;
+
+        /** @brief The empty shape. */
+        std::vector<size_t> shape_;
+
+        /** @brief The default layout. */
+        Layout layout_;
+    };
+
+    /**
+     * @class BinaryExpression
+     * @brief An element-wise operation on two expressions.
+     * @tparam Op The operation, e.g. std::plus<>.
+     * @tparam L The left operand.
+     * @tparam R The right operand.
+     */
+    template <typename Op, typename L, typename R>
+    class BinaryExpression : public Expression<BinaryExpression<Op, L, R>>
+    {
+    public:
+        /** @brief The type of each element, the common type of the operands. */
+        using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+
+        /**
+         * @brief Constructor for the BinaryExpression class.
+         * @param left The left operand.
+         * @param right The right operand.
+         * @throw std::runtime_error If neither operand is a scalar and their sizes, shapes or layouts differ.
+         */
+        BinaryExpression(const L &left, const R &right);
+
+        /**
+         * @brief Get an element.
+         * @param i The index of the element.
+         * @return The operation applied to the elements of the operands.
+         */
+        value_type operator[](const size_t i) const;
+
+        /**
+         * @brief Get the number of elements.
+         * @return The size of the operands, 0 if both are scalars.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Get the extent of each dimension.
+         * @return The shape of the operands, empty if both are scalars.
+         */
+        const std::vector<size_t> &GetShape() const;
+
+        /**
+         * @brief Get the ordering of the elements.
+         * @return The layout of the operands.
+         */
+        const Layout &GetLayout() const;
+
+    private:
+        /** @brief The left operand. */
+        L left_;
+
+        /** @brief The right operand. */
+        R right_;
+    };
+
+    /**
+     * @class NegateExpression
+     * @brief The element-wise negation of an expression.
+     * @tparam E The operand.
+     */
+    template <typename E>
+    class NegateExpression : public Expression<NegateExpression<E>>
+    {
+    public:
+        /** @brief The type of each element. */
+        using value_type = typename E::value_type;
+
+        /**
+         * @brief Constructor for the NegateExpression class.
+         * @param operand The operand.
+         */
+        NegateExpression(const E &operand);
+
+        /**
+         * @brief Get an element.
+         * @param i The index of the element.
+         * @return The negated element of the operand.
+         */
+        value_type operator[](const size_t i) const;
+
+        /**
+         * @brief Get the number of elements.
+         * @return The size of the operand.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Get the extent of each dimension.
+         * @return The shape of the operand.
+         */
+        const std::vector<size_t> &GetShape() const;
+
+        /**
+         * @brief Get the ordering of the elements.
+         * @return The layout of the operand.
+         */
+        const Layout &GetLayout() const;
+
+    private:
+        /** @brief The operand. */
+        E operand_;
+    };
+
+    /**
+     * @brief Use the elements of a resource in an expression.
+     * @tparam T The element type of the resource.
+     * @param resource The resource.
+     * @return The operand.
+     */
+    template <typename T>
+    ResourceOperand<T> Elements(const IResource &resource);
+
+    /**
+     * @brief Evaluate an expression into the elements of a resource in a single pass.
+     *
+     * Each element is computed once, converted to T and stored, in a loop the compiler vectorizes. The target
+     * may also be an operand of the expression. Large parallel evaluations split the loop across an OpenMP team.
+     * @tparam T The element type of the target.
+     * @tparam E The expression type.
+     * @param target The resource receiving the result; must hold dense elements of type T. A compressed target is pinned while it is written.
+     * @param expression The expression.
+     * @param parallel True to spread large evaluations over the threads of an OpenMP team.
+     * @throw std::runtime_error If the target does not hold elements of type T or its size, shape or layout differs from the expression.
+     */
+    template <typename T, typename E>
+    void Evaluate(IResource &target, const Expression<E> &expression, const bool parallel = false);
+
+    /** @brief Add two expressions element-wise. */
+    template <typename L, typename R>
+    BinaryExpression<std::plus<>, L, R> operator+(const Expression<L> &left, const Expression<R> &right);
+
+    /** @brief Subtract two expressions element-wise. */
+    template <typename L, typename R>
+    BinaryExpression<std::minus<>, L, R> operator-(const Expression<L> &left, const Expression<R> &right);
+
+    /** @brief Multiply two expressions element-wise. */
+    template <typename L, typename R>
+    BinaryExpression<std::multiplies<>, L, R> operator*(const Expression<L> &left, const Expression<R> &right);
+
+    /** @brief Divide two expressions element-wise. */
+    template <typename L, typename R>
+    BinaryExpression<std::divides<>, L, R> operator/(const Expression<L> &left, const Expression<R> &right);
+
+    /** @brief Add a scalar to every element of an expression. */
+    template <typename L, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::plus<>, L, ScalarOperand<typename L::value_type>> operator+(const Expression<L> &left, const S right);
+
+    /** @brief Subtract a scalar from every element of an expression. */
+    template <typename L, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::minus<>, L, ScalarOperand<typename L::value_type>> operator-(const Expression<L> &left, const S right);
+
+    /** @brief Multiply every element of an expression by a scalar. */
+    template <typename L, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::multiplies<>, L, ScalarOperand<typename L::value_type>> operator*(const Expression<L> &left, const S right);
+
+    /** @brief Divide every element of an expression by a scalar. */
+    template <typename L, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::divides<>, L, ScalarOperand<typename L::value_type>> operator/(const Expression<L> &left, const S right);
+
+    /** @brief Add every element of an expression to a scalar. */
+    template <typename S, typename R, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::plus<>, ScalarOperand<typename R::value_type>, R> operator+(const S left, const Expression<R> &right);
+
+    /** @brief Subtract every element of an expression from a scalar. */
+    template <typename S, typename R, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::minus<>, ScalarOperand<typename R::value_type>, R> operator-(const S left, const Expression<R> &right);
+
+    /** @brief Multiply a scalar by every element of an expression. */
+    template <typename S, typename R, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::multiplies<>, ScalarOperand<typename R::value_type>, R> operator*(const S left, const Expression<R> &right);
+
+    /** @brief Divide a scalar by every element of an expression. */
+    template <typename S, typename R, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    BinaryExpression<std::divides<>, ScalarOperand<typename R::value_type>, R> operator/(const S left, const Expression<R> &right);
+
+    /** @brief Negate every element of an expression. */
+    template <typename E>
+    NegateExpression<E> operator-(const Expression<E> &operand);
+
+#include "Resources/ResourceExpression.hpp"
+
+} // end namespace resource
+
+#endif // end resource_resourceexpression_h
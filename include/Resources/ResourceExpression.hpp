@@ -0,0 +1,272 @@
+
+template <typename E>
+const E &Expression<E>::Self() const
+{
+	return static_cast<const E &>(*this);
+}
+
+template <typename T>
+ResourceOperand<T>::ResourceOperand(const IResource &resource)
+{
+	CheckType(resource);
+	if (auto compressed = dynamic_cast<const CompressedResource *>(&resource))
+		pin_ = compressed->Pin();
+	data_ = static_cast<const T *>(resource.Data());
+	size_ = resource.GetColumnSize() * resource.GetRowSize();
+	shape_ = resource.GetShape();
+	layout_ = resource.GetLayout();
+}
+
+template <typename T>
+void ResourceOperand<T>::CheckType(const IResource &resource)
+{
+	if (dynamic_cast<const SparseResource *>(&resource))
+		throw std::runtime_error("Sparse resources cannot be used in element-wise expressions");
+
+	// untagged resources are trusted to hold T if the element size agrees
+	const DataType dataType = resource.GetDataType();
+	const bool matches = dataType == DataType::Unknown ? resource.GetElementSize() == sizeof(T) : dataType == DataTypeConverter::GetDataType<T>();
+	if (!matches)
+		throw std::runtime_error("Resource of " + DataTypeConverter::GetName(dataType) + " elements cannot be used as " + DataTypeConverter::GetName(DataTypeConverter::GetDataType<T>()) + " in an expression");
+}
+
+template <typename T>
+T ResourceOperand<T>::operator[](const size_t i) const
+{
+	return data_[i];
+}
+
+template <typename T>
+size_t ResourceOperand<T>::GetSize() const
+{
+	return size_;
+}
+
+template <typename T>
+const std::vector<size_t> &ResourceOperand<T>::GetShape() const
+{
+	return shape_;
+}
+
+template <typename T>
+const Layout &ResourceOperand<T>::GetLayout() const
+{
+	return layout_;
+}
+
+template <typename T>
+ScalarOperand<T>::ScalarOperand(const T value) : value_(value)
+{
+}
+
+template <typename T>
+T ScalarOperand<T>::operator[](const size_t) const
+{
+	return value_;
+}
+
+template <typename T>
+size_t ScalarOperand<T>::GetSize() const
+{
+	return 0;
+}
+
+template <typename T>
+const std::vector<size_t> &ScalarOperand<T>::GetShape() const
+{
+	return shape_;
+}
+
+template <typename T>
+const Layout &ScalarOperand<T>::GetLayout() const
+{
+	return layout_;
+}
+
+template <typename Op, typename L, typename R>
+BinaryExpression<Op, L, R>::BinaryExpression(const L &left, const R &right) : left_(left), right_(right)
+{
+	if (left_.GetSize() == 0 || right_.GetSize() == 0)
+		return;
+	if (left_.GetSize() != right_.GetSize())
+		throw std::runtime_error("Expression operands of " + std::to_string(left_.GetSize()) + " and " + std::to_string(right_.GetSize()) + " elements cannot be combined");
+	if (left_.GetShape() != right_.GetShape())
+		throw std::runtime_error("Expression operands of different shapes cannot be combined");
+	if (left_.GetLayout() != right_.GetLayout())
+		throw std::runtime_error("Expression operands of different layouts cannot be combined");
+}
+
+template <typename Op, typename L, typename R>
+typename BinaryExpression<Op, L, R>::value_type BinaryExpression<Op, L, R>::operator[](const size_t i) const
+{
+	return static_cast<value_type>(Op()(static_cast<value_type>(left_[i]), static_cast<value_type>(right_[i])));
+}
+
+template <typename Op, typename L, typename R>
+size_t BinaryExpression<Op, L, R>::GetSize() const
+{
+	return left_.GetSize() != 0 ? left_.GetSize() : right_.GetSize();
+}
+
+template <typename Op, typename L, typename R>
+const std::vector<size_t> &BinaryExpression<Op, L, R>::GetShape() const
+{
+	return left_.GetSize() != 0 ? left_.GetShape() : right_.GetShape();
+}
+
+template <typename Op, typename L, typename R>
+const Layout &BinaryExpression<Op, L, R>::GetLayout() const
+{
+	return left_.GetSize() != 0 ? left_.GetLayout() : right_.GetLayout();
+}
+
+template <typename E>
+NegateExpression<E>::NegateExpression(const E &operand) : operand_(operand)
+{
+}
+
+template <typename E>
+typename NegateExpression<E>::value_type NegateExpression<E>::operator[](const size_t i) const
+{
+	return static_cast<value_type>(-operand_[i]);
+}
+
+template <typename E>
+size_t NegateExpression<E>::GetSize() const
+{
+	return operand_.GetSize();
+}
+
+template <typename E>
+const std::vector<size_t> &NegateExpression<E>::GetShape() const
+{
+	return operand_.GetShape();
+}
+
+template <typename E>
+const Layout &NegateExpression<E>::GetLayout() const
+{
+	return operand_.GetLayout();
+}
+
+template <typename T>
+ResourceOperand<T> Elements(const IResource &resource)
+{
+	return ResourceOperand<T>(resource);
+}
+
+template <typename T, typename E>
+void Evaluate(IResource &target, const Expression<E> &expression, const bool parallel)
+{
+	ResourceOperand<T>::CheckType(target);
+	const E &self = expression.Self();
+	const size_t size = target.GetColumnSize() * target.GetRowSize();
+	if (self.GetSize() != 0 && self.GetSize() != size)
+		throw std::runtime_error("Expression of " + std::to_string(self.GetSize()) + " elements cannot be evaluated into a resource of " + std::to_string(size) + " elements");
+	if (self.GetSize() != 0 && self.GetShape() != target.GetShape())
+		throw std::runtime_error("Expression cannot be evaluated into a resource of a different shape");
+	if (self.GetSize() != 0 && self.GetLayout() != target.GetLayout())
+		throw std::runtime_error("Expression cannot be evaluated into a resource of a different layout");
+	if (size == 0)
+		return;
+
+	// below this many elements a team costs more than it saves
+	constexpr size_t PARALLEL_SIZE = size_t(1) << 16;
+
+	// the operands are pinned already, so acquiring the target cannot evict them, nor they the target
+	std::shared_ptr<void> pin;
+	if (auto compressed = dynamic_cast<CompressedResource *>(&target))
+		pin = compressed->Pin();
+	T *out = static_cast<T *>(target.Data());
+	const long long count = static_cast<long long>(size);
+	if (parallel && size >= PARALLEL_SIZE)
+	{
+#pragma omp parallel for simd schedule(static)
+		for (long long i = 0; i < count; ++i)
+			out[i] = static_cast<T>(self[static_cast<size_t>(i)]);
+	}
+	else
+	{
+#pragma omp simd
+		for (long long i = 0; i < count; ++i)
+			out[i] = static_cast<T>(self[static_cast<size_t>(i)]);
+	}
+}
+
+template <typename L, typename R>
+BinaryExpression<std::plus<>, L, R> operator+(const Expression<L> &left, const Expression<R> &right)
+{
+	return BinaryExpression<std::plus<>, L, R>(left.Self(), right.Self());
+}
+
+template <typename L, typename R>
+BinaryExpression<std::minus<>, L, R> operator-(const Expression<L> &left, const Expression<R> &right)
+{
+	return BinaryExpression<std::minus<>, L, R>(left.Self(), right.Self());
+}
+
+template <typename L, typename R>
+BinaryExpression<std::multiplies<>, L, R> operator*(const Expression<L> &left, const Expression<R> &right)
+{
+	return BinaryExpression<std::multiplies<>, L, R>(left.Self(), right.Self());
+}
+
+template <typename L, typename R>
+BinaryExpression<std::divides<>, L, R> operator/(const Expression<L> &left, const Expression<R> &right)
+{
+	return BinaryExpression<std::divides<>, L, R>(left.Self(), right.Self());
+}
+
+template <typename L, typename S, typename>
+BinaryExpression<std::plus<>, L, ScalarOperand<typename L::value_type>> operator+(const Expression<L> &left, const S right)
+{
+	return {left.Self(), ScalarOperand<typename L::value_type>(static_cast<typename L::value_type>(right))};
+}
+
+template <typename L, typename S, typename>
+BinaryExpression<std::minus<>, L, ScalarOperand<typename L::value_type>> operator-(const Expression<L> &left, const S right)
+{
+	return {left.Self(), ScalarOperand<typename L::value_type>(static_cast<typename L::value_type>(right))};
+}
+
+template <typename L, typename S, typename>
+BinaryExpression<std::multiplies<>, L, ScalarOperand<typename L::value_type>> operator*(const Expression<L> &left, const S right)
+{
+	return {left.Self(), ScalarOperand<typename L::value_type>(static_cast<typename L::value_type>(right))};
+}
+
+template <typename L, typename S, typename>
+BinaryExpression<std::divides<>, L, ScalarOperand<typename L::value_type>> operator/(const Expression<L> &left, const S right)
+{
+	return {left.Self(), ScalarOperand<typename L::value_type>(static_cast<typename L::value_type>(right))};
+}
+
+template <typename S, typename R, typename>
+BinaryExpression<std::plus<>, ScalarOperand<typename R::value_type>, R> operator+(const S left, const Expression<R> &right)
+{
+	return {ScalarOperand<typename R::value_type>(static_cast<typename R::value_type>(left)), right.Self()};
+}
+
+template <typename S, typename R, typename>
+BinaryExpression<std::minus<>, ScalarOperand<typename R::value_type>, R> operator-(const S left, const Expression<R> &right)
+{
+	return {ScalarOperand<typename R::value_type>(static_cast<typename R::value_type>(left)), right.Self()};
+}
+
+template <typename S, typename R, typename>
+BinaryExpression<std::multiplies<>, ScalarOperand<typename R::value_type>, R> operator*(const S left, const Expression<R> &right)
+{
+	return {ScalarOperand<typename R::value_type>(static_cast<typename R::value_type>(left)), right.Self()};
+}
+
+template <typename S, typename R, typename>
+BinaryExpression<std::divides<>, ScalarOperand<typename R::value_type>, R> operator/(const S left, const Expression<R> &right)
+{
+	return {ScalarOperand<typename R::value_type>(static_cast<typename R::value_type>(left)), right.Self()};
+}
+
+template <typename E>
+NegateExpression<E> operator-(const Expression<E> &operand)
+{
+	return NegateExpression<E>(operand.Self());
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ResourceStats.h
+ * @brief Declaration of the ResourceStats class summarizing the values of a resource payload.
+ */
+
+#ifndef resource_resourcestats_h
+#define resource_resourcestats_h
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Resources/config.h"
+#include "Resources/DataType.h"
+
+namespace resource
+{
+
+    /**
+     * @class ResourceStats
+     * @brief The minimum, maximum, sum, element count and NaN count of a run of elements.
+     *
+     * NaNs are counted but excluded from the minimum, maximum and sum. Without any other value the minimum is
+     * +infinity and the maximum -infinity, so that the statistics match no range.
+     */
+    class RESOURCE_DLL_EXPORT ResourceStats
+    {
+    public:
+        /**
+         * @brief Default constructor for the ResourceStats class; describes no elements.
+         */
+        ResourceStats();
+
+        /**
+         * @brief Constructor for the ResourceStats class.
+         * @param min The smallest value.
+         * @param max The largest value.
+         * @param sum The sum of the values.
+         * @param count The number of elements.
+         * @param nanCount The number of NaN elements.
+         */
+        ResourceStats(const double min, const double max, const double sum, const uint64_t count, const uint64_t nanCount);
+
+        /**
+         * @brief Destructor for the ResourceStats class.
+         */
+        virtual ~ResourceStats() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The ResourceStats instance to copy from.
+         */
+        ResourceStats(const ResourceStats &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The ResourceStats instance to copy from.
+         * @return Reference to the updated ResourceStats instance.
+         */
+        ResourceStats &operator=(const ResourceStats &other);
+
+        /**
+         * @brief Compute the statistics of a run of elements.
+         * @param data The elements.
+         * @param type The element type; must not be Unknown.
+         * @param count The number of elements.
+         * @return The statistics.
+         * @throw std::runtime_error If the element type is Unknown.
+         */
+        static ResourceStats Compute(const void *data, const DataType type, const size_t count);
+
+        /**
+         * @brief Add the statistics of another run of elements.
+         * @param other The statistics to add.
+         */
+        void Merge(const ResourceStats &other);
+
+        /**
+         * @brief Check if any value may fall within a closed range.
+         * @param low The lower bound.
+         * @param high The upper bound.
+         * @return False if no value lies within the range, true otherwise.
+         */
+        bool MayContain(const double low, const double high) const;
+
+        /**
+         * @brief Get the smallest value.
+         * @return The minimum.
+         */
+        double GetMin() const;
+
+        /**
+         * @brief Get the largest value.
+         * @return The maximum.
+         */
+        double GetMax() const;
+
+        /**
+         * @brief Get the sum of the values.
+         * @return The sum.
+         */
+        double GetSum() const;
+
+        /**
+         * @brief Get the number of elements, including NaNs.
+         * @return The count.
+         */
+        uint64_t GetCount() const;
+
+        /**
+         * @brief Get the number of NaN elements.
+         * @return The NaN count.
+         */
+        uint64_t GetNaNCount() const;
+
+        /**
+         * @brief Compare two sets of statistics.
+         * @param other The statistics to compare with.
+         * @return True if every field is equal, false otherwise.
+         */
+        bool operator==(const ResourceStats &other) const;
+
+    private:
+        /** @brief The smallest value. */
+        double min_;
+
+        /** @brief The largest value. */
+        double max_;
+
+        /** @brief The sum of the values. */
+        double sum_{0.0};
+
+        /** @brief The number of elements. */
+        uint64_t count_{0};
+
+        /** @brief The number of NaN elements. */
+        uint64_t nanCount_{0};
+    };
+
+} // end namespace resource
+
+#endif // end resource_resourcestats_h
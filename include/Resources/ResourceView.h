@@ -0,0 +1,213 @@
+/**
+ * @file ResourceView.h
+ * @brief Declaration of the ResourceView class for non-owning, strided access to resource data.
+ */
+
+#ifndef resource_resourceview_h
+#define resource_resourceview_h
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+#include "Resources/config.h"
+#include "Resources/IResource.h"
+
+namespace resource
+{
+
+    /**
+     * @class ResourceView
+     * @brief A non-owning, strided window into the data of an IResource.
+     *
+     * Element (i, j) of the view maps to element offset + i * stride(0) + j * stride(1) of the parent
+     * buffer, where the parent buffer holds GetColumnSize() x GetRowSize() elements in the order of its
+     * layout. Views of row-major and column-major parents take their strides from the layout; tiled
+     * parents cannot be viewed. The view does not copy the parent data and is only valid while the
+     * parent is alive and not resized.
+     */
+    class RESOURCE_DLL_EXPORT ResourceView
+    {
+    public:
+        /**
+         * @brief Construct a view spanning the entire parent resource, with the strides of its layout.
+         * @param parent The resource to view.
+         * @throw std::runtime_error If the parent is sparse or tiled, or column-major with a rank other than two.
+         */
+        ResourceView(const IResource &parent);
+
+        /**
+         * @brief Construct a strided view into a parent resource.
+         * @param parent The resource to view.
+         * @param offset The element offset of the first element of the view.
+         * @param columnSize The number of elements along the first dimension (i).
+         * @param rowSize The number of elements along the second dimension (j).
+         * @param columnStride The element stride between consecutive i.
+         * @param rowStride The element stride between consecutive j.
+         * @throw std::runtime_error If the parent is sparse or tiled, or the view exceeds its bounds.
+         */
+        ResourceView(const IResource &parent, const size_t offset, const size_t columnSize, const size_t rowSize, const size_t columnStride, const size_t rowStride);
+
+        /**
+         * @brief Destructor for the ResourceView class.
+         */
+        virtual ~ResourceView() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The ResourceView instance to copy from.
+         */
+        ResourceView(const ResourceView &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The ResourceView instance to copy from.
+         * @return Reference to the updated ResourceView instance.
+         */
+        ResourceView &operator=(const ResourceView &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The ResourceView instance to move from.
+         */
+        ResourceView(ResourceView &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The ResourceView instance to move from.
+         * @return Reference to the updated ResourceView instance.
+         */
+        ResourceView &operator=(ResourceView &&other) noexcept;
+
+        /**
+         * @brief Get a view of a contiguous block of rows (i).
+         * @param first The first row of the block.
+         * @param count The number of rows in the block.
+         * @return The row block view.
+         */
+        ResourceView Rows(const size_t first, const size_t count) const;
+
+        /**
+         * @brief Get a view of a single column (fixed j).
+         * @param j The column index.
+         * @return The column view.
+         */
+        ResourceView Column(const size_t j) const;
+
+        /**
+         * @brief Get a view of a sub-matrix.
+         * @param i The first row of the block.
+         * @param j The first column of the block.
+         * @param columnSize The number of rows in the block.
+         * @param rowSize The number of columns in the block.
+         * @return The sub-matrix view.
+         */
+        ResourceView Block(const size_t i, const size_t j, const size_t columnSize, const size_t rowSize) const;
+
+        /**
+         * @brief Get the parent resource.
+         * @return The viewed resource.
+         */
+        const IResource &GetParent() const;
+
+        /**
+         * @brief Get the number of elements along the first dimension (i).
+         * @return The column size of the view.
+         */
+        size_t GetColumnSize() const;
+
+        /**
+         * @brief Get the number of elements along the second dimension (j).
+         * @return The row size of the view.
+         */
+        size_t GetRowSize() const;
+
+        /**
+         * @brief Get the size of each element in the view.
+         * @return The element size of the parent resource.
+         */
+        size_t GetElementSize() const;
+
+        /**
+         * @brief Get the element offset of the view into the parent buffer.
+         * @return The element offset.
+         */
+        size_t GetOffset() const;
+
+        /**
+         * @brief Get the element stride of a dimension.
+         * @param dim The dimension (0 for i, 1 for j).
+         * @return The element stride.
+         */
+        size_t GetStride(const size_t dim) const;
+
+        /**
+         * @brief Get the number of bytes spanned by the packed view data.
+         * @return The packed size of the view in bytes.
+         */
+        size_t GetByteSize() const;
+
+        /**
+         * @brief Check if the elements of every row (fixed i) are adjacent in the parent buffer.
+         * @return True if rows are contiguous, false otherwise.
+         */
+        bool IsRowContiguous() const;
+
+        /**
+         * @brief Check if the entire view is a single contiguous range of the parent buffer.
+         * @return True if the view is contiguous, false otherwise.
+         */
+        bool IsContiguous() const;
+
+        /**
+         * @brief Access an element of the view.
+         * @param i The row index.
+         * @param j The column index.
+         * @return A constant pointer to the element.
+         */
+        const void *At(const size_t i, const size_t j) const;
+
+        /**
+         * @brief Access a typed element of the view.
+         * @tparam T The element type; sizeof(T) must match the element size.
+         * @param i The row index.
+         * @param j The column index.
+         * @return A constant reference to the element.
+         */
+        template <typename T>
+        const T &Get(const size_t i, const size_t j) const;
+
+        /**
+         * @brief Copy a single row of the view into a packed buffer.
+         * @param i The row index.
+         * @param buff The destination buffer of at least GetRowSize() * GetElementSize() bytes.
+         */
+        void CopyRow(const size_t i, char *buff) const;
+
+        /**
+         * @brief Copy the entire view into a packed buffer.
+         * @param buff The destination buffer of at least GetByteSize() bytes.
+         */
+        void CopyTo(char *buff) const;
+
+    private:
+        /** @brief The viewed resource. */
+        const IResource *parent_;
+
+        /** @brief The element offset of the view into the parent buffer. */
+        size_t offset_{0};
+
+        /** @brief The number of elements along each dimension. */
+        std::array<size_t, 2> extents_{0, 0};
+
+        /** @brief The element stride of each dimension. */
+        std::array<size_t, 2> strides_{0, 1};
+    };
+
+#include "Resources/ResourceView.hpp"
+
+} // end namespace resource
+
+#endif // end resource_resourceview_h
@@ -0,0 +1,8 @@
+
+template <typename T>
+const T &ResourceView::Get(const size_t i, const size_t j) const
+{
+	if (sizeof(T) != GetElementSize())
+		throw std::runtime_error("Type (" + std::string(typeid(T).name()) + ") size does not match the element size during ResourceView::Get");
+	return *static_cast<const T *>(At(i, j));
+}
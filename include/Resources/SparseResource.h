@@ -0,0 +1,163 @@
+/**
+ * @file SparseResource.h
+ * @brief Declaration of the SparseResource class for resources stored in compressed sparse row (CSR) form.
+ */
+
+#ifndef resource_sparseresource_h
+#define resource_sparseresource_h
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "Resources/config.h"
+#include "Resources/IResource.h"
+
+namespace resource
+{
+
+    /**
+     * @class SparseResource
+     * @brief A resource that stores only its non-zero elements in compressed sparse row (CSR) form.
+     *
+     * Row i (0 <= i < GetColumnSize()) holds the non-zeros GetRowOffsets()[i] to GetRowOffsets()[i + 1] - 1,
+     * whose column indices are in GetColumnIndices() and whose values are packed in Data(). An element is
+     * zero if all of its bytes are zero. The CSR arrays are allocated from the memory resource given at
+     * construction. Derived classes provide GetElementSize().
+     */
+    class RESOURCE_DLL_EXPORT SparseResource : public virtual IResource
+    {
+    public:
+        /**
+         * @brief Constructor for the SparseResource class.
+         * @param memory The memory resource that the CSR arrays are allocated from.
+         */
+        SparseResource(std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+        /**
+         * @brief Destructor for the SparseResource class.
+         */
+        virtual ~SparseResource() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The SparseResource instance to copy from.
+         */
+        SparseResource(const SparseResource &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The SparseResource instance to copy from.
+         * @return Reference to the updated SparseResource instance.
+         */
+        SparseResource &operator=(const SparseResource &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The SparseResource instance to move from.
+         */
+        SparseResource(SparseResource &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The SparseResource instance to move from.
+         * @return Reference to the updated SparseResource instance.
+         */
+        SparseResource &operator=(SparseResource &&other) noexcept;
+
+        /**
+         * @brief Access the packed non-zero values as a mutable pointer.
+         * @return A pointer to the non-zero values.
+         */
+        void *Data() override;
+
+        /**
+         * @brief Access the packed non-zero values as a constant pointer.
+         * @return A constant pointer to the non-zero values.
+         */
+        const void *Data() const override;
+
+        /**
+         * @brief Assign dense data to the resource, keeping only its non-zero elements.
+         * @param buff A pointer to GetColumnSize() x GetRowSize() dense elements.
+         * @param n The size of the dense data in bytes.
+         */
+        void Assign(const char *buff, const size_t n) override;
+
+        /**
+         * @brief Assign CSR data to the resource.
+         * @param rowOffsets GetColumnSize() + 1 offsets into the non-zeros.
+         * @param columnIndices The column index of each non-zero.
+         * @param values The packed non-zero values.
+         * @param nnz The number of non-zeros.
+         */
+        void AssignSparse(const size_t *rowOffsets, const size_t *columnIndices, const char *values, const size_t nnz);
+
+        /**
+         * @brief Assign coordinate (COO) data to the resource.
+         * @param rows The row index of each non-zero.
+         * @param columns The column index of each non-zero.
+         * @param values The packed non-zero values.
+         * @param nnz The number of non-zeros; duplicate coordinates are not allowed.
+         */
+        void AssignCoordinates(const size_t *rows, const size_t *columns, const char *values, const size_t nnz);
+
+        /**
+         * @brief Get the number of non-zero elements.
+         * @return The non-zero count.
+         */
+        size_t GetNonZeroCount() const;
+
+        /**
+         * @brief Get the CSR row offsets.
+         * @return GetColumnSize() + 1 offsets into the non-zeros.
+         */
+        const std::pmr::vector<size_t> &GetRowOffsets() const;
+
+        /**
+         * @brief Get the CSR column indices.
+         * @return The column index of each non-zero.
+         */
+        const std::pmr::vector<size_t> &GetColumnIndices() const;
+
+        /**
+         * @brief Get the memory resource that the CSR arrays are allocated from.
+         * @return The memory resource.
+         */
+        std::pmr::memory_resource *GetMemoryResource() const;
+
+        /**
+         * @brief Access an element of the resource.
+         * @param i The row index.
+         * @param j The column index.
+         * @return A constant pointer to the element, or nullptr if the element is zero.
+         */
+        const void *At(const size_t i, const size_t j) const;
+
+        /**
+         * @brief Expand the resource into a dense buffer.
+         * @param buff The destination buffer of at least GetColumnSize() x GetRowSize() elements.
+         */
+        void CopyToDense(char *buff) const;
+
+    protected:
+        /**
+         * @brief Get the checksum of the CSR structure and values.
+         * @return The checksum value.
+         */
+        int Checksum() const override;
+
+    private:
+        /** @brief The CSR row offsets. */
+        std::pmr::vector<size_t> rowOffsets_;
+
+        /** @brief The CSR column indices. */
+        std::pmr::vector<size_t> columnIndices_;
+
+        /** @brief The packed non-zero values. */
+        std::pmr::vector<char> values_;
+    };
+
+} // end namespace resource
+
+#endif // end resource_sparseresource_h
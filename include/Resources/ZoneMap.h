@@ -0,0 +1,157 @@
+/**
+ * @file ZoneMap.h
+ * @brief Declaration of the ZoneMap class holding per-block statistics of a resource payload.
+ */
+
+#ifndef resource_zonemap_h
+#define resource_zonemap_h
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "Resources/config.h"
+#include "Resources/DataType.h"
+#include "Resources/ResourceStats.h"
+
+namespace resource
+{
+
+    /**
+     * @class ZoneMap
+     * @brief Statistics of every block of GetBlockSize() consecutive elements of a payload and of the payload as a whole.
+     *
+     * Lets scans skip resources, or blocks of a resource, whose values cannot fall within a range without reading
+     * the payload. The last block may be shorter. When part of a payload changes, Update() recomputes only the
+     * affected block.
+     */
+    class RESOURCE_DLL_EXPORT ZoneMap
+    {
+    public:
+        /**
+         * @brief Default constructor for the ZoneMap class; describes an empty payload.
+         */
+        ZoneMap();
+
+        /**
+         * @brief Destructor for the ZoneMap class.
+         */
+        virtual ~ZoneMap() noexcept;
+
+        /**
+         * @brief Copy constructor.
+         * @param other The ZoneMap instance to copy from.
+         */
+        ZoneMap(const ZoneMap &other);
+
+        /**
+         * @brief Copy assignment operator.
+         * @param other The ZoneMap instance to copy from.
+         * @return Reference to the updated ZoneMap instance.
+         */
+        ZoneMap &operator=(const ZoneMap &other);
+
+        /**
+         * @brief Move constructor.
+         * @param other The ZoneMap instance to move from.
+         */
+        ZoneMap(ZoneMap &&other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The ZoneMap instance to move from.
+         * @return Reference to the updated ZoneMap instance.
+         */
+        ZoneMap &operator=(ZoneMap &&other) noexcept;
+
+        /**
+         * @brief Compute the statistics of every block of a payload.
+         * @param data The payload.
+         * @param type The element type; must not be Unknown.
+         * @param count The number of elements.
+         * @param blockSize The number of elements per block; must not be 0.
+         * @return The zone map.
+         * @throw std::runtime_error If the element type is Unknown or the block size is 0.
+         */
+        static ZoneMap Build(const void *data, const DataType type, const size_t count, const size_t blockSize);
+
+        /**
+         * @brief Recompute the statistics of one block after its elements changed.
+         * @param block The index of the block.
+         * @param data The elements of the block.
+         * @param type The element type.
+         * @throw std::runtime_error If the block does not exist.
+         */
+        void Update(const size_t block, const void *data, const DataType type);
+
+        /**
+         * @brief Get the number of elements per block.
+         * @return The block size.
+         */
+        size_t GetBlockSize() const;
+
+        /**
+         * @brief Get the number of blocks.
+         * @return The block count.
+         */
+        size_t GetBlockCount() const;
+
+        /**
+         * @brief Get the statistics of a block.
+         * @param block The index of the block.
+         * @return The statistics.
+         */
+        const ResourceStats &GetBlock(const size_t block) const;
+
+        /**
+         * @brief Get the statistics of the whole payload.
+         * @return The statistics.
+         */
+        const ResourceStats &GetTotal() const;
+
+        /**
+         * @brief Find the blocks that may hold a value within a closed range.
+         * @param low The lower bound.
+         * @param high The upper bound.
+         * @return The indices of the blocks to read.
+         */
+        std::vector<size_t> FindBlocks(const double low, const double high) const;
+
+        /**
+         * @brief Get the size of the zone map once written.
+         * @return The size in bytes; a multiple of 8.
+         */
+        size_t GetSize() const;
+
+        /**
+         * @brief Write the block size, the block count, the total and every block.
+         * @param outFile The stream to write to.
+         */
+        void Write(std::ostream &outFile) const;
+
+        /**
+         * @brief Parse a zone map written by Write().
+         * @param buff The start of the zone map.
+         * @param size The number of bytes available.
+         * @return The zone map.
+         * @throw std::runtime_error If the zone map is truncated.
+         */
+        static ZoneMap Read(const char *buff, const size_t size);
+
+    private:
+        /** @brief The number of elements per block. */
+        size_t blockSize_{0};
+
+        /** @brief The number of elements. */
+        size_t count_{0};
+
+        /** @brief The statistics of the whole payload. */
+        ResourceStats total_;
+
+        /** @brief The statistics of each block. */
+        std::vector<ResourceStats> blocks_;
+    };
+
+} // end namespace resource
+
+#endif // end resource_zonemap_h
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "DatabaseAdapters/IPersistableResource.h"
+#include "Resources/Layout.h"
 
 template<typename T = int>
 class ContainerResource : public database_adapters::IPersistableResource
@@ -25,6 +26,13 @@ public:
 		SetColumnSize(1);
 	}
 
+	ContainerResource(const std::vector<size_t>& shape, const std::vector<T>& values, const resource::Layout& layout = resource::Layout()) :
+		data_(values)
+	{
+		SetShape(shape);
+		SetLayout(layout);
+	}
+
 	bool UpdateChecksumProtected() { return UpdateChecksum(); }
 	int ChecksumProtected() { return Checksum(); }
 
@@ -59,6 +67,11 @@ public:
 		return sizeof(T);
 	}
 
+	resource::DataType GetDataType() const override
+	{
+		return resource::DataTypeConverter::GetDataType<T>();
+	}
+
 private:
 	std::vector<T> data_;
 };
@@ -0,0 +1,41 @@
+#ifndef sparse_container_resource
+#define sparse_container_resource
+
+#include <memory_resource>
+#include <vector>
+
+#include "DatabaseAdapters/IPersistableResource.h"
+#include "Resources/SparseResource.h"
+
+template<typename T = int>
+class SparseContainerResource : 
+	public resource::SparseResource,
+	public database_adapters::IPersistableResource
+{
+public:
+	SparseContainerResource(std::pmr::memory_resource* memory = std::pmr::get_default_resource()) :
+		resource::SparseResource(memory)
+	{
+	}
+
+	SparseContainerResource(const size_t M, const size_t N, const std::vector<T>& dense)
+	{
+		SetColumnSize(M);
+		SetRowSize(N);
+		Assign(reinterpret_cast<const char*>(dense.data()), dense.size() * sizeof(T));
+	}
+
+	bool UpdateChecksumProtected() { return UpdateChecksum(); }
+
+	size_t GetElementSize() const override
+	{
+		return sizeof(T);
+	}
+
+	resource::DataType GetDataType() const override
+	{
+		return resource::DataTypeConverter::GetDataType<T>();
+	}
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef compressed_container_resource
+#define compressed_container_resource
+
+#include <vector>
+
+#include "DatabaseAdapters/IPersistableResource.h"
+#include "FilesystemAdapters/ISerializableResource.h"
+#include "Resources/Codec.h"
+#include "Resources/CompressedResource.h"
+
+template<typename T = int>
+class CompressedContainerResource : 
+	public resource::CompressedResource,
+	public filesystem_adapters::ISerializableResource,
+	public database_adapters::IPersistableResource
+{
+public:
+	CompressedContainerResource(const resource::Codec& codec = resource::Codec()) :
+		resource::CompressedResource(codec)
+	{
+	}
+
+	CompressedContainerResource(const std::vector<T>& values, const resource::Codec& codec = resource::Codec()) :
+		resource::CompressedResource(codec)
+	{
+		SetRowSize(values.size());
+		SetColumnSize(1);
+		Assign(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+	}
+
+	size_t GetElementSize() const override
+	{
+		return sizeof(T);
+	}
+
+	resource::DataType GetDataType() const override
+	{
+		return resource::DataTypeConverter::GetDataType<T>();
+	}
+};
+
+#endif
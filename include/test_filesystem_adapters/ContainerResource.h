@@ -6,6 +6,7 @@
 
 #include "DatabaseAdapters/IPersistableResource.h"
 #include "FilesystemAdapters/ISerializableResource.h"
+#include "Resources/Layout.h"
 
 template<typename T = int>
 class ContainerResource : 
@@ -28,6 +29,13 @@ public:
 		SetColumnSize(1);
 	}
 
+	ContainerResource(const std::vector<size_t>& shape, const std::vector<T>& values, const resource::Layout& layout = resource::Layout()) :
+		data_(values)
+	{
+		SetShape(shape);
+		SetLayout(layout);
+	}
+
 	bool UpdateChecksumProtected() { return UpdateChecksum(); }
 	int ChecksumProtected() { return Checksum(); }
 
@@ -62,6 +70,11 @@ public:
 		return sizeof(T);
 	}
 
+	resource::DataType GetDataType() const override
+	{
+		return resource::DataTypeConverter::GetDataType<T>();
+	}
+
 private:
 	std::vector<T> data_;
 };
@@ -101,6 +101,11 @@ public:
 		return sizeof(T);
 	}
 
+	resource::DataType GetDataType() const override
+	{
+		return resource::DataTypeConverter::GetDataType<T>();
+	}
+
 private:
 	std::vector<T> data_;
 };
@@ -0,0 +1,26 @@
+#ifndef mapped_container_resource
+#define mapped_container_resource
+
+#include "FilesystemAdapters/MappedResource.h"
+
+template<typename T = int>
+class MappedContainerResource : public filesystem_adapters::MappedResource
+{
+public:
+	MappedContainerResource(const filesystem_adapters::MapMode mode = filesystem_adapters::MapMode::ReadOnly) :
+		filesystem_adapters::MappedResource(mode)
+	{
+	}
+
+	size_t GetElementSize() const override
+	{
+		return sizeof(T);
+	}
+
+	resource::DataType GetDataType() const override
+	{
+		return resource::DataTypeConverter::GetDataType<T>();
+	}
+};
+
+#endif
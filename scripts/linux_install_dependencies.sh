@@ -14,6 +14,7 @@ PKGS=(
 
   # — Compression & archiving
   zlib1g-dev libbz2-dev liblzma-dev xz-utils
+  liblz4-dev libzstd-dev
 
   # — Scripting & data backends
   libreadline-dev    # readline for interactive shells
@@ -1,4 +1,7 @@
 #!/bin/bash
 
 # — Build & SCM tools
-brew install cmake ninja autoconf automake autoconf-archive libtool pkg-config
\ No newline at end of file
+brew install cmake ninja autoconf automake autoconf-archive libtool pkg-config
+
+# — Compression codecs of CompressedResource
+brew install lz4 zstd
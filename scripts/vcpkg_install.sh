@@ -34,11 +34,12 @@ vcpkg install --classic \
   gtest \
   libffi \
   liblzma \
+  lz4 \
+  zstd \
   openssl \
   python3 \
   sqlite3 \
   zlib \
-  zstd \
   cpprestsdk \
   --triplet "${TRIPLET}"
 
@@ -0,0 +1,173 @@
+#include "DatabaseAdapters/BlobChunkStore.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DatabaseAdapters/DeltaChain.h"
+#include "DatabaseAdapters/ResourceTable.h"
+#include "DatabaseAdapters/Sqlite.h"
+#include "DatabaseAdapters/SqliteBlob.h"
+#include "Resources/DataType.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceStats.h"
+#include "Resources/ZoneMap.h"
+
+using database_adapters::BlobChunkStore;
+using database_adapters::DeltaChain;
+using database_adapters::Sqlite;
+using database_adapters::SqliteBlob;
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::LayoutType;
+using resource::ResourceStats;
+using resource::ZoneMap;
+using namespace database_adapters::resource_table;
+
+BlobChunkStore::BlobChunkStore(Sqlite &db, const std::string_view key) : db_(db)
+{
+	if (key.empty())
+		throw std::runtime_error("Key is empty when opening chunk store");
+	if (!db_.IsOpen())
+		throw std::runtime_error("Cannot open chunk store because the database is not open");
+
+	const std::string sql = "SELECT " + ROW_KEY + ", " + M_KEY + ", " + N_KEY + ", " + NNZ_KEY + ", " + SHAPE_KEY + ", " + LAYOUT_KEY + ", " + DTYPE_KEY + ", length(" + DATA_KEY + ") FROM " + TABLE_NAME + " WHERE " + P_KEY + " = '" + std::string(key) + "';";
+
+	bool isSparse = false;
+	LayoutType layout = LayoutType::RowMajor;
+	std::function<int(int, char **, char **)> rowHandler =
+		[this, &isSparse, &layout](int numCols, char **colValues, char **colNames)
+	{
+		iRow_ = std::stoll(std::string(colValues[0]));
+		shape_ = {std::stoull(std::string(colValues[1])), std::stoull(std::string(colValues[2]))};
+		isSparse = colValues[3] != nullptr;
+		if (colValues[4] != nullptr)
+		{
+			shape_ = SplitExtents(colValues[4]);
+			layout = static_cast<LayoutType>(std::stoul(std::string(colValues[5])));
+		}
+		if (colValues[6] != nullptr)
+			dataType_ = static_cast<DataType>(std::stoul(std::string(colValues[6])));
+		size_ = colValues[7] != nullptr ? std::stoull(std::string(colValues[7])) : 0;
+		return 0;
+	};
+
+	db_.Execute(sql, rowHandler);
+
+	if (iRow_ < 0)
+		throw std::runtime_error("Cannot open chunk store because resource " + std::string(key) + " was not persisted");
+	if (isSparse)
+		throw std::runtime_error("Cannot chunk sparse resource " + std::string(key));
+	if (layout != LayoutType::RowMajor)
+		throw std::runtime_error("Cannot chunk resource " + std::string(key) + " because it is not row-major");
+	// the blob of a delta row is not the payload
+	if (db_.HasColumn(TABLE_NAME, DELTA_BASE_KEY) && DeltaChain(db_, iRow_).GetLength() > 0)
+		throw std::runtime_error("Cannot chunk resource " + std::string(key) + " because it was persisted as a delta");
+
+	// quantized elements need their scale and offset to be read back
+	bool isQuantized = false;
+	std::function<int(int, char **, char **)> quantizationHandler =
+		[&isQuantized](int numCols, char **colValues, char **colNames)
+	{
+		isQuantized = colValues[0] != nullptr;
+		return 0;
+	};
+	if (db_.HasColumn(TABLE_NAME, QUANT_SCALE_KEY))
+		db_.Execute("SELECT " + QUANT_SCALE_KEY + " FROM " + TABLE_NAME + " WHERE " + ROW_KEY + " = " + std::to_string(iRow_) + ";", quantizationHandler);
+	if (isQuantized)
+		throw std::runtime_error("Cannot chunk resource " + std::string(key) + " because it was persisted quantized");
+
+	// rows persisted with statistics keep them current as chunks are written back
+	std::function<int(int, char **, char **)> zoneMapHandler =
+		[this](int numCols, char **colValues, char **colNames)
+	{
+		zoneMapSize_ = colValues[0] != nullptr ? std::stoull(std::string(colValues[0])) : 0;
+		return 0;
+	};
+	if (db_.HasColumn(TABLE_NAME, ZONE_MAP_KEY))
+		db_.Execute("SELECT length(" + ZONE_MAP_KEY + ") FROM " + TABLE_NAME + " WHERE " + ROW_KEY + " = " + std::to_string(iRow_) + ";", zoneMapHandler);
+}
+
+BlobChunkStore::~BlobChunkStore() noexcept = default;
+
+std::vector<size_t> BlobChunkStore::GetShape() const
+{
+	return shape_;
+}
+
+DataType BlobChunkStore::GetDataType() const
+{
+	return dataType_;
+}
+
+size_t BlobChunkStore::GetSize() const
+{
+	return size_;
+}
+
+void BlobChunkStore::Read(const size_t offset, char *buff, const size_t n)
+{
+	if (offset + n > size_)
+		throw std::runtime_error("BlobChunkStore cannot read past the end of the blob");
+
+	SqliteBlob sqliteBlob(db_);
+	sqliteBlob.Open(TABLE_NAME, DATA_KEY, iRow_);
+	sqliteBlob.Read(buff, n, static_cast<int>(offset));
+}
+
+void BlobChunkStore::Write(const size_t offset, const char *buff, const size_t n)
+{
+	if (offset + n > size_)
+		throw std::runtime_error("BlobChunkStore cannot write past the end of the blob");
+
+	SqliteBlob sqliteBlob(db_);
+	sqliteBlob.Open(TABLE_NAME, DATA_KEY, iRow_);
+	sqliteBlob.Write(buff, n, static_cast<int>(offset));
+
+	// FindKeys prunes by the statistics, so they must keep covering the new values
+	if (zoneMapSize_ > 0 && n > 0)
+		UpdateZoneMap(offset, n);
+}
+
+void BlobChunkStore::UpdateZoneMap(const size_t offset, const size_t n)
+{
+	ZoneMap zoneMap;
+	{
+		SqliteBlob zoneMapBlob(db_);
+		zoneMapBlob.Open(TABLE_NAME, ZONE_MAP_KEY, iRow_);
+		const std::vector<char> stored = zoneMapBlob.Read(zoneMapSize_, 0);
+		zoneMap = ZoneMap::Read(stored.data(), stored.size());
+	}
+
+	const size_t blockBytes = zoneMap.GetBlockSize() * DataTypeConverter::GetSize(dataType_);
+	std::vector<char> block(blockBytes);
+	for (size_t i = offset / blockBytes; i * blockBytes < offset + n; ++i)
+	{
+		const size_t blockSize = std::min(blockBytes, size_ - i * blockBytes);
+		Read(i * blockBytes, block.data(), blockSize);
+		zoneMap.Update(i, block.data(), dataType_);
+	}
+
+	// the block count is unchanged, so the zone map is rewritten in place
+	{
+		std::ostringstream outStream(std::ios::binary);
+		zoneMap.Write(outStream);
+		const std::string bytes = outStream.str();
+		SqliteBlob zoneMapBlob(db_);
+		zoneMapBlob.Open(TABLE_NAME, ZONE_MAP_KEY, iRow_);
+		zoneMapBlob.Write(bytes.data(), bytes.size(), 0);
+	}
+
+	const ResourceStats &stats = zoneMap.GetTotal();
+	db_.Execute("UPDATE " + TABLE_NAME + " SET " +
+				STAT_MIN_KEY + " = " + RealValue(stats.GetMin()) + ", " +
+				STAT_MAX_KEY + " = " + RealValue(stats.GetMax()) + ", " +
+				STAT_SUM_KEY + " = " + RealValue(stats.GetSum()) + ", " +
+				STAT_COUNT_KEY + " = " + std::to_string(stats.GetCount()) + ", " +
+				STAT_NAN_KEY + " = " + std::to_string(stats.GetNaNCount()) +
+				" WHERE " + ROW_KEY + " = " + std::to_string(iRow_) + ";");
+}
@@ -0,0 +1,83 @@
+#include "DatabaseAdapters/DeltaChain.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DatabaseAdapters/ResourceTable.h"
+#include "DatabaseAdapters/Sqlite.h"
+#include "DatabaseAdapters/SqliteBlob.h"
+#include "Resources/DeltaCodec.h"
+
+using database_adapters::DeltaChain;
+using database_adapters::Sqlite;
+using database_adapters::SqliteBlob;
+using resource::DeltaCodec;
+using namespace database_adapters::resource_table;
+
+DeltaChain::DeltaChain(Sqlite &db, const sqlite3_int64 iRow) : db_(db)
+{
+	sqlite3_int64 row = iRow;
+	while (true)
+	{
+		const std::string sql = "SELECT " + DELTA_BASE_KEY + ", length(" + DATA_KEY + ") FROM " + TABLE_NAME + " WHERE " + ROW_KEY + " = " + std::to_string(row) + ";";
+
+		bool found = false;
+		sqlite3_int64 base = -1;
+		size_t size = 0;
+		std::function<int(int, char **, char **)> rowHandler =
+			[&found, &base, &size](int numCols, char **colValues, char **colNames)
+		{
+			found = true;
+			base = colValues[0] != nullptr ? std::stoll(std::string(colValues[0])) : -1;
+			size = colValues[1] != nullptr ? std::stoull(std::string(colValues[1])) : 0;
+			return 0;
+		};
+		db_.Execute(sql, rowHandler);
+
+		if (!found)
+			throw std::runtime_error("DeltaChain row does not exist: " + std::to_string(row));
+		// deltas only ever refer to earlier rows, which rules out cycles
+		if (base >= row)
+			throw std::runtime_error("DeltaChain row refers to a later row: " + std::to_string(row));
+
+		rows_.push_back(row);
+		sizes_.push_back(size);
+		if (base < 0)
+			break;
+		row = base;
+	}
+
+	std::reverse(rows_.begin(), rows_.end());
+	std::reverse(sizes_.begin(), sizes_.end());
+}
+
+DeltaChain::~DeltaChain() noexcept = default;
+
+size_t DeltaChain::GetLength() const
+{
+	return rows_.size() - 1;
+}
+
+std::vector<char> DeltaChain::Read() const
+{
+	std::vector<char> payload;
+	for (size_t i = 0; i < rows_.size(); ++i)
+	{
+		std::vector<char> blob(sizes_[i]);
+		if (!blob.empty())
+		{
+			SqliteBlob sqliteBlob(db_);
+			sqliteBlob.Open(TABLE_NAME, DATA_KEY, rows_[i]);
+			sqliteBlob.Read(blob.data(), blob.size(), 0);
+		}
+
+		if (i == 0)
+			payload.swap(blob);
+		else
+			payload = DeltaCodec::Apply(payload.data(), payload.size(), blob.data(), blob.size());
+	}
+	return payload;
+}
@@ -1,30 +1,43 @@
 #include "DatabaseAdapters/ResourceLoader.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include "Config/filesystem.hpp"
 
+#include "DatabaseAdapters/DeltaChain.h"
 #include "DatabaseAdapters/IPersistableResource.h"
+#include "DatabaseAdapters/ResourceTable.h"
 #include "DatabaseAdapters/Sqlite.h"
 #include "DatabaseAdapters/SqliteBlob.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/SparseResource.h"
+#include "Resources/ZoneMap.h"
 
+using database_adapters::DeltaChain;
+using database_adapters::CreateResourceTable;
 using database_adapters::IPersistableResource;
 using database_adapters::ResourceLoader;
 using database_adapters::Sqlite;
 using database_adapters::SqliteBlob;
-
-namespace
-{
-	const std::string TABLE_NAME = "resources";
-	const std::string ROW_KEY = "row";
-	const std::string P_KEY = "resource_key";
-	const std::string M_KEY = "m";
-	const std::string N_KEY = "n";
-	const std::string SIZE_OF_KEY = "sizeof";
-	const std::string DATA_KEY = "data";
-}
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::Encoding;
+using resource::Layout;
+using resource::LayoutType;
+using resource::Quantization;
+using resource::SparseResource;
+using resource::ZoneMap;
+using namespace database_adapters::resource_table;
 
 ResourceLoader *ResourceLoader::instance_ = nullptr;
 
@@ -61,17 +74,7 @@ void ResourceLoader::OpenDatabase(const Path &dbPath)
 		throw std::runtime_error("ResourceLoader already has a database set");
 	databaseAdapter_.Open(dbPath);
 
-	std::string sql = "CREATE TABLE IF NOT EXISTS " + TABLE_NAME + " (" +
-					  ROW_KEY + " INTEGER PRIMARY KEY AUTOINCREMENT, " +
-					  P_KEY + " TEXT NOT NULL, " +
-					  M_KEY + " INTEGER, " +
-					  N_KEY + " INTEGER, " +
-					  SIZE_OF_KEY + " INTEGER, " +
-					  DATA_KEY + " BLOB);";
-
-	sql += " PRAGMA auto_vacuum = FULL;";
-
-	databaseAdapter_.Execute(sql);
+	CreateResourceTable(databaseAdapter_);
 }
 
 Sqlite &ResourceLoader::GetDatabase()
@@ -99,7 +102,7 @@ void ResourceLoader::UnregisterAll()
 	keyToResourceMap_.clear();
 }
 
-std::unique_ptr<IPersistableResource> ResourceLoader::Load(const std::string_view key)
+std::unique_ptr<IPersistableResource> ResourceLoader::Load(const std::string_view key, std::pmr::memory_resource *memory)
 {
 	if (key.empty())
 		throw std::runtime_error("Key is empty when loading resource with ResourceLoader");
@@ -107,45 +110,220 @@ std::unique_ptr<IPersistableResource> ResourceLoader::Load(const std::string_vie
 	if (!databaseAdapter_.IsOpen())
 		throw std::runtime_error("Cannot load resource because the database is not open");
 
-	const std::string sql = "SELECT " + P_KEY + ", " + ROW_KEY + ", " + M_KEY + ", " + N_KEY + ", " + SIZE_OF_KEY + " FROM " + TABLE_NAME + " WHERE " + P_KEY + " = '" + std::string(key) + "';";
+	const std::string sql = "SELECT " + P_KEY + ", " + ROW_KEY + ", " + M_KEY + ", " + N_KEY + ", " + SIZE_OF_KEY + ", " + NNZ_KEY + ", " + SHAPE_KEY + ", " + LAYOUT_KEY + ", " + TILE_KEY + ", " + DTYPE_KEY + ", " + DELTA_BASE_KEY + ", " + QUANT_SCALE_KEY + ", " + QUANT_OFFSET_KEY + " FROM " + TABLE_NAME + " WHERE " + P_KEY + " = '" + std::string(key) + "';";
 
 	int iRow = -1;
 	size_t m, n, sizeOf;
+	bool isSparse = false;
+	size_t nnz = 0;
+	boost::optional<std::vector<size_t>> shape;
+	Layout layout;
+	DataType dataType = DataType::Unknown;
+	bool isDelta = false;
+	boost::optional<Quantization> quantization;
 	std::function<int(int, char **, char **)> PKeyHandler =
-		[&iRow, &m, &n, &sizeOf](int numCols, char **colValues, char **colNames)
+		[&iRow, &m, &n, &sizeOf, &isSparse, &nnz, &shape, &layout, &dataType, &isDelta, &quantization](int numCols, char **colValues, char **colNames)
 	{
 		iRow = std::stoi(std::string(colValues[1]));
 		m = std::stoi(std::string(colValues[2]));
 		n = std::stoi(std::string(colValues[3]));
 		sizeOf = std::stoi(std::string(colValues[4]));
+		isSparse = colValues[5] != nullptr;
+		if (isSparse)
+			nnz = std::stoull(std::string(colValues[5]));
+		if (colValues[6] != nullptr)
+		{
+			shape = SplitExtents(colValues[6]);
+			const auto type = static_cast<LayoutType>(std::stoul(std::string(colValues[7])));
+			layout = Layout::Make(type, colValues[8] != nullptr ? SplitExtents(colValues[8]) : std::vector<size_t>());
+		}
+		if (colValues[9] != nullptr)
+			dataType = static_cast<DataType>(std::stoul(std::string(colValues[9])));
+		isDelta = colValues[10] != nullptr;
+		quantization = boost::none;
+		if (colValues[11] != nullptr)
+			quantization = Quantization{std::stod(std::string(colValues[11])), std::stod(std::string(colValues[12]))};
 		return 0;
 	};
 
 	databaseAdapter_.Execute(sql, PKeyHandler);
 
-	// TODO not very efficient since here we do a second query to DB
-	SqliteBlob sqliteBlob(GetDatabase());
-	sqliteBlob.Open(TABLE_NAME, DATA_KEY, iRow);
+	std::unique_ptr<IPersistableResource> resource = GenerateResource(key, memory);
+	if (iRow < 0)
+		throw std::runtime_error("Cannot load resource " + std::string(key) + " because it was not persisted");
+	if (auto sparse = dynamic_cast<SparseResource *>(resource.get()))
+	{
+		if (quantization)
+			throw std::runtime_error("Cannot load quantized resource " + std::string(key) + " into a sparse resource");
+		resource->SetColumnSize(m);
+		resource->SetRowSize(n);
+		LoadSparse(*sparse, iRow, isSparse ? boost::optional<size_t>(nnz) : boost::none, dataType, isDelta, memory);
+		return resource;
+	}
+	if (isSparse)
+		throw std::runtime_error("Cannot load sparse resource " + std::string(key) + " into a dense resource");
 
 	size_t size = m * n * sizeOf;
-	std::vector<char> blob = sqliteBlob.Read(size, 0);
+	std::pmr::vector<char> blob(size, memory);
+	ReadDense(iRow, isDelta, blob);
 
-	std::unique_ptr<IPersistableResource> resource = GenerateResource(key);
-	resource->SetRowSize(m);
-	resource->SetColumnSize(n);
+	// payloads stored with another element type are converted to the type of the resource
+	if (quantization)
+	{
+		size = m * n * DataTypeConverter::GetSize(resource->GetDataType());
+		std::pmr::vector<char> values(size, memory);
+		Encoding::Dequantize(blob.data(), dataType, values.data(), resource->GetDataType(), m * n, *quantization);
+		blob.swap(values);
+	}
+	else if (DataTypeConverter::RequiresConversion(dataType, resource->GetDataType()))
+	{
+		size = m * n * DataTypeConverter::GetSize(resource->GetDataType());
+		std::pmr::vector<char> converted(size, memory);
+		DataTypeConverter::Convert(blob.data(), dataType, converted.data(), resource->GetDataType(), m * n);
+		blob.swap(converted);
+	}
+
+	// rows with a persisted shape are restored exactly; plain matrices keep their historic dimensions
+	if (shape)
+	{
+		resource->SetShape(*shape);
+		resource->SetLayout(layout);
+	}
+	else
+	{
+		resource->SetRowSize(m);
+		resource->SetColumnSize(n);
+	}
 	resource->Assign(blob.data(), size);
 
 	return resource;
 }
 
-std::unique_ptr<IPersistableResource> ResourceLoader::GenerateResource(const std::string_view key) const
+void ResourceLoader::ReadDense(const int iRow, const bool isDelta, std::pmr::vector<char> &blob)
+{
+	if (!isDelta)
+	{
+		// TODO not very efficient since here we do a second query to DB
+		SqliteBlob sqliteBlob(GetDatabase());
+		sqliteBlob.Open(TABLE_NAME, DATA_KEY, iRow);
+		sqliteBlob.Read(blob.data(), blob.size(), 0);
+		return;
+	}
+
+	const std::vector<char> payload = DeltaChain(GetDatabase(), iRow).Read();
+	if (payload.size() != blob.size())
+		throw std::runtime_error("Delta row " + std::to_string(iRow) + " does not rebuild a payload of its shape");
+	std::copy(payload.cbegin(), payload.cend(), blob.begin());
+}
+
+void ResourceLoader::LoadSparse(SparseResource &sparse, const int iRow, const boost::optional<size_t> nnz, const DataType dataType, const bool isDelta, std::pmr::memory_resource *memory)
+{
+	const size_t m = sparse.GetColumnSize();
+	const size_t n = sparse.GetRowSize();
+	const bool convert = DataTypeConverter::RequiresConversion(dataType, sparse.GetDataType());
+	const size_t storedSize = convert ? DataTypeConverter::GetSize(dataType) : sparse.GetElementSize();
+
+	// rows persisted densely are converted on assignment
+	if (!nnz)
+	{
+		std::pmr::vector<char> blob(m * n * storedSize, memory);
+		ReadDense(iRow, isDelta, blob);
+		if (convert)
+		{
+			std::pmr::vector<char> converted(m * n * sparse.GetElementSize(), memory);
+			DataTypeConverter::Convert(blob.data(), dataType, converted.data(), sparse.GetDataType(), m * n);
+			blob.swap(converted);
+		}
+		sparse.Assign(blob.data(), blob.size());
+		return;
+	}
+
+	// the blob holds the M + 1 row offsets, then the nnz column indices, then the nnz values
+	const size_t offsetsBytes = (m + 1) * sizeof(size_t);
+	const size_t indicesBytes = *nnz * sizeof(size_t);
+	const size_t valuesBytes = *nnz * storedSize;
+	std::pmr::vector<char> blob(offsetsBytes + indicesBytes + valuesBytes, memory);
+	SqliteBlob sqliteBlob(GetDatabase());
+	sqliteBlob.Open(TABLE_NAME, DATA_KEY, iRow);
+	sqliteBlob.Read(blob.data(), blob.size(), 0);
+
+	std::pmr::vector<size_t> rowOffsets(m + 1, memory);
+	std::memcpy(rowOffsets.data(), blob.data(), offsetsBytes);
+	std::pmr::vector<size_t> columnIndices(*nnz, memory);
+	std::memcpy(columnIndices.data(), blob.data() + offsetsBytes, indicesBytes);
+
+	const char *values = blob.data() + offsetsBytes + indicesBytes;
+	std::pmr::vector<char> converted(memory);
+	if (convert)
+	{
+		converted.resize(*nnz * sparse.GetElementSize());
+		DataTypeConverter::Convert(values, dataType, converted.data(), sparse.GetDataType(), *nnz);
+		values = converted.data();
+	}
+
+	sparse.AssignSparse(rowOffsets.data(), columnIndices.data(), values, *nnz);
+}
+
+std::vector<std::string> ResourceLoader::FindKeys(const double low, const double high)
+{
+	if (!databaseAdapter_.IsOpen())
+		throw std::runtime_error("Cannot find resources because the database is not open");
+
+	// rows without statistics have NULL bounds and never match; an infinite bound excludes only them
+	const std::string upper = high == std::numeric_limits<double>::infinity() ? STAT_MIN_KEY + " IS NOT NULL" : STAT_MIN_KEY + " <= " + RealValue(high);
+	const std::string lower = low == -std::numeric_limits<double>::infinity() ? STAT_MAX_KEY + " IS NOT NULL" : STAT_MAX_KEY + " >= " + RealValue(low);
+	const std::string sql = "SELECT DISTINCT " + P_KEY + " FROM " + TABLE_NAME + " WHERE " + upper + " AND " + lower + " ORDER BY " + P_KEY + ";";
+
+	std::vector<std::string> keys;
+	std::function<int(int, char **, char **)> KeyHandler =
+		[&keys](int numCols, char **colValues, char **colNames)
+	{
+		keys.emplace_back(colValues[0]);
+		return 0;
+	};
+
+	databaseAdapter_.Execute(sql, KeyHandler);
+	return keys;
+}
+
+boost::optional<ZoneMap> ResourceLoader::LoadZoneMap(const std::string_view key)
+{
+	if (key.empty())
+		throw std::runtime_error("Key is empty when loading zone map with ResourceLoader");
+
+	if (!databaseAdapter_.IsOpen())
+		throw std::runtime_error("Cannot load zone map because the database is not open");
+
+	const std::string sql = "SELECT " + ROW_KEY + ", length(" + ZONE_MAP_KEY + ") FROM " + TABLE_NAME + " WHERE " + P_KEY + " = '" + std::string(key) + "';";
+
+	int iRow = -1;
+	boost::optional<size_t> size;
+	std::function<int(int, char **, char **)> PKeyHandler =
+		[&iRow, &size](int numCols, char **colValues, char **colNames)
+	{
+		iRow = std::stoi(std::string(colValues[0]));
+		size = colValues[1] != nullptr ? boost::optional<size_t>(std::stoull(std::string(colValues[1]))) : boost::none;
+		return 0;
+	};
+
+	databaseAdapter_.Execute(sql, PKeyHandler);
+	if (!size)
+		return boost::none;
+
+	SqliteBlob sqliteBlob(GetDatabase());
+	sqliteBlob.Open(TABLE_NAME, ZONE_MAP_KEY, iRow);
+	const std::vector<char> blob = sqliteBlob.Read(*size, 0);
+	return ZoneMap::Read(blob.data(), blob.size());
+}
+
+std::unique_ptr<IPersistableResource> ResourceLoader::GenerateResource(const std::string_view key, std::pmr::memory_resource *memory) const
 {
 	if (key.empty())
 		throw std::runtime_error("Key is empty when generating resource with ResourceLoader");
 	if (keyToResourceMap_.find(key) == keyToResourceMap_.cend())
 		throw std::runtime_error("Key is not registered with the ResourceLoader");
 
-	std::unique_ptr<IPersistableResource> resource = keyToResourceMap_[std::string(key)]();
+	std::unique_ptr<IPersistableResource> resource = keyToResourceMap_[std::string(key)](memory);
 
 	return resource;
 }
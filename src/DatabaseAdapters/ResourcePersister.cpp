@@ -1,28 +1,89 @@
 #include "DatabaseAdapters/ResourcePersister.h"
 
+#include <functional>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include "Config/filesystem.hpp"
 
+#include "DatabaseAdapters/DeltaChain.h"
 #include "DatabaseAdapters/IPersistableResource.h"
+#include "DatabaseAdapters/ResourceTable.h"
 #include "DatabaseAdapters/Sqlite.h"
 #include "DatabaseAdapters/SqliteBlob.h"
+#include "Resources/DataType.h"
+#include "Resources/DeltaCodec.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceStats.h"
+#include "Resources/SparseResource.h"
+#include "Resources/ResourceView.h"
+#include "Resources/ZoneMap.h"
 
+using database_adapters::CreateResourceTable;
+using database_adapters::DeltaChain;
 using database_adapters::IPersistableResource;
 using database_adapters::ResourcePersister;
 using database_adapters::Sqlite;
 using database_adapters::SqliteBlob;
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::DeltaCodec;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::Layout;
+using resource::Quantization;
+using resource::ResourceStats;
+using resource::SparseResource;
+using resource::ResourceView;
+using resource::ZoneMap;
+using namespace database_adapters::resource_table;
 
 namespace
 {
-	const std::string TABLE_NAME = "resources";
-	const std::string ROW_KEY = "row";
-	const std::string P_KEY = "resource_key";
-	const std::string M_KEY = "m";
-	const std::string N_KEY = "n";
-	const std::string SIZE_OF_KEY = "sizeof";
-	const std::string DATA_KEY = "data";
+	// untagged element types are stored as NULL
+	std::string DataTypeValue(const DataType dataType)
+	{
+		return dataType == DataType::Unknown ? "NULL" : std::to_string(static_cast<uint32_t>(dataType));
+	}
+
+	// a row whose blob is reserved and then written in place must not be left behind half written
+	void RunInTransaction(Sqlite &db, const std::function<void()> &statements)
+	{
+		db.Execute("BEGIN;");
+		try
+		{
+			statements();
+		}
+		catch (...)
+		{
+			db.Execute("ROLLBACK;");
+			throw;
+		}
+		db.Execute("COMMIT;");
+	}
+
+	// zone maps are stored as blob literals, e.g. X'0a00'
+	std::string BlobValue(const ZoneMap &zoneMap)
+	{
+		std::ostringstream outStream(std::ios::binary);
+		zoneMap.Write(outStream);
+		const std::string bytes = outStream.str();
+
+		static const char DIGITS[] = "0123456789abcdef";
+		std::string text = "X'";
+		text.reserve(bytes.size() * 2 + 3);
+		for (unsigned char byte : bytes)
+		{
+			text += DIGITS[byte >> 4];
+			text += DIGITS[byte & 0x0f];
+		}
+		return text + "'";
+	}
 }
 
 ResourcePersister *ResourcePersister::instance_ = nullptr;
@@ -55,17 +116,7 @@ void ResourcePersister::OpenDatabase(const Path &dbPath)
 		throw std::runtime_error("ResourcePersister already has a database open");
 	databaseAdapter_.Open(dbPath);
 
-	std::string sql = "CREATE TABLE IF NOT EXISTS " + TABLE_NAME + " (" +
-					  ROW_KEY + " INTEGER PRIMARY KEY AUTOINCREMENT, " +
-					  P_KEY + " TEXT NOT NULL, " +
-					  M_KEY + " INTEGER, " +
-					  N_KEY + " INTEGER, " +
-					  SIZE_OF_KEY + " INTEGER, " +
-					  DATA_KEY + " BLOB);";
-
-	sql += " PRAGMA auto_vacuum = FULL;";
-
-	databaseAdapter_.Execute(sql);
+	CreateResourceTable(databaseAdapter_);
 }
 
 void ResourcePersister::CloseDatabase()
@@ -90,14 +141,206 @@ void ResourcePersister::Persist(const IPersistableResource &resource, const std:
 	if (!databaseAdapter_.IsOpen())
 		throw std::runtime_error("Cannot persist resource because the database is not open");
 
+	if (auto sparse = dynamic_cast<const SparseResource *>(&resource))
+	{
+		PersistSparse(*sparse, key);
+		return;
+	}
+
+	// encoded payloads are stored with the element type and size of the encoding
+	const Encoding encoding = GetEncoding(key);
+	const DataType storedType = encoding.GetStoredType(resource.GetDataType());
+	const size_t count = resource.GetColumnSize() * resource.GetRowSize();
 	const std::string M = std::to_string(resource.GetColumnSize());
 	const std::string N = std::to_string(resource.GetRowSize());
-	const std::string SIZE_OF = std::to_string(resource.GetElementSize());
+	const std::string SIZE_OF = std::to_string(encoding.AppliesTo(resource.GetDataType()) ? DataTypeConverter::GetSize(storedType) : resource.GetElementSize());
+
+	// plain row-major matrices leave the shape and layout columns NULL
+	std::string columns = P_KEY + "," + M_KEY + "," + N_KEY + "," + SIZE_OF_KEY + "," + DTYPE_KEY;
+	std::string values = "'" + std::string(key) + "'," + M + "," + N + "," + SIZE_OF + "," + DataTypeValue(storedType);
+	const Layout &layout = resource.GetLayout();
+	if (resource.GetRank() != 2 || !(layout == Layout::RowMajor()))
+	{
+		columns += "," + SHAPE_KEY + "," + LAYOUT_KEY;
+		values += ",'" + JoinExtents(resource.GetShape()) + "'," + std::to_string(static_cast<uint32_t>(layout.GetType()));
+		if (!layout.GetTileShape().empty())
+		{
+			columns += "," + TILE_KEY;
+			values += ",'" + JoinExtents(layout.GetTileShape()) + "'";
+		}
+	}
+
+	// statistics let loaders find rows by value range without reading the payload
+	if (zoneMapBlockSize_ > 0 && resource.GetDataType() != DataType::Unknown)
+	{
+		const ZoneMap zoneMap = ZoneMap::Build(resource.Data(), resource.GetDataType(), resource.GetColumnSize() * resource.GetRowSize(), zoneMapBlockSize_);
+		const ResourceStats &stats = zoneMap.GetTotal();
+		columns += "," + STAT_MIN_KEY + "," + STAT_MAX_KEY + "," + STAT_SUM_KEY + "," + STAT_COUNT_KEY + "," + STAT_NAN_KEY + "," + ZONE_MAP_KEY;
+		values += "," + RealValue(stats.GetMin()) + "," + RealValue(stats.GetMax()) + "," + RealValue(stats.GetSum()) + "," +
+				  std::to_string(stats.GetCount()) + "," + std::to_string(stats.GetNaNCount()) + "," + BlobValue(zoneMap);
+	}
+
+	const char *payload = static_cast<const char *>(resource.Data());
+	size_t size = resource.GetElementSize() * count;
+	std::vector<char> encoded;
+	if (encoding.AppliesTo(resource.GetDataType()))
+	{
+		const Quantization quantization = encoding.Fit(payload, resource.GetDataType(), count);
+		encoded.resize(count * DataTypeConverter::GetSize(storedType));
+		encoding.Encode(payload, resource.GetDataType(), encoded.data(), count, quantization);
+		payload = encoded.data();
+		size = encoded.size();
+		if (encoding.IsQuantized())
+		{
+			columns += "," + QUANT_SCALE_KEY + "," + QUANT_OFFSET_KEY;
+			values += "," + RealValue(quantization.scale) + "," + RealValue(quantization.offset);
+		}
+	}
+
+	// while the chain is short, only what changed since the latest row of the key is stored
+	const sqlite3_int64 latestRow = deltaChainLength_ > 0 ? GetLatestDenseRow(key) : -1;
+	if (latestRow >= 0)
+	{
+		const DeltaChain chain(databaseAdapter_, latestRow);
+		if (chain.GetLength() < deltaChainLength_)
+		{
+			const std::vector<char> previous = chain.Read();
+			const std::vector<char> delta = DeltaCodec::Encode(previous.data(), previous.size(), payload, size);
+			if (delta.size() <= size / 2)
+			{
+				const std::string sql = "INSERT INTO " + TABLE_NAME + " (" + columns + "," + DELTA_BASE_KEY + "," + DATA_KEY + ") VALUES (" + values + "," + std::to_string(latestRow) + ",?);";
+				SqliteBlob::InsertBlob(databaseAdapter_, sql, delta.data(), delta.size());
+				return;
+			}
+		}
+	}
+
+	const std::string sql = "INSERT INTO " + TABLE_NAME + " (" + columns + "," + DATA_KEY + ") VALUES (" + values + ",?);";
+	SqliteBlob::InsertBlob(databaseAdapter_, sql, payload, size);
+}
+
+sqlite3_int64 ResourcePersister::GetLatestDenseRow(const std::string_view key)
+{
+	const std::string sql = "SELECT " + ROW_KEY + ", " + NNZ_KEY + " FROM " + TABLE_NAME + " WHERE " + P_KEY + " = '" + std::string(key) + "' ORDER BY " + ROW_KEY + " DESC LIMIT 1;";
 
-	const std::string sql = "INSERT INTO " + TABLE_NAME + " (" + P_KEY + "," + M_KEY + "," + N_KEY + "," + SIZE_OF_KEY + "," + DATA_KEY + ") VALUES ('" + std::string(key) + "'," + M + "," + N + "," + SIZE_OF + ",?);";
-	const size_t size = resource.GetElementSize() * resource.GetColumnSize() * resource.GetRowSize();
+	sqlite3_int64 iRow = -1;
+	std::function<int(int, char **, char **)> rowHandler =
+		[&iRow](int numCols, char **colValues, char **colNames)
+	{
+		// sparse rows cannot serve as the base of a dense delta
+		if (colValues[1] == nullptr)
+			iRow = std::stoll(std::string(colValues[0]));
+		return 0;
+	};
 
-	SqliteBlob::InsertBlob(databaseAdapter_, sql, resource.Data(), size);
+	databaseAdapter_.Execute(sql, rowHandler);
+	return iRow;
+}
+
+void ResourcePersister::PersistSparse(const SparseResource &sparse, const std::string_view key)
+{
+	const size_t nnz = sparse.GetNonZeroCount();
+	std::vector<size_t> rowOffsets(sparse.GetRowOffsets().cbegin(), sparse.GetRowOffsets().cend());
+	if (rowOffsets.empty())
+		rowOffsets.assign(sparse.GetColumnSize() + 1, 0);
+
+	// the blob holds the M + 1 row offsets, then the nnz column indices, then the nnz values
+	const size_t offsetsBytes = rowOffsets.size() * sizeof(size_t);
+	const size_t indicesBytes = nnz * sizeof(size_t);
+	const size_t valuesBytes = nnz * sparse.GetElementSize();
+
+	const std::string M = std::to_string(sparse.GetColumnSize());
+	const std::string N = std::to_string(sparse.GetRowSize());
+	const std::string SIZE_OF = std::to_string(sparse.GetElementSize());
+	const std::string NNZ = std::to_string(nnz);
+	const std::string DTYPE = DataTypeValue(sparse.GetDataType());
+
+	const std::string sql = "INSERT INTO " + TABLE_NAME + " (" + P_KEY + "," + M_KEY + "," + N_KEY + "," + SIZE_OF_KEY + "," + DTYPE_KEY + "," + NNZ_KEY + "," + DATA_KEY + ") VALUES ('" + std::string(key) + "'," + M + "," + N + "," + SIZE_OF + "," + DTYPE + "," + NNZ + ",zeroblob(" + std::to_string(offsetsBytes + indicesBytes + valuesBytes) + "));";
+	std::function<void()> insertSparse =
+		[this, &sql, &sparse, &rowOffsets, nnz, offsetsBytes, indicesBytes, valuesBytes]()
+	{
+		databaseAdapter_.Execute(sql);
+
+		SqliteBlob sqliteBlob(databaseAdapter_);
+		sqliteBlob.Open(TABLE_NAME, DATA_KEY, sqlite3_last_insert_rowid(databaseAdapter_.GetSqlite3()));
+		sqliteBlob.Write(reinterpret_cast<const char *>(rowOffsets.data()), offsetsBytes, 0);
+		if (nnz == 0)
+			return;
+		sqliteBlob.Write(reinterpret_cast<const char *>(sparse.GetColumnIndices().data()), indicesBytes, static_cast<int>(offsetsBytes));
+		sqliteBlob.Write(static_cast<const char *>(sparse.Data()), valuesBytes, static_cast<int>(offsetsBytes + indicesBytes));
+	};
+
+	RunInTransaction(databaseAdapter_, insertSparse);
+}
+
+void ResourcePersister::Persist(const ResourceView &view, const std::string_view key)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot persist resource view with empty key");
+
+	if (!databaseAdapter_.IsOpen())
+		throw std::runtime_error("Cannot persist resource view because the database is not open");
+
+	const size_t size = view.GetByteSize();
+	if (size == 0)
+		throw std::runtime_error("Cannot persist an empty resource view");
+
+	const std::string M = std::to_string(view.GetColumnSize());
+	const std::string N = std::to_string(view.GetRowSize());
+	const std::string SIZE_OF = std::to_string(view.GetElementSize());
+	const std::string DTYPE = DataTypeValue(view.GetParent().GetDataType());
+
+	// reserve the blob and stream the view into it one row at a time
+	const std::string sql = "INSERT INTO " + TABLE_NAME + " (" + P_KEY + "," + M_KEY + "," + N_KEY + "," + SIZE_OF_KEY + "," + DTYPE_KEY + "," + DATA_KEY + ") VALUES ('" + std::string(key) + "'," + M + "," + N + "," + SIZE_OF + "," + DTYPE + ",zeroblob(" + std::to_string(size) + "));";
+	std::function<void()> insertView =
+		[this, &sql, &view, size]()
+	{
+		databaseAdapter_.Execute(sql);
+
+		SqliteBlob sqliteBlob(databaseAdapter_);
+		sqliteBlob.Open(TABLE_NAME, DATA_KEY, sqlite3_last_insert_rowid(databaseAdapter_.GetSqlite3()));
+
+		const size_t rowBytes = view.GetRowSize() * view.GetElementSize();
+		if (view.IsContiguous())
+		{
+			sqliteBlob.Write(static_cast<const char *>(view.At(0, 0)), size, 0);
+			return;
+		}
+
+		auto rowBuff = std::make_unique<char[]>(rowBytes);
+		for (size_t i = 0; i < view.GetColumnSize(); ++i)
+		{
+			const char *row = static_cast<const char *>(view.At(i, 0));
+			if (!view.IsRowContiguous())
+			{
+				view.CopyRow(i, rowBuff.get());
+				row = rowBuff.get();
+			}
+			sqliteBlob.Write(row, rowBytes, static_cast<int>(i * rowBytes));
+		}
+	};
+
+	RunInTransaction(databaseAdapter_, insertView);
+}
+
+void ResourcePersister::SetZoneMapBlockSize(const size_t blockSize)
+{
+	zoneMapBlockSize_ = blockSize;
+}
+
+size_t ResourcePersister::GetZoneMapBlockSize() const
+{
+	return zoneMapBlockSize_;
+}
+
+void ResourcePersister::SetDeltaChainLength(const size_t chainLength)
+{
+	deltaChainLength_ = chainLength;
+}
+
+size_t ResourcePersister::GetDeltaChainLength() const
+{
+	return deltaChainLength_;
 }
 
 void ResourcePersister::Load(const std::string_view key)
@@ -111,3 +354,24 @@ void ResourcePersister::Load(const std::string_view key)
 	std::string sql = "DELETE FROM " + TABLE_NAME + " WHERE " + P_KEY + " = '" + std::string(key) + "';";
 	GetDatabase().Execute(sql);
 }
+
+void ResourcePersister::SetEncoding(const std::string_view key, const Encoding &encoding)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot set the encoding of a resource with empty key");
+
+	if (encoding.GetType() == EncodingType::None)
+	{
+		auto it = keyToEncodingMap_.find(key);
+		if (it != keyToEncodingMap_.end())
+			keyToEncodingMap_.erase(it);
+		return;
+	}
+	keyToEncodingMap_.insert_or_assign(std::string(key), encoding);
+}
+
+Encoding ResourcePersister::GetEncoding(const std::string_view key) const
+{
+	auto it = keyToEncodingMap_.find(key);
+	return it == keyToEncodingMap_.cend() ? Encoding() : it->second;
+}
@@ -0,0 +1,85 @@
+#include "DatabaseAdapters/ResourceTable.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DatabaseAdapters/Sqlite.h"
+
+using database_adapters::Sqlite;
+using namespace database_adapters::resource_table;
+
+namespace
+{
+	// columns added after the table was first released, with their types
+	const std::vector<std::pair<std::string, std::string>> ADDED_COLUMNS = {
+		{NNZ_KEY, "INTEGER"},
+		{SHAPE_KEY, "TEXT"},
+		{LAYOUT_KEY, "INTEGER"},
+		{TILE_KEY, "TEXT"},
+		{DTYPE_KEY, "INTEGER"},
+		{STAT_MIN_KEY, "REAL"},
+		{STAT_MAX_KEY, "REAL"},
+		{STAT_SUM_KEY, "REAL"},
+		{STAT_COUNT_KEY, "INTEGER"},
+		{STAT_NAN_KEY, "INTEGER"},
+		{ZONE_MAP_KEY, "BLOB"},
+		{DELTA_BASE_KEY, "INTEGER"},
+		{QUANT_SCALE_KEY, "REAL"},
+		{QUANT_OFFSET_KEY, "REAL"}};
+} // end namespace anonymous
+
+std::string database_adapters::resource_table::JoinExtents(const std::vector<size_t> &extents)
+{
+	std::string text;
+	for (size_t extent : extents)
+		text += (text.empty() ? "" : ",") + std::to_string(extent);
+	return text;
+}
+
+std::vector<size_t> database_adapters::resource_table::SplitExtents(const std::string &text)
+{
+	std::vector<size_t> extents;
+	size_t begin = 0;
+	while (begin <= text.size())
+	{
+		size_t end = text.find(',', begin);
+		if (end == std::string::npos)
+			end = text.size();
+		extents.push_back(std::stoull(text.substr(begin, end - begin)));
+		begin = end + 1;
+	}
+	return extents;
+}
+
+std::string database_adapters::resource_table::RealValue(const double value)
+{
+	if (!std::isfinite(value))
+		return "NULL";
+	char text[32];
+	std::snprintf(text, sizeof(text), "%.17g", value);
+	return text;
+}
+
+void database_adapters::CreateResourceTable(Sqlite &db)
+{
+	std::string sql = "CREATE TABLE IF NOT EXISTS " + TABLE_NAME + " (" +
+					  ROW_KEY + " INTEGER PRIMARY KEY AUTOINCREMENT, " +
+					  P_KEY + " TEXT NOT NULL, " +
+					  M_KEY + " INTEGER, " +
+					  N_KEY + " INTEGER, " +
+					  SIZE_OF_KEY + " INTEGER, " +
+					  DATA_KEY + " BLOB";
+	for (const auto &[column, type] : ADDED_COLUMNS)
+		sql += ", " + column + " " + type;
+	sql += "); PRAGMA auto_vacuum = FULL;";
+
+	db.Execute(sql);
+
+	// databases created by earlier releases lack the newer columns
+	for (const auto &[column, type] : ADDED_COLUMNS)
+		if (!db.HasColumn(TABLE_NAME, column))
+			db.Execute("ALTER TABLE " + TABLE_NAME + " ADD COLUMN " + column + " " + type + ";");
+}
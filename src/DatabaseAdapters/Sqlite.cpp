@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 #include <stdio.h>
+#include <string>
 #include "Config/filesystem.hpp"
 
 #include <boost/optional.hpp>
@@ -88,6 +89,23 @@ void Sqlite::Execute(const std::string &sql, boost::optional<Sqlite::RowCallback
 	}
 }
 
+bool Sqlite::HasColumn(const std::string &tableName, const std::string &columnName)
+{
+	bool found = false;
+	RowCallbackType columnHandler = [&found, &columnName](int numCols, char **colValues, char **colNames)
+	{
+		for (int i = 0; i < numCols; ++i)
+		{
+			if (std::string(colNames[i]) == "name" && colValues[i] && columnName == colValues[i])
+				found = true;
+		}
+		return 0;
+	};
+
+	Execute("PRAGMA table_info(" + tableName + ");", columnHandler);
+	return found;
+}
+
 sqlite3 *Sqlite::GetSqlite3()
 {
 	return db_;
@@ -44,10 +44,22 @@ std::vector<char> SqliteBlob::Read(const size_t numBytes, const int offset) cons
 		throw std::runtime_error("SqliteBlob cannot read at negative offset");
 
 	std::vector<char> buff(numBytes);
-	int result = sqlite3_blob_read(blob_, buff.data(), static_cast<int>(numBytes), offset);
+	Read(buff.data(), numBytes, offset);
+	return buff;
+}
+
+void SqliteBlob::Read(char *buff, const size_t numBytes, const int offset) const
+{
+	if (!buff)
+		throw std::runtime_error("SqliteBlob cannot read because buffer is nullptr");
+	if (numBytes == 0)
+		throw std::runtime_error("SqliteBlob cannot read 0 bytes");
+	if (offset < 0)
+		throw std::runtime_error("SqliteBlob cannot read at negative offset");
+
+	int result = sqlite3_blob_read(blob_, buff, static_cast<int>(numBytes), offset);
 	if (result != SQLITE_OK)
 		throw std::runtime_error("Could not read " + std::to_string(numBytes) + " from sqlite3 blob at offset=" + std::to_string(offset));
-	return buff;
 }
 
 void SqliteBlob::Write(const char *buff, const size_t size, const int offset)
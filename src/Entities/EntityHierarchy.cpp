@@ -1,17 +1,39 @@
 #include "Entities/EntityHierarchy.h"
 
+#include <cstdint>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 #include "Config/filesystem.hpp"
 
+#if defined(__APPLE__) || defined(__MACH__)
+#include <boost/system/error_code.hpp>
+#else
+#include <system_error>
+#endif
+
+#include <boost/optional.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 namespace pt = boost::property_tree;
 
+#if defined(__APPLE__) || defined(__MACH__)
+using boost::system::error_code;
+#else
+using std::error_code;
+#endif
 using entity::EntityHierarchy;
 
+namespace
+{
+	const std::string LOG_EXT = ".log";
+	const std::string TMP_EXT = ".tmp";
+} // end namespace anonymous
+
 EntityHierarchy::EntityHierarchy() = default;
 EntityHierarchy::EntityHierarchy(const EntityHierarchy &) = default;
 EntityHierarchy &EntityHierarchy::operator=(const EntityHierarchy &) = default;
@@ -32,6 +54,128 @@ void EntityHierarchy::LoadSerializationStructure(const Path &pathToJSON)
 		serializationPath_.clear();
 		throw std::runtime_error("Could not open " + pathToJSON.string() + " when loading serialization structure");
 	}
+	pendingUpdates_.clear();
+
+	// a line cut short by a crash ends the log
+	const Path logPath = GetLogPath(pathToJSON);
+	uintmax_t end = 0;
+	{
+		std::ifstream log(logPath.string(), std::ios::binary);
+		for (std::string line; std::getline(log, line) && !log.eof();)
+		{
+			pt::ptree update;
+			try
+			{
+				std::istringstream record(line);
+				pt::read_json(record, update);
+			}
+			catch (const pt::json_parser_error &)
+			{
+				break;
+			}
+			if (!update.get_optional<std::string>("path"))
+				break;
+			ApplyUpdate(update);
+			end += line.size() + 1;
+		}
+	}
+
+	// drop the torn line so that the next records are not appended to it
+	error_code ec;
+	if (fs::exists(logPath, ec) && fs::file_size(logPath, ec) != end)
+	{
+		fs::resize_file(logPath, end, ec);
+		if (ec)
+			throw std::runtime_error("Could not truncate " + logPath.string() + " when loading serialization structure");
+	}
+}
+
+void EntityHierarchy::SaveSerializationStructure()
+{
+	if (serializationPath_.empty())
+		throw std::runtime_error("Cannot save serialization structure without a serialization path");
+
+	// the structure replaces the file at once, and replaying the log over it again changes nothing
+	const Path tmpPath = Path(serializationPath_.string() + TMP_EXT);
+	pt::write_json(tmpPath.string(), serializationStructure_);
+
+	error_code ec;
+	fs::rename(tmpPath, serializationPath_, ec);
+	if (ec)
+		throw std::runtime_error("Could not replace " + serializationPath_.string() + " when saving serialization structure");
+	fs::remove(GetLogPath(serializationPath_), ec);
+	if (ec)
+		throw std::runtime_error("Could not remove " + GetLogPath(serializationPath_).string() + " when saving serialization structure");
+	pendingUpdates_.clear();
+}
+
+void EntityHierarchy::UpdateNode(const std::string &keyPath, const pt::ptree &fields, const std::vector<std::string> &memberKeys)
+{
+	pt::ptree update;
+	update.put("path", keyPath);
+	update.add_child("fields", fields);
+	pt::ptree &members = update.add_child("members", pt::ptree());
+	for (const std::string &key : memberKeys)
+		members.push_back(pt::ptree::value_type(key, pt::ptree()));
+
+	ApplyUpdate(update);
+	pendingUpdates_.push_back(std::move(update));
+}
+
+void EntityHierarchy::SaveUpdates()
+{
+	if (serializationPath_.empty())
+		throw std::runtime_error("Cannot save serialization structure without a serialization path");
+	if (!fs::exists(serializationPath_))
+	{
+		SaveSerializationStructure();
+		return;
+	}
+	if (pendingUpdates_.empty())
+		return;
+
+	std::ostringstream records;
+	for (const pt::ptree &update : pendingUpdates_)
+		pt::write_json(records, update, false);
+	const std::string text = records.str();
+
+	// the structure is rewritten once the log would outgrow it, so a save costs as much as what changed
+	const Path logPath = GetLogPath(serializationPath_);
+	const uintmax_t logSize = fs::exists(logPath) ? fs::file_size(logPath) : 0;
+	if (logSize + text.size() > fs::file_size(serializationPath_))
+	{
+		SaveSerializationStructure();
+		return;
+	}
+
+	std::ofstream log(logPath.string(), std::ios::binary | std::ios::app);
+	if (!log.write(text.data(), static_cast<std::streamsize>(text.size())) || !log.flush())
+		throw std::runtime_error("Could not append to " + logPath.string() + " when saving serialization structure");
+	pendingUpdates_.clear();
+}
+
+Path EntityHierarchy::GetLogPath(const Path &pathToJSON)
+{
+	return Path(pathToJSON.string() + LOG_EXT);
+}
+
+void EntityHierarchy::ApplyUpdate(const pt::ptree &update)
+{
+	const std::string keyPath = update.get<std::string>("path");
+	pt::ptree node = update.get_child("fields", pt::ptree());
+
+	// members keep their subtrees, which change only through updates of their own
+	boost::optional<pt::ptree &> existing = serializationStructure_.get_child_optional(keyPath);
+	if (existing)
+	{
+		for (const pt::ptree::value_type &member : update.get_child("members", pt::ptree()))
+		{
+			auto found = existing->find(member.first);
+			if (found != existing->not_found())
+				node.push_back(*found);
+		}
+	}
+	serializationStructure_.put_child(keyPath, node);
 }
 
 bool EntityHierarchy::HasSerializationStructure() const
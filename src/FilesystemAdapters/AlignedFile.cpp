@@ -0,0 +1,181 @@
+#include "FilesystemAdapters/AlignedFile.h"
+
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using filesystem_adapters::AlignedFile;
+
+namespace
+{
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+	int OpenFile(const std::string &filePath, const bool write, const bool)
+	{
+		const int flags = _O_BINARY | (write ? _O_WRONLY | _O_CREAT | _O_TRUNC : _O_RDONLY);
+		return _open(filePath.c_str(), flags, _S_IREAD | _S_IWRITE);
+	}
+
+	long long ReadFile(const int fd, char *buff, const size_t n)
+	{
+		return _read(fd, buff, static_cast<unsigned int>(n));
+	}
+
+	long long WriteFile(const int fd, const char *buff, const size_t n)
+	{
+		return _write(fd, buff, static_cast<unsigned int>(n));
+	}
+
+	int TruncateFile(const int fd, const size_t size)
+	{
+		return _chsize_s(fd, static_cast<long long>(size));
+	}
+
+	int CloseFile(const int fd)
+	{
+		return _close(fd);
+	}
+#else
+	int OpenFile(const std::string &filePath, const bool write, const bool direct)
+	{
+		int flags = write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY;
+#if defined(O_DIRECT)
+		if (direct)
+			flags |= O_DIRECT;
+#endif
+		const int fd = ::open(filePath.c_str(), flags, 0644);
+#if defined(F_NOCACHE)
+		if (fd >= 0 && direct)
+			::fcntl(fd, F_NOCACHE, 1);
+#endif
+		return fd;
+	}
+
+	long long ReadFile(const int fd, char *buff, const size_t n)
+	{
+		return ::read(fd, buff, n);
+	}
+
+	long long WriteFile(const int fd, const char *buff, const size_t n)
+	{
+		return ::write(fd, buff, n);
+	}
+
+	int TruncateFile(const int fd, const size_t size)
+	{
+		return ::ftruncate(fd, static_cast<off_t>(size));
+	}
+
+	int CloseFile(const int fd)
+	{
+		return ::close(fd);
+	}
+#endif
+} // end namespace anonymous
+
+void AlignedFile::BufferDeleter::operator()(char *buff) const
+{
+	::operator delete[](buff, std::align_val_t(ALIGNMENT));
+}
+
+AlignedFile::AlignedFile(const std::string_view filePath, const bool write, const bool direct) : filePath_(filePath)
+{
+	if (filePath_.empty())
+		throw std::runtime_error("File path is empty when opening aligned file");
+
+	fd_ = OpenFile(filePath_, write, direct);
+	direct_ = direct && fd_ >= 0;
+
+	// file systems such as tmpfs reject direct I/O
+	if (fd_ < 0 && direct && errno == EINVAL)
+		fd_ = OpenFile(filePath_, write, false);
+	if (fd_ < 0)
+		throw std::runtime_error("AlignedFile could not open file: " + filePath_);
+}
+
+AlignedFile::~AlignedFile() noexcept
+{
+	if (fd_ >= 0)
+		CloseFile(fd_);
+}
+
+AlignedFile::BufferType AlignedFile::AllocateBuffer(const size_t size)
+{
+	return BufferType(static_cast<char *>(::operator new[](RoundUp(size), std::align_val_t(ALIGNMENT))));
+}
+
+size_t AlignedFile::RoundUp(const size_t size)
+{
+	return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+bool AlignedFile::IsDirect() const
+{
+	return direct_;
+}
+
+size_t AlignedFile::Read(char *buff, const size_t n)
+{
+	if (fd_ < 0)
+		throw std::runtime_error("Cannot read closed aligned file: " + filePath_);
+
+	// reads can return early, so keep reading until the buffer is full or the file ends
+	size_t total = 0;
+	while (total < n)
+	{
+		const long long count = ReadFile(fd_, buff + total, n - total);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count < 0)
+			throw std::runtime_error("AlignedFile could not read file: " + filePath_);
+		if (count == 0)
+			break;
+		total += static_cast<size_t>(count);
+	}
+	return total;
+}
+
+void AlignedFile::Write(const char *buff, const size_t n)
+{
+	if (fd_ < 0)
+		throw std::runtime_error("Cannot write closed aligned file: " + filePath_);
+
+	size_t total = 0;
+	while (total < n)
+	{
+		const long long count = WriteFile(fd_, buff + total, n - total);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			throw std::runtime_error("AlignedFile could not write file: " + filePath_);
+		total += static_cast<size_t>(count);
+	}
+}
+
+void AlignedFile::Truncate(const size_t size)
+{
+	if (fd_ < 0 || TruncateFile(fd_, size) != 0)
+		throw std::runtime_error("AlignedFile could not set the size of file: " + filePath_);
+}
+
+void AlignedFile::Close()
+{
+	if (fd_ < 0)
+		return;
+
+	const int fd = fd_;
+	fd_ = -1;
+	if (CloseFile(fd) != 0)
+		throw std::runtime_error("AlignedFile could not close file: " + filePath_);
+}
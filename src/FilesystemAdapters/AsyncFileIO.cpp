@@ -0,0 +1,605 @@
+#include "FilesystemAdapters/AsyncFileIO.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define FILESYSTEM_ADAPTERS_IO_URING
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <unordered_set>
+#endif
+
+#include "Intraprocess/ThreadPool.h"
+
+using filesystem_adapters::AsyncBackend;
+using filesystem_adapters::AsyncFileIO;
+using intraprocess::ThreadPool;
+
+struct AsyncFileIO::Request
+{
+	/** @brief True for a write, false for a read. */
+	bool write{false};
+
+	/** @brief The path of the file. */
+	std::string filePath;
+
+	/** @brief The contents read or to write. */
+	std::vector<char> data;
+
+	/** @brief The number of bytes transferred so far. */
+	size_t done{0};
+
+	/** @brief Fulfilled with the contents of a read. */
+	std::promise<std::vector<char>> readPromise;
+
+	/** @brief Fulfilled when a write completes. */
+	std::promise<void> writePromise;
+
+#if defined(FILESYSTEM_ADAPTERS_IO_URING)
+	/** @brief The open file, -1 if not open. */
+	int fd{-1};
+
+	/** @brief The buffer of the operation in flight. */
+	iovec iov{};
+
+	/** @brief True once the request failed with the ring; its completion only releases it. */
+	bool abandoned{false};
+#endif
+};
+
+namespace
+{
+	template <typename R>
+	void Fail(R &request, const std::string &error)
+	{
+		const std::exception_ptr exception = std::make_exception_ptr(std::runtime_error(error));
+		if (request.write)
+			request.writePromise.set_exception(exception);
+		else
+			request.readPromise.set_exception(exception);
+	}
+
+	template <typename R>
+	void Succeed(R &request)
+	{
+		if (request.write)
+			request.writePromise.set_value();
+		else
+			request.readPromise.set_value(std::move(request.data));
+	}
+
+	// the fallback needs no more threads than requests in flight or cores
+	size_t PoolSize(const size_t queueDepth)
+	{
+		return std::min(queueDepth, std::max(size_t(1), size_t(std::thread::hardware_concurrency())));
+	}
+
+	// the fallback reads and writes with blocking streams
+	template <typename R>
+	void RunBlocking(R &request)
+	{
+		if (request.write)
+		{
+			std::ofstream outFile(request.filePath, std::ios::binary | std::ios::trunc);
+			if (!outFile || !outFile.write(request.data.data(), static_cast<std::streamsize>(request.data.size())))
+				return Fail(request, "AsyncFileIO could not write file: " + request.filePath);
+			outFile.close();
+			if (!outFile)
+				return Fail(request, "AsyncFileIO could not write file: " + request.filePath);
+			return Succeed(request);
+		}
+
+		std::ifstream inFile(request.filePath, std::ios::binary);
+		if (!inFile)
+			return Fail(request, "AsyncFileIO could not read file: " + request.filePath);
+		request.data.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+		if (inFile.bad())
+			return Fail(request, "AsyncFileIO could not read file: " + request.filePath);
+		Succeed(request);
+	}
+} // end namespace anonymous
+
+#if defined(FILESYSTEM_ADAPTERS_IO_URING)
+namespace
+{
+	// the kernel caps single reads and writes just below 2 GiB
+	const size_t MAX_TRANSFER = size_t(1) << 30;
+
+	unsigned LoadAcquire(unsigned *value)
+	{
+		return std::atomic_ref<unsigned>(*value).load(std::memory_order_acquire);
+	}
+
+	void StoreRelease(unsigned *value, const unsigned newValue)
+	{
+		std::atomic_ref<unsigned>(*value).store(newValue, std::memory_order_release);
+	}
+} // end namespace anonymous
+
+struct AsyncFileIO::Ring
+{
+	~Ring()
+	{
+		if (sqes)
+			munmap(sqes, sqesSize);
+		if (cqRing && cqRing != sqRing)
+			munmap(cqRing, cqRingSize);
+		if (sqRing)
+			munmap(sqRing, sqRingSize);
+		if (fd >= 0)
+			close(fd);
+	}
+
+	// null if the kernel does not provide io_uring or refuses it
+	static std::unique_ptr<Ring> Create(const size_t queueDepth)
+	{
+		io_uring_params params{};
+		auto ring = std::make_unique<Ring>();
+		ring->fd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(queueDepth), &params));
+		if (ring->fd < 0)
+			return nullptr;
+
+		ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+		if (singleMap)
+			ring->sqRingSize = ring->cqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+
+		void *sqRing = mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+		if (sqRing == MAP_FAILED)
+			return nullptr;
+		ring->sqRing = sqRing;
+
+		void *cqRing = singleMap ? sqRing : mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if (cqRing == MAP_FAILED)
+			return nullptr;
+		ring->cqRing = cqRing;
+
+		ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void *sqes = mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED)
+			return nullptr;
+		ring->sqes = static_cast<io_uring_sqe *>(sqes);
+
+		char *sq = static_cast<char *>(sqRing);
+		ring->sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+		ring->sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+		ring->sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+		ring->sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+		char *cq = static_cast<char *>(cqRing);
+		ring->cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+		ring->cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+		ring->cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+		ring->cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+		ring->entries = params.sq_entries;
+		return ring;
+	}
+
+	// opens the file of a request; false if the request already completed
+	static bool Open(AsyncFileIO::Request &request)
+	{
+		if (request.write)
+		{
+			request.fd = open(request.filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if (request.fd < 0)
+			{
+				Fail(request, "AsyncFileIO could not open file: " + request.filePath);
+				return false;
+			}
+		}
+		else
+		{
+			request.fd = open(request.filePath.c_str(), O_RDONLY | O_CLOEXEC);
+			struct stat status{};
+			if (request.fd < 0 || fstat(request.fd, &status) != 0)
+			{
+				Fail(request, "AsyncFileIO could not open file: " + request.filePath);
+				Close(request);
+				return false;
+			}
+			request.data.resize(static_cast<size_t>(status.st_size));
+		}
+
+		if (request.data.empty())
+		{
+			Close(request);
+			Succeed(request);
+			return false;
+		}
+		return true;
+	}
+
+	static void Close(AsyncFileIO::Request &request)
+	{
+		if (request.fd >= 0)
+			close(request.fd);
+		request.fd = -1;
+	}
+
+	// queues the next transfer of a request; the caller owns the submission slot
+	void Queue(AsyncFileIO::Request &request)
+	{
+		const unsigned tail = *sqTail;
+		const unsigned index = tail & *sqMask;
+		io_uring_sqe &sqe = sqes[index];
+		std::memset(&sqe, 0, sizeof(sqe));
+
+		request.iov.iov_base = request.data.data() + request.done;
+		request.iov.iov_len = std::min(request.data.size() - request.done, MAX_TRANSFER);
+		sqe.opcode = request.write ? IORING_OP_WRITEV : IORING_OP_READV;
+		sqe.fd = request.fd;
+		sqe.addr = reinterpret_cast<uint64_t>(&request.iov);
+		sqe.len = 1;
+		sqe.off = request.done;
+		sqe.user_data = reinterpret_cast<uint64_t>(&request);
+
+		sqArray[index] = index;
+		StoreRelease(sqTail, tail + 1);
+	}
+
+	// submits the queued transfers and waits for at least minComplete completions
+	void Enter(unsigned toSubmit, const unsigned minComplete)
+	{
+		while (toSubmit > 0 || minComplete > 0)
+		{
+			const long submitted = syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+			if (submitted < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY))
+				continue;
+			if (submitted < 0)
+				throw std::runtime_error("AsyncFileIO could not submit to io_uring: " + std::string(std::strerror(errno)));
+			toSubmit -= std::min(toSubmit, static_cast<unsigned>(submitted));
+			if (toSubmit == 0)
+				return;
+		}
+	}
+
+	/** @brief The io_uring file descriptor. */
+	int fd{-1};
+
+	void *sqRing{nullptr};
+	size_t sqRingSize{0};
+	void *cqRing{nullptr};
+	size_t cqRingSize{0};
+	io_uring_sqe *sqes{nullptr};
+	size_t sqesSize{0};
+
+	unsigned *sqHead{nullptr};
+	unsigned *sqTail{nullptr};
+	unsigned *sqMask{nullptr};
+	unsigned *sqArray{nullptr};
+	unsigned *cqHead{nullptr};
+	unsigned *cqTail{nullptr};
+	unsigned *cqMask{nullptr};
+	io_uring_cqe *cqes{nullptr};
+
+	/** @brief The number of submission slots. */
+	unsigned entries{0};
+
+	/** @brief Guards the pending requests and the stop flag. */
+	std::mutex lock;
+
+	/** @brief Wakes the ring thread when it is idle. */
+	std::condition_variable notifier;
+
+	/** @brief Requests not yet in flight. */
+	std::deque<std::unique_ptr<AsyncFileIO::Request>> pending;
+
+	/** @brief Set to stop the ring thread once every request completes. */
+	bool stop{false};
+
+	/** @brief Set once io_uring failed; requests then run on the thread pool. */
+	bool failed{false};
+
+	/** @brief The thread that submits and completes requests. */
+	std::thread worker;
+};
+#else
+struct AsyncFileIO::Ring
+{
+	static std::unique_ptr<Ring> Create(const size_t)
+	{
+		return nullptr;
+	}
+
+	std::thread worker;
+};
+#endif
+
+AsyncFileIO::AsyncFileIO(const size_t queueDepth, const AsyncBackend backend) : queueDepth_(queueDepth)
+{
+	if (queueDepth_ == 0)
+		throw std::runtime_error("Cannot construct AsyncFileIO with a queue depth of 0");
+
+	if (backend == AsyncBackend::IoUring)
+		ring_ = Ring::Create(queueDepth_);
+	if (ring_)
+	{
+		ring_->worker = std::thread(&AsyncFileIO::RunRing, this);
+		return;
+	}
+
+	pool_ = std::make_unique<ThreadPool>(PoolSize(queueDepth_));
+}
+
+AsyncFileIO::~AsyncFileIO() noexcept
+{
+#if defined(FILESYSTEM_ADAPTERS_IO_URING)
+	if (ring_)
+	{
+		{
+			std::lock_guard<std::mutex> lock(ring_->lock);
+			ring_->stop = true;
+		}
+		ring_->notifier.notify_all();
+		ring_->worker.join();
+	}
+#endif
+	if (pool_)
+		pool_->Join();
+}
+
+AsyncBackend AsyncFileIO::GetBackend() const
+{
+#if defined(FILESYSTEM_ADAPTERS_IO_URING)
+	if (ring_)
+	{
+		std::lock_guard<std::mutex> lock(ring_->lock);
+		if (!ring_->failed)
+			return AsyncBackend::IoUring;
+	}
+#endif
+	return AsyncBackend::ThreadPool;
+}
+
+size_t AsyncFileIO::GetQueueDepth() const
+{
+	return queueDepth_;
+}
+
+std::future<std::vector<char>> AsyncFileIO::Read(const std::string_view filePath)
+{
+	const std::string path(filePath);
+	return std::move(ReadBatch(std::span<const std::string>(&path, 1)).front());
+}
+
+std::future<void> AsyncFileIO::Write(const std::string_view filePath, std::vector<char> data)
+{
+	const std::string path(filePath);
+	std::vector<std::vector<char>> contents;
+	contents.push_back(std::move(data));
+	return std::move(WriteBatch(std::span<const std::string>(&path, 1), std::move(contents)).front());
+}
+
+std::vector<std::future<std::vector<char>>> AsyncFileIO::ReadBatch(const std::span<const std::string> filePaths)
+{
+	std::vector<std::future<std::vector<char>>> futures;
+	std::vector<std::unique_ptr<Request>> requests;
+	for (const std::string &filePath : filePaths)
+	{
+		auto request = std::make_unique<Request>();
+		request->filePath = filePath;
+		futures.push_back(request->readPromise.get_future());
+		requests.push_back(std::move(request));
+	}
+	Submit(std::move(requests));
+	return futures;
+}
+
+std::vector<std::future<void>> AsyncFileIO::WriteBatch(const std::span<const std::string> filePaths, std::vector<std::vector<char>> data)
+{
+	if (filePaths.size() != data.size())
+		throw std::runtime_error("AsyncFileIO needs the contents of every file of a batch");
+
+	std::vector<std::future<void>> futures;
+	std::vector<std::unique_ptr<Request>> requests;
+	for (size_t i = 0; i < filePaths.size(); ++i)
+	{
+		auto request = std::make_unique<Request>();
+		request->write = true;
+		request->filePath = filePaths[i];
+		request->data = std::move(data[i]);
+		futures.push_back(request->writePromise.get_future());
+		requests.push_back(std::move(request));
+	}
+	Submit(std::move(requests));
+	return futures;
+}
+
+void AsyncFileIO::Submit(std::vector<std::unique_ptr<Request>> requests)
+{
+#if defined(FILESYSTEM_ADAPTERS_IO_URING)
+	if (ring_)
+	{
+		std::unique_lock<std::mutex> lock(ring_->lock);
+		if (!ring_->failed)
+		{
+			for (std::unique_ptr<Request> &request : requests)
+				ring_->pending.push_back(std::move(request));
+			lock.unlock();
+			ring_->notifier.notify_one();
+			return;
+		}
+	}
+#endif
+
+	for (std::unique_ptr<Request> &request : requests)
+	{
+		std::shared_ptr<Request> shared(std::move(request));
+		std::function<void()> task = [shared]()
+		{ RunBlocking(*shared); };
+		pool_->Post(task);
+	}
+}
+
+void AsyncFileIO::RunRing()
+{
+#if defined(FILESYSTEM_ADAPTERS_IO_URING)
+	Ring &ring = *ring_;
+	// the requests the kernel may hold; each is released once its completion is reaped
+	std::unordered_set<Request *> inFlight;
+	unsigned queued = 0;
+	bool failed = false;
+	while (true)
+	{
+		std::vector<std::unique_ptr<Request>> incoming;
+		if (!failed)
+		{
+			// block for new requests only when there is nothing to complete
+			std::unique_lock<std::mutex> lock(ring.lock);
+			if (inFlight.empty())
+				ring.notifier.wait(lock, [&ring]()
+								   { return ring.stop || !ring.pending.empty(); });
+			if (inFlight.empty() && ring.pending.empty() && ring.stop)
+				return;
+			while (!ring.pending.empty() && inFlight.size() + incoming.size() < std::min<size_t>(queueDepth_, ring.entries))
+			{
+				incoming.push_back(std::move(ring.pending.front()));
+				ring.pending.pop_front();
+			}
+		}
+		else if (inFlight.empty())
+			return;
+
+		for (std::unique_ptr<Request> &request : incoming)
+		{
+			if (!Ring::Open(*request))
+				continue;
+			ring.Queue(*request);
+			inFlight.insert(request.release());
+			++queued;
+		}
+		if (inFlight.empty())
+			continue;
+
+		try
+		{
+			ring.Enter(queued, 1);
+		}
+		catch (const std::runtime_error &error)
+		{
+			if (failed)
+			{
+				// the abandoned requests complete without the ring; wait for the kernel to release their buffers
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			else
+			{
+				failed = true;
+				std::vector<std::unique_ptr<Request>> rerouted;
+
+				// entries the kernel has not consumed are taken back and run on the thread pool with the pending requests
+				const unsigned head = LoadAcquire(ring.sqHead);
+				for (unsigned index = head; index != *ring.sqTail; ++index)
+				{
+					Request *request = reinterpret_cast<Request *>(ring.sqes[index & *ring.sqMask].user_data);
+					inFlight.erase(request);
+					Ring::Close(*request);
+					request->done = 0;
+					rerouted.emplace_back(request);
+				}
+				StoreRelease(ring.sqTail, head);
+
+				// the requests submitted to the kernel fail now, but their buffers live until they complete
+				for (Request *request : inFlight)
+				{
+					request->abandoned = true;
+					Fail(*request, error.what());
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(ring.lock);
+					pool_ = std::make_unique<ThreadPool>(PoolSize(queueDepth_));
+					ring.failed = true;
+					while (!ring.pending.empty())
+					{
+						rerouted.push_back(std::move(ring.pending.front()));
+						ring.pending.pop_front();
+					}
+				}
+				Submit(std::move(rerouted));
+			}
+		}
+		queued = 0;
+
+		unsigned head = *ring.cqHead;
+		const unsigned tail = LoadAcquire(ring.cqTail);
+		for (; head != tail; ++head)
+		{
+			const io_uring_cqe &cqe = ring.cqes[head & *ring.cqMask];
+			std::unique_ptr<Request> request(reinterpret_cast<Request *>(cqe.user_data));
+			const int result = cqe.res;
+
+			if (request->abandoned)
+			{
+				inFlight.erase(request.get());
+				Ring::Close(*request);
+				continue;
+			}
+
+			if (result == -EINTR || result == -EAGAIN)
+			{
+				ring.Queue(*request.release());
+				++queued;
+				continue;
+			}
+
+			if (result < 0)
+			{
+				inFlight.erase(request.get());
+				Ring::Close(*request);
+				Fail(*request, "AsyncFileIO could not " + std::string(request->write ? "write" : "read") + " file: " + request->filePath + ": " + std::strerror(-result));
+				continue;
+			}
+			if (result == 0 && request->write)
+			{
+				inFlight.erase(request.get());
+				Ring::Close(*request);
+				Fail(*request, "AsyncFileIO could not write file: " + request->filePath);
+				continue;
+			}
+
+			// a read that ends early means the file shrank since it was opened
+			if (result == 0)
+				request->data.resize(request->done);
+			request->done += static_cast<size_t>(result);
+			if (result > 0 && request->done < request->data.size())
+			{
+				ring.Queue(*request.release());
+				++queued;
+				continue;
+			}
+
+			inFlight.erase(request.get());
+			Ring::Close(*request);
+			Succeed(*request);
+		}
+		StoreRelease(ring.cqHead, head);
+	}
+#endif
+}
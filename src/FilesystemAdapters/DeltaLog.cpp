@@ -0,0 +1,143 @@
+#include "FilesystemAdapters/DeltaLog.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#if defined(__APPLE__) || defined(__MACH__)
+#include <boost/system/error_code.hpp>
+#else
+#include <system_error>
+#endif
+
+#include "Resources/DeltaCodec.h"
+
+#if defined(__APPLE__) || defined(__MACH__)
+using boost::system::error_code;
+#else
+using std::error_code;
+#endif
+using filesystem_adapters::DeltaLog;
+using resource::DeltaCodec;
+
+namespace
+{
+	const char MAGIC[8] = {'A', 'Z', 'R', 'E', 'S', 'D', 'L', 'T'};
+	const std::string RESOURCE_EXT = ".bin";
+	const std::string DELTA_EXT = ".delta";
+
+	std::vector<char> ReadFile(const std::string &filePath, const size_t size)
+	{
+		std::ifstream inFile(filePath, std::ios::binary);
+		std::vector<char> buff(size);
+		if (!inFile || !inFile.read(buff.data(), buff.size()))
+			throw std::runtime_error("DeltaLog could not read file: " + filePath);
+		return buff;
+	}
+} // end namespace anonymous
+
+DeltaLog::DeltaLog(const std::string_view filePath) : filePath_(filePath), logPath_(GetLogPath(filePath))
+{
+	if (!fs::exists(logPath_))
+		return;
+
+	const size_t size = static_cast<size_t>(fs::file_size(logPath_));
+	std::ifstream inFile(logPath_, std::ios::binary);
+	char magic[sizeof(MAGIC)];
+	if (!inFile.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+		throw std::runtime_error("DeltaLog file is not a delta log: " + logPath_);
+
+	// only the record sizes are read; a record that runs past the end of the file was cut short
+	end_ = sizeof(MAGIC);
+	uint64_t recordSize = 0;
+	while (end_ + sizeof(recordSize) <= size && inFile.read(reinterpret_cast<char *>(&recordSize), sizeof(recordSize)))
+	{
+		if (recordSize > size - end_ - sizeof(recordSize))
+			break;
+		end_ += sizeof(recordSize) + recordSize;
+		++length_;
+		inFile.seekg(end_);
+	}
+}
+
+DeltaLog::~DeltaLog() noexcept = default;
+
+std::string DeltaLog::GetLogPath(const std::string_view filePath)
+{
+	std::string logPath(filePath);
+	if (logPath.size() >= RESOURCE_EXT.size() && logPath.compare(logPath.size() - RESOURCE_EXT.size(), RESOURCE_EXT.size(), RESOURCE_EXT) == 0)
+		logPath.resize(logPath.size() - RESOURCE_EXT.size());
+	return logPath + DELTA_EXT;
+}
+
+size_t DeltaLog::GetLength() const
+{
+	return length_;
+}
+
+std::vector<char> DeltaLog::ReadImage() const
+{
+	if (!fs::exists(filePath_))
+		throw std::runtime_error("DeltaLog base image does not exist: " + filePath_);
+
+	std::vector<char> image = ReadFile(filePath_, static_cast<size_t>(fs::file_size(filePath_)));
+	if (length_ == 0)
+		return image;
+
+	const std::vector<char> log = ReadFile(logPath_, end_);
+	size_t offset = sizeof(MAGIC);
+	for (size_t record = 0; record < length_; ++record)
+	{
+		uint64_t recordSize = 0;
+		std::memcpy(&recordSize, log.data() + offset, sizeof(recordSize));
+		offset += sizeof(recordSize);
+		image = DeltaCodec::Apply(image.data(), image.size(), log.data() + offset, recordSize);
+		offset += recordSize;
+	}
+	return image;
+}
+
+void DeltaLog::Append(const std::vector<char> &delta)
+{
+	if (length_ == 0)
+	{
+		std::ofstream outFile(logPath_, std::ios::binary | std::ios::trunc);
+		if (!outFile.write(MAGIC, sizeof(MAGIC)))
+			throw std::runtime_error("DeltaLog could not create log: " + logPath_);
+		end_ = sizeof(MAGIC);
+	}
+	else if (static_cast<size_t>(fs::file_size(logPath_)) != end_)
+	{
+		// drop a record cut short by a crash
+		fs::resize_file(logPath_, end_);
+	}
+
+	std::ofstream outFile(logPath_, std::ios::binary | std::ios::app);
+	const uint64_t recordSize = delta.size();
+	outFile.write(reinterpret_cast<const char *>(&recordSize), sizeof(recordSize));
+	outFile.write(delta.data(), delta.size());
+	outFile.close();
+	if (!outFile)
+		throw std::runtime_error("DeltaLog could not append to log: " + logPath_);
+
+	end_ += sizeof(recordSize) + delta.size();
+	++length_;
+}
+
+void DeltaLog::Remove()
+{
+	if (fs::exists(logPath_))
+	{
+		error_code ec;
+		fs::remove(logPath_, ec);
+		if (ec)
+			throw std::runtime_error("DeltaLog could not remove log: " + logPath_);
+	}
+	length_ = 0;
+	end_ = 0;
+}
@@ -111,6 +111,7 @@ void EntityDeserializer::LoadWithParentKey(ISerializableEntity &entity, const st
 	std::replace(relativePath.begin(), relativePath.end(), '.', '/');
 	std::string absolutePath = (hierarchy_.GetSerializationPath().parent_path() / relativePath).string();
 	entity.Load(*tree, absolutePath);
+	entity.dirty_ = false;
 
 	for (const std::pair<std::string, pt::ptree> &child : *tree)
 	{
@@ -5,8 +5,8 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
-#include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 #include "Entities/Entity.h"
@@ -46,20 +46,44 @@ void EntitySerializer::Serialize(const ISerializableEntity &entity)
 	if (entity.GetKey().empty())
 		throw std::runtime_error("Cannot serialize entity because key=" + entity.GetKey() + " is not present in the loaded serialization structure");
 	SerializeWithParentKey(entity, "");
+	if (incremental_)
+		hierarchy_.SaveUpdates();
+	else
+		hierarchy_.SaveSerializationStructure();
+}
+
+void EntitySerializer::SetIncremental(const bool incremental)
+{
+	incremental_ = incremental;
+}
+
+bool EntitySerializer::GetIncremental() const
+{
+	return incremental_;
 }
 
 void EntitySerializer::SerializeWithParentKey(const ISerializableEntity &entity, const std::string_view parentKey)
 {
 	std::string searchPath = parentKey.empty() ? entity.GetKey() : std::string(parentKey) + "." + entity.GetKey();
 
-	pt::ptree &tree = hierarchy_.GetSerializationStructure().put_child(searchPath, pt::ptree());
+	// in incremental mode clean entities keep their node, so only what changed is saved and logged
+	if (!incremental_ || entity.IsDirty() || !hierarchy_.GetSerializationStructure().get_child_optional(searchPath))
+	{
+		std::string relativePath = searchPath;
+		std::replace(relativePath.begin(), relativePath.end(), '.', '/');
 
-	std::string relativePath = searchPath;
-	std::replace(relativePath.begin(), relativePath.end(), '.', '/');
+		std::string absolutePath = (hierarchy_.GetSerializationPath().parent_path() / relativePath).string();
 
-	std::string absolutePath = (hierarchy_.GetSerializationPath().parent_path() / relativePath).string();
+		pt::ptree fields;
+		entity.Save(fields, absolutePath);
 
-	entity.Save(tree, absolutePath);
+		// members that are not loaded keep their subtrees too
+		std::vector<Key> memberKeys;
+		for (const auto &[key, member] : entity.GetAggregatedMembers())
+			memberKeys.push_back(key);
+		hierarchy_.UpdateNode(searchPath, fields, memberKeys);
+		entity.dirty_ = false;
+	}
 
 	for (auto keys = entity.GetAggregatedMemberKeys<ISerializableEntity>(); const std::string &key : keys)
 	{
@@ -67,9 +91,6 @@ void EntitySerializer::SerializeWithParentKey(const ISerializableEntity &entity,
 		auto memberPtr = dynamic_cast<ISerializableEntity *>(member.get());
 		SerializeWithParentKey(*memberPtr, searchPath);
 	}
-
-	if (parentKey.empty())
-		boost::property_tree::json_parser::write_json(hierarchy_.GetSerializationPath().string(), hierarchy_.GetSerializationStructure());
 }
 
 EntityHierarchy &EntitySerializer::GetHierarchy()
@@ -0,0 +1,139 @@
+#include "FilesystemAdapters/FileChunkStore.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include "FilesystemAdapters/DeltaLog.h"
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "Resources/DataType.h"
+#include "Resources/Layout.h"
+#include "Resources/ZoneMap.h"
+
+using filesystem_adapters::DeltaLog;
+using filesystem_adapters::FileChunkStore;
+using filesystem_adapters::ResourceHeader;
+using resource::DataTypeConverter;
+using resource::ZoneMap;
+
+FileChunkStore::FileChunkStore(const std::string_view filePath) : filePath_(filePath)
+{
+	if (filePath_.empty())
+		throw std::runtime_error("File path is empty when opening chunk store");
+
+	// the payload on disk is stale until the deltas are folded into a new base image
+	if (DeltaLog(filePath_).GetLength() > 0)
+		throw std::runtime_error("FileChunkStore cannot chunk a file with pending deltas: " + filePath_);
+
+	file_.open(filePath_, std::ios::in | std::ios::out | std::ios::binary);
+	writable_ = file_.is_open();
+	if (!writable_)
+		file_.open(filePath_, std::ios::in | std::ios::binary);
+	if (!file_.is_open())
+		throw std::runtime_error("FileChunkStore could not open file: " + filePath_);
+
+	try
+	{
+		header_ = ResourceHeader::Read(file_);
+	}
+	catch (const std::runtime_error &)
+	{
+		throw std::runtime_error("FileChunkStore file does not hold a valid header: " + filePath_);
+	}
+	if (!(header_.GetLayout() == resource::Layout::RowMajor()))
+		throw std::runtime_error("FileChunkStore can only chunk row-major files: " + filePath_);
+	if (header_.IsQuantized())
+		throw std::runtime_error("FileChunkStore cannot chunk a quantized payload: " + filePath_);
+	if (header_.IsCompressed())
+		throw std::runtime_error("FileChunkStore cannot chunk a compressed payload: " + filePath_);
+
+	size_ = static_cast<size_t>(fs::file_size(filePath_)) - header_.GetSize();
+}
+
+FileChunkStore::~FileChunkStore() noexcept = default;
+
+const ResourceHeader &FileChunkStore::GetHeader() const
+{
+	return header_;
+}
+
+std::vector<size_t> FileChunkStore::GetShape() const
+{
+	return header_.GetShape();
+}
+
+resource::DataType FileChunkStore::GetDataType() const
+{
+	return header_.GetDataType();
+}
+
+size_t FileChunkStore::GetSize() const
+{
+	return size_;
+}
+
+void FileChunkStore::Read(const size_t offset, char *buff, const size_t n)
+{
+	if (offset + n > size_)
+		throw std::runtime_error("FileChunkStore cannot read past the end of file: " + filePath_);
+
+	file_.clear();
+	file_.seekg(static_cast<std::streamoff>(header_.GetSize() + offset));
+	file_.read(buff, static_cast<std::streamsize>(n));
+	if (!file_)
+		throw std::runtime_error("FileChunkStore could not read " + std::to_string(n) + " bytes from file: " + filePath_);
+}
+
+void FileChunkStore::Write(const size_t offset, const char *buff, const size_t n)
+{
+	if (!writable_)
+		throw std::runtime_error("FileChunkStore file is read-only: " + filePath_);
+	if (offset + n > size_)
+		throw std::runtime_error("FileChunkStore cannot write past the end of file: " + filePath_);
+
+	// the checksum no longer describes the payload once part of it is rewritten
+	if (header_.HasChecksum())
+	{
+		header_.ClearChecksum();
+		file_.clear();
+		file_.seekp(0);
+		header_.Write(file_);
+	}
+
+	file_.clear();
+	file_.seekp(static_cast<std::streamoff>(header_.GetSize() + offset));
+	file_.write(buff, static_cast<std::streamsize>(n));
+	file_.flush();
+	if (!file_)
+		throw std::runtime_error("FileChunkStore could not write " + std::to_string(n) + " bytes to file: " + filePath_);
+
+	// scans prune by the zone map, so it must keep covering the new values
+	if (header_.HasZoneMap() && n > 0)
+	{
+		UpdateZoneMap(offset, n);
+		file_.clear();
+		file_.seekp(0);
+		header_.Write(file_);
+		file_.flush();
+		if (!file_)
+			throw std::runtime_error("FileChunkStore could not update the zone map of file: " + filePath_);
+	}
+}
+
+void FileChunkStore::UpdateZoneMap(const size_t offset, const size_t n)
+{
+	ZoneMap zoneMap = header_.GetZoneMap();
+	const size_t blockBytes = zoneMap.GetBlockSize() * DataTypeConverter::GetSize(header_.GetDataType());
+	std::vector<char> block(blockBytes);
+	for (size_t i = offset / blockBytes; i * blockBytes < offset + n; ++i)
+	{
+		const size_t blockSize = std::min(blockBytes, size_ - i * blockBytes);
+		Read(i * blockBytes, block.data(), blockSize);
+		zoneMap.Update(i, block.data(), header_.GetDataType());
+	}
+	// the block count is unchanged, so the header keeps its size and the payload stays in place
+	header_.SetZoneMap(zoneMap);
+}
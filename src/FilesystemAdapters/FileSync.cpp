@@ -0,0 +1,58 @@
+#include "FilesystemAdapters/FileSync.h"
+
+#include <string>
+
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+int filesystem_adapters::SyncFile(const int fd)
+{
+	return _commit(fd);
+}
+
+bool filesystem_adapters::SyncPath(const std::string &filePath)
+{
+	const int fd = _open(filePath.c_str(), _O_BINARY | _O_WRONLY);
+	if (fd < 0)
+		return false;
+	const bool synced = SyncFile(fd) == 0;
+	return _close(fd) == 0 && synced;
+}
+
+// directory entries are durable once written on Windows
+bool filesystem_adapters::SyncDirectory(const std::string &)
+{
+	return true;
+}
+#else
+// fsync on macOS leaves the data in the drive cache, which F_FULLFSYNC flushes
+int filesystem_adapters::SyncFile(const int fd)
+{
+#if defined(F_FULLFSYNC)
+	if (::fcntl(fd, F_FULLFSYNC) == 0)
+		return 0;
+#endif
+	return ::fsync(fd);
+}
+
+bool filesystem_adapters::SyncPath(const std::string &filePath)
+{
+	const int fd = ::open(filePath.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	const bool synced = SyncFile(fd) == 0;
+	return ::close(fd) == 0 && synced;
+}
+
+// a created, renamed or removed file is only durable once its directory is synced
+bool filesystem_adapters::SyncDirectory(const std::string &directory)
+{
+	return SyncPath(directory.empty() ? std::string(".") : directory);
+}
+#endif
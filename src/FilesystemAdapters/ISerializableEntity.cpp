@@ -18,11 +18,43 @@ using SharedEntity = Entity::SharedEntity;
 ISerializableEntity::ISerializableEntity() = default;
 ISerializableEntity::~ISerializableEntity() noexcept = default;
 
-ISerializableEntity::ISerializableEntity(const ISerializableEntity &) = default;
-ISerializableEntity &ISerializableEntity::operator=(const ISerializableEntity &) = default;
+// a copy has not been saved yet
+ISerializableEntity::ISerializableEntity(const ISerializableEntity &other) : Entity(other)
+{
+}
+
+ISerializableEntity &ISerializableEntity::operator=(const ISerializableEntity &other)
+{
+	Entity::operator=(other);
+	dirty_ = true;
+	return *this;
+}
+
 ISerializableEntity::ISerializableEntity(ISerializableEntity &&) noexcept = default;
 ISerializableEntity &ISerializableEntity::operator=(ISerializableEntity &&) noexcept = default;
 
+void ISerializableEntity::MarkDirty()
+{
+	dirty_ = true;
+}
+
+bool ISerializableEntity::IsDirty() const
+{
+	return dirty_;
+}
+
+void ISerializableEntity::RemoveMember(const Key &key)
+{
+	Entity::RemoveMember(key);
+	dirty_ = true;
+}
+
+void ISerializableEntity::RemoveMember(SharedEntity sharedObj)
+{
+	Entity::RemoveMember(std::move(sharedObj));
+	dirty_ = true;
+}
+
 SharedEntity &ISerializableEntity::GetAggregatedMember(const Key &key) const
 {
 	MemberMap &members = Entity::GetAggregatedMembers();
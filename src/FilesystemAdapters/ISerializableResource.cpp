@@ -1,14 +1,93 @@
 #include "FilesystemAdapters/ISerializableResource.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "Resources/ChunkedResource.h"
+#include "Resources/CompressedResource.h"
+#include "Resources/SparseResource.h"
+
 using filesystem_adapters::ISerializableResource;
+using filesystem_adapters::ResourceSnapshot;
 using LockedResource = filesystem_adapters::ISerializableResource::LockedResource;
 
-ISerializableResource::ISerializableResource() : mtx_{std::make_shared<std::mutex>()} {};
-ISerializableResource::~ISerializableResource() noexcept = default;
-ISerializableResource::ISerializableResource(const ISerializableResource &) = default;
-ISerializableResource &ISerializableResource::operator=(const ISerializableResource &) = default;
-ISerializableResource::ISerializableResource(ISerializableResource &&) noexcept = default;
-ISerializableResource &ISerializableResource::operator=(ISerializableResource &&) noexcept = default;
+namespace
+{
+    // optimistic attempts before a reader falls back to the shared lock
+    const size_t MAX_OPTIMISTIC_READS = 64;
+    // published size of a payload that does not fit the seqlock
+    const size_t NOT_PUBLISHED = std::numeric_limits<size_t>::max();
+
+    // Data() holds GetElementSize() * M * N bytes only for resident dense payloads
+    bool IsDense(const ISerializableResource &resource)
+    {
+        return !dynamic_cast<const resource::SparseResource *>(&resource) &&
+               !dynamic_cast<const resource::ChunkedResource *>(&resource) &&
+               !dynamic_cast<const resource::CompressedResource *>(&resource);
+    }
+
+    void ThrowIfNotDense(const ISerializableResource &resource)
+    {
+        if (!IsDense(resource))
+            throw std::runtime_error("Consistent reads are only supported for dense, uncompressed resources");
+    }
+} // end namespace anonymous
+
+/**
+ * @brief Sequence counter and payload copy for optimistic reads.
+ *
+ * The copy is held in relaxed atomic words so that readers racing a writer see torn values instead of undefined
+ * behaviour; the sequence tells them to retry. It is sized once and lives as long as the resource, so readers never
+ * race its reclamation; disabling only stops publishing.
+ */
+struct ISerializableResource::Seqlock
+{
+    explicit Seqlock(const size_t capacity)
+        : capacity(capacity), words(new std::atomic<uint64_t>[(capacity + sizeof(uint64_t) - 1) / sizeof(uint64_t)]())
+    {
+    }
+
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<size_t> size{NOT_PUBLISHED};
+    std::atomic<bool> enabled{true};
+    const size_t capacity;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+};
+
+ISerializableResource::ISerializableResource() : mtx_{std::make_shared<std::shared_mutex>()} {};
+ISerializableResource::~ISerializableResource() noexcept
+{
+    delete seqlock_.load();
+}
+ISerializableResource::ISerializableResource(const ISerializableResource &other) : resource::IResource(other), mtx_(other.mtx_) {};
+ISerializableResource &ISerializableResource::operator=(const ISerializableResource &other)
+{
+    resource::IResource::operator=(other);
+    mtx_ = other.mtx_;
+    return *this;
+}
+ISerializableResource::ISerializableResource(ISerializableResource &&other) noexcept
+    : resource::IResource(std::move(other)),
+      mtx_(std::move(other.mtx_)),
+      seqlock_(other.seqlock_.exchange(nullptr)),
+      version_(other.version_.load()),
+      snapshot_(std::move(other.snapshot_))
+{
+}
+ISerializableResource &ISerializableResource::operator=(ISerializableResource &&other) noexcept
+{
+    resource::IResource::operator=(std::move(other));
+    mtx_ = std::move(other.mtx_);
+    delete seqlock_.exchange(other.seqlock_.exchange(nullptr));
+    version_ = other.version_.load();
+    std::lock_guard<std::mutex> lock(snapshotMtx_);
+    snapshot_ = std::move(other.snapshot_);
+    return *this;
+}
 
 LockedResource ISerializableResource::Lock()
 {
@@ -17,18 +96,257 @@ LockedResource ISerializableResource::Lock()
 
 const LockedResource ISerializableResource::Lock() const
 {
-    return LockedResource(const_cast<ISerializableResource &>(*this));
+    return LockedResource(const_cast<ISerializableResource &>(*this), true);
+}
+
+const LockedResource ISerializableResource::LockShared() const
+{
+    return Lock();
+}
+
+std::shared_ptr<const ResourceSnapshot> ISerializableResource::CopySnapshot() const
+{
+    {
+        std::lock_guard<std::mutex> lock(snapshotMtx_);
+        if (snapshot_)
+            return snapshot_;
+    }
+
+    // writers invalidate the cache while holding the exclusive lock, so caching under the shared lock never keeps a stale version
+    const LockedResource lock = Lock();
+    auto snapshot = std::make_shared<const ResourceSnapshot>(*this, version_.load());
+
+    std::lock_guard<std::mutex> snapshotLock(snapshotMtx_);
+    if (!snapshot_)
+        snapshot_ = snapshot;
+    return snapshot_;
+}
+
+uint64_t ISerializableResource::GetVersion() const
+{
+    return version_.load();
+}
+
+void ISerializableResource::EnableSeqlock(const size_t capacity)
+{
+    ThrowIfNotDense(*this);
+
+    LockedResource lock = Lock();
+    if (Seqlock *seqlock = seqlock_.load(std::memory_order_acquire))
+    {
+        if (seqlock->capacity != capacity)
+            throw std::runtime_error("Seqlock is already sized for " + std::to_string(seqlock->capacity) + " bytes");
+        seqlock->enabled.store(true, std::memory_order_relaxed);
+    }
+    else
+    {
+        seqlock_.store(new Seqlock(capacity), std::memory_order_release);
+    }
+    // the current payload is published when the lock is released
+}
+
+void ISerializableResource::DisableSeqlock()
+{
+    LockedResource lock = Lock();
+    Seqlock *seqlock = seqlock_.load(std::memory_order_acquire);
+    if (!seqlock)
+        return;
+
+    // readers that still see the seqlock fall back to the shared lock
+    const uint64_t sequence = seqlock->sequence.load(std::memory_order_relaxed);
+    seqlock->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    seqlock->size.store(NOT_PUBLISHED, std::memory_order_relaxed);
+    seqlock->enabled.store(false, std::memory_order_relaxed);
+    seqlock->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool ISerializableResource::IsSeqlockEnabled() const
+{
+    const Seqlock *seqlock = seqlock_.load(std::memory_order_acquire);
+    return seqlock && seqlock->enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t ISerializableResource::GetSeqlockVersion() const
+{
+    if (!IsSeqlockEnabled())
+        return 0;
+    return seqlock_.load(std::memory_order_acquire)->sequence.load(std::memory_order_acquire) / 2;
 }
 
-LockedResource::LockedResource(ISerializableResource &o) : obj_(&o), lk_(*o.mtx_) {}
+void ISerializableResource::Publish() const
+{
+    Seqlock &seqlock = *seqlock_.load(std::memory_order_relaxed);
+    const size_t size = GetElementSize() * GetColumnSize() * GetRowSize();
+
+    // writers are serialized by the exclusive lock, so a plain increment makes the sequence odd
+    const uint64_t sequence = seqlock.sequence.load(std::memory_order_relaxed);
+    seqlock.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (size > seqlock.capacity)
+    {
+        seqlock.size.store(NOT_PUBLISHED, std::memory_order_relaxed);
+    }
+    else
+    {
+        const char *data = static_cast<const char *>(Data());
+        for (size_t offset = 0; offset < size; offset += sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, data + offset, std::min(sizeof(uint64_t), size - offset));
+            seqlock.words[offset / sizeof(uint64_t)].store(word, std::memory_order_relaxed);
+        }
+        seqlock.size.store(size, std::memory_order_relaxed);
+    }
+
+    seqlock.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+size_t ISerializableResource::ReadLocked(char *buff, const size_t n) const
+{
+    ThrowIfNotDense(*this);
+
+    const LockedResource lock = Lock();
+    const size_t size = lock.GetElementSize() * lock.GetColumnSize() * lock.GetRowSize();
+    if (size > n)
+        throw std::runtime_error("Buffer of " + std::to_string(n) + " bytes cannot hold a payload of " + std::to_string(size) + " bytes");
+    if (size > 0)
+        std::memcpy(buff, lock.Data(), size);
+    return size;
+}
+
+size_t ISerializableResource::ReadConsistent(char *buff, const size_t n) const
+{
+    const Seqlock *current = seqlock_.load(std::memory_order_acquire);
+    if (!current)
+        return ReadLocked(buff, n);
+
+    const Seqlock &seqlock = *current;
+    for (size_t attempt = 0; attempt < MAX_OPTIMISTIC_READS; ++attempt)
+    {
+        const uint64_t before = seqlock.sequence.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            // a writer is publishing
+            std::this_thread::yield();
+            continue;
+        }
+
+        const size_t size = seqlock.size.load(std::memory_order_relaxed);
+        if (size == NOT_PUBLISHED)
+            break;
+
+        const size_t copied = std::min(size, n);
+        for (size_t offset = 0; offset < copied; offset += sizeof(uint64_t))
+        {
+            const uint64_t word = seqlock.words[offset / sizeof(uint64_t)].load(std::memory_order_relaxed);
+            std::memcpy(buff + offset, &word, std::min(sizeof(uint64_t), copied - offset));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seqlock.sequence.load(std::memory_order_relaxed) != before)
+            continue;
+
+        if (size > n)
+            throw std::runtime_error("Buffer of " + std::to_string(n) + " bytes cannot hold a payload of " + std::to_string(size) + " bytes");
+        return size;
+    }
+    return ReadLocked(buff, n);
+}
+
+LockedResource::LockedResource(ISerializableResource &o, const bool shared) : obj_(&o)
+{
+    if (shared)
+        sharedLk_ = std::shared_lock<std::shared_mutex>(*o.mtx_);
+    else
+        lk_ = std::unique_lock<std::shared_mutex>(*o.mtx_);
+
+    // keep compressed payloads resident so that pointers from Data() stay valid while locked
+    if (auto compressed = dynamic_cast<const resource::CompressedResource *>(obj_))
+        pin_ = compressed->Pin();
+}
+
+LockedResource::~LockedResource()
+{
+    EndWrite();
+}
+
+void LockedResource::EndWrite()
+{
+    if (!lk_.owns_lock())
+        return;
+
+    // start the next version before the pin and the lock are released so that readers never see a partial write
+    ++obj_->version_;
+    {
+        std::lock_guard<std::mutex> lock(obj_->snapshotMtx_);
+        obj_->snapshot_.reset();
+    }
+    if (obj_->IsSeqlockEnabled())
+        obj_->Publish();
+}
+
+LockedResource::LockedResource(LockedResource &&other) noexcept = default;
+LockedResource &LockedResource::operator=(LockedResource &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    EndWrite();
+    pin_.reset();
+    obj_ = other.obj_;
+    lk_ = std::move(other.lk_);
+    sharedLk_ = std::move(other.sharedLk_);
+    pin_ = std::move(other.pin_);
+    return *this;
+}
+
+bool LockedResource::IsShared() const { return sharedLk_.owns_lock(); };
+void LockedResource::ThrowIfShared() const
+{
+    if (IsShared())
+        throw std::runtime_error("Cannot modify a resource through a shared lock");
+}
 size_t LockedResource::GetColumnSize() const { return obj_->GetColumnSize(); };
 size_t LockedResource::GetRowSize() const { return obj_->GetRowSize(); };
+size_t LockedResource::GetRank() const { return obj_->GetRank(); };
+std::vector<size_t> LockedResource::GetShape() const { return obj_->GetShape(); };
+const resource::Layout &LockedResource::GetLayout() const { return obj_->GetLayout(); };
 bool LockedResource::GetDirty() const { return obj_->GetDirty(); };
 size_t LockedResource::GetElementSize() const { return obj_->GetElementSize(); };
-void *LockedResource::Data() { return obj_->Data(); };
-const void *LockedResource::Data() const { return obj_->Data(); };
-void LockedResource::Assign(const char *buff, const size_t n) { return obj_->Assign(buff, n); };
-void LockedResource::SetColumnSize(const size_t size) { obj_->SetColumnSize(size); };
-void LockedResource::SetRowSize(const size_t size) { obj_->SetRowSize(size); };
+resource::DataType LockedResource::GetDataType() const { return obj_->GetDataType(); };
+void *LockedResource::Data()
+{
+    ThrowIfShared();
+    return obj_->Data();
+};
+const void *LockedResource::Data() const { return static_cast<const ISerializableResource *>(obj_)->Data(); };
+void LockedResource::Assign(const char *buff, const size_t n)
+{
+    ThrowIfShared();
+    return obj_->Assign(buff, n);
+};
+void LockedResource::SetColumnSize(const size_t size)
+{
+    ThrowIfShared();
+    obj_->SetColumnSize(size);
+};
+void LockedResource::SetRowSize(const size_t size)
+{
+    ThrowIfShared();
+    obj_->SetRowSize(size);
+};
+void LockedResource::SetShape(const std::vector<size_t> &shape)
+{
+    ThrowIfShared();
+    obj_->SetShape(shape);
+};
+void LockedResource::SetLayout(const resource::Layout &layout)
+{
+    ThrowIfShared();
+    obj_->SetLayout(layout);
+};
 bool LockedResource::UpdateChecksum() const { return obj_->UpdateChecksum(); };
+int LockedResource::GetChecksum() const { return obj_->GetChecksum(); };
 int LockedResource::Checksum() const { return obj_->Checksum(); };
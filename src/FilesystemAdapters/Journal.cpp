@@ -0,0 +1,523 @@
+#include "FilesystemAdapters/Journal.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#if defined(__APPLE__) || defined(__MACH__)
+#include <boost/system/error_code.hpp>
+#else
+#include <system_error>
+#endif
+
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "FilesystemAdapters/DeltaLog.h"
+#include "FilesystemAdapters/FileSync.h"
+#include "Resources/IResource.h"
+
+#if defined(__APPLE__) || defined(__MACH__)
+using boost::system::error_code;
+#else
+using std::error_code;
+#endif
+using filesystem_adapters::DeltaLog;
+using filesystem_adapters::Journal;
+using filesystem_adapters::SyncDirectory;
+using filesystem_adapters::SyncFile;
+using filesystem_adapters::SyncPath;
+using resource::IResource;
+
+namespace
+{
+	const char MAGIC[8] = {'A', 'Z', 'R', 'E', 'S', 'W', 'A', 'L'};
+	const std::string TMP_EXT = ".tmp";
+
+	// path size, checksum and image size
+	const uint64_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+	// the image size of a removal, which has no image
+	const uint64_t TOMBSTONE = ~uint64_t(0);
+
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+	int OpenJournal(const std::string &filePath)
+	{
+		return _open(filePath.c_str(), _O_BINARY | _O_WRONLY | _O_CREAT | _O_TRUNC | _O_APPEND, _S_IREAD | _S_IWRITE);
+	}
+
+	long long WriteFile(const int fd, const char *buff, const size_t n)
+	{
+		return _write(fd, buff, static_cast<unsigned int>(n));
+	}
+
+	int TruncateFile(const int fd, const size_t size)
+	{
+		return _chsize_s(fd, static_cast<long long>(size));
+	}
+
+	int CloseFile(const int fd)
+	{
+		return _close(fd);
+	}
+#else
+	int OpenJournal(const std::string &filePath)
+	{
+		return ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+	}
+
+	long long WriteFile(const int fd, const char *buff, const size_t n)
+	{
+		return ::write(fd, buff, n);
+	}
+
+	int TruncateFile(const int fd, const size_t size)
+	{
+		return ::ftruncate(fd, static_cast<off_t>(size));
+	}
+
+	int CloseFile(const int fd)
+	{
+		return ::close(fd);
+	}
+#endif
+
+	bool WriteAll(const int fd, const char *buff, size_t n)
+	{
+		while (n > 0)
+		{
+			const long long written = WriteFile(fd, buff, n);
+			if (written < 0 && errno == EINTR)
+				continue;
+			if (written <= 0)
+				return false;
+			buff += written;
+			n -= static_cast<size_t>(written);
+		}
+		return true;
+	}
+
+	struct Buffer
+	{
+		const char *data;
+		size_t size;
+	};
+
+#if defined(_WIN64) || defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+	bool WriteAll(const int fd, const std::vector<Buffer> &buffers)
+	{
+		for (const Buffer &buffer : buffers)
+		{
+			if (!WriteAll(fd, buffer.data, buffer.size))
+				return false;
+		}
+		return true;
+	}
+#else
+	// one system call writes many records, without first copying them into one buffer
+	bool WriteAll(const int fd, const std::vector<Buffer> &buffers)
+	{
+		std::vector<iovec> vectors;
+		vectors.reserve(buffers.size());
+		for (const Buffer &buffer : buffers)
+		{
+			if (buffer.size > 0)
+				vectors.push_back({const_cast<char *>(buffer.data), buffer.size});
+		}
+
+		size_t first = 0;
+		while (first < vectors.size())
+		{
+			const int count = static_cast<int>(std::min(vectors.size() - first, static_cast<size_t>(IOV_MAX)));
+			const ssize_t written = ::writev(fd, vectors.data() + first, count);
+			if (written < 0 && errno == EINTR)
+				continue;
+			if (written <= 0)
+				return false;
+
+			// skip the buffers written in full and resume within a buffer written in part
+			size_t remaining = static_cast<size_t>(written);
+			while (first < vectors.size() && remaining >= vectors[first].iov_len)
+				remaining -= vectors[first++].iov_len;
+			if (remaining > 0)
+			{
+				vectors[first].iov_base = static_cast<char *>(vectors[first].iov_base) + remaining;
+				vectors[first].iov_len -= remaining;
+			}
+		}
+		return true;
+	}
+#endif
+
+	// the checksum of the image is combined with that of the path, so the image is not hashed again
+	std::string MakeHead(const std::string_view filePath, const char *data, const size_t size, const uint32_t imageChecksum)
+	{
+		if (filePath.size() > UINT32_MAX)
+			throw std::runtime_error("Journal path is too long: " + std::string(filePath.substr(0, 64)));
+
+		const uint32_t pathSize = static_cast<uint32_t>(filePath.size());
+		const uint64_t length = data ? size : TOMBSTONE;
+		uint32_t checksum = IResource::Crc32(filePath.data(), filePath.size());
+		if (data)
+			checksum = IResource::Crc32Combine(checksum, imageChecksum, size);
+
+		std::string head;
+		head.reserve(RECORD_HEADER_SIZE + filePath.size());
+		head.append(reinterpret_cast<const char *>(&pathSize), sizeof(pathSize));
+		head.append(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+		head.append(reinterpret_cast<const char *>(&length), sizeof(length));
+		head.append(filePath.data(), filePath.size());
+		return head;
+	}
+
+	std::string GetDirectory(const std::string &filePath)
+	{
+		return fs::path(filePath).parent_path().string();
+	}
+} // end namespace anonymous
+
+Journal::Journal(const std::string_view filePath, const size_t checkpointSize) : filePath_(filePath), checkpointSize_(checkpointSize)
+{
+	if (filePath_.empty())
+		throw std::runtime_error("Path is empty when opening journal");
+
+	const std::string directory = GetDirectory(filePath_);
+	if (!directory.empty())
+	{
+		error_code ec;
+		fs::create_directories(fs::path(directory), ec);
+		if (ec)
+			throw std::runtime_error("Journal could not create the directory: " + directory);
+	}
+
+	// the files are synced before the records that restore them are dropped
+	recoveredCount_ = Replay();
+
+	fd_ = OpenJournal(filePath_);
+	if (fd_ < 0)
+		throw std::runtime_error("Journal could not open file: " + filePath_);
+	if (!WriteAll(fd_, MAGIC, sizeof(MAGIC)) || SyncFile(fd_) != 0 || !SyncDirectory(directory))
+	{
+		CloseFile(fd_);
+		throw std::runtime_error("Journal could not write file: " + filePath_);
+	}
+	size_ = sizeof(MAGIC);
+}
+
+Journal::~Journal() noexcept
+{
+	if (checkpoint_.valid())
+		checkpoint_.wait();
+	try
+	{
+		Checkpoint();
+	}
+	catch (...)
+	{
+		// the records stay in the journal and are replayed when it is opened again
+	}
+	CloseFile(fd_);
+}
+
+const std::string &Journal::GetPath() const
+{
+	return filePath_;
+}
+
+size_t Journal::GetSize() const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+	return size_;
+}
+
+size_t Journal::GetCommitCount() const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+	return commitCount_;
+}
+
+size_t Journal::GetRecoveredCount() const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+	return recoveredCount_;
+}
+
+void Journal::Write(const std::string_view filePath, const char *data, const size_t size, const std::function<void()> &apply)
+{
+	if (!data && size > 0)
+		throw std::runtime_error("Cannot journal a null image of file: " + std::string(filePath));
+	Write(filePath, data, size, IResource::Crc32(data, size), apply);
+}
+
+void Journal::Write(const std::string_view filePath, const char *data, const size_t size, const uint32_t checksum, const std::function<void()> &apply)
+{
+	if (filePath.empty())
+		throw std::runtime_error("Cannot journal a file with an empty path: " + filePath_);
+	if (!data && size > 0)
+		throw std::runtime_error("Cannot journal a null image of file: " + std::string(filePath));
+
+	const char *image = data ? data : "";
+	Record record{MakeHead(filePath, image, size, checksum), image, size};
+
+	bool full = false;
+	{
+		// a checkpoint must not drop the record before the file reflects it
+		std::shared_lock<std::shared_mutex> checkpointLock(checkpointLock_);
+		Commit(std::move(record));
+		{
+			std::lock_guard<std::mutex> lock(lock_);
+			dirty_.insert(std::string(filePath));
+			full = size_ >= checkpointSize_;
+		}
+		apply();
+	}
+	if (full)
+		StartCheckpoint();
+}
+
+void Journal::Remove(const std::string_view filePath, const std::function<void()> &apply)
+{
+	if (filePath.empty())
+		throw std::runtime_error("Cannot journal a file with an empty path: " + filePath_);
+
+	Record record{MakeHead(filePath, nullptr, 0, 0)};
+
+	std::shared_lock<std::shared_mutex> checkpointLock(checkpointLock_);
+	Commit(std::move(record));
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		dirty_.insert(std::string(filePath));
+	}
+	apply();
+}
+
+void Journal::Flush(const std::string_view filePath)
+{
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		dirty_.insert(std::string(filePath));
+	}
+	Checkpoint();
+}
+
+void Journal::Checkpoint()
+{
+	std::unique_lock<std::shared_mutex> checkpointLock(checkpointLock_);
+
+	std::set<std::string> dirty;
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		dirty.swap(dirty_);
+	}
+
+	try
+	{
+		std::set<std::string> directories;
+		for (const std::string &filePath : dirty)
+		{
+			const std::string logPath = DeltaLog::GetLogPath(filePath);
+			if (fs::exists(fs::path(filePath)) && !SyncPath(filePath))
+				throw std::runtime_error("Journal could not sync file: " + filePath);
+			if (fs::exists(fs::path(logPath)) && !SyncPath(logPath))
+				throw std::runtime_error("Journal could not sync file: " + logPath);
+			directories.insert(GetDirectory(filePath));
+		}
+		for (const std::string &directory : directories)
+		{
+			if (!SyncDirectory(directory))
+				throw std::runtime_error("Journal could not sync directory: " + directory);
+		}
+
+		// no writer is between its commit and its write, so every record is reflected in a synced file
+		if (TruncateFile(fd_, sizeof(MAGIC)) != 0 || SyncFile(fd_) != 0)
+			throw std::runtime_error("Journal could not truncate file: " + filePath_);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		dirty_.insert(dirty.cbegin(), dirty.cend());
+		throw;
+	}
+
+	std::lock_guard<std::mutex> lock(lock_);
+	size_ = sizeof(MAGIC);
+}
+
+void Journal::StartCheckpoint()
+{
+	std::lock_guard<std::mutex> lock(lock_);
+
+	if (checkpoint_.valid() && checkpoint_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+	checkpoint_ = std::async(std::launch::async, [this]()
+							 { Checkpoint(); });
+}
+
+void Journal::WaitForCheckpoint()
+{
+	std::future<void> checkpoint;
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		checkpoint = std::move(checkpoint_);
+	}
+	if (checkpoint.valid())
+		checkpoint.get();
+}
+
+void Journal::Commit(Record record)
+{
+	std::unique_lock<std::mutex> lock(lock_);
+
+	if (failed_)
+		throw std::runtime_error("Journal could not commit to file: " + filePath_);
+	queue_.push_back(std::move(record));
+	const uint64_t sequence = ++queued_;
+
+	while (durable_ < sequence)
+	{
+		if (failed_)
+			throw std::runtime_error("Journal could not commit to file: " + filePath_);
+		if (committing_)
+		{
+			committed_.wait(lock);
+			continue;
+		}
+
+		// the first writer to find no commit in progress commits every queued record with a single sync
+		committing_ = true;
+		std::vector<Record> group;
+		group.swap(queue_);
+		const uint64_t last = queued_;
+		lock.unlock();
+
+		// the images stay valid, since their writers wait for this commit
+		std::vector<Buffer> buffers;
+		buffers.reserve(2 * group.size());
+		size_t groupSize = 0;
+		for (const Record &queued : group)
+		{
+			buffers.push_back({queued.head.data(), queued.head.size()});
+			buffers.push_back({queued.image, queued.size});
+			groupSize += queued.head.size() + queued.size;
+		}
+		const bool written = WriteAll(fd_, buffers) && SyncFile(fd_) == 0;
+
+		lock.lock();
+		committing_ = false;
+		if (written)
+		{
+			durable_ = last;
+			size_ += groupSize;
+			++commitCount_;
+		}
+		else
+		{
+			failed_ = true;
+		}
+		committed_.notify_all();
+	}
+}
+
+size_t Journal::Replay()
+{
+	if (!fs::exists(fs::path(filePath_)))
+		return 0;
+
+	const size_t fileSize = static_cast<size_t>(fs::file_size(fs::path(filePath_)));
+	std::vector<char> records(fileSize);
+	std::ifstream inFile(filePath_, std::ios::binary);
+	if (!inFile || !inFile.read(records.data(), static_cast<std::streamsize>(fileSize)))
+		throw std::runtime_error("Journal could not read file: " + filePath_);
+	inFile.close();
+	if (fileSize < sizeof(MAGIC) || std::memcmp(records.data(), MAGIC, sizeof(MAGIC)) != 0)
+		throw std::runtime_error("Journal file is not a journal: " + filePath_);
+
+	// only the latest record of a file is replayed; a record cut short or corrupted by a crash ends the journal
+	std::map<std::string, std::pair<uint64_t, uint64_t>> latest;
+	for (uint64_t offset = sizeof(MAGIC); offset + RECORD_HEADER_SIZE <= fileSize;)
+	{
+		uint32_t pathSize = 0;
+		uint32_t checksum = 0;
+		uint64_t length = 0;
+		std::memcpy(&pathSize, records.data() + offset, sizeof(pathSize));
+		std::memcpy(&checksum, records.data() + offset + sizeof(pathSize), sizeof(checksum));
+		std::memcpy(&length, records.data() + offset + sizeof(pathSize) + sizeof(checksum), sizeof(length));
+
+		const uint64_t available = fileSize - offset - RECORD_HEADER_SIZE;
+		const uint64_t imageSize = length == TOMBSTONE ? 0 : length;
+		if (pathSize == 0 || pathSize > available || imageSize > available - pathSize)
+			break;
+
+		const char *path = records.data() + offset + RECORD_HEADER_SIZE;
+		uint32_t actual = IResource::Crc32(path, pathSize);
+		if (length != TOMBSTONE)
+			actual = IResource::Crc32(path + pathSize, imageSize, actual);
+		if (actual != checksum)
+			break;
+
+		latest.insert_or_assign(std::string(path, pathSize), std::make_pair(offset + RECORD_HEADER_SIZE + pathSize, length));
+		offset += RECORD_HEADER_SIZE + pathSize + imageSize;
+	}
+
+	std::set<std::string> directories;
+	for (const auto &[filePath, record] : latest)
+	{
+		const auto [imageOffset, length] = record;
+		const std::string directory = GetDirectory(filePath);
+		error_code ec;
+
+		// the image is the whole file, so deltas against an older base image no longer apply
+		fs::remove(fs::path(DeltaLog::GetLogPath(filePath)), ec);
+		if (length == TOMBSTONE)
+		{
+			fs::remove(fs::path(filePath), ec);
+			directories.insert(directory);
+			continue;
+		}
+
+		if (!directory.empty())
+			fs::create_directories(fs::path(directory), ec);
+		const std::string tmpPath = filePath + TMP_EXT;
+		{
+			std::ofstream outFile(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!outFile.write(records.data() + imageOffset, static_cast<std::streamsize>(length)))
+				throw std::runtime_error("Journal could not replay file: " + filePath);
+		}
+		if (!SyncPath(tmpPath))
+			throw std::runtime_error("Journal could not sync file: " + tmpPath);
+		fs::rename(fs::path(tmpPath), fs::path(filePath), ec);
+		if (ec)
+			throw std::runtime_error("Journal could not replay file: " + filePath);
+		directories.insert(directory);
+	}
+	for (const std::string &directory : directories)
+	{
+		if (!SyncDirectory(directory))
+			throw std::runtime_error("Journal could not sync directory: " + directory);
+	}
+	return latest.size();
+}
@@ -0,0 +1,184 @@
+#include "FilesystemAdapters/MappedResource.h"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "FilesystemAdapters/DeltaLog.h"
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "Resources/DataType.h"
+
+using filesystem_adapters::DeltaLog;
+using filesystem_adapters::MapAdvice;
+using filesystem_adapters::MapMode;
+using filesystem_adapters::MappedResource;
+using filesystem_adapters::ResourceHeader;
+
+MappedResource::MappedResource(const MapMode mode) : mode_(mode) {}
+MappedResource::~MappedResource() noexcept = default;
+
+MappedResource::MappedResource(MappedResource &&other) noexcept
+	: IResource(std::move(other)), ISerializableResource(std::move(other)), mode_(other.mode_), filePath_(std::move(other.filePath_)), region_(std::move(other.region_)), dataOffset_(other.dataOffset_), owned_(std::move(other.owned_))
+{
+}
+
+MappedResource &MappedResource::operator=(MappedResource &&other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	ISerializableResource::operator=(std::move(other));
+	mode_ = other.mode_;
+	filePath_ = std::move(other.filePath_);
+	region_ = std::move(other.region_);
+	dataOffset_ = other.dataOffset_;
+	owned_ = std::move(other.owned_);
+	return *this;
+}
+
+void MappedResource::Map(const std::string_view filePath)
+{
+	using namespace boost::interprocess;
+
+	if (filePath.empty())
+		throw std::runtime_error("File path is empty when mapping resource");
+	if (region_)
+		throw std::runtime_error("MappedResource is already mapped to " + filePath_);
+
+	const std::string path = std::string(filePath);
+	// the payload on disk is stale until the deltas are folded into a new base image
+	if (DeltaLog(path).GetLength() > 0)
+		throw std::runtime_error("MappedResource cannot map a file with pending deltas: " + path);
+
+	std::unique_ptr<mapped_region> region;
+	try
+	{
+		// copy-on-write pages are private, so the file itself only needs to be readable
+		file_mapping file(path.c_str(), read_only);
+		region = std::make_unique<mapped_region>(file, mode_ == MapMode::ReadOnly ? read_only : copy_on_write);
+	}
+	catch (const interprocess_exception &)
+	{
+		throw std::runtime_error("MappedResource could not map file: " + path);
+	}
+
+	const size_t size = region->get_size();
+	ResourceHeader header;
+	try
+	{
+		header = ResourceHeader::Read(static_cast<const char *>(region->get_address()), size);
+	}
+	catch (const std::runtime_error &)
+	{
+		throw std::runtime_error("MappedResource file does not hold a valid header: " + path);
+	}
+	if (header.IsQuantized())
+		throw std::runtime_error("MappedResource cannot map a quantized payload: " + path);
+	if (header.IsCompressed())
+		throw std::runtime_error("MappedResource cannot map a compressed payload: " + path);
+	if (resource::DataTypeConverter::RequiresConversion(header.GetDataType(), GetDataType()))
+		throw std::runtime_error("MappedResource cannot map " + resource::DataTypeConverter::GetName(header.GetDataType()) + " elements as " + resource::DataTypeConverter::GetName(GetDataType()) + ": " + path);
+	if (size != header.GetSize() + header.GetElementCount() * GetElementSize())
+		throw std::runtime_error("MappedResource file size does not match its dimensions: " + path);
+
+	SetShape(header.GetShape());
+	SetLayout(header.GetLayout());
+
+	region_ = std::move(region);
+	dataOffset_ = header.GetSize();
+	filePath_ = path;
+	owned_.clear();
+	owned_.shrink_to_fit();
+}
+
+void MappedResource::Unmap()
+{
+	region_.reset();
+	filePath_.clear();
+	owned_.clear();
+	owned_.shrink_to_fit();
+}
+
+bool MappedResource::IsMapped() const
+{
+	return region_ != nullptr;
+}
+
+MapMode MappedResource::GetMode() const
+{
+	return mode_;
+}
+
+std::string MappedResource::GetFilePath() const
+{
+	return filePath_;
+}
+
+bool MappedResource::Advise(const MapAdvice advice) const
+{
+	using boost::interprocess::mapped_region;
+
+	if (!region_)
+		return false;
+
+	switch (advice)
+	{
+	case MapAdvice::Sequential:
+		return region_->advise(mapped_region::advice_sequential);
+	case MapAdvice::Random:
+		return region_->advise(mapped_region::advice_random);
+	case MapAdvice::WillNeed:
+		return region_->advise(mapped_region::advice_willneed);
+	case MapAdvice::DontNeed:
+		return region_->advise(mapped_region::advice_dontneed);
+	default:
+		return region_->advise(mapped_region::advice_normal);
+	}
+}
+
+void *MappedResource::Data()
+{
+	if (region_ && mode_ == MapMode::ReadOnly)
+		throw std::runtime_error("Cannot access mutable data of a read-only MappedResource");
+	return const_cast<void *>(static_cast<const MappedResource *>(this)->Data());
+}
+
+const void *MappedResource::Data() const
+{
+	if (region_)
+		return static_cast<const char *>(region_->get_address()) + dataOffset_;
+	return owned_.empty() ? nullptr : owned_.data();
+}
+
+void MappedResource::Assign(const char *buff, const size_t n)
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during MappedResource::Assign");
+	if (region_ && mode_ == MapMode::ReadOnly)
+		throw std::runtime_error("Cannot assign to a read-only MappedResource");
+
+	// data that fits the private mapping is written in place, anything else moves to an owned buffer
+	if (region_ && n == GetPayloadSize())
+	{
+		std::memcpy(static_cast<char *>(region_->get_address()) + dataOffset_, buff, n);
+		return;
+	}
+
+	region_.reset();
+	filePath_.clear();
+	owned_.assign(buff, buff + n);
+}
+
+size_t MappedResource::GetPayloadSize() const
+{
+	if (region_)
+		return region_->get_size() - dataOffset_;
+	return owned_.size();
+}
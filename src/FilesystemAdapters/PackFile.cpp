@@ -0,0 +1,470 @@
+#include "FilesystemAdapters/PackFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#if defined(__APPLE__) || defined(__MACH__)
+#include <boost/system/error_code.hpp>
+#else
+#include <system_error>
+#endif
+
+#include "FilesystemAdapters/FileSync.h"
+#include "Resources/IResource.h"
+
+#if defined(__APPLE__) || defined(__MACH__)
+using boost::system::error_code;
+#else
+using std::error_code;
+#endif
+using filesystem_adapters::PackFile;
+using filesystem_adapters::SyncDirectory;
+using filesystem_adapters::SyncPath;
+using resource::IResource;
+
+namespace
+{
+	const char MAGIC[8] = {'A', 'Z', 'R', 'E', 'S', 'P', 'A', 'K'};
+	const std::string SEGMENT_EXT = ".pack";
+
+	// key size, checksum and image size
+	const uint64_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+	// the image size of a tombstone, which has no image
+	const uint64_t TOMBSTONE = ~uint64_t(0);
+
+	// the bytes of records compacted at a time while the lock is held
+	const uint64_t COMPACT_BATCH_SIZE = uint64_t(1) << 20;
+
+	// the checksum covers the key too, so a record whose key was torn or overwritten is not indexed
+	uint32_t RecordChecksum(const std::string_view key, const char *data, const size_t size)
+	{
+		return IResource::Crc32(data, size, IResource::Crc32(key.data(), key.size()));
+	}
+
+	bool IsSegmentName(const fs::path &path)
+	{
+		const std::string stem = path.stem().string();
+		return path.extension().string() == SEGMENT_EXT && !stem.empty() && stem.size() <= 9 &&
+			   std::all_of(stem.cbegin(), stem.cend(), [](const char c)
+						   { return c >= '0' && c <= '9'; });
+	}
+} // end namespace anonymous
+
+PackFile::PackFile(const std::string_view directory, const size_t segmentSize) : directory_(directory), segmentSize_(segmentSize)
+{
+	if (directory_.empty())
+		throw std::runtime_error("Directory is empty when opening pack file");
+
+	error_code ec;
+	fs::create_directories(fs::path(directory_), ec);
+	if (ec)
+		throw std::runtime_error("PackFile could not create the directory: " + directory_);
+
+	std::vector<uint32_t> segments;
+	for (const auto &file : fs::directory_iterator(fs::path(directory_)))
+	{
+		if (IsSegmentName(file.path()))
+			segments.push_back(static_cast<uint32_t>(std::stoul(file.path().stem().string())));
+	}
+	std::sort(segments.begin(), segments.end());
+
+	// later records replace earlier ones, so segments are scanned oldest first
+	std::lock_guard<std::mutex> lock(lock_);
+	for (size_t i = 0; i < segments.size(); ++i)
+		Open(segments[i], i + 1 == segments.size());
+	if (segments.empty())
+		Create(0);
+	else
+		active_ = segments.back();
+}
+
+PackFile::~PackFile() noexcept
+{
+	if (compaction_.valid())
+		compaction_.wait();
+}
+
+const std::string &PackFile::GetDirectory() const
+{
+	return directory_;
+}
+
+bool PackFile::Contains(const std::string_view key) const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+	return index_.find(std::string(key)) != index_.cend();
+}
+
+std::optional<PackFile::Entry> PackFile::Find(const std::string_view key) const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+
+	auto it = index_.find(std::string(key));
+	if (it == index_.cend())
+		return std::nullopt;
+	return it->second;
+}
+
+std::vector<std::string> PackFile::GetKeys() const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+
+	std::vector<std::string> keys;
+	keys.reserve(index_.size());
+	for (const auto &[key, entry] : index_)
+		keys.push_back(key);
+	return keys;
+}
+
+size_t PackFile::GetSegmentCount() const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+	return segments_.size();
+}
+
+double PackFile::GetDeadRatio() const
+{
+	std::lock_guard<std::mutex> lock(lock_);
+
+	uint64_t deadBytes = 0;
+	uint64_t recordBytes = 0;
+	for (const auto &[number, segment] : segments_)
+	{
+		deadBytes += segment->deadBytes;
+		recordBytes += segment->size - sizeof(MAGIC);
+	}
+	return recordBytes == 0 ? 0.0 : static_cast<double>(deadBytes) / static_cast<double>(recordBytes);
+}
+
+void PackFile::Put(const std::string_view key, const char *data, const size_t size)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot put image with empty key into pack file: " + directory_);
+	if (!data && size > 0)
+		throw std::runtime_error("Cannot put null image into pack file: " + std::string(key));
+
+	const uint32_t checksum = RecordChecksum(key, data, size);
+
+	std::lock_guard<std::mutex> lock(lock_);
+
+	const Entry entry = Append(key, data ? data : "", size, checksum);
+	auto it = index_.find(std::string(key));
+	if (it == index_.end())
+	{
+		index_.emplace(std::string(key), entry);
+		return;
+	}
+	Kill(it->second, key.size());
+	it->second = entry;
+}
+
+std::vector<char> PackFile::Get(const std::string_view key) const
+{
+	std::unique_lock<std::mutex> lock(lock_);
+
+	auto it = index_.find(std::string(key));
+	if (it == index_.cend())
+		throw std::runtime_error("PackFile has no image for key: " + std::string(key));
+
+	const Entry entry = it->second;
+	Segment &segment = *segments_.at(entry.segment);
+	std::vector<char> image(entry.length);
+	segment.file.clear();
+	segment.file.seekg(static_cast<std::streamoff>(entry.offset));
+	segment.file.read(image.data(), static_cast<std::streamsize>(image.size()));
+	if (!segment.file)
+		throw std::runtime_error("PackFile could not read image of key: " + std::string(key));
+	lock.unlock();
+
+	if (RecordChecksum(key, image.data(), image.size()) != entry.checksum)
+		throw std::runtime_error("PackFile image does not match its checksum: " + std::string(key));
+	return image;
+}
+
+bool PackFile::Erase(const std::string_view key)
+{
+	std::lock_guard<std::mutex> lock(lock_);
+
+	auto it = index_.find(std::string(key));
+	if (it == index_.end())
+		return false;
+
+	// the tombstone only hides the image in an older segment, so it is dead as soon as it is written
+	Append(key, nullptr, 0, RecordChecksum(key, nullptr, 0));
+	segments_.at(active_)->deadBytes += RECORD_HEADER_SIZE + key.size();
+	Kill(it->second, key.size());
+	index_.erase(it);
+	return true;
+}
+
+size_t PackFile::Compact(const double deadRatio)
+{
+	std::lock_guard<std::mutex> compactLock(compactLock_);
+
+	std::vector<uint32_t> candidates;
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		for (const auto &[number, segment] : segments_)
+		{
+			const uint64_t recordBytes = segment->size - sizeof(MAGIC);
+			if (number != active_ && static_cast<double>(segment->deadBytes) >= deadRatio * static_cast<double>(recordBytes))
+				candidates.push_back(number);
+		}
+	}
+
+	size_t removed = 0;
+	for (const uint32_t number : candidates)
+	{
+		const std::string segmentPath = GetSegmentPath(number);
+
+		// only the newest segment is appended to, so older ones are read without the lock
+		uint64_t size = 0;
+		{
+			std::lock_guard<std::mutex> lock(lock_);
+			size = segments_.at(number)->size;
+		}
+		std::vector<char> records(size);
+		std::ifstream inFile(segmentPath, std::ios::binary);
+		if (!inFile || !inFile.read(records.data(), static_cast<std::streamsize>(size)))
+			throw std::runtime_error("PackFile could not read segment: " + segmentPath);
+		inFile.close();
+
+		// the live records are appended in batches, so readers and writers wait for one batch at a time
+		std::unique_lock<std::mutex> lock(lock_);
+		const uint32_t firstTarget = active_;
+
+		// a tombstone must outlive every older segment that may still hold the image it hides
+		const bool hasOlderSegment = segments_.begin()->first < number;
+		for (uint64_t offset = sizeof(MAGIC); offset < size;)
+		{
+			const uint64_t batchEnd = offset + COMPACT_BATCH_SIZE;
+			for (; offset < size && offset < batchEnd;)
+			{
+				uint32_t keySize = 0;
+				uint32_t checksum = 0;
+				uint64_t length = 0;
+				std::memcpy(&keySize, records.data() + offset, sizeof(keySize));
+				std::memcpy(&checksum, records.data() + offset + sizeof(keySize), sizeof(checksum));
+				std::memcpy(&length, records.data() + offset + sizeof(keySize) + sizeof(checksum), sizeof(length));
+
+				const std::string key(records.data() + offset + RECORD_HEADER_SIZE, keySize);
+				const uint64_t imageOffset = offset + RECORD_HEADER_SIZE + keySize;
+				auto it = index_.find(key);
+				if (length == TOMBSTONE)
+				{
+					if (hasOlderSegment && it == index_.end())
+					{
+						Append(key, nullptr, 0, checksum);
+						segments_.at(active_)->deadBytes += RECORD_HEADER_SIZE + keySize;
+					}
+					offset = imageOffset;
+					continue;
+				}
+
+				if (it != index_.end() && it->second.segment == number && it->second.offset == imageOffset)
+					it->second = Append(key, records.data() + imageOffset, length, checksum);
+				offset = imageOffset + length;
+			}
+
+			lock.unlock();
+			lock.lock();
+		}
+
+		// the copies must be durable before the only other copy of the records is removed
+		std::vector<std::string> targetPaths;
+		for (auto it = segments_.lower_bound(firstTarget); it != segments_.end(); ++it)
+			targetPaths.push_back(GetSegmentPath(it->first));
+		lock.unlock();
+		for (const std::string &targetPath : targetPaths)
+		{
+			if (!SyncPath(targetPath))
+				throw std::runtime_error("PackFile could not sync segment: " + targetPath);
+		}
+		if (!SyncDirectory(directory_))
+			throw std::runtime_error("PackFile could not sync directory: " + directory_);
+		lock.lock();
+
+		segments_.at(number)->file.close();
+		segments_.erase(number);
+
+		error_code ec;
+		fs::remove(fs::path(segmentPath), ec);
+		if (ec)
+			throw std::runtime_error("PackFile could not remove segment: " + segmentPath);
+		++removed;
+	}
+	return removed;
+}
+
+void PackFile::StartCompaction(const double deadRatio)
+{
+	std::lock_guard<std::mutex> lock(lock_);
+
+	if (compaction_.valid() && compaction_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+	compaction_ = std::async(std::launch::async, [this, deadRatio]()
+							 { return Compact(deadRatio); });
+}
+
+size_t PackFile::WaitForCompaction()
+{
+	std::future<size_t> compaction;
+	{
+		std::lock_guard<std::mutex> lock(lock_);
+		compaction = std::move(compaction_);
+	}
+	return compaction.valid() ? compaction.get() : 0;
+}
+
+std::string PackFile::GetSegmentPath(const uint32_t segment) const
+{
+	return (fs::path(directory_) / (std::to_string(segment) + SEGMENT_EXT)).string();
+}
+
+void PackFile::Create(const uint32_t segment)
+{
+	const std::string segmentPath = GetSegmentPath(segment);
+	{
+		std::ofstream outFile(segmentPath, std::ios::binary | std::ios::trunc);
+		if (!outFile.write(MAGIC, sizeof(MAGIC)))
+			throw std::runtime_error("PackFile could not create segment: " + segmentPath);
+	}
+
+	auto created = std::make_unique<Segment>();
+	created->file.open(segmentPath, std::ios::in | std::ios::out | std::ios::binary);
+	if (!created->file.is_open())
+		throw std::runtime_error("PackFile could not open segment: " + segmentPath);
+	created->size = sizeof(MAGIC);
+
+	segments_[segment] = std::move(created);
+	active_ = segment;
+}
+
+void PackFile::Open(const uint32_t segment, const bool last)
+{
+	const std::string segmentPath = GetSegmentPath(segment);
+	const uint64_t fileSize = static_cast<uint64_t>(fs::file_size(fs::path(segmentPath)));
+
+	auto opened = std::make_unique<Segment>();
+	opened->file.open(segmentPath, std::ios::in | std::ios::out | std::ios::binary);
+	if (!opened->file.is_open())
+		throw std::runtime_error("PackFile could not open segment: " + segmentPath);
+
+	char magic[sizeof(MAGIC)];
+	if (!opened->file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+		throw std::runtime_error("PackFile segment is not a pack segment: " + segmentPath);
+
+	std::fstream &file = opened->file;
+	Segment &scanned = *opened;
+	segments_[segment] = std::move(opened);
+
+	// a record that runs past the end of the file was cut short; a crash can only leave garbage at the end of the
+	// newest segment, so only its records are checked against their checksums and the others are read for their keys
+	uint64_t end = sizeof(MAGIC);
+	std::vector<char> image;
+	while (end + RECORD_HEADER_SIZE <= fileSize)
+	{
+		uint32_t keySize = 0;
+		uint32_t checksum = 0;
+		uint64_t length = 0;
+		file.seekg(static_cast<std::streamoff>(end));
+		file.read(reinterpret_cast<char *>(&keySize), sizeof(keySize));
+		file.read(reinterpret_cast<char *>(&checksum), sizeof(checksum));
+		file.read(reinterpret_cast<char *>(&length), sizeof(length));
+
+		const uint64_t available = fileSize - end - RECORD_HEADER_SIZE;
+		const uint64_t imageSize = length == TOMBSTONE ? 0 : length;
+		if (!file || keySize == 0 || keySize > available || imageSize > available - keySize)
+			break;
+
+		std::string key(keySize, '\0');
+		if (!file.read(key.data(), keySize))
+			break;
+
+		if (last)
+		{
+			image.resize(imageSize);
+			if (!file.read(image.data(), static_cast<std::streamsize>(imageSize)) || RecordChecksum(key, image.data(), imageSize) != checksum)
+				break;
+		}
+
+		const uint64_t recordSize = RECORD_HEADER_SIZE + keySize + imageSize;
+		auto it = index_.find(key);
+		if (it != index_.end())
+			Kill(it->second, keySize);
+		if (length == TOMBSTONE)
+		{
+			scanned.deadBytes += recordSize;
+			if (it != index_.end())
+				index_.erase(it);
+		}
+		else
+		{
+			index_.insert_or_assign(std::move(key), Entry{segment, end + RECORD_HEADER_SIZE + keySize, length, checksum});
+		}
+		end += recordSize;
+	}
+	file.clear();
+	scanned.size = end;
+
+	// drop a record cut short by a crash so that it does not precede the next append
+	if (last && end < fileSize)
+	{
+		file.close();
+		fs::resize_file(fs::path(segmentPath), end);
+		file.open(segmentPath, std::ios::in | std::ios::out | std::ios::binary);
+		if (!file.is_open())
+			throw std::runtime_error("PackFile could not open segment: " + segmentPath);
+	}
+}
+
+PackFile::Entry PackFile::Append(const std::string_view key, const char *data, const size_t size, const uint32_t checksum)
+{
+	if (key.size() > UINT32_MAX)
+		throw std::runtime_error("PackFile key is too long: " + std::string(key.substr(0, 64)));
+
+	const uint64_t imageSize = data ? size : 0;
+	const uint64_t recordSize = RECORD_HEADER_SIZE + key.size() + imageSize;
+	if (segments_.at(active_)->size > sizeof(MAGIC) && segments_.at(active_)->size + recordSize > segmentSize_)
+		Create(active_ + 1);
+
+	Segment &segment = *segments_.at(active_);
+	const uint32_t keySize = static_cast<uint32_t>(key.size());
+	const uint64_t length = data ? size : TOMBSTONE;
+
+	segment.file.clear();
+	segment.file.seekp(static_cast<std::streamoff>(segment.size));
+	segment.file.write(reinterpret_cast<const char *>(&keySize), sizeof(keySize));
+	segment.file.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+	segment.file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+	segment.file.write(key.data(), static_cast<std::streamsize>(key.size()));
+	if (data)
+		segment.file.write(data, static_cast<std::streamsize>(size));
+	segment.file.flush();
+	if (!segment.file)
+		throw std::runtime_error("PackFile could not append to segment: " + GetSegmentPath(active_));
+
+	const Entry entry{active_, segment.size + RECORD_HEADER_SIZE + keySize, imageSize, checksum};
+	segment.size += recordSize;
+	return entry;
+}
+
+void PackFile::Kill(const Entry &entry, const size_t keySize)
+{
+	auto it = segments_.find(entry.segment);
+	if (it != segments_.end())
+		it->second->deadBytes += RECORD_HEADER_SIZE + keySize + entry.length;
+}
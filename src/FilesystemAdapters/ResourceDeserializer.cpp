@@ -1,23 +1,169 @@
 #include "FilesystemAdapters/ResourceDeserializer.h"
 
+#include <algorithm>
+#include <exception>
 #include <fstream>
+#include <future>
+#include <istream>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include "Config/filesystem.hpp"
 
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/streams/bufferstream.hpp>
+
+#include "FilesystemAdapters/AlignedFile.h"
+#include "FilesystemAdapters/AsyncFileIO.h"
+#include "FilesystemAdapters/DeltaLog.h"
 #include "FilesystemAdapters/FileLock.hpp"
 #include "FilesystemAdapters/ISerializableResource.h"
+#include "FilesystemAdapters/MappedResource.h"
+#include "FilesystemAdapters/PackFile.h"
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "Resources/ChunkedResource.h"
+#include "Resources/Codec.h"
+#include "Resources/CompressedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/IResource.h"
+#include "Resources/SparseResource.h"
+
+using filesystem_adapters::AlignedFile;
+using filesystem_adapters::AsyncFileIO;
+using filesystem_adapters::DeltaLog;
+using filesystem_adapters::GetFileLock;
+using filesystem_adapters::ISerializableResource;
+using filesystem_adapters::MappedResource;
+using filesystem_adapters::PackFile;
+using filesystem_adapters::ResourceDeserializer;
+using filesystem_adapters::ResourceHeader;
+using resource::ChunkedResource;
+using resource::Codec;
+using resource::CompressedResource;
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::Encoding;
+using resource::IResource;
+using resource::Quantization;
+using resource::SparseResource;
 
 namespace
 {
 	const std::string RESOURCE_EXT = ".bin";
-} // end namespace anonymous
 
-using filesystem_adapters::GetGlobalFileLock;
-using filesystem_adapters::ISerializableResource;
-using filesystem_adapters::ResourceDeserializer;
+	// shared by batch reads so that their requests fill one queue
+	AsyncFileIO &GetAsyncFileIO()
+	{
+		static AsyncFileIO io;
+		return io;
+	}
+
+	// maps a whole file for one sequential pass
+	std::unique_ptr<boost::interprocess::mapped_region> MapFile(const std::string &filePath)
+	{
+		using namespace boost::interprocess;
+
+		std::unique_ptr<mapped_region> region;
+		try
+		{
+			file_mapping file(filePath.c_str(), read_only);
+			region = std::make_unique<mapped_region>(file, read_only);
+		}
+		catch (const interprocess_exception &)
+		{
+			throw std::runtime_error("Could not map input file: " + filePath);
+		}
+		region->advise(mapped_region::advice_sequential);
+		region->advise(mapped_region::advice_willneed);
+		return region;
+	}
+
+	// converts a payload read from disk into the element type of the resource
+	std::pmr::vector<char> ConvertPayload(const char *payload, const size_t size, const DataType from, const DataType to, const size_t count, std::pmr::memory_resource *memory)
+	{
+		if (size < count * DataTypeConverter::GetSize(from))
+			throw std::runtime_error("Resource payload is smaller than its shape");
+
+		std::pmr::vector<char> converted(count * DataTypeConverter::GetSize(to), memory);
+		DataTypeConverter::Convert(payload, from, converted.data(), to, count);
+		return converted;
+	}
+
+	// restores a quantized payload to the floating point type of the resource
+	std::pmr::vector<char> DequantizePayload(const char *payload, const size_t size, const DataType from, const DataType to, const size_t count, const Quantization &quantization, std::pmr::memory_resource *memory)
+	{
+		if (size < count * DataTypeConverter::GetSize(from))
+			throw std::runtime_error("Resource payload is smaller than its shape");
+
+		std::pmr::vector<char> values(count * DataTypeConverter::GetSize(to), memory);
+		Encoding::Dequantize(payload, from, values.data(), to, count, quantization);
+		return values;
+	}
+
+	// frames are independent, so they are decompressed on an OpenMP team straight into the payload
+	std::pmr::vector<char> DecompressFrames(const ResourceHeader &header, const char *payload, const size_t size, std::pmr::memory_resource *memory)
+	{
+		const std::vector<uint64_t> &frameOffsets = header.GetFrameOffsets();
+		if (frameOffsets.back() > size)
+			throw std::runtime_error("Resource payload is smaller than its frame index");
+
+		const Codec codec(header.GetCodecType());
+		const size_t frameSize = header.GetFrameSize();
+		const long long frameCount = static_cast<long long>(header.GetFrameCount());
+		std::pmr::vector<char> raw(header.GetRawSize(), memory);
+		std::exception_ptr error;
+
+#pragma omp parallel for schedule(dynamic) if (frameCount > 1)
+		for (long long frame = 0; frame < frameCount; ++frame)
+		{
+			const size_t offset = static_cast<size_t>(frame) * frameSize;
+			try
+			{
+				codec.Decompress(payload + frameOffsets[frame], frameOffsets[frame + 1] - frameOffsets[frame], raw.data() + offset, std::min(frameSize, raw.size() - offset));
+			}
+			catch (...)
+			{
+#pragma omp critical
+				error = std::current_exception();
+			}
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+		return raw;
+	}
+
+	// sparse payload: nnz, M + 1 row offsets, nnz column indices, nnz values
+	void ReadSparse(std::istream &inFile, SparseResource &sparse, const DataType dataType, std::pmr::memory_resource *memory)
+	{
+		size_t nnz = 0;
+		inFile.read(reinterpret_cast<char *>(&nnz), sizeof(size_t));
+
+		std::pmr::vector<size_t> rowOffsets(sparse.GetColumnSize() + 1, memory);
+		inFile.read(reinterpret_cast<char *>(rowOffsets.data()), rowOffsets.size() * sizeof(size_t));
+
+		std::pmr::vector<size_t> columnIndices(nnz, memory);
+		inFile.read(reinterpret_cast<char *>(columnIndices.data()), nnz * sizeof(size_t));
+
+		const bool convert = DataTypeConverter::RequiresConversion(dataType, sparse.GetDataType());
+		std::pmr::vector<char> values(nnz * (convert ? DataTypeConverter::GetSize(dataType) : sparse.GetElementSize()), memory);
+		inFile.read(values.data(), values.size());
+		if (convert)
+			values = ConvertPayload(values.data(), values.size(), dataType, sparse.GetDataType(), nnz, memory);
+
+		sparse.AssignSparse(rowOffsets.data(), columnIndices.data(), values.data(), nnz);
+	}
+} // end namespace anonymous
 
 using LockedResource = filesystem_adapters::ISerializableResource::LockedResource;
 
@@ -35,7 +181,7 @@ void ResourceDeserializer::UnregisterResource(const std::string_view key)
 	if (key.empty())
 		throw std::runtime_error("Key is empty when unregistering resource with ResourceDeserializer");
 
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
+	std::unique_lock<std::shared_mutex> lock(registryLock_);
 
 	if (keyToResourceMap_.find(key) == keyToResourceMap_.cend())
 		throw std::runtime_error("Key not already registered with the ResourceDeserializer");
@@ -45,77 +191,307 @@ void ResourceDeserializer::UnregisterResource(const std::string_view key)
 
 bool ResourceDeserializer::HasSerializationKey(const std::string_view key) const
 {
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
+	std::shared_lock<std::shared_mutex> lock(registryLock_);
 
 	return keyToResourceMap_.find(key) != keyToResourceMap_.cend();
 }
 
 void ResourceDeserializer::UnregisterAll()
 {
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
+	std::unique_lock<std::shared_mutex> lock(registryLock_);
 
 	keyToResourceMap_.clear();
 }
 
-std::unique_ptr<ISerializableResource> ResourceDeserializer::Deserialize(const std::string_view key, const std::string_view deserializationPath)
+std::unique_ptr<ISerializableResource> ResourceDeserializer::Deserialize(const std::string_view key, const std::string_view deserializationPath, std::pmr::memory_resource *memory)
 {
+	using boost::interprocess::mapped_region;
+
 	if (key.empty())
 		throw std::runtime_error("Key is empty when deserializing resource with ResourceDeserializer");
 
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
-
 	Path serializationPath = std::string(deserializationPath);
 	if (serializationPath.empty())
 		throw std::runtime_error("Serialization path is empty when deserializaing resource with ResourceDeserializer");
 
 	std::string fileName = std::string(key) + RESOURCE_EXT;
-	std::ifstream inFile((serializationPath / fileName).string(), std::ios::binary);
-	if (!inFile)
-		throw std::runtime_error("Could not open input file: " + (serializationPath / fileName).string());
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(serializationPath / fileName));
+
+	const std::string filePath = (serializationPath / fileName).string();
+	if (!fs::exists(serializationPath / fileName))
+		throw std::runtime_error("Could not open input file: " + filePath);
+
+	// files with deltas are rebuilt in memory; all others are mapped and read from the page cache
+	const DeltaLog deltaLog(filePath);
+	std::vector<char> deltaImage;
+	std::unique_ptr<mapped_region> region;
+	const char *image = nullptr;
+	size_t size = 0;
+	if (deltaLog.GetLength() > 0)
+	{
+		deltaImage = deltaLog.ReadImage();
+		image = deltaImage.data();
+		size = deltaImage.size();
+	}
+	else if (fs::file_size(serializationPath / fileName) > 0)
+	{
+		region = MapFile(filePath);
+		image = static_cast<const char *>(region->get_address());
+		size = region->get_size();
+	}
+
+	return ReadImage(key, filePath, image, size, deltaLog.GetLength() > 0, memory);
+}
 
-	// throw on failures
-	inFile.exceptions(std::ios::failbit | std::ios::badbit);
+std::vector<std::unique_ptr<ISerializableResource>> ResourceDeserializer::DeserializeBatch(const std::span<const std::string> keys, const std::string_view deserializationPath, std::pmr::memory_resource *memory)
+{
+	Path serializationPath = std::string(deserializationPath);
+	if (serializationPath.empty())
+		throw std::runtime_error("Serialization path is empty when deserializaing resources with ResourceDeserializer");
+
+	std::vector<std::string> filePaths;
+	for (const std::string &key : keys)
+	{
+		if (key.empty())
+			throw std::runtime_error("Key is empty when deserializing resources with ResourceDeserializer");
+		filePaths.push_back((serializationPath / (key + RESOURCE_EXT)).string());
+	}
+
+	// every file is requested before the first is parsed, so the reads overlap
+	std::vector<std::future<std::vector<char>>> images = GetAsyncFileIO().ReadBatch(filePaths);
+
+	std::vector<std::unique_ptr<ISerializableResource>> resources;
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		const std::vector<char> image = images[i].get();
+
+		// files that gained deltas while they were read are read again under their lock
+		std::lock_guard<std::recursive_mutex> lock(GetFileLock(filePaths[i]));
+		if (DeltaLog(filePaths[i]).GetLength() > 0)
+			resources.push_back(Deserialize(keys[i], deserializationPath, memory));
+		else
+			resources.push_back(ReadImage(keys[i], filePaths[i], image.data(), image.size(), false, memory));
+	}
+	return resources;
+}
 
-	auto size = fs::file_size(serializationPath / fileName);
+std::unique_ptr<ISerializableResource> ResourceDeserializer::Deserialize(const std::string_view key, const PackFile &pack, std::pmr::memory_resource *memory)
+{
+	if (key.empty())
+		throw std::runtime_error("Key is empty when deserializing resource with ResourceDeserializer");
 
-	size_t colSizeOffset = 0;
-	size_t rowSizeOffset = sizeof(size_t);
-	size_t dataOffset = 2 * sizeof(size_t);
+	const std::vector<char> image = pack.Get(key);
+	return ReadImage(key, "", image.data(), image.size(), false, memory);
+}
 
-	auto buff = std::make_unique<char[]>(size);
+std::unique_ptr<ISerializableResource> ResourceDeserializer::ReadImage(const std::string_view key, const std::string &filePath, const char *image, const size_t size, const bool hasDeltas, std::pmr::memory_resource *memory)
+{
+	const ResourceHeader header = ResourceHeader::Read(image, size);
 
-	// read headers directly into locals (avoids alignment/aliasing issues)
-	size_t M = 0;
-	size_t N = 0;
-	inFile.read(reinterpret_cast<char *>(&M), sizeof(size_t));
-	inFile.read(reinterpret_cast<char *>(&N), sizeof(size_t));
+	std::unique_ptr<ISerializableResource> arithmeticContainer = GenerateResource(key, memory);
 
-	if (size > dataOffset)
-		inFile.read(buff.get() + dataOffset, size - dataOffset);
+	LockedResource resourceLock = arithmeticContainer->Lock();
+	resourceLock.SetShape(header.GetShape());
+	resourceLock.SetLayout(header.GetLayout());
+
+	// the registered type decides how the payload is read
+	if (auto mapped = dynamic_cast<MappedResource *>(resourceLock.obj_))
+	{
+		if (filePath.empty())
+			throw std::runtime_error("Cannot map resource from a pack file: " + std::string(key));
+		if (hasDeltas)
+			throw std::runtime_error("Cannot map resource file with pending deltas: " + filePath);
+		mapped->Map(filePath);
+		return arithmeticContainer;
+	}
+	// mapped payloads are not checked, which would read every page up front
+	const char *payload = image + header.GetSize();
+	size_t payloadSize = size - header.GetSize();
+
+	// a payload copied verbatim into a resident buffer is checked there after the copy, so the mapping is read once
+	const bool checkCopy = header.HasChecksum() && !header.IsCompressed() && !header.IsQuantized() && payloadSize > 0 &&
+						   payloadSize == header.GetElementCount() * resourceLock.GetElementSize() &&
+						   !DataTypeConverter::RequiresConversion(header.GetDataType(), resourceLock.GetDataType()) &&
+						   !dynamic_cast<SparseResource *>(resourceLock.obj_) && !dynamic_cast<CompressedResource *>(resourceLock.obj_) &&
+						   !dynamic_cast<ChunkedResource *>(resourceLock.obj_);
+	if (!checkCopy && !header.MatchesChecksum(payload, payloadSize))
+		throw std::runtime_error("Resource payload does not match its checksum: " + std::string(key));
+
+	std::pmr::vector<char> raw(memory);
+	if (header.IsCompressed())
+	{
+		raw = DecompressFrames(header, payload, payloadSize, memory);
+		payload = raw.data();
+		payloadSize = raw.size();
+	}
+
+	if (auto sparse = dynamic_cast<SparseResource *>(resourceLock.obj_))
+	{
+		boost::interprocess::ibufferstream inStream(payload, payloadSize, std::ios::binary);
+
+		// throw on failures
+		inStream.exceptions(std::ios::failbit | std::ios::badbit);
+		ReadSparse(inStream, *sparse, header.GetDataType(), memory);
+		return arithmeticContainer;
+	}
+
+	if (payloadSize > 0)
+	{
+		// payloads of the element type of the resource are copied once, straight from the mapping
+		if (header.IsQuantized())
+		{
+			const std::pmr::vector<char> buff = DequantizePayload(payload, payloadSize, header.GetDataType(), resourceLock.GetDataType(), header.GetElementCount(), header.GetQuantization(), memory);
+			resourceLock.Assign(buff.data(), buff.size());
+		}
+		else if (DataTypeConverter::RequiresConversion(header.GetDataType(), resourceLock.GetDataType()))
+		{
+			const std::pmr::vector<char> buff = ConvertPayload(payload, payloadSize, header.GetDataType(), resourceLock.GetDataType(), header.GetElementCount(), memory);
+			resourceLock.Assign(buff.data(), buff.size());
+		}
+		else
+		{
+			resourceLock.Assign(payload, payloadSize);
+			if (checkCopy && IResource::Crc32(std::as_const(resourceLock).Data(), payloadSize) != header.GetChecksum())
+				throw std::runtime_error("Resource payload does not match its checksum: " + std::string(key));
+		}
+	}
 
-	std::unique_ptr<ISerializableResource> arithmeticContainer = GenerateResource(key);
+	return arithmeticContainer;
+}
 
-	LockedResource resourceLock = arithmeticContainer->Lock();
-	resourceLock.SetColumnSize(M);
-	resourceLock.SetRowSize(N);
+ResourceHeader ResourceDeserializer::DeserializeChunks(const std::string_view key, const std::string_view deserializationPath, const ChunkCallbackType &onChunk, const size_t chunkSize, const bool direct) const
+{
+	if (key.empty())
+		throw std::runtime_error("Key is empty when streaming resource with ResourceDeserializer");
+	if (!onChunk)
+		throw std::runtime_error("Chunk callback is empty when streaming resource with ResourceDeserializer");
 
-	if (size > dataOffset)
-		resourceLock.Assign(buff.get() + dataOffset, size - dataOffset);
+	Path serializationPath = std::string(deserializationPath);
+	if (serializationPath.empty())
+		throw std::runtime_error("Serialization path is empty when streaming resource with ResourceDeserializer");
+
+	const std::string fileName = std::string(key) + RESOURCE_EXT;
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(serializationPath / fileName));
+
+	const std::string filePath = (serializationPath / fileName).string();
+	if (DeltaLog(filePath).GetLength() > 0)
+		throw std::runtime_error("Cannot stream resource file with pending deltas: " + filePath);
+
+	ResourceHeader header;
+	{
+		std::ifstream inFile(filePath, std::ios::binary);
+		if (!inFile)
+			throw std::runtime_error("Could not open input file: " + filePath);
+		header = ResourceHeader::Read(inFile);
+	}
+	if (header.IsCompressed())
+		throw std::runtime_error("Cannot stream compressed resource file, read its frames instead: " + filePath);
+
+	// direct reads start at aligned offsets, so the blocks holding the header are read again and skipped
+	AlignedFile file(filePath, false, direct);
+	const size_t bufferSize = AlignedFile::RoundUp(std::max(chunkSize, AlignedFile::ALIGNMENT));
+	AlignedFile::BufferType buff = AlignedFile::AllocateBuffer(bufferSize);
+
+	size_t fileOffset = 0;
+	size_t payloadOffset = 0;
+	uint32_t checksum = 0;
+	for (size_t n = file.Read(buff.get(), bufferSize); n > 0; n = file.Read(buff.get(), bufferSize))
+	{
+		const size_t begin = fileOffset < header.GetSize() ? std::min(header.GetSize() - fileOffset, n) : 0;
+		if (n > begin)
+		{
+			if (header.HasChecksum())
+				checksum = IResource::Crc32(buff.get() + begin, n - begin, checksum);
+			onChunk(buff.get() + begin, n - begin, payloadOffset);
+			payloadOffset += n - begin;
+		}
+		fileOffset += n;
+		if (n < bufferSize)
+			break;
+	}
+
+	// the chunks are handed over as they are read, so corruption is only reported at the end
+	if (header.HasChecksum() && checksum != header.GetChecksum())
+		throw std::runtime_error("Streamed payload does not match its checksum: " + filePath);
+	return header;
+}
 
-	return arithmeticContainer;
+std::vector<char> ResourceDeserializer::DeserializeFrame(const std::string_view key, const std::string_view deserializationPath, const size_t frame) const
+{
+	if (key.empty())
+		throw std::runtime_error("Key is empty when reading resource frame with ResourceDeserializer");
+
+	Path serializationPath = std::string(deserializationPath);
+	if (serializationPath.empty())
+		throw std::runtime_error("Serialization path is empty when reading resource frame with ResourceDeserializer");
+
+	const std::string fileName = std::string(key) + RESOURCE_EXT;
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(serializationPath / fileName));
+
+	const std::string filePath = (serializationPath / fileName).string();
+	if (DeltaLog(filePath).GetLength() > 0)
+		throw std::runtime_error("Cannot read a frame of resource file with pending deltas: " + filePath);
+
+	std::ifstream inFile(filePath, std::ios::binary);
+	if (!inFile)
+		throw std::runtime_error("Could not open input file: " + filePath);
+
+	const ResourceHeader header = ResourceHeader::Read(inFile);
+	if (!header.IsCompressed())
+		throw std::runtime_error("Resource file is not compressed in frames: " + filePath);
+	if (frame >= header.GetFrameCount())
+		throw std::runtime_error("Resource file has no frame " + std::to_string(frame) + ": " + filePath);
+
+	// only the frame is read, seeking past the ones before it
+	const std::vector<uint64_t> &frameOffsets = header.GetFrameOffsets();
+	std::vector<char> compressed(frameOffsets[frame + 1] - frameOffsets[frame]);
+	inFile.seekg(static_cast<std::streamoff>(header.GetSize() + frameOffsets[frame]));
+	if (!inFile.read(compressed.data(), static_cast<std::streamsize>(compressed.size())))
+		throw std::runtime_error("Could not read frame " + std::to_string(frame) + " of file: " + filePath);
+
+	const size_t offset = frame * header.GetFrameSize();
+	std::vector<char> raw(std::min(header.GetFrameSize(), header.GetRawSize() - offset));
+	Codec(header.GetCodecType()).Decompress(compressed.data(), compressed.size(), raw.data(), raw.size());
+	return raw;
 }
 
-std::unique_ptr<ISerializableResource> ResourceDeserializer::GenerateResource(const std::string_view key) const
+ResourceHeader ResourceDeserializer::ReadHeader(const std::string_view key, const std::string_view deserializationPath) const
+{
+	if (key.empty())
+		throw std::runtime_error("Key is empty when reading resource header with ResourceDeserializer");
+
+	Path serializationPath = std::string(deserializationPath);
+	if (serializationPath.empty())
+		throw std::runtime_error("Serialization path is empty when reading resource header with ResourceDeserializer");
+
+	const std::string fileName = std::string(key) + RESOURCE_EXT;
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(serializationPath / fileName));
+
+	std::ifstream inFile((serializationPath / fileName).string(), std::ios::binary);
+	if (!inFile)
+		throw std::runtime_error("Could not open input file: " + (serializationPath / fileName).string());
+
+	const DeltaLog deltaLog((serializationPath / fileName).string());
+	if (deltaLog.GetLength() > 0)
+	{
+		const std::vector<char> image = deltaLog.ReadImage();
+		return ResourceHeader::Read(image.data(), image.size());
+	}
+	return ResourceHeader::Read(inFile);
+}
+
+std::unique_ptr<ISerializableResource> ResourceDeserializer::GenerateResource(const std::string_view key, std::pmr::memory_resource *memory) const
 {
 	if (key.empty())
 		throw std::runtime_error("Key is empty when generating resource with ResourceDeserializer");
 
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
+	std::shared_lock<std::shared_mutex> lock(registryLock_);
 
-	if (keyToResourceMap_.find(key) == keyToResourceMap_.cend())
+	auto it = keyToResourceMap_.find(key);
+	if (it == keyToResourceMap_.cend())
 		throw std::runtime_error("Key is not registered with the ResourceDeserializer");
 
-	std::unique_ptr<ISerializableResource> resource = keyToResourceMap_[std::string(key)]();
+	std::unique_ptr<ISerializableResource> resource = it->second(memory);
 
 	return resource;
 }
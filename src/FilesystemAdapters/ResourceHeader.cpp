@@ -0,0 +1,409 @@
+#include "FilesystemAdapters/ResourceHeader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Resources/Codec.h"
+#include "Resources/Encoding.h"
+#include "Resources/IResource.h"
+#include "Resources/Layout.h"
+#include "Resources/ZoneMap.h"
+
+using filesystem_adapters::ResourceHeader;
+using resource::CodecType;
+using resource::DataType;
+using resource::IResource;
+using resource::Layout;
+using resource::LayoutType;
+using resource::Quantization;
+using resource::ZoneMap;
+
+namespace
+{
+	const char MAGIC[8] = {'A', 'Z', 'R', 'E', 'S', 'B', 'I', 'N'};
+	const uint32_t CURRENT_VERSION = 3;
+
+	// magic, version, header size
+	const size_t PREFIX_SIZE = sizeof(MAGIC) + 2 * sizeof(uint32_t);
+	// rank, layout type, data type, flags, byte order mark, payload checksum
+	const size_t DESCRIPTOR_SIZE = 6 * sizeof(uint32_t);
+	// written in the byte order of the writer
+	const uint32_t BYTE_ORDER_MARK = 0x01020304;
+	// a zone map follows the extents
+	const uint32_t FLAG_ZONE_MAP = 1;
+	// the scale and offset of a quantized payload follow the extents, ahead of the zone map
+	const uint32_t FLAG_QUANTIZED = 2;
+	const size_t QUANTIZATION_SIZE = 2 * sizeof(double);
+	// the payload checksum is valid
+	const uint32_t FLAG_CHECKSUM = 4;
+	// the payload is compressed in frames, whose index follows the quantization, ahead of the zone map
+	const uint32_t FLAG_FRAMED = 8;
+	// codec type, reserved, frame size, uncompressed size, frame count
+	const size_t FRAMES_PREFIX_SIZE = 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+	// M, N
+	const size_t LEGACY_HEADER_SIZE = 2 * sizeof(size_t);
+
+	uint32_t ByteSwap(const uint32_t value)
+	{
+		return ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value >> 8) & 0xFF00) | (value >> 24);
+	}
+
+	template <typename T>
+	T ReadField(const char *buff, size_t &offset)
+	{
+		T value;
+		std::memcpy(&value, buff + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+
+	template <typename T>
+	void WriteField(std::ostream &outFile, const T value)
+	{
+		outFile.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	// the frame offsets hold the end of the last frame too
+	size_t GetFramesSize(const std::vector<uint64_t> *frameOffsets)
+	{
+		return frameOffsets ? FRAMES_PREFIX_SIZE + frameOffsets->size() * sizeof(uint64_t) : 0;
+	}
+
+	size_t GetFieldsSize(const std::vector<size_t> &shape, const Layout &layout, const bool isQuantized = false, const ZoneMap *zoneMap = nullptr, const std::vector<uint64_t> *frameOffsets = nullptr)
+	{
+		const size_t quantizationSize = isQuantized ? QUANTIZATION_SIZE : 0;
+		const size_t zoneMapSize = zoneMap ? zoneMap->GetSize() : 0;
+		return PREFIX_SIZE + DESCRIPTOR_SIZE + (shape.size() + layout.GetTileShape().size()) * sizeof(size_t) + quantizationSize + GetFramesSize(frameOffsets) + zoneMapSize;
+	}
+
+	// padding after the fields puts the payload on an ALIGNMENT boundary of a mapped file
+	size_t GetVersionedSize(const std::vector<size_t> &shape, const Layout &layout, const bool isQuantized = false, const ZoneMap *zoneMap = nullptr, const std::vector<uint64_t> *frameOffsets = nullptr)
+	{
+		const size_t size = GetFieldsSize(shape, layout, isQuantized, zoneMap, frameOffsets);
+		return (size + ResourceHeader::ALIGNMENT - 1) / ResourceHeader::ALIGNMENT * ResourceHeader::ALIGNMENT;
+	}
+} // end namespace anonymous
+
+ResourceHeader::ResourceHeader() : ResourceHeader(std::vector<size_t>{0, 0}) {}
+
+ResourceHeader::ResourceHeader(const std::vector<size_t> &shape, const Layout &layout, const DataType dataType)
+	: version_(CURRENT_VERSION), size_(GetVersionedSize(shape, layout)), shape_(shape), layout_(layout), dataType_(dataType)
+{
+	if (shape_.empty())
+		throw std::runtime_error("ResourceHeader shape must have at least one dimension");
+	layout_.Validate(shape_);
+}
+
+ResourceHeader::~ResourceHeader() noexcept = default;
+ResourceHeader::ResourceHeader(const ResourceHeader &) = default;
+ResourceHeader &ResourceHeader::operator=(const ResourceHeader &) = default;
+ResourceHeader::ResourceHeader(ResourceHeader &&) noexcept = default;
+ResourceHeader &ResourceHeader::operator=(ResourceHeader &&) noexcept = default;
+
+ResourceHeader ResourceHeader::Read(std::istream &inFile)
+{
+	std::vector<char> buff(PREFIX_SIZE);
+	if (!inFile.read(buff.data(), buff.size()))
+		throw std::runtime_error("Resource file is too small to hold a header");
+
+	if (std::memcmp(buff.data(), MAGIC, sizeof(MAGIC)) == 0)
+	{
+		size_t offset = sizeof(MAGIC) + sizeof(uint32_t);
+		const uint32_t size = ReadField<uint32_t>(buff.data(), offset);
+		if (size < PREFIX_SIZE)
+			throw std::runtime_error("Resource file header size is invalid: " + std::to_string(size));
+
+		buff.resize(size);
+		if (!inFile.read(buff.data() + PREFIX_SIZE, size - PREFIX_SIZE))
+			throw std::runtime_error("Resource file header is truncated");
+	}
+
+	return Read(buff.data(), buff.size());
+}
+
+ResourceHeader ResourceHeader::Read(const char *buff, const size_t size)
+{
+	if (!buff || size < LEGACY_HEADER_SIZE)
+		throw std::runtime_error("Resource file is too small to hold a header");
+
+	size_t offset = 0;
+	if (std::memcmp(buff, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		const size_t M = ReadField<size_t>(buff, offset);
+		const size_t N = ReadField<size_t>(buff, offset);
+
+		ResourceHeader header({M, N});
+		header.version_ = 0;
+		header.size_ = LEGACY_HEADER_SIZE;
+		return header;
+	}
+
+	offset = sizeof(MAGIC);
+	const uint32_t version = ReadField<uint32_t>(buff, offset);
+	if (version != CURRENT_VERSION && ByteSwap(version) == CURRENT_VERSION)
+		throw std::runtime_error("Resource file byte order does not match this machine");
+	if (version != CURRENT_VERSION)
+		throw std::runtime_error("Resource file version is not supported: " + std::to_string(version));
+	const uint32_t headerSize = ReadField<uint32_t>(buff, offset);
+	if (headerSize > size || headerSize < PREFIX_SIZE + DESCRIPTOR_SIZE)
+		throw std::runtime_error("Resource file header is truncated");
+
+	const uint32_t rank = ReadField<uint32_t>(buff, offset);
+	const auto type = static_cast<LayoutType>(ReadField<uint32_t>(buff, offset));
+	const auto dataType = static_cast<DataType>(ReadField<uint32_t>(buff, offset));
+	const uint32_t flags = ReadField<uint32_t>(buff, offset);
+	if (dataType > DataType::Float64)
+		throw std::runtime_error("Resource file data type is not supported: " + std::to_string(static_cast<uint32_t>(dataType)));
+	if (ReadField<uint32_t>(buff, offset) != BYTE_ORDER_MARK)
+		throw std::runtime_error("Resource file byte order does not match this machine");
+	const uint32_t checksum = ReadField<uint32_t>(buff, offset);
+	const size_t tileRank = type == LayoutType::Tiled ? rank : 0;
+	if (rank == 0 || offset + (rank + tileRank) * sizeof(size_t) > headerSize)
+		throw std::runtime_error("Resource file header is truncated");
+
+	std::vector<size_t> shape(rank);
+	for (size_t &extent : shape)
+		extent = ReadField<size_t>(buff, offset);
+	std::vector<size_t> tileShape(tileRank);
+	for (size_t &extent : tileShape)
+		extent = ReadField<size_t>(buff, offset);
+
+	ResourceHeader header(shape, Layout::Make(type, tileShape), dataType);
+	if (flags & FLAG_QUANTIZED)
+	{
+		if (offset + QUANTIZATION_SIZE > headerSize)
+			throw std::runtime_error("Resource file header is truncated");
+		header.quantization_.scale = ReadField<double>(buff, offset);
+		header.quantization_.offset = ReadField<double>(buff, offset);
+		header.isQuantized_ = true;
+	}
+	if (flags & FLAG_FRAMED)
+	{
+		if (offset + FRAMES_PREFIX_SIZE > headerSize)
+			throw std::runtime_error("Resource file header is truncated");
+		const auto codecType = static_cast<CodecType>(ReadField<uint32_t>(buff, offset));
+		ReadField<uint32_t>(buff, offset);
+		const uint64_t frameSize = ReadField<uint64_t>(buff, offset);
+		const uint64_t rawSize = ReadField<uint64_t>(buff, offset);
+		const uint64_t frameCount = ReadField<uint64_t>(buff, offset);
+		if (codecType > CodecType::Zstd)
+			throw std::runtime_error("Resource file codec is not supported: " + std::to_string(static_cast<uint32_t>(codecType)));
+		if (frameCount >= (headerSize - offset) / sizeof(uint64_t))
+			throw std::runtime_error("Resource file header is truncated");
+		if (frameSize == 0 || frameCount != (rawSize + frameSize - 1) / frameSize)
+			throw std::runtime_error("Resource file frame index does not match its payload size");
+
+		std::vector<uint64_t> frameOffsets(frameCount + 1);
+		for (uint64_t &frameOffset : frameOffsets)
+			frameOffset = ReadField<uint64_t>(buff, offset);
+		if (frameOffsets.front() != 0 || !std::is_sorted(frameOffsets.cbegin(), frameOffsets.cend()))
+			throw std::runtime_error("Resource file frame index is not ordered");
+		header.SetFrames(codecType, frameSize, rawSize, frameOffsets);
+	}
+	if (flags & FLAG_ZONE_MAP)
+	{
+		header.zoneMap_ = ZoneMap::Read(buff + offset, headerSize - offset);
+		header.hasZoneMap_ = true;
+	}
+	if (flags & FLAG_CHECKSUM)
+	{
+		header.checksum_ = checksum;
+		header.hasChecksum_ = true;
+	}
+	header.version_ = version;
+	header.size_ = headerSize;
+	return header;
+}
+
+void ResourceHeader::Write(std::ostream &outFile) const
+{
+	const ZoneMap *zoneMap = hasZoneMap_ ? &zoneMap_ : nullptr;
+	const std::vector<uint64_t> *frameOffsets = IsCompressed() ? &frameOffsets_ : nullptr;
+	const size_t size = GetVersionedSize(shape_, layout_, isQuantized_, zoneMap, frameOffsets);
+	outFile.write(MAGIC, sizeof(MAGIC));
+	WriteField<uint32_t>(outFile, CURRENT_VERSION);
+	WriteField<uint32_t>(outFile, static_cast<uint32_t>(size));
+	WriteField<uint32_t>(outFile, static_cast<uint32_t>(shape_.size()));
+	WriteField<uint32_t>(outFile, static_cast<uint32_t>(layout_.GetType()));
+	WriteField<uint32_t>(outFile, static_cast<uint32_t>(dataType_));
+	WriteField<uint32_t>(outFile, (hasZoneMap_ ? FLAG_ZONE_MAP : 0) | (isQuantized_ ? FLAG_QUANTIZED : 0) | (hasChecksum_ ? FLAG_CHECKSUM : 0) | (frameOffsets ? FLAG_FRAMED : 0));
+	WriteField<uint32_t>(outFile, BYTE_ORDER_MARK);
+	WriteField<uint32_t>(outFile, hasChecksum_ ? checksum_ : 0);
+	for (size_t extent : shape_)
+		WriteField<size_t>(outFile, extent);
+	for (size_t extent : layout_.GetTileShape())
+		WriteField<size_t>(outFile, extent);
+	if (isQuantized_)
+	{
+		WriteField<double>(outFile, quantization_.scale);
+		WriteField<double>(outFile, quantization_.offset);
+	}
+	if (frameOffsets)
+	{
+		WriteField<uint32_t>(outFile, static_cast<uint32_t>(codecType_));
+		WriteField<uint32_t>(outFile, 0);
+		WriteField<uint64_t>(outFile, frameSize_);
+		WriteField<uint64_t>(outFile, rawSize_);
+		WriteField<uint64_t>(outFile, GetFrameCount());
+		for (uint64_t frameOffset : frameOffsets_)
+			WriteField<uint64_t>(outFile, frameOffset);
+	}
+	if (hasZoneMap_)
+		zoneMap_.Write(outFile);
+
+	const char padding[ALIGNMENT] = {};
+	outFile.write(padding, static_cast<std::streamsize>(size - GetFieldsSize(shape_, layout_, isQuantized_, zoneMap, frameOffsets)));
+}
+
+uint32_t ResourceHeader::GetVersion() const
+{
+	return version_;
+}
+
+size_t ResourceHeader::GetSize() const
+{
+	return size_;
+}
+
+const std::vector<size_t> &ResourceHeader::GetShape() const
+{
+	return shape_;
+}
+
+const Layout &ResourceHeader::GetLayout() const
+{
+	return layout_;
+}
+
+DataType ResourceHeader::GetDataType() const
+{
+	return dataType_;
+}
+
+size_t ResourceHeader::GetElementCount() const
+{
+	return std::accumulate(shape_.cbegin(), shape_.cend(), size_t(1), std::multiplies<size_t>());
+}
+
+void ResourceHeader::SetZoneMap(const ZoneMap &zoneMap)
+{
+	zoneMap_ = zoneMap;
+	hasZoneMap_ = true;
+	version_ = CURRENT_VERSION;
+	size_ = GetVersionedSize(shape_, layout_, isQuantized_, &zoneMap_, IsCompressed() ? &frameOffsets_ : nullptr);
+}
+
+bool ResourceHeader::HasZoneMap() const
+{
+	return hasZoneMap_;
+}
+
+const ZoneMap &ResourceHeader::GetZoneMap() const
+{
+	if (!hasZoneMap_)
+		throw std::runtime_error("ResourceHeader has no zone map");
+	return zoneMap_;
+}
+
+void ResourceHeader::SetQuantization(const Quantization &quantization)
+{
+	quantization_ = quantization;
+	isQuantized_ = true;
+	version_ = CURRENT_VERSION;
+	size_ = GetVersionedSize(shape_, layout_, isQuantized_, hasZoneMap_ ? &zoneMap_ : nullptr, IsCompressed() ? &frameOffsets_ : nullptr);
+}
+
+bool ResourceHeader::IsQuantized() const
+{
+	return isQuantized_;
+}
+
+const Quantization &ResourceHeader::GetQuantization() const
+{
+	if (!isQuantized_)
+		throw std::runtime_error("ResourceHeader payload is not quantized");
+	return quantization_;
+}
+
+void ResourceHeader::SetChecksum(const uint32_t checksum)
+{
+	checksum_ = checksum;
+	hasChecksum_ = true;
+	version_ = CURRENT_VERSION;
+	size_ = GetVersionedSize(shape_, layout_, isQuantized_, hasZoneMap_ ? &zoneMap_ : nullptr, IsCompressed() ? &frameOffsets_ : nullptr);
+}
+
+void ResourceHeader::ClearChecksum()
+{
+	checksum_ = 0;
+	hasChecksum_ = false;
+}
+
+bool ResourceHeader::HasChecksum() const
+{
+	return hasChecksum_;
+}
+
+uint32_t ResourceHeader::GetChecksum() const
+{
+	if (!hasChecksum_)
+		throw std::runtime_error("ResourceHeader has no payload checksum");
+	return checksum_;
+}
+
+void ResourceHeader::SetFrames(const CodecType codecType, const size_t frameSize, const size_t rawSize, const std::vector<uint64_t> &frameOffsets)
+{
+	if (codecType == CodecType::None)
+		throw std::runtime_error("ResourceHeader frames need a codec");
+	if (frameSize == 0 || frameOffsets.size() != (rawSize + frameSize - 1) / frameSize + 1)
+		throw std::runtime_error("ResourceHeader frame index does not match its payload size");
+
+	codecType_ = codecType;
+	frameSize_ = frameSize;
+	rawSize_ = rawSize;
+	frameOffsets_ = frameOffsets;
+	version_ = CURRENT_VERSION;
+	size_ = GetVersionedSize(shape_, layout_, isQuantized_, hasZoneMap_ ? &zoneMap_ : nullptr, &frameOffsets_);
+}
+
+bool ResourceHeader::IsCompressed() const
+{
+	return codecType_ != CodecType::None;
+}
+
+CodecType ResourceHeader::GetCodecType() const
+{
+	return codecType_;
+}
+
+size_t ResourceHeader::GetFrameSize() const
+{
+	return frameSize_;
+}
+
+size_t ResourceHeader::GetFrameCount() const
+{
+	return frameOffsets_.empty() ? 0 : frameOffsets_.size() - 1;
+}
+
+size_t ResourceHeader::GetRawSize() const
+{
+	return rawSize_;
+}
+
+const std::vector<uint64_t> &ResourceHeader::GetFrameOffsets() const
+{
+	return frameOffsets_;
+}
+
+bool ResourceHeader::MatchesChecksum(const char *payload, const size_t size) const
+{
+	return !hasChecksum_ || IResource::Crc32(payload, size) == checksum_;
+}
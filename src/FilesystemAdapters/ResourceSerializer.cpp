@@ -1,20 +1,74 @@
 #include "FilesystemAdapters/ResourceSerializer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
 #include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 #include "Config/filesystem.hpp"
 
+#if defined(__APPLE__) || defined(__MACH__)
 #include <boost/system/error_code.hpp>
+#else
+#include <system_error>
+#endif
 
+#include "FilesystemAdapters/AlignedFile.h"
+#include "FilesystemAdapters/DeltaLog.h"
 #include "FilesystemAdapters/FileLock.hpp"
 #include "FilesystemAdapters/ISerializableResource.h"
+#include "FilesystemAdapters/Journal.h"
+#include "FilesystemAdapters/PackFile.h"
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "FilesystemAdapters/ResourceSnapshot.h"
+#include "Intraprocess/ThreadPool.h"
+#include "Resources/Codec.h"
+#include "Resources/DataType.h"
+#include "Resources/DeltaCodec.h"
+#include "Resources/Encoding.h"
+#include "Resources/IResource.h"
+#include "Resources/ResourceView.h"
+#include "Resources/SparseResource.h"
+#include "Resources/ZoneMap.h"
 
+#if defined(__APPLE__) || defined(__MACH__)
 using boost::system::error_code;
-using filesystem_adapters::GetGlobalFileLock;
+#else
+using std::error_code;
+#endif
+using filesystem_adapters::AlignedFile;
+using filesystem_adapters::DeltaLog;
+using filesystem_adapters::GetFileLock;
 using filesystem_adapters::ISerializableResource;
+using filesystem_adapters::Journal;
+using filesystem_adapters::PackFile;
+using filesystem_adapters::ResourceHeader;
 using filesystem_adapters::ResourceSerializer;
+using filesystem_adapters::ResourceSnapshot;
+using resource::ResourceView;
+using resource::Codec;
+using resource::CodecType;
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::DeltaCodec;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::IResource;
+using resource::Quantization;
+using resource::SparseResource;
+using resource::ZoneMap;
 
 using LockedResource = filesystem_adapters::ISerializableResource::LockedResource;
 
@@ -22,7 +76,119 @@ namespace
 {
 	const std::string RESOURCE_EXT = ".bin";
 	const std::string RESOURCE_TMP_EXT = ".tmp";
-}
+
+	// sparse payload: nnz, M + 1 row offsets, nnz column indices, nnz values
+	void WriteSparse(std::ostream &outfile, ResourceHeader header, const std::vector<size_t> &rowOffsets, const size_t *columnIndices, const void *values, const size_t nnz, const size_t elementSize)
+	{
+		uint32_t checksum = IResource::Crc32(&nnz, sizeof(size_t));
+		checksum = IResource::Crc32(rowOffsets.data(), rowOffsets.size() * sizeof(size_t), checksum);
+		checksum = IResource::Crc32(columnIndices, nnz * sizeof(size_t), checksum);
+		checksum = IResource::Crc32(values, nnz * elementSize, checksum);
+		header.SetChecksum(checksum);
+		header.Write(outfile);
+
+		outfile.write(reinterpret_cast<const char *>(&nnz), sizeof(size_t));
+		outfile.write(reinterpret_cast<const char *>(rowOffsets.data()), rowOffsets.size() * sizeof(size_t));
+		outfile.write(reinterpret_cast<const char *>(columnIndices), nnz * sizeof(size_t));
+		outfile.write(static_cast<const char *>(values), nnz * elementSize);
+	}
+
+	void WriteSparse(std::ostream &outfile, const ResourceHeader &header, const SparseResource &sparse)
+	{
+		std::vector<size_t> rowOffsets(sparse.GetRowOffsets().cbegin(), sparse.GetRowOffsets().cend());
+		if (rowOffsets.empty())
+			rowOffsets.assign(sparse.GetColumnSize() + 1, 0);
+		WriteSparse(outfile, header, rowOffsets, sparse.GetColumnIndices().data(), sparse.Data(), sparse.GetNonZeroCount(), sparse.GetElementSize());
+	}
+
+	// frames are independent, so they are compressed on an OpenMP team and can later be read one at a time
+	std::vector<std::vector<char>> CompressFrames(const Codec &codec, const char *data, const size_t size, const size_t frameSize)
+	{
+		const long long frameCount = static_cast<long long>((size + frameSize - 1) / frameSize);
+		std::vector<std::vector<char>> frames(static_cast<size_t>(frameCount));
+		std::exception_ptr error;
+
+#pragma omp parallel for schedule(dynamic) if (frameCount > 1)
+		for (long long frame = 0; frame < frameCount; ++frame)
+		{
+			const size_t offset = static_cast<size_t>(frame) * frameSize;
+			try
+			{
+				frames[frame] = codec.Compress(data + offset, std::min(frameSize, size - offset));
+			}
+			catch (...)
+			{
+#pragma omp critical
+				error = std::current_exception();
+			}
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+		return frames;
+	}
+
+	// the checksum covers the stored bytes, so corrupt frames are found before they are decompressed
+	void WritePayload(std::ostream &outfile, ResourceHeader &header, const Codec &codec, const size_t frameSize, const char *data, const size_t size, const std::optional<uint32_t> &checksum)
+	{
+		if (codec.GetType() == CodecType::None)
+		{
+			header.SetChecksum(checksum ? *checksum : IResource::Crc32(data, size));
+			header.Write(outfile);
+			outfile.write(data, size);
+			return;
+		}
+
+		const std::vector<std::vector<char>> frames = CompressFrames(codec, data, size, frameSize);
+		std::vector<uint64_t> frameOffsets(1, 0);
+		uint32_t frameChecksum = 0;
+		for (const std::vector<char> &frame : frames)
+		{
+			frameOffsets.push_back(frameOffsets.back() + frame.size());
+			frameChecksum = IResource::Crc32(frame.data(), frame.size(), frameChecksum);
+		}
+		header.SetFrames(codec.GetType(), frameSize, size, frameOffsets);
+		header.SetChecksum(frameChecksum);
+		header.Write(outfile);
+		for (const std::vector<char> &frame : frames)
+			outfile.write(frame.data(), frame.size());
+	}
+
+	// zone maps need the element type to interpret the payload
+	void AttachZoneMap(ResourceHeader &header, const void *data, const size_t blockSize)
+	{
+		if (blockSize == 0 || header.GetDataType() == DataType::Unknown)
+			return;
+		header.SetZoneMap(ZoneMap::Build(data, header.GetDataType(), header.GetElementCount(), blockSize));
+	}
+
+	// encoded payloads are described by a header of the stored element type; the zone map keeps the original values
+	void WriteDense(std::ostream &outfile, ResourceHeader header, const Encoding &encoding, const Codec &codec, const size_t frameSize, const char *data, const size_t size, const std::optional<uint32_t> &checksum)
+	{
+		const DataType dataType = header.GetDataType();
+		if (!encoding.AppliesTo(dataType))
+		{
+			WritePayload(outfile, header, codec, frameSize, data, size, checksum);
+			return;
+		}
+
+		const size_t count = header.GetElementCount();
+		if (size < count * DataTypeConverter::GetSize(dataType))
+			throw std::runtime_error("Cannot encode a resource payload that is smaller than its shape");
+
+		const DataType storedType = encoding.GetStoredType(dataType);
+		const Quantization quantization = encoding.Fit(data, dataType, count);
+		std::vector<char> encoded(count * DataTypeConverter::GetSize(storedType));
+		encoding.Encode(data, dataType, encoded.data(), count, quantization);
+
+		ResourceHeader encodedHeader(header.GetShape(), header.GetLayout(), storedType);
+		if (encoding.IsQuantized())
+			encodedHeader.SetQuantization(quantization);
+		if (header.HasZoneMap())
+			encodedHeader.SetZoneMap(header.GetZoneMap());
+		WritePayload(outfile, encodedHeader, codec, frameSize, encoded.data(), encoded.size(), std::nullopt);
+	}
+} // end namespace anonymous
 
 ResourceSerializer::ResourceSerializer() = default;
 ResourceSerializer::~ResourceSerializer() noexcept = default;
@@ -40,39 +206,416 @@ void ResourceSerializer::Serialize(const LockedResource &resource, const std::st
 
 	Path resourcePath = std::string(serializationPath);
 
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
-
 	error_code ec;
 	fs::create_directories(resourcePath, ec);
 	if (ec)
 		throw std::runtime_error("ResourceSerializer could not create the directory: " + resourcePath.string());
 
+	WriteResource(resource, key, resourcePath);
+}
+
+bool ResourceSerializer::WriteResource(const LockedResource &resource, const std::string_view key, const Path &resourcePath)
+{
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(resourcePath / (std::string(key) + RESOURCE_EXT)));
+
 	if (!resource.UpdateChecksum())
-		return;
+		return false;
 
-	const std::string keyStr = std::string(key);
-	const std::string fileName = keyStr + RESOURCE_EXT;
-	const std::string tmpFileName = keyStr + RESOURCE_TMP_EXT;
-	std::ofstream outfile((resourcePath / tmpFileName).string(), std::ios::binary);
-	if (!outfile)
-		throw std::runtime_error("Could not open output file: " + (resourcePath / fileName).string());
+	WriteResourceFile(resource, key, resourcePath);
+	return true;
+}
 
-	const void *data = resource.Data();
+void ResourceSerializer::WriteResourceFile(const LockedResource &resource, const std::string_view key, const Path &resourcePath)
+{
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(resourcePath / (std::string(key) + RESOURCE_EXT)));
 
-	const size_t M = resource.GetColumnSize();
-	const char *MBuff = reinterpret_cast<const char *>(&M);
-	outfile.write(MBuff, sizeof(size_t));
+	std::function<void(std::ostream &)> writeImage =
+		[&](std::ostream &outfile)
+	{
+		WriteImage(resource, key, outfile);
+	};
 
-	const size_t N = resource.GetRowSize();
-	const char *NBuff = reinterpret_cast<const char *>(&N);
-	outfile.write(NBuff, sizeof(size_t));
+	WriteFile(resourcePath, std::string(key), writeImage);
+}
 
-	const char *buff = reinterpret_cast<const char *>(data);
+void ResourceSerializer::WriteImage(const LockedResource &resource, const std::string_view key, std::ostream &outfile) const
+{
+	ResourceHeader header(resource.GetShape(), resource.GetLayout(), resource.GetDataType());
+	if (auto sparse = dynamic_cast<const SparseResource *>(resource.obj_))
+	{
+		WriteSparse(outfile, header, *sparse);
+		return;
+	}
+
+	const char *buff = reinterpret_cast<const char *>(resource.Data());
 	size_t size = resource.GetElementSize() * resource.GetColumnSize() * resource.GetRowSize();
-	outfile.write(buff, size);
+	AttachZoneMap(header, buff, zoneMapBlockSize_.load(std::memory_order_relaxed));
 
-	// move temp file to actual file
+	// UpdateChecksum has just hashed these bytes in parallel, and the lock keeps them from changing since
+	const uint32_t checksum = static_cast<uint32_t>(resource.GetChecksum());
+	WriteDense(outfile, header, GetEncoding(key), GetCodec(key), GetFrameSize(), buff, size, checksum);
+}
+
+void ResourceSerializer::Serialize(const LockedResource &resource, const std::string_view key, PackFile &pack)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot serialize resource with empty key");
+
+	if (!resource.UpdateChecksum())
+		return;
+
+	std::ostringstream imageStream(std::ios::binary);
+	WriteImage(resource, key, imageStream);
+	const std::string image = imageStream.str();
+	pack.Put(key, image.data(), image.size());
+}
+
+void ResourceSerializer::SerializeChunks(const ResourceHeader &header, const std::string_view key, const std::string_view serializationPath, const ChunkProducerType &produce, const size_t chunkSize, const bool direct)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot stream resource with empty key");
+	if (!produce)
+		throw std::runtime_error("Cannot stream resource without a chunk producer: " + std::string(key));
+	if (header.IsCompressed())
+		throw std::runtime_error("Cannot stream resource with a compressed header: " + std::string(key));
+
+	Path resourcePath = std::string(serializationPath);
+	const std::string fileName = std::string(key) + RESOURCE_EXT;
+	const std::string tmpFileName = std::string(key) + RESOURCE_TMP_EXT;
+
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(resourcePath / fileName));
+
+	error_code ec;
+	fs::create_directories(resourcePath, ec);
+	if (ec)
+		throw std::runtime_error("ResourceSerializer could not create the directory: " + resourcePath.string());
+
+	// the header is written ahead of the payload it would have to checksum
+	ResourceHeader streamedHeader = header;
+	streamedHeader.ClearChecksum();
+	std::ostringstream headerStream(std::ios::binary);
+	streamedHeader.Write(headerStream);
+	const std::string headerBytes = headerStream.str();
+
+	// the header starts the first block, and the payload fills the buffer behind it
+	const size_t bufferSize = AlignedFile::RoundUp(std::max({chunkSize, headerBytes.size(), AlignedFile::ALIGNMENT}));
+	AlignedFile::BufferType buff = AlignedFile::AllocateBuffer(bufferSize);
+	std::copy(headerBytes.cbegin(), headerBytes.cend(), buff.get());
+
+	size_t fill = headerBytes.size();
+	size_t payloadSize = 0;
+	{
+		AlignedFile outfile((resourcePath / tmpFileName).string(), true, direct);
+		for (size_t n = produce(buff.get() + fill, bufferSize - fill, payloadSize); n > 0; n = produce(buff.get() + fill, bufferSize - fill, payloadSize))
+		{
+			if (n > bufferSize - fill)
+				throw std::runtime_error("Chunk producer wrote past the end of the chunk: " + std::string(key));
+			fill += n;
+			payloadSize += n;
+			if (fill == bufferSize)
+			{
+				outfile.Write(buff.get(), bufferSize);
+				fill = 0;
+			}
+		}
+
+		// direct writes are whole blocks, so the padding of the last one is cut off again
+		if (fill > 0)
+			outfile.Write(buff.get(), outfile.IsDirect() ? AlignedFile::RoundUp(fill) : fill);
+		if (outfile.IsDirect())
+			outfile.Truncate(headerBytes.size() + payloadSize);
+		outfile.Close();
+	}
+
+	const size_t expectedSize = header.GetElementCount() * DataTypeConverter::GetSize(header.GetDataType());
+	if (header.GetDataType() != DataType::Unknown && payloadSize != expectedSize)
+	{
+		fs::remove(resourcePath / tmpFileName, ec);
+		throw std::runtime_error("Streamed payload of " + std::to_string(payloadSize) + " bytes does not match its header: " + std::string(key));
+	}
+
+	// the deltas describe the previous base image, so they go before it is replaced
+	DeltaLog((resourcePath / fileName).string()).Remove();
+
+	fs::rename(resourcePath / tmpFileName, resourcePath / fileName, ec);
+	if (ec)
+		throw std::runtime_error("ResourceSerializer could .tmp file to file: " + fileName);
+
+	// the payload is too large to journal, so the file is synced instead and older images of it are dropped
+	std::shared_ptr<Journal> journal = GetJournal();
+	if (journal)
+		journal->Flush((resourcePath / fileName).string());
+}
+
+std::vector<ResourceSerializer::BatchResult> ResourceSerializer::SerializeBatch(const std::span<const BatchItem> items, const size_t threadCount)
+{
+	std::vector<BatchResult> results(items.size());
+
+	// sorting by directory lets each directory be created once; the items are still written concurrently
+	std::vector<size_t> order(items.size());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::stable_sort(order.begin(), order.end(), [&items](const size_t a, const size_t b)
+					 { return items[a].serializationPath < items[b].serializationPath; });
+
+	std::map<std::string, std::string> directoryErrors;
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		const std::string &directory = items[order[i]].serializationPath;
+		if (i > 0 && directory == items[order[i - 1]].serializationPath)
+			continue;
+
+		error_code ec;
+		fs::create_directories(Path(directory), ec);
+		if (ec)
+			directoryErrors[directory] = "ResourceSerializer could not create the directory: " + directory;
+	}
+
+	// the items of a resource go to one task, so a resource is hashed once and never by two workers at once
+	std::vector<std::vector<size_t>> tasks;
+	std::map<const ISerializableResource *, size_t> resourceTasks;
+	for (const size_t index : order)
+	{
+		const ISerializableResource *resource = items[index].resource;
+		auto task = resource ? resourceTasks.find(resource) : resourceTasks.end();
+		if (task != resourceTasks.end())
+		{
+			tasks[task->second].push_back(index);
+			continue;
+		}
+		if (resource)
+			resourceTasks.emplace(resource, tasks.size());
+		tasks.push_back({index});
+	}
+
+	std::atomic<size_t> next{0};
+	std::function<void()> work =
+		[&]()
+	{
+		for (size_t t = next.fetch_add(1); t < tasks.size(); t = next.fetch_add(1))
+		{
+			const ISerializableResource *resource = items[tasks[t].front()].resource;
+			if (!resource)
+			{
+				for (const size_t index : tasks[t])
+				{
+					results[index].status = BatchStatus::Failed;
+					results[index].error = "Cannot serialize null resource with key: " + items[index].key;
+				}
+				continue;
+			}
+
+			// the resource is hashed once and stays locked, so every item of a changed resource writes the hashed payload
+			const LockedResource locked = resource->LockShared();
+			std::optional<bool> changed;
+			for (const size_t index : tasks[t])
+			{
+				const BatchItem &item = items[index];
+				BatchResult &result = results[index];
+				try
+				{
+					if (item.key.empty())
+						throw std::runtime_error("Cannot serialize resource with empty key");
+					if (item.serializationPath.empty())
+						throw std::runtime_error("Cannot serialize resource with empty path: " + item.key);
+
+					auto directoryError = directoryErrors.find(item.serializationPath);
+					if (directoryError != directoryErrors.cend())
+						throw std::runtime_error(directoryError->second);
+
+					if (!changed)
+						changed = locked.UpdateChecksum();
+					if (*changed)
+						WriteResourceFile(locked, item.key, Path(item.serializationPath));
+					result.status = *changed ? BatchStatus::Written : BatchStatus::Unchanged;
+				}
+				catch (const std::exception &e)
+				{
+					result.status = BatchStatus::Failed;
+					result.error = e.what();
+				}
+			}
+		}
+	};
+
+	const size_t hardwareThreads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+	const size_t workerCount = std::min(threadCount == 0 ? hardwareThreads : threadCount, tasks.size());
+	if (workerCount <= 1)
+	{
+		work();
+		return results;
+	}
+
+	intraprocess::ThreadPool pool(workerCount);
+	for (size_t t = 0; t < workerCount; ++t)
+		pool.Post(work);
+	pool.Join();
+
+	return results;
+}
+
+void ResourceSerializer::Serialize(const ResourceSnapshot &snapshot, const std::string_view key, const std::string_view serializationPath)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot serialize resource snapshot with empty key");
+
+	Path resourcePath = std::string(serializationPath);
+
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(resourcePath / (std::string(key) + RESOURCE_EXT)));
+
+	error_code ec;
+	fs::create_directories(resourcePath, ec);
+	if (ec)
+		throw std::runtime_error("ResourceSerializer could not create the directory: " + resourcePath.string());
+
+	ResourceHeader header(snapshot.GetShape(), snapshot.GetLayout(), snapshot.GetDataType());
+	const Encoding encoding = GetEncoding(key);
+	const Codec codec = GetCodec(key);
+
+	std::function<void(std::ostream &)> writeImage =
+		[&](std::ostream &outfile)
+	{
+		if (snapshot.IsSparse())
+		{
+			const size_t nnz = snapshot.GetColumnIndices().size();
+			WriteSparse(outfile, header, snapshot.GetRowOffsets(), snapshot.GetColumnIndices().data(), snapshot.Data(), nnz, snapshot.GetElementSize());
+		}
+		else
+		{
+			AttachZoneMap(header, snapshot.Data(), zoneMapBlockSize_.load(std::memory_order_relaxed));
+			WriteDense(outfile, header, encoding, codec, GetFrameSize(), static_cast<const char *>(snapshot.Data()), snapshot.GetSize(), std::nullopt);
+		}
+	};
+
+	WriteFile(resourcePath, std::string(key), writeImage);
+}
+
+void ResourceSerializer::Serialize(const ResourceView &view, const std::string_view key, const std::string_view serializationPath)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot serialize resource view with empty key");
+
+	Path resourcePath = std::string(serializationPath);
+
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(resourcePath / (std::string(key) + RESOURCE_EXT)));
+
+	error_code ec;
+	fs::create_directories(resourcePath, ec);
+	if (ec)
+		throw std::runtime_error("ResourceSerializer could not create the directory: " + resourcePath.string());
+
+	std::function<void(std::ostream &)> writeImage =
+		[&](std::ostream &outfile)
+	{
+		const size_t M = view.GetColumnSize();
+		const size_t N = view.GetRowSize();
+		ResourceHeader header({M, N}, resource::Layout(), view.GetParent().GetDataType());
+		if (M == 0 || N == 0)
+		{
+			header.Write(outfile);
+			return;
+		}
+
+		const size_t rowBytes = N * view.GetElementSize();
+		if (view.IsContiguous())
+		{
+			header.SetChecksum(IResource::Crc32(view.At(0, 0), M * rowBytes));
+			header.Write(outfile);
+			outfile.write(static_cast<const char *>(view.At(0, 0)), M * rowBytes);
+		}
+		else if (view.IsRowContiguous())
+		{
+			uint32_t checksum = 0;
+			for (size_t i = 0; i < M; ++i)
+				checksum = IResource::Crc32(view.At(i, 0), rowBytes, checksum);
+			header.SetChecksum(checksum);
+			header.Write(outfile);
+			for (size_t i = 0; i < M; ++i)
+				outfile.write(static_cast<const char *>(view.At(i, 0)), rowBytes);
+		}
+		else
+		{
+			// gathered rows are written without a checksum, which would take a second gather
+			header.Write(outfile);
+
+			// gather one row at a time so that memory use is bounded by a single row
+			auto rowBuff = std::make_unique<char[]>(rowBytes);
+			for (size_t i = 0; i < M; ++i)
+			{
+				view.CopyRow(i, rowBuff.get());
+				outfile.write(rowBuff.get(), rowBytes);
+			}
+		}
+	};
+
+	WriteFile(resourcePath, std::string(key), writeImage);
+}
+
+void ResourceSerializer::WriteFile(const Path &resourcePath, const std::string &key, const std::function<void(std::ostream &)> &writeImage)
+{
+	std::shared_ptr<Journal> journal = GetJournal();
+	if (!journal)
+	{
+		ReplaceFile(resourcePath, key, writeImage);
+		return;
+	}
+
+	// the journal holds the whole image, which replays the file even if it was written as a delta
+	std::ostringstream imageStream(std::ios::binary);
+	writeImage(imageStream);
+	const std::string_view image = imageStream.view();
+
+	// the payload was hashed for its header, so only the header itself is hashed again
+	const ResourceHeader header = ResourceHeader::Read(image.data(), image.size());
+	const uint32_t checksum = header.HasChecksum() ? IResource::Crc32Combine(IResource::Crc32(image.data(), header.GetSize()), header.GetChecksum(), image.size() - header.GetSize())
+												   : IResource::Crc32(image.data(), image.size());
+
+	std::function<void(std::ostream &)> copyImage =
+		[&](std::ostream &outfile)
+	{
+		outfile.write(image.data(), image.size());
+	};
+	journal->Write((resourcePath / (key + RESOURCE_EXT)).string(), image.data(), image.size(), checksum, [&]()
+				   { ReplaceFile(resourcePath, key, copyImage); });
+}
+
+void ResourceSerializer::ReplaceFile(const Path &resourcePath, const std::string &key, const std::function<void(std::ostream &)> &writeImage)
+{
+	const std::string fileName = key + RESOURCE_EXT;
+	const std::string tmpFileName = key + RESOURCE_TMP_EXT;
+	DeltaLog deltaLog((resourcePath / fileName).string());
+
+	// while the chain is short, only what changed since the latest version is appended
+	const size_t chainLength = deltaChainLength_.load(std::memory_order_relaxed);
+	std::string image;
+	if (chainLength > 0 && deltaLog.GetLength() < chainLength && fs::exists(resourcePath / fileName))
+	{
+		std::ostringstream imageStream(std::ios::binary);
+		writeImage(imageStream);
+		image = imageStream.str();
+
+		const std::vector<char> previous = deltaLog.ReadImage();
+		const std::vector<char> delta = DeltaCodec::Encode(previous.data(), previous.size(), image.data(), image.size());
+		if (delta.size() <= image.size() / 2)
+		{
+			deltaLog.Append(delta);
+			return;
+		}
+	}
+
+	std::ofstream outfile((resourcePath / tmpFileName).string(), std::ios::binary);
+	if (!outfile)
+		throw std::runtime_error("Could not open output file: " + (resourcePath / fileName).string());
+	if (image.empty())
+		writeImage(outfile);
+	else
+		outfile.write(image.data(), image.size());
+
+	// the deltas describe the previous base image, so they go before it is replaced
 	outfile.close();
+	deltaLog.Remove();
+
+	// move temp file to actual file
+	error_code ec;
 	fs::rename(resourcePath / tmpFileName, resourcePath / fileName, ec);
 	if (ec)
 		throw std::runtime_error("ResourceSerializer could .tmp file to file: " + fileName);
@@ -86,8 +629,20 @@ void ResourceSerializer::Unserialize(const std::string_view key, const std::stri
 	const std::string fileName = std::string(key) + RESOURCE_EXT;
 	Path resourcePath = Path(serializationPath) / fileName;
 
-	std::lock_guard<std::recursive_mutex> lock(GetGlobalFileLock());
+	std::lock_guard<std::recursive_mutex> lock(GetFileLock(resourcePath));
+
+	std::shared_ptr<Journal> journal = GetJournal();
+	if (journal)
+	{
+		journal->Remove(resourcePath.string(), [&]()
+						{ RemoveFile(resourcePath); });
+		return;
+	}
+	RemoveFile(resourcePath);
+}
 
+void ResourceSerializer::RemoveFile(const Path &resourcePath)
+{
 	if (fs::exists(resourcePath))
 	{
 		error_code ec;
@@ -102,4 +657,107 @@ void ResourceSerializer::Unserialize(const std::string_view key, const std::stri
 		if (ec)
 			throw std::runtime_error("ResourceSerializer could not remove file: " + resourcePath.string());
 	}
+	DeltaLog(resourcePath.string()).Remove();
+}
+
+void ResourceSerializer::Unserialize(const std::string_view key, PackFile &pack)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot unserialize resource with empty key");
+
+	pack.Erase(key);
+}
+
+void ResourceSerializer::SetZoneMapBlockSize(const size_t blockSize)
+{
+	zoneMapBlockSize_.store(blockSize, std::memory_order_relaxed);
+}
+
+size_t ResourceSerializer::GetZoneMapBlockSize() const
+{
+	return zoneMapBlockSize_.load(std::memory_order_relaxed);
+}
+
+void ResourceSerializer::SetDeltaChainLength(const size_t chainLength)
+{
+	deltaChainLength_.store(chainLength, std::memory_order_relaxed);
+}
+
+size_t ResourceSerializer::GetDeltaChainLength() const
+{
+	return deltaChainLength_.load(std::memory_order_relaxed);
+}
+
+void ResourceSerializer::SetJournal(std::shared_ptr<Journal> journal)
+{
+	std::lock_guard<std::mutex> lock(journalLock_);
+	journal_ = std::move(journal);
+}
+
+std::shared_ptr<Journal> ResourceSerializer::GetJournal() const
+{
+	std::lock_guard<std::mutex> lock(journalLock_);
+	return journal_;
+}
+
+void ResourceSerializer::SetEncoding(const std::string_view key, const Encoding &encoding)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot set the encoding of a resource with empty key");
+
+	std::unique_lock<std::shared_mutex> lock(encodingLock_);
+
+	if (encoding.GetType() == EncodingType::None)
+	{
+		auto it = keyToEncodingMap_.find(key);
+		if (it != keyToEncodingMap_.end())
+			keyToEncodingMap_.erase(it);
+		return;
+	}
+	keyToEncodingMap_.insert_or_assign(std::string(key), encoding);
+}
+
+Encoding ResourceSerializer::GetEncoding(const std::string_view key) const
+{
+	std::shared_lock<std::shared_mutex> lock(encodingLock_);
+
+	auto it = keyToEncodingMap_.find(key);
+	return it == keyToEncodingMap_.cend() ? Encoding() : it->second;
+}
+
+void ResourceSerializer::SetCodec(const std::string_view key, const Codec &codec)
+{
+	if (key.empty())
+		throw std::runtime_error("Cannot set the codec of a resource with empty key");
+
+	std::unique_lock<std::shared_mutex> lock(encodingLock_);
+
+	if (codec.GetType() == CodecType::None)
+	{
+		auto it = keyToCodecMap_.find(key);
+		if (it != keyToCodecMap_.end())
+			keyToCodecMap_.erase(it);
+		return;
+	}
+	keyToCodecMap_.insert_or_assign(std::string(key), codec);
+}
+
+Codec ResourceSerializer::GetCodec(const std::string_view key) const
+{
+	std::shared_lock<std::shared_mutex> lock(encodingLock_);
+
+	auto it = keyToCodecMap_.find(key);
+	return it == keyToCodecMap_.cend() ? Codec(CodecType::None) : it->second;
+}
+
+void ResourceSerializer::SetFrameSize(const size_t frameSize)
+{
+	if (frameSize == 0)
+		throw std::runtime_error("Cannot compress resources in frames of 0 bytes");
+	frameSize_.store(frameSize, std::memory_order_relaxed);
+}
+
+size_t ResourceSerializer::GetFrameSize() const
+{
+	return frameSize_.load(std::memory_order_relaxed);
 }
@@ -0,0 +1,98 @@
+#include "FilesystemAdapters/ResourceSnapshot.h"
+
+#include <cstring>
+#include <vector>
+
+#include "FilesystemAdapters/ISerializableResource.h"
+#include "Resources/SparseResource.h"
+
+using filesystem_adapters::ISerializableResource;
+using filesystem_adapters::ResourceSnapshot;
+using resource::SparseResource;
+
+ResourceSnapshot::ResourceSnapshot(const ISerializableResource &resource, const uint64_t version)
+	: version_(version),
+	  M_(resource.GetColumnSize()),
+	  N_(resource.GetRowSize()),
+	  shape_(resource.GetShape()),
+	  layout_(resource.GetLayout()),
+	  dataType_(resource.GetDataType()),
+	  elementSize_(resource.GetElementSize())
+{
+	size_t count = M_ * N_;
+	if (auto sparse = dynamic_cast<const SparseResource *>(&resource))
+	{
+		sparse_ = true;
+		count = sparse->GetNonZeroCount();
+		rowOffsets_.assign(sparse->GetRowOffsets().cbegin(), sparse->GetRowOffsets().cend());
+		if (rowOffsets_.empty())
+			rowOffsets_.assign(M_ + 1, 0);
+		columnIndices_.assign(sparse->GetColumnIndices().cbegin(), sparse->GetColumnIndices().cend());
+	}
+
+	payload_.resize(count * elementSize_);
+	if (!payload_.empty())
+		std::memcpy(payload_.data(), resource.Data(), payload_.size());
+}
+
+ResourceSnapshot::~ResourceSnapshot() noexcept = default;
+
+uint64_t ResourceSnapshot::GetVersion() const
+{
+	return version_;
+}
+
+size_t ResourceSnapshot::GetColumnSize() const
+{
+	return M_;
+}
+
+size_t ResourceSnapshot::GetRowSize() const
+{
+	return N_;
+}
+
+const std::vector<size_t> &ResourceSnapshot::GetShape() const
+{
+	return shape_;
+}
+
+const resource::Layout &ResourceSnapshot::GetLayout() const
+{
+	return layout_;
+}
+
+resource::DataType ResourceSnapshot::GetDataType() const
+{
+	return dataType_;
+}
+
+size_t ResourceSnapshot::GetElementSize() const
+{
+	return elementSize_;
+}
+
+const void *ResourceSnapshot::Data() const
+{
+	return payload_.data();
+}
+
+size_t ResourceSnapshot::GetSize() const
+{
+	return payload_.size();
+}
+
+bool ResourceSnapshot::IsSparse() const
+{
+	return sparse_;
+}
+
+const std::vector<size_t> &ResourceSnapshot::GetRowOffsets() const
+{
+	return rowOffsets_;
+}
+
+const std::vector<size_t> &ResourceSnapshot::GetColumnIndices() const
+{
+	return columnIndices_;
+}
@@ -0,0 +1,88 @@
+#include "Resources/ArenaMemoryResource.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+using resource::ArenaMemoryResource;
+
+ArenaMemoryResource::ArenaMemoryResource(const size_t alignment, const size_t chunkSize, std::pmr::memory_resource *upstream)
+	: alignment_(alignment), chunkSize_(std::max(chunkSize, alignment)), initialChunkSize_(chunkSize_), upstream_(upstream)
+{
+	if (!upstream)
+		throw std::runtime_error("ArenaMemoryResource requires an upstream memory resource");
+	if (!std::has_single_bit(alignment))
+		throw std::runtime_error("ArenaMemoryResource alignment must be a power of two: " + std::to_string(alignment));
+}
+
+ArenaMemoryResource::~ArenaMemoryResource() noexcept
+{
+	Release();
+}
+
+size_t ArenaMemoryResource::GetAlignment() const
+{
+	return alignment_;
+}
+
+size_t ArenaMemoryResource::GetUsedBytes() const
+{
+	return usedBytes_;
+}
+
+size_t ArenaMemoryResource::GetReservedBytes() const
+{
+	return reservedBytes_;
+}
+
+void ArenaMemoryResource::Release()
+{
+	for (const Chunk &chunk : chunks_)
+		upstream_->deallocate(chunk.data, chunk.size, chunk.alignment);
+	chunks_.clear();
+	chunkSize_ = initialChunkSize_;
+	offset_ = 0;
+	usedBytes_ = 0;
+	reservedBytes_ = 0;
+}
+
+void *ArenaMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+	alignment = std::max(alignment, alignment_);
+
+	if (!chunks_.empty())
+	{
+		const Chunk &chunk = chunks_.back();
+		const uintptr_t address = reinterpret_cast<uintptr_t>(chunk.data) + offset_;
+		const size_t padding = (alignment - address % alignment) % alignment;
+		if (offset_ + padding + bytes <= chunk.size)
+		{
+			offset_ += padding + bytes;
+			usedBytes_ += padding + bytes;
+			return chunk.data + offset_ - bytes;
+		}
+	}
+
+	// chunks grow geometrically, and a chunk always fits the request that started it
+	const size_t size = std::max(chunkSize_, bytes);
+	char *data = static_cast<char *>(upstream_->allocate(size, alignment));
+	chunks_.push_back(Chunk{data, size, alignment});
+	chunkSize_ *= 2;
+	reservedBytes_ += size;
+
+	offset_ = bytes;
+	usedBytes_ += bytes;
+	return data;
+}
+
+void ArenaMemoryResource::do_deallocate(void *, size_t, size_t)
+{
+}
+
+bool ArenaMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+	return this == &other;
+}
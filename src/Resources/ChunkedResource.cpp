@@ -0,0 +1,204 @@
+#include "Resources/ChunkedResource.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "Resources/DataType.h"
+#include "Resources/PageCache.h"
+
+using resource::ChunkedResource;
+using resource::DataTypeConverter;
+using resource::IChunkStore;
+using resource::PageCache;
+
+ChunkedResource::ChunkedResource() = default;
+
+ChunkedResource::~ChunkedResource() noexcept
+{
+	PageCache *cache = PageCache::GetInstance();
+	try
+	{
+		cache->Remove(*this, true);
+	}
+	catch (...)
+	{
+		cache->Remove(*this, false);
+	}
+}
+
+void ChunkedResource::Open(std::unique_ptr<IChunkStore> store, const size_t chunkRows)
+{
+	if (store_)
+		throw std::runtime_error("ChunkedResource is already open");
+	if (!store)
+		throw std::runtime_error("ChunkedResource cannot open a NULL store");
+	if (chunkRows == 0)
+		throw std::runtime_error("ChunkedResource chunks must hold at least one row");
+	if (DataTypeConverter::RequiresConversion(store->GetDataType(), GetDataType()))
+		throw std::runtime_error("ChunkedResource cannot open " + DataTypeConverter::GetName(store->GetDataType()) + " elements as " + DataTypeConverter::GetName(GetDataType()));
+
+	const std::vector<size_t> shape = store->GetShape();
+	size_t count = 1;
+	for (size_t extent : shape)
+		count *= extent;
+	if (store->GetSize() != count * GetElementSize())
+		throw std::runtime_error("ChunkedResource store size does not match its shape");
+
+	SetShape(shape);
+	store_ = std::move(store);
+	chunkRows_ = chunkRows;
+	sliceSize_ = GetRowSize() * GetElementSize();
+}
+
+void ChunkedResource::Close()
+{
+	PageCache::GetInstance()->Remove(*this, true);
+	store_.reset();
+	chunkRows_ = 0;
+	sliceSize_ = 0;
+	ClearShape();
+}
+
+bool ChunkedResource::IsOpen() const
+{
+	return store_ != nullptr;
+}
+
+size_t ChunkedResource::GetChunkRows() const
+{
+	return chunkRows_;
+}
+
+size_t ChunkedResource::GetChunkCount() const
+{
+	if (chunkRows_ == 0)
+		return 0;
+	return (GetColumnSize() + chunkRows_ - 1) / chunkRows_;
+}
+
+size_t ChunkedResource::GetChunkSize(const size_t chunk) const
+{
+	CheckChunk(chunk);
+	const size_t first = chunk * chunkRows_;
+	return std::min(chunkRows_, GetColumnSize() - first) * sliceSize_;
+}
+
+std::shared_ptr<const void> ChunkedResource::ReadChunk(const size_t chunk) const
+{
+	CheckChunk(chunk);
+	PageCache *cache = PageCache::GetInstance();
+	const char *data = cache->Acquire(*this, chunk, false);
+
+	auto unpin = [cache, this, chunk](const void *)
+	{ cache->Unpin(*this, chunk); };
+	return std::shared_ptr<const void>(data, unpin);
+}
+
+std::shared_ptr<void> ChunkedResource::WriteChunk(const size_t chunk)
+{
+	CheckChunk(chunk);
+	PageCache *cache = PageCache::GetInstance();
+	char *data = cache->Acquire(*this, chunk, true);
+
+	auto unpin = [cache, this, chunk](void *)
+	{ cache->Unpin(*this, chunk); };
+	return std::shared_ptr<void>(data, unpin);
+}
+
+bool ChunkedResource::IsResident(const size_t chunk) const
+{
+	return PageCache::GetInstance()->IsResident(*this, chunk);
+}
+
+void ChunkedResource::ReadRows(const size_t first, const size_t count, char *buff) const
+{
+	if (!store_)
+		throw std::runtime_error("ChunkedResource is not open");
+	if (first + count > GetColumnSize())
+		throw std::runtime_error("ChunkedResource rows " + std::to_string(first) + " to " + std::to_string(first + count) + " are out of range");
+
+	for (size_t row = first; row < first + count;)
+	{
+		const size_t chunk = row / chunkRows_;
+		const size_t offset = row - chunk * chunkRows_;
+		const size_t rows = std::min(first + count - row, GetChunkSize(chunk) / sliceSize_ - offset);
+
+		std::shared_ptr<const void> data = ReadChunk(chunk);
+		std::memcpy(buff, static_cast<const char *>(data.get()) + offset * sliceSize_, rows * sliceSize_);
+		buff += rows * sliceSize_;
+		row += rows;
+	}
+}
+
+void ChunkedResource::WriteRows(const size_t first, const size_t count, const char *buff)
+{
+	if (!store_)
+		throw std::runtime_error("ChunkedResource is not open");
+	if (first + count > GetColumnSize())
+		throw std::runtime_error("ChunkedResource rows " + std::to_string(first) + " to " + std::to_string(first + count) + " are out of range");
+
+	for (size_t row = first; row < first + count;)
+	{
+		const size_t chunk = row / chunkRows_;
+		const size_t offset = row - chunk * chunkRows_;
+		const size_t rows = std::min(first + count - row, GetChunkSize(chunk) / sliceSize_ - offset);
+
+		std::shared_ptr<void> data = WriteChunk(chunk);
+		std::memcpy(static_cast<char *>(data.get()) + offset * sliceSize_, buff, rows * sliceSize_);
+		buff += rows * sliceSize_;
+		row += rows;
+	}
+}
+
+void ChunkedResource::Flush() const
+{
+	PageCache::GetInstance()->Flush(*this);
+}
+
+void *ChunkedResource::Data()
+{
+	throw std::runtime_error("ChunkedResource payload is not resident; access it through its chunks");
+}
+
+const void *ChunkedResource::Data() const
+{
+	throw std::runtime_error("ChunkedResource payload is not resident; access it through its chunks");
+}
+
+void ChunkedResource::Assign(const char *buff, const size_t n)
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during ChunkedResource::Assign");
+	if (!store_)
+		throw std::runtime_error("ChunkedResource must be open during ChunkedResource::Assign");
+	if (n != GetColumnSize() * sliceSize_)
+		throw std::runtime_error("n does not match the size of the resource during ChunkedResource::Assign");
+
+	WriteRows(0, GetColumnSize(), buff);
+}
+
+int ChunkedResource::Checksum() const
+{
+	uint32_t crc = 0;
+	for (size_t chunk = 0; chunk < GetChunkCount(); ++chunk)
+		crc = Crc32(ReadChunk(chunk).get(), GetChunkSize(chunk), crc);
+	return static_cast<int>(crc);
+}
+
+size_t ChunkedResource::GetChunkOffset(const size_t chunk) const
+{
+	return chunk * chunkRows_ * sliceSize_;
+}
+
+void ChunkedResource::CheckChunk(const size_t chunk) const
+{
+	if (!store_)
+		throw std::runtime_error("ChunkedResource is not open");
+	if (chunk >= GetChunkCount())
+		throw std::runtime_error("ChunkedResource chunk " + std::to_string(chunk) + " is out of range");
+}
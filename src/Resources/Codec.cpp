@@ -0,0 +1,189 @@
+#include "Resources/Codec.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#ifdef RESOURCE_WITH_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef RESOURCE_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+using resource::Codec;
+using resource::CodecType;
+
+#ifdef RESOURCE_WITH_LZ4
+namespace
+{
+	void CheckIntSize(const size_t n, const CodecType type)
+	{
+		if (n > static_cast<size_t>(std::numeric_limits<int>::max()))
+			throw std::runtime_error("Buffer of " + std::to_string(n) + " bytes is too large for the " + Codec::GetName(type) + " codec");
+	}
+} // end namespace anonymous
+#endif
+
+Codec::Codec(const CodecType type, const int level) : type_(type), level_(level)
+{
+	if (!IsAvailable(type))
+		throw std::runtime_error("Codec " + GetName(type) + " is not available in this build");
+}
+
+Codec::~Codec() noexcept = default;
+Codec::Codec(const Codec &) = default;
+Codec &Codec::operator=(const Codec &) = default;
+Codec::Codec(Codec &&) noexcept = default;
+Codec &Codec::operator=(Codec &&) noexcept = default;
+
+bool Codec::IsAvailable(const CodecType type)
+{
+	switch (type)
+	{
+	case CodecType::None:
+	case CodecType::Zlib:
+		return true;
+	case CodecType::LZ4:
+#ifdef RESOURCE_WITH_LZ4
+		return true;
+#else
+		return false;
+#endif
+	case CodecType::Zstd:
+#ifdef RESOURCE_WITH_ZSTD
+		return true;
+#else
+		return false;
+#endif
+	}
+	return false;
+}
+
+std::string Codec::GetName(const CodecType type)
+{
+	switch (type)
+	{
+	case CodecType::None:
+		return "none";
+	case CodecType::Zlib:
+		return "zlib";
+	case CodecType::LZ4:
+		return "lz4";
+	case CodecType::Zstd:
+		return "zstd";
+	}
+	return "unknown";
+}
+
+CodecType Codec::GetType() const
+{
+	return type_;
+}
+
+int Codec::GetLevel() const
+{
+	return level_;
+}
+
+std::vector<char> Codec::Compress(const char *buff, const size_t n) const
+{
+	if (!buff && n > 0)
+		throw std::runtime_error("Buffer cannot be NULL during Codec::Compress");
+
+	std::vector<char> out;
+	switch (type_)
+	{
+	case CodecType::None:
+	{
+		out.assign(buff, buff + n);
+		break;
+	}
+	case CodecType::Zlib:
+	{
+		uLongf size = compressBound(static_cast<uLong>(n));
+		out.resize(size);
+		const int level = level_ == 0 ? Z_DEFAULT_COMPRESSION : level_;
+		if (compress2(reinterpret_cast<Bytef *>(out.data()), &size, reinterpret_cast<const Bytef *>(buff), static_cast<uLong>(n), level) != Z_OK)
+			throw std::runtime_error("Zlib could not compress " + std::to_string(n) + " bytes");
+		out.resize(size);
+		break;
+	}
+	case CodecType::LZ4:
+	{
+#ifdef RESOURCE_WITH_LZ4
+		CheckIntSize(n, type_);
+		out.resize(LZ4_compressBound(static_cast<int>(n)));
+		const int size = LZ4_compress_default(buff, out.data(), static_cast<int>(n), static_cast<int>(out.size()));
+		if (size <= 0 && n > 0)
+			throw std::runtime_error("LZ4 could not compress " + std::to_string(n) + " bytes");
+		out.resize(size);
+#endif
+		break;
+	}
+	case CodecType::Zstd:
+	{
+#ifdef RESOURCE_WITH_ZSTD
+		out.resize(ZSTD_compressBound(n));
+		const int level = level_ == 0 ? ZSTD_CLEVEL_DEFAULT : level_;
+		const size_t size = ZSTD_compress(out.data(), out.size(), buff, n, level);
+		if (ZSTD_isError(size))
+			throw std::runtime_error(std::string("Zstd could not compress: ") + ZSTD_getErrorName(size));
+		out.resize(size);
+#endif
+		break;
+	}
+	}
+	return out;
+}
+
+void Codec::Decompress(const char *buff, const size_t n, char *dest, const size_t destSize) const
+{
+	if (destSize == 0)
+		return;
+	if (!buff || !dest)
+		throw std::runtime_error("Buffers cannot be NULL during Codec::Decompress");
+
+	switch (type_)
+	{
+	case CodecType::None:
+	{
+		if (n != destSize)
+			throw std::runtime_error("Uncompressed payload size does not match the destination size");
+		std::memcpy(dest, buff, n);
+		break;
+	}
+	case CodecType::Zlib:
+	{
+		uLongf size = static_cast<uLongf>(destSize);
+		if (uncompress(reinterpret_cast<Bytef *>(dest), &size, reinterpret_cast<const Bytef *>(buff), static_cast<uLong>(n)) != Z_OK || size != destSize)
+			throw std::runtime_error("Zlib could not decompress " + std::to_string(n) + " bytes");
+		break;
+	}
+	case CodecType::LZ4:
+	{
+#ifdef RESOURCE_WITH_LZ4
+		CheckIntSize(destSize, type_);
+		CheckIntSize(n, type_);
+		const int size = LZ4_decompress_safe(buff, dest, static_cast<int>(n), static_cast<int>(destSize));
+		if (size < 0 || static_cast<size_t>(size) != destSize)
+			throw std::runtime_error("LZ4 could not decompress " + std::to_string(n) + " bytes");
+#endif
+		break;
+	}
+	case CodecType::Zstd:
+	{
+#ifdef RESOURCE_WITH_ZSTD
+		const size_t size = ZSTD_decompress(dest, destSize, buff, n);
+		if (ZSTD_isError(size) || size != destSize)
+			throw std::runtime_error("Zstd could not decompress " + std::to_string(n) + " bytes");
+#endif
+		break;
+	}
+	}
+}
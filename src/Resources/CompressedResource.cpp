@@ -0,0 +1,134 @@
+#include "Resources/CompressedResource.h"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "Resources/Codec.h"
+#include "Resources/DecompressionCache.h"
+
+using resource::Codec;
+using resource::CompressedResource;
+using resource::DecompressionCache;
+
+CompressedResource::CompressedResource(const Codec &codec) : codec_(codec) {}
+
+CompressedResource::~CompressedResource() noexcept
+{
+	DecompressionCache::GetInstance()->Remove(*this);
+}
+
+CompressedResource::CompressedResource(const CompressedResource &other) : IResource(other), codec_(other.codec_), size_(other.size_)
+{
+	DecompressionCache::GetInstance()->Flush(other);
+	compressed_ = other.compressed_;
+}
+
+CompressedResource &CompressedResource::operator=(const CompressedResource &other)
+{
+	if (this == &other)
+		return *this;
+
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Remove(*this);
+	cache->Flush(other);
+
+	IResource::operator=(other);
+	codec_ = other.codec_;
+	compressed_ = other.compressed_;
+	size_ = other.size_;
+	return *this;
+}
+
+CompressedResource::CompressedResource(CompressedResource &&other) noexcept : IResource(std::move(other)), codec_(other.codec_), size_(other.size_)
+{
+	// the cache is keyed by address, so the resident buffer is handed over with the compressed payload
+	DecompressionCache::GetInstance()->Transfer(other, *this);
+	compressed_ = std::move(other.compressed_);
+	other.size_ = 0;
+}
+
+CompressedResource &CompressedResource::operator=(CompressedResource &&other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	// the buffer of this resource is released before it takes over the buffer of the other
+	DecompressionCache::GetInstance()->Transfer(other, *this);
+
+	IResource::operator=(std::move(other));
+	codec_ = other.codec_;
+	compressed_ = std::move(other.compressed_);
+	size_ = other.size_;
+	other.size_ = 0;
+	return *this;
+}
+
+void *CompressedResource::Data()
+{
+	if (size_ == 0)
+		return nullptr;
+	return DecompressionCache::GetInstance()->Acquire(*this, true, false);
+}
+
+const void *CompressedResource::Data() const
+{
+	if (size_ == 0)
+		return nullptr;
+	return DecompressionCache::GetInstance()->Acquire(*this, false, false);
+}
+
+void CompressedResource::Assign(const char *buff, const size_t n)
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during CompressedResource::Assign");
+	if (n < 1)
+		throw std::runtime_error("N cannot be 0 during CompressedResource::Assign");
+	if (GetElementSize() == 0 || n % GetElementSize() != 0)
+		throw std::runtime_error("n is not a multiple of the element size during CompressedResource::Assign");
+
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Remove(*this);
+
+	compressed_ = codec_.Compress(buff, n);
+	size_ = n;
+}
+
+std::shared_ptr<void> CompressedResource::Pin() const
+{
+	if (size_ == 0)
+		return std::shared_ptr<void>();
+
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Acquire(*this, false, true);
+
+	auto unpin = [cache](void *resource)
+	{ cache->Unpin(*static_cast<const CompressedResource *>(resource)); };
+	return std::shared_ptr<void>(const_cast<CompressedResource *>(this), unpin);
+}
+
+void CompressedResource::Evict() const
+{
+	DecompressionCache::GetInstance()->Evict(*this);
+}
+
+bool CompressedResource::IsResident() const
+{
+	return DecompressionCache::GetInstance()->IsResident(*this);
+}
+
+size_t CompressedResource::GetCompressedSize() const
+{
+	DecompressionCache::GetInstance()->Flush(*this);
+	return compressed_.size();
+}
+
+size_t CompressedResource::GetUncompressedSize() const
+{
+	return size_;
+}
+
+const Codec &CompressedResource::GetCodec() const
+{
+	return codec_;
+}
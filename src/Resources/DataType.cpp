@@ -0,0 +1,278 @@
+#include "Resources/DataType.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+using resource::DataType;
+using resource::DataTypeConverter;
+
+namespace
+{
+	// storage types for the 16-bit floating point formats
+	struct Half
+	{
+		uint16_t bits;
+	};
+
+	struct BFloat16
+	{
+		uint16_t bits;
+	};
+
+	// round-to-nearest-even without a branch on the common path so that conversion loops vectorize
+	inline uint16_t FloatToHalfBits(const float value)
+	{
+		uint32_t f = std::bit_cast<uint32_t>(value);
+		const uint32_t sign = f & 0x80000000u;
+		f ^= sign;
+
+		uint32_t h;
+		if (f >= 0x47800000u)
+		{
+			// overflow rounds to infinity, NaN stays NaN
+			h = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+		}
+		else if (f < 0x38800000u)
+		{
+			// subnormal halves; adding 0.5f lets the FPU do the rounding
+			const float magic = 0.5f;
+			h = std::bit_cast<uint32_t>(std::bit_cast<float>(f) + magic) - std::bit_cast<uint32_t>(magic);
+		}
+		else
+		{
+			const uint32_t mantissaOdd = (f >> 13) & 1u;
+			f += (uint32_t(15 - 127) << 23) + 0xfffu + mantissaOdd;
+			h = f >> 13;
+		}
+		return static_cast<uint16_t>(h | (sign >> 16));
+	}
+
+	inline float HalfBitsToFloat(const uint16_t bits)
+	{
+		const uint32_t sign = uint32_t(bits & 0x8000u) << 16;
+		uint32_t f = uint32_t(bits & 0x7fffu) << 13;
+		const uint32_t exponent = f & 0x0f800000u;
+
+		f += uint32_t(127 - 15) << 23;
+		if (exponent == 0x0f800000u)
+		{
+			// infinity or NaN
+			f += uint32_t(128 - 16) << 23;
+		}
+		else if (exponent == 0)
+		{
+			// zero or subnormal, renormalized by the FPU
+			f += 1u << 23;
+			f = std::bit_cast<uint32_t>(std::bit_cast<float>(f) - std::bit_cast<float>(113u << 23));
+		}
+		return std::bit_cast<float>(f | sign);
+	}
+
+	inline uint16_t FloatToBFloat16Bits(const float value)
+	{
+		const uint32_t f = std::bit_cast<uint32_t>(value);
+		if ((f & 0x7fffffffu) > 0x7f800000u)
+			return static_cast<uint16_t>((f >> 16) | 0x40u);
+		return static_cast<uint16_t>((f + 0x7fffu + ((f >> 16) & 1u)) >> 16);
+	}
+
+	inline float BFloat16BitsToFloat(const uint16_t bits)
+	{
+		return std::bit_cast<float>(uint32_t(bits) << 16);
+	}
+
+	template <typename To, typename From>
+	inline To Cast(const From value)
+	{
+		if constexpr (std::is_same_v<From, Half>)
+			return Cast<To>(HalfBitsToFloat(value.bits));
+		else if constexpr (std::is_same_v<From, BFloat16>)
+			return Cast<To>(BFloat16BitsToFloat(value.bits));
+		else if constexpr (std::is_same_v<To, Half>)
+			return Half{FloatToHalfBits(static_cast<float>(value))};
+		else if constexpr (std::is_same_v<To, BFloat16>)
+			return BFloat16{FloatToBFloat16Bits(static_cast<float>(value))};
+		else
+			return static_cast<To>(value);
+	}
+
+	template <typename From, typename To>
+	void ConvertKernel(const void *src, void *dst, const size_t count)
+	{
+		const From *in = static_cast<const From *>(src);
+		To *out = static_cast<To *>(dst);
+#pragma omp simd
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Cast<To>(in[i]);
+	}
+
+#if defined(__F16C__)
+	// widening halves is the hot path of loading reduced-precision payloads; F16C converts eight at a time
+	template <>
+	void ConvertKernel<Half, float>(const void *src, void *dst, const size_t count)
+	{
+		const Half *in = static_cast<const Half *>(src);
+		float *out = static_cast<float *>(dst);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i))));
+		for (; i < count; ++i)
+			out[i] = HalfBitsToFloat(in[i].bits);
+	}
+#endif
+
+	// calls visitor with a value of the storage type of the tag
+	template <typename Visitor>
+	void Visit(const DataType type, Visitor &&visitor)
+	{
+		switch (type)
+		{
+		case DataType::Int8:
+			return visitor(int8_t{});
+		case DataType::UInt8:
+			return visitor(uint8_t{});
+		case DataType::Int16:
+			return visitor(int16_t{});
+		case DataType::UInt16:
+			return visitor(uint16_t{});
+		case DataType::Int32:
+			return visitor(int32_t{});
+		case DataType::UInt32:
+			return visitor(uint32_t{});
+		case DataType::Int64:
+			return visitor(int64_t{});
+		case DataType::UInt64:
+			return visitor(uint64_t{});
+		case DataType::Float16:
+			return visitor(Half{});
+		case DataType::BFloat16:
+			return visitor(BFloat16{});
+		case DataType::Float32:
+			return visitor(float{});
+		case DataType::Float64:
+			return visitor(double{});
+		default:
+			throw std::runtime_error("Unknown data type: " + std::to_string(static_cast<uint32_t>(type)));
+		}
+	}
+
+	bool IsFloatingPoint(const DataType type)
+	{
+		return type == DataType::Float16 || type == DataType::BFloat16 || type == DataType::Float32 || type == DataType::Float64;
+	}
+
+	bool IsSigned(const DataType type)
+	{
+		return type == DataType::Int8 || type == DataType::Int16 || type == DataType::Int32 || type == DataType::Int64;
+	}
+} // end namespace anonymous
+
+size_t DataTypeConverter::GetSize(const DataType type)
+{
+	if (type == DataType::Unknown)
+		return 0;
+
+	size_t size = 0;
+	Visit(type, [&size](auto value)
+		  { size = sizeof(value); });
+	return size;
+}
+
+std::string DataTypeConverter::GetName(const DataType type)
+{
+	switch (type)
+	{
+	case DataType::Int8:
+		return "int8";
+	case DataType::UInt8:
+		return "uint8";
+	case DataType::Int16:
+		return "int16";
+	case DataType::UInt16:
+		return "uint16";
+	case DataType::Int32:
+		return "int32";
+	case DataType::UInt32:
+		return "uint32";
+	case DataType::Int64:
+		return "int64";
+	case DataType::UInt64:
+		return "uint64";
+	case DataType::Float16:
+		return "float16";
+	case DataType::BFloat16:
+		return "bfloat16";
+	case DataType::Float32:
+		return "float32";
+	case DataType::Float64:
+		return "float64";
+	default:
+		return "unknown";
+	}
+}
+
+bool DataTypeConverter::IsConvertible(const DataType from, const DataType to)
+{
+	if (from == DataType::Unknown || to == DataType::Unknown)
+		return false;
+	if (from == to || IsFloatingPoint(to))
+		return GetSize(from) > 0;
+	if (IsFloatingPoint(from))
+		return false;
+
+	// integers only widen, and signed values never become unsigned
+	if (IsSigned(from) && !IsSigned(to))
+		return false;
+	return GetSize(to) > GetSize(from) || (GetSize(to) == GetSize(from) && IsSigned(to) == IsSigned(from));
+}
+
+bool DataTypeConverter::RequiresConversion(const DataType stored, const DataType target)
+{
+	return stored != DataType::Unknown && target != DataType::Unknown && stored != target;
+}
+
+void DataTypeConverter::Convert(const void *src, const DataType from, void *dst, const DataType to, const size_t count)
+{
+	if (!IsConvertible(from, to))
+		throw std::runtime_error("Cannot convert " + GetName(from) + " elements to " + GetName(to));
+	if (count == 0)
+		return;
+
+	if (from == to)
+	{
+		std::memcpy(dst, src, count * GetSize(from));
+		return;
+	}
+
+	Visit(from, [&](auto source)
+		  { Visit(to, [&](auto destination)
+				  { ConvertKernel<decltype(source), decltype(destination)>(src, dst, count); }); });
+}
+
+uint16_t DataTypeConverter::FloatToHalf(const float value)
+{
+	return FloatToHalfBits(value);
+}
+
+float DataTypeConverter::HalfToFloat(const uint16_t bits)
+{
+	return HalfBitsToFloat(bits);
+}
+
+uint16_t DataTypeConverter::FloatToBFloat16(const float value)
+{
+	return FloatToBFloat16Bits(value);
+}
+
+float DataTypeConverter::BFloat16ToFloat(const uint16_t bits)
+{
+	return BFloat16BitsToFloat(bits);
+}
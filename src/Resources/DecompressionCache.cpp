@@ -0,0 +1,177 @@
+#include "Resources/DecompressionCache.h"
+
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+#include "Resources/CompressedResource.h"
+
+using resource::CompressedResource;
+using resource::DecompressionCache;
+
+namespace
+{
+	const size_t DEFAULT_BUDGET = size_t(256) << 20;
+} // end namespace anonymous
+
+DecompressionCache::DecompressionCache() : budget_(DEFAULT_BUDGET) {}
+DecompressionCache::~DecompressionCache() noexcept = default;
+
+DecompressionCache *DecompressionCache::GetInstance()
+{
+	static DecompressionCache instance;
+	return &instance;
+}
+
+void DecompressionCache::SetBudget(const size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	budget_ = bytes;
+	EvictOverBudget();
+}
+
+size_t DecompressionCache::GetBudget() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return budget_;
+}
+
+size_t DecompressionCache::GetResidentBytes() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return residentBytes_;
+}
+
+size_t DecompressionCache::GetResidentCount() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return lru_.size();
+}
+
+void DecompressionCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	for (auto it = lru_.begin(); it != lru_.end();)
+	{
+		const CompressedResource *resource = *(it++);
+		if (resource->pins_ == 0)
+			EvictUnlocked(*resource, true);
+	}
+}
+
+char *DecompressionCache::Acquire(const CompressedResource &resource, const bool modify, const bool pin)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	if (auto found = index_.find(&resource); found != index_.cend())
+	{
+		lru_.splice(lru_.begin(), lru_, found->second);
+	}
+	else
+	{
+		resource.resident_ = std::make_unique<char[]>(resource.size_);
+		resource.codec_.Decompress(resource.compressed_.data(), resource.compressed_.size(), resource.resident_.get(), resource.size_);
+		lru_.push_front(&resource);
+		index_[&resource] = lru_.begin();
+		residentBytes_ += resource.size_;
+	}
+
+	if (modify)
+		resource.modified_ = true;
+	if (pin)
+		++resource.pins_;
+
+	// the most recently used resource is never evicted, even if it exceeds the budget on its own
+	EvictOverBudget();
+
+	return resource.resident_.get();
+}
+
+bool DecompressionCache::IsResident(const CompressedResource &resource) const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return index_.find(&resource) != index_.cend();
+}
+
+void DecompressionCache::Unpin(const CompressedResource &resource)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	if (resource.pins_ > 0)
+		--resource.pins_;
+	EvictOverBudget();
+}
+
+void DecompressionCache::Flush(const CompressedResource &resource)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	if (!resource.resident_ || !resource.modified_)
+		return;
+	// a writer may still hold the pointer Data() returned, so the buffer stays modified until it is released
+	resource.compressed_ = resource.codec_.Compress(resource.resident_.get(), resource.size_);
+}
+
+void DecompressionCache::Evict(const CompressedResource &resource)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	if (index_.find(&resource) != index_.cend() && resource.pins_ == 0)
+		EvictUnlocked(resource, true);
+}
+
+void DecompressionCache::Remove(const CompressedResource &resource)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	if (index_.find(&resource) != index_.cend())
+		EvictUnlocked(resource, false);
+}
+
+void DecompressionCache::Transfer(const CompressedResource &from, const CompressedResource &to)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	if (index_.find(&to) != index_.cend())
+		EvictUnlocked(to, false);
+
+	auto found = index_.find(&from);
+	if (found == index_.cend())
+		return;
+
+	// the node is reinserted under the new address, so the index neither allocates nor grows
+	auto node = index_.extract(found);
+	node.key() = &to;
+	*node.mapped() = &to;
+	index_.insert(std::move(node));
+
+	to.resident_ = std::move(from.resident_);
+	to.modified_ = from.modified_;
+	from.modified_ = false;
+}
+
+void DecompressionCache::EvictOverBudget()
+{
+	if (lru_.empty())
+		return;
+
+	auto it = lru_.end();
+	--it;
+	while (residentBytes_ > budget_ && it != lru_.begin())
+	{
+		const CompressedResource *resource = *it;
+		auto next = std::prev(it);
+		if (resource->pins_ == 0)
+			EvictUnlocked(*resource, true);
+		it = next;
+	}
+}
+
+void DecompressionCache::EvictUnlocked(const CompressedResource &resource, const bool writeBack)
+{
+	if (writeBack && resource.modified_)
+		resource.compressed_ = resource.codec_.Compress(resource.resident_.get(), resource.size_);
+
+	resource.modified_ = false;
+	resource.resident_.reset();
+	residentBytes_ -= resource.size_;
+
+	auto found = index_.find(&resource);
+	lru_.erase(found->second);
+	index_.erase(found);
+}
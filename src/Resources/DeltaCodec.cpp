@@ -0,0 +1,112 @@
+#include "Resources/DeltaCodec.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using resource::DeltaCodec;
+
+namespace
+{
+	// offset, length
+	const size_t RUN_HEADER_SIZE = 2 * sizeof(uint64_t);
+
+	inline char BaseByte(const char *base, const size_t baseSize, const size_t i)
+	{
+		return i < baseSize ? base[i] : 0;
+	}
+
+	// compares a word at a time while both versions have one
+	size_t SkipEqual(const char *base, const size_t baseSize, const char *target, const size_t targetSize, size_t i)
+	{
+		const size_t common = std::min(baseSize, targetSize);
+		while (i + sizeof(uint64_t) <= common && std::memcmp(base + i, target + i, sizeof(uint64_t)) == 0)
+			i += sizeof(uint64_t);
+		while (i < targetSize && BaseByte(base, baseSize, i) == target[i])
+			++i;
+		return i;
+	}
+
+	template <typename T>
+	void Append(std::vector<char> &delta, const T value)
+	{
+		const char *bytes = reinterpret_cast<const char *>(&value);
+		delta.insert(delta.end(), bytes, bytes + sizeof(T));
+	}
+
+	template <typename T>
+	T ReadField(const char *buff, size_t &offset)
+	{
+		T value;
+		std::memcpy(&value, buff + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+} // end namespace anonymous
+
+std::vector<char> DeltaCodec::Encode(const char *base, const size_t baseSize, const char *target, const size_t targetSize)
+{
+	std::vector<char> delta;
+	Append<uint64_t>(delta, targetSize);
+
+	size_t i = SkipEqual(base, baseSize, target, targetSize, 0);
+	while (i < targetSize)
+	{
+		// extend the run until the versions agree for longer than a run header
+		const size_t begin = i;
+		size_t end = i + 1;
+		while (end < targetSize)
+		{
+			const size_t next = SkipEqual(base, baseSize, target, targetSize, end);
+			if (next - end >= RUN_HEADER_SIZE || next == targetSize)
+				break;
+			end = next + 1;
+		}
+
+		Append<uint64_t>(delta, begin);
+		Append<uint64_t>(delta, end - begin);
+		for (size_t j = begin; j < end; ++j)
+			delta.push_back(static_cast<char>(target[j] ^ BaseByte(base, baseSize, j)));
+
+		i = SkipEqual(base, baseSize, target, targetSize, end);
+	}
+	return delta;
+}
+
+std::vector<char> DeltaCodec::Apply(const char *base, const size_t baseSize, const char *delta, const size_t deltaSize)
+{
+	const size_t targetSize = GetTargetSize(delta, deltaSize);
+
+	std::vector<char> target(targetSize, 0);
+	if (baseSize > 0 && targetSize > 0)
+		std::memcpy(target.data(), base, std::min(baseSize, targetSize));
+
+	size_t offset = sizeof(uint64_t);
+	while (offset < deltaSize)
+	{
+		if (deltaSize - offset < RUN_HEADER_SIZE)
+			throw std::runtime_error("Delta run is truncated");
+		const uint64_t begin = ReadField<uint64_t>(delta, offset);
+		const uint64_t length = ReadField<uint64_t>(delta, offset);
+		if (length > deltaSize - offset || begin > targetSize || length > targetSize - begin)
+			throw std::runtime_error("Delta run is out of range");
+
+		char *out = target.data() + begin;
+		const char *in = delta + offset;
+		for (size_t j = 0; j < length; ++j)
+			out[j] ^= in[j];
+		offset += length;
+	}
+	return target;
+}
+
+size_t DeltaCodec::GetTargetSize(const char *delta, const size_t deltaSize)
+{
+	if (!delta || deltaSize < sizeof(uint64_t))
+		throw std::runtime_error("Delta is truncated");
+
+	size_t offset = 0;
+	return ReadField<uint64_t>(delta, offset);
+}
@@ -0,0 +1,209 @@
+#include "Resources/Encoding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "Resources/DataType.h"
+
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::Quantization;
+
+namespace
+{
+	template <typename From>
+	void FindRange(const void *src, const size_t count, double &low, double &high)
+	{
+		const From *in = static_cast<const From *>(src);
+		low = std::numeric_limits<double>::infinity();
+		high = -std::numeric_limits<double>::infinity();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const double value = static_cast<double>(in[i]);
+			if (!std::isfinite(value))
+				continue;
+			low = std::min(low, value);
+			high = std::max(high, value);
+		}
+	}
+
+	template <typename From, typename To>
+	void QuantizeKernel(const void *src, void *dst, const size_t count, const Quantization &quantization)
+	{
+		const From *in = static_cast<const From *>(src);
+		To *out = static_cast<To *>(dst);
+		const double inverse = quantization.scale > 0.0 ? 1.0 / quantization.scale : 0.0;
+		const double low = std::numeric_limits<To>::min();
+		const double high = std::numeric_limits<To>::max();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const double step = (static_cast<double>(in[i]) - quantization.offset) * inverse;
+			out[i] = static_cast<To>(std::isnan(step) ? 0.0 : std::nearbyint(std::clamp(step, low, high)));
+		}
+	}
+
+	// a multiply-add per element so that the loop vectorizes
+	template <typename From, typename To>
+	void DequantizeKernel(const void *src, void *dst, const size_t count, const Quantization &quantization)
+	{
+		const From *in = static_cast<const From *>(src);
+		To *out = static_cast<To *>(dst);
+		const To scale = static_cast<To>(quantization.scale);
+		const To offset = static_cast<To>(quantization.offset);
+#pragma omp simd
+		for (size_t i = 0; i < count; ++i)
+			out[i] = static_cast<To>(in[i]) * scale + offset;
+	}
+
+	// calls visitor with a value of the floating point type of the tag
+	template <typename Visitor>
+	void VisitFloatingPoint(const DataType type, Visitor &&visitor)
+	{
+		switch (type)
+		{
+		case DataType::Float32:
+			return visitor(float{});
+		case DataType::Float64:
+			return visitor(double{});
+		default:
+			throw std::runtime_error("Encoding does not apply to " + DataTypeConverter::GetName(type) + " elements");
+		}
+	}
+
+	// calls visitor with a value of the integer type of a quantized tag
+	template <typename Visitor>
+	void VisitQuantized(const DataType type, Visitor &&visitor)
+	{
+		switch (type)
+		{
+		case DataType::Int8:
+			return visitor(int8_t{});
+		case DataType::Int16:
+			return visitor(int16_t{});
+		default:
+			throw std::runtime_error("Encoding cannot dequantize " + DataTypeConverter::GetName(type) + " elements");
+		}
+	}
+} // end namespace anonymous
+
+Encoding::Encoding(const EncodingType type) : type_(type)
+{
+	if (type > EncodingType::Int16)
+		throw std::runtime_error("Unknown encoding: " + std::to_string(static_cast<uint32_t>(type)));
+}
+
+Encoding::~Encoding() noexcept = default;
+Encoding::Encoding(const Encoding &) = default;
+Encoding &Encoding::operator=(const Encoding &) = default;
+Encoding::Encoding(Encoding &&) noexcept = default;
+Encoding &Encoding::operator=(Encoding &&) noexcept = default;
+
+std::string Encoding::GetName(const EncodingType type)
+{
+	switch (type)
+	{
+	case EncodingType::None:
+		return "none";
+	case EncodingType::Float16:
+		return "float16";
+	case EncodingType::BFloat16:
+		return "bfloat16";
+	case EncodingType::Int8:
+		return "int8";
+	case EncodingType::Int16:
+		return "int16";
+	}
+	return "unknown";
+}
+
+EncodingType Encoding::GetType() const
+{
+	return type_;
+}
+
+bool Encoding::IsQuantized() const
+{
+	return type_ == EncodingType::Int8 || type_ == EncodingType::Int16;
+}
+
+bool Encoding::AppliesTo(const DataType dataType) const
+{
+	return type_ != EncodingType::None && (dataType == DataType::Float32 || dataType == DataType::Float64);
+}
+
+DataType Encoding::GetStoredType(const DataType dataType) const
+{
+	if (!AppliesTo(dataType))
+		return dataType;
+
+	switch (type_)
+	{
+	case EncodingType::Float16:
+		return DataType::Float16;
+	case EncodingType::BFloat16:
+		return DataType::BFloat16;
+	case EncodingType::Int8:
+		return DataType::Int8;
+	case EncodingType::Int16:
+		return DataType::Int16;
+	default:
+		return dataType;
+	}
+}
+
+Quantization Encoding::Fit(const void *src, const DataType dataType, const size_t count) const
+{
+	Quantization quantization;
+	if (!IsQuantized())
+		return quantization;
+
+	double low = 0.0;
+	double high = 0.0;
+	VisitFloatingPoint(dataType, [&](auto value)
+					   { FindRange<decltype(value)>(src, count, low, high); });
+	if (low > high)
+	{
+		// no finite values
+		low = 0.0;
+		high = 0.0;
+	}
+
+	// the lowest stored integer maps to the lowest value and the highest to the highest
+	VisitQuantized(GetStoredType(dataType), [&](auto stored)
+				   {
+		using Stored = decltype(stored);
+		const double steps = double(std::numeric_limits<Stored>::max()) - double(std::numeric_limits<Stored>::min());
+		quantization.scale = (high - low) / steps;
+		quantization.offset = low - double(std::numeric_limits<Stored>::min()) * quantization.scale; });
+	return quantization;
+}
+
+void Encoding::Encode(const void *src, const DataType dataType, void *dst, const size_t count, const Quantization &quantization) const
+{
+	if (!AppliesTo(dataType))
+		throw std::runtime_error("Encoding " + GetName(type_) + " does not apply to " + DataTypeConverter::GetName(dataType) + " elements");
+
+	const DataType storedType = GetStoredType(dataType);
+	if (!IsQuantized())
+	{
+		DataTypeConverter::Convert(src, dataType, dst, storedType, count);
+		return;
+	}
+
+	VisitFloatingPoint(dataType, [&](auto value)
+					   { VisitQuantized(storedType, [&](auto stored)
+										{ QuantizeKernel<decltype(value), decltype(stored)>(src, dst, count, quantization); }); });
+}
+
+void Encoding::Dequantize(const void *src, const DataType storedType, void *dst, const DataType dataType, const size_t count, const Quantization &quantization)
+{
+	VisitQuantized(storedType, [&](auto stored)
+				   { VisitFloatingPoint(dataType, [&](auto value)
+										{ DequantizeKernel<decltype(stored), decltype(value)>(src, dst, count, quantization); }); });
+}
@@ -0,0 +1,5 @@
+#include "Resources/IChunkStore.h"
+
+using resource::IChunkStore;
+
+IChunkStore::~IChunkStore() noexcept = default;
@@ -1,15 +1,67 @@
 #include "Resources/IResource.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
 #include <stdexcept>
-#include <boost/crc.hpp>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
 
 using resource::IResource;
 
+namespace
+{
+	// zlib takes 32-bit lengths, so every buffer is hashed a segment at a time
+	const size_t CRC_SEGMENT_SIZE = size_t(1) << 22;
+
+	// below a few segments the threads cost more than they save
+	const size_t CRC_PARALLEL_SIZE = 4 * CRC_SEGMENT_SIZE;
+} // end namespace anonymous
+
 IResource::IResource() = default;
 IResource::~IResource() noexcept = default;
-IResource::IResource(const IResource &) = default;
-IResource &IResource::operator=(const IResource &) = default;
-IResource::IResource(IResource &&) noexcept = default;
-IResource &IResource::operator=(IResource &&) noexcept = default;
+
+IResource::IResource(const IResource &other)
+	: M_(other.M_), N_(other.N_), shape_(other.shape_), layout_(other.layout_),
+	  checkSum_(other.checkSum_.load()), dirty_(other.dirty_.load())
+{
+}
+
+IResource &IResource::operator=(const IResource &other)
+{
+	if (this == &other)
+		return *this;
+
+	M_ = other.M_;
+	N_ = other.N_;
+	shape_ = other.shape_;
+	layout_ = other.layout_;
+	checkSum_ = other.checkSum_.load();
+	dirty_ = other.dirty_.load();
+	return *this;
+}
+
+IResource::IResource(IResource &&other) noexcept
+	: M_(other.M_), N_(other.N_), shape_(std::move(other.shape_)), layout_(std::move(other.layout_)),
+	  checkSum_(other.checkSum_.load()), dirty_(other.dirty_.load())
+{
+}
+
+IResource &IResource::operator=(IResource &&other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	M_ = other.M_;
+	N_ = other.N_;
+	shape_ = std::move(other.shape_);
+	layout_ = std::move(other.layout_);
+	checkSum_ = other.checkSum_.load();
+	dirty_ = other.dirty_.load();
+	return *this;
+}
 
 void IResource::SetColumnSize(const size_t size)
 {
@@ -25,6 +77,54 @@ void IResource::SetRowSize(const size_t size)
 	N_ = size;
 }
 
+void IResource::SetShape(const std::vector<size_t> &shape)
+{
+	if (shape.empty())
+		throw std::runtime_error("Resource shape must have at least one dimension");
+
+	const size_t m = shape.front();
+	const size_t n = std::accumulate(shape.cbegin() + 1, shape.cend(), size_t(1), std::multiplies<size_t>());
+	if ((!shape_.empty() && shape_ != shape) || (M_ != 0 && M_ != m) || (N_ != 0 && N_ != n))
+		throw std::runtime_error("Cannot change dimensions of Resource object");
+	layout_.Validate(shape);
+
+	M_ = m;
+	N_ = n;
+	if (shape.size() != 2)
+		shape_ = shape;
+}
+
+void IResource::ClearShape()
+{
+	M_ = 0;
+	N_ = 0;
+	shape_.clear();
+	layout_ = Layout();
+}
+
+void IResource::SetLayout(const Layout &layout)
+{
+	layout.Validate(GetShape());
+	layout_ = layout;
+}
+
+size_t IResource::GetRank() const
+{
+	return shape_.empty() ? 2 : shape_.size();
+}
+
+std::vector<size_t> IResource::GetShape() const
+{
+	if (shape_.empty())
+		return {M_, N_};
+	return shape_;
+}
+
+const resource::Layout &IResource::GetLayout() const
+{
+	return layout_;
+}
+
 size_t IResource::GetColumnSize() const
 {
 	return M_;
@@ -35,6 +135,11 @@ size_t IResource::GetRowSize() const
 	return N_;
 }
 
+resource::DataType IResource::GetDataType() const
+{
+	return DataType::Unknown;
+}
+
 bool IResource::GetDirty() const
 {
 	return dirty_;
@@ -42,23 +147,62 @@ bool IResource::GetDirty() const
 
 bool IResource::UpdateChecksum() const
 {
-	int check = Checksum();
-	if (check == checkSum_)
+	const int check = Checksum();
+
+	// readers that hash the same change race to store it; only the winner reports it, so it is written once
+	int previous = checkSum_.load();
+	while (previous != check)
 	{
-		dirty_ = false;
-		return false;
+		if (checkSum_.compare_exchange_weak(previous, check))
+		{
+			dirty_ = true;
+			return true;
+		}
 	}
 
-	checkSum_ = check;
-	dirty_ = true;
+	dirty_ = false;
+	return false;
+}
 
-	return true;
+int IResource::GetChecksum() const
+{
+	return checkSum_;
 }
 
 int IResource::Checksum() const
 {
 	size_t size = GetElementSize() * GetColumnSize() * GetRowSize();
-	boost::crc_32_type crc;
-	crc.process_bytes(Data(), size);
-	return crc.checksum();
+	return static_cast<int>(Crc32(Data(), size));
+}
+
+uint32_t IResource::Crc32(const void *buff, const size_t size, const uint32_t crc)
+{
+	const Bytef *bytes = static_cast<const Bytef *>(buff);
+	const size_t segmentCount = (size + CRC_SEGMENT_SIZE - 1) / CRC_SEGMENT_SIZE;
+	auto SegmentSize = [size](const size_t segment)
+	{ return std::min(CRC_SEGMENT_SIZE, size - segment * CRC_SEGMENT_SIZE); };
+
+	if (size < CRC_PARALLEL_SIZE)
+	{
+		uLong result = crc;
+		for (size_t segment = 0; segment < segmentCount; ++segment)
+			result = crc32(result, bytes + segment * CRC_SEGMENT_SIZE, static_cast<uInt>(SegmentSize(segment)));
+		return static_cast<uint32_t>(result);
+	}
+
+	std::vector<uLong> segmentCrcs(segmentCount);
+#pragma omp parallel for schedule(static)
+	for (long long segment = 0; segment < static_cast<long long>(segmentCount); ++segment)
+		segmentCrcs[segment] = crc32(0L, bytes + segment * CRC_SEGMENT_SIZE, static_cast<uInt>(SegmentSize(segment)));
+
+	// crc(a + b) is a function of crc(a), crc(b) and the length of b alone
+	uLong result = crc;
+	for (size_t segment = 0; segment < segmentCount; ++segment)
+		result = crc32_combine(result, segmentCrcs[segment], static_cast<z_off_t>(SegmentSize(segment)));
+	return static_cast<uint32_t>(result);
+}
+
+uint32_t IResource::Crc32Combine(const uint32_t crc, const uint32_t next, const size_t nextSize)
+{
+	return static_cast<uint32_t>(crc32_combine(crc, next, static_cast<z_off_t>(nextSize)));
 }
@@ -0,0 +1,159 @@
+#include "Resources/Layout.h"
+
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+using resource::Layout;
+using resource::LayoutType;
+
+namespace
+{
+	size_t Volume(const std::vector<size_t> &shape)
+	{
+		return std::accumulate(shape.cbegin(), shape.cend(), size_t(1), std::multiplies<size_t>());
+	}
+} // end namespace
+
+Layout::Layout() = default;
+Layout::~Layout() noexcept = default;
+Layout::Layout(const Layout &) = default;
+Layout &Layout::operator=(const Layout &) = default;
+Layout::Layout(Layout &&) noexcept = default;
+Layout &Layout::operator=(Layout &&) noexcept = default;
+
+Layout Layout::RowMajor()
+{
+	return Make(LayoutType::RowMajor);
+}
+
+Layout Layout::ColumnMajor()
+{
+	return Make(LayoutType::ColumnMajor);
+}
+
+Layout Layout::Tiled(const std::vector<size_t> &tileShape)
+{
+	return Make(LayoutType::Tiled, tileShape);
+}
+
+Layout Layout::Make(const LayoutType type, const std::vector<size_t> &tileShape)
+{
+	switch (type)
+	{
+	case LayoutType::RowMajor:
+	case LayoutType::ColumnMajor:
+		if (!tileShape.empty())
+			throw std::runtime_error("Only tiled layouts have a tile shape");
+		break;
+	case LayoutType::Tiled:
+		if (tileShape.empty())
+			throw std::runtime_error("Tiled layout requires a tile shape");
+		for (size_t extent : tileShape)
+			if (extent == 0)
+				throw std::runtime_error("Tiled layout cannot have an empty tile");
+		break;
+	default:
+		throw std::runtime_error("Unknown layout type: " + std::to_string(static_cast<uint32_t>(type)));
+	}
+
+	Layout layout;
+	layout.type_ = type;
+	layout.tileShape_ = tileShape;
+	return layout;
+}
+
+LayoutType Layout::GetType() const
+{
+	return type_;
+}
+
+const std::vector<size_t> &Layout::GetTileShape() const
+{
+	return tileShape_;
+}
+
+void Layout::Validate(const std::vector<size_t> &shape) const
+{
+	if (type_ != LayoutType::Tiled)
+		return;
+
+	if (tileShape_.size() != shape.size())
+		throw std::runtime_error("Tile rank (" + std::to_string(tileShape_.size()) + ") does not match resource rank (" + std::to_string(shape.size()) + ")");
+	for (size_t d = 0; d < shape.size(); ++d)
+		if (shape[d] % tileShape_[d] != 0)
+			throw std::runtime_error("Tile extent " + std::to_string(tileShape_[d]) + " does not divide resource extent " + std::to_string(shape[d]));
+}
+
+size_t Layout::GetOffset(const std::vector<size_t> &shape, const std::vector<size_t> &index) const
+{
+	if (index.size() != shape.size())
+		throw std::runtime_error("Index rank (" + std::to_string(index.size()) + ") does not match resource rank (" + std::to_string(shape.size()) + ")");
+	for (size_t d = 0; d < shape.size(); ++d)
+		if (index[d] >= shape[d])
+			throw std::runtime_error("Index out of bounds in dimension " + std::to_string(d));
+
+	size_t offset = 0;
+	switch (type_)
+	{
+	case LayoutType::RowMajor:
+		for (size_t d = 0; d < shape.size(); ++d)
+			offset = offset * shape[d] + index[d];
+		break;
+	case LayoutType::ColumnMajor:
+		for (size_t d = shape.size(); d-- > 0;)
+			offset = offset * shape[d] + index[d];
+		break;
+	case LayoutType::Tiled:
+	{
+		Validate(shape);
+		size_t tile = 0;
+		size_t within = 0;
+		for (size_t d = 0; d < shape.size(); ++d)
+		{
+			tile = tile * (shape[d] / tileShape_[d]) + index[d] / tileShape_[d];
+			within = within * tileShape_[d] + index[d] % tileShape_[d];
+		}
+		offset = tile * Volume(tileShape_) + within;
+		break;
+	}
+	}
+	return offset;
+}
+
+void Layout::Convert(const char *src, const Layout &from, char *dst, const Layout &to, const std::vector<size_t> &shape, const size_t elementSize)
+{
+	if (shape.empty())
+		return;
+
+	const size_t count = Volume(shape);
+	if (from == to || shape.size() < 2)
+	{
+		std::memcpy(dst, src, count * elementSize);
+		return;
+	}
+
+	from.Validate(shape);
+	to.Validate(shape);
+
+	// walk every element in row-major order and move it between the two orderings
+	std::vector<size_t> index(shape.size(), 0);
+	for (size_t i = 0; i < count; ++i)
+	{
+		std::memcpy(dst + to.GetOffset(shape, index) * elementSize, src + from.GetOffset(shape, index) * elementSize, elementSize);
+
+		for (size_t d = shape.size(); d-- > 0;)
+		{
+			if (++index[d] < shape[d])
+				break;
+			index[d] = 0;
+		}
+	}
+}
+
+bool Layout::operator==(const Layout &other) const
+{
+	return type_ == other.type_ && tileShape_ == other.tileShape_;
+}
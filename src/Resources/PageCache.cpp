@@ -0,0 +1,289 @@
+#include "Resources/PageCache.h"
+
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Resources/ChunkedResource.h"
+#include "Resources/IChunkStore.h"
+
+using resource::ChunkedResource;
+using resource::PageCache;
+
+namespace
+{
+	const size_t DEFAULT_BUDGET = size_t(256) << 20;
+} // end namespace anonymous
+
+PageCache::PageCache() : budget_(DEFAULT_BUDGET) {}
+PageCache::~PageCache() noexcept = default;
+
+PageCache *PageCache::GetInstance()
+{
+	static PageCache instance;
+	return &instance;
+}
+
+void PageCache::SetBudget(const size_t bytes)
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+	budget_ = bytes;
+	EvictOverBudget(lock);
+}
+
+size_t PageCache::GetBudget() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return budget_;
+}
+
+size_t PageCache::GetResidentBytes() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return residentBytes_;
+}
+
+size_t PageCache::GetResidentCount() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return lru_.size();
+}
+
+void PageCache::Clear()
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+	std::vector<PageIterator> pages;
+	for (auto page = lru_.begin(); page != lru_.end(); ++page)
+	{
+		if (page->pins == 0 && page->state == State::Resident)
+		{
+			MarkEvicting(page);
+			pages.push_back(page);
+		}
+	}
+	Evict(lock, pages, true);
+}
+
+char *PageCache::Acquire(const ChunkedResource &resource, const size_t chunk, const bool modify)
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+
+	PageIterator page;
+	for (;;)
+	{
+		auto found = index_.find({&resource, chunk});
+		if (found == index_.cend())
+		{
+			page = Load(lock, resource, chunk);
+			break;
+		}
+		if (found->second->state == State::Resident)
+		{
+			page = found->second;
+			lru_.splice(lru_.begin(), lru_, page);
+			break;
+		}
+		// another thread is loading or writing back the chunk
+		settled_.wait(lock);
+	}
+
+	page->dirty = page->dirty || modify;
+	++page->pins;
+
+	// the most recently used chunk is never evicted, even if it exceeds the budget on its own
+	try
+	{
+		EvictOverBudget(lock);
+	}
+	catch (...)
+	{
+		--page->pins;
+		throw;
+	}
+
+	return page->data.get();
+}
+
+void PageCache::Unpin(const ChunkedResource &resource, const size_t chunk)
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+	if (auto found = index_.find({&resource, chunk}); found != index_.cend() && found->second->pins > 0)
+		--found->second->pins;
+	EvictOverBudget(lock);
+}
+
+bool PageCache::IsResident(const ChunkedResource &resource, const size_t chunk) const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	auto found = index_.find({&resource, chunk});
+	return found != index_.cend() && found->second->state == State::Resident;
+}
+
+void PageCache::Flush(const ChunkedResource &resource)
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+	std::vector<PageIterator> pages;
+	for (auto it = index_.lower_bound({&resource, 0}); it != index_.end() && it->first.first == &resource; ++it)
+	{
+		PageIterator page = it->second;
+		if (page->state != State::Resident || !page->dirty)
+			continue;
+		// pinned so that the chunk is not evicted while it is written
+		++page->pins;
+		page->dirty = false;
+		pages.push_back(page);
+	}
+	lock.unlock();
+
+	size_t written = 0;
+	try
+	{
+		std::lock_guard<std::mutex> storeLock(resource.storeMtx_);
+		for (; written < pages.size(); ++written)
+			resource.store_->Write(resource.GetChunkOffset(pages[written]->chunk), pages[written]->data.get(), pages[written]->size);
+	}
+	catch (...)
+	{
+		lock.lock();
+		for (size_t i = 0; i < pages.size(); ++i)
+		{
+			pages[i]->dirty = pages[i]->dirty || i >= written;
+			--pages[i]->pins;
+		}
+		throw;
+	}
+
+	lock.lock();
+	for (PageIterator page : pages)
+		--page->pins;
+}
+
+void PageCache::Remove(const ChunkedResource &resource, const bool writeBack)
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+
+	// wait until no chunk of the resource is being loaded or written back by another thread
+	auto isSettled = [this, &resource]()
+	{
+		for (auto it = index_.lower_bound({&resource, 0}); it != index_.end() && it->first.first == &resource; ++it)
+			if (it->second->state != State::Resident)
+				return false;
+		return true;
+	};
+	settled_.wait(lock, isSettled);
+
+	std::vector<PageIterator> pages;
+	for (auto it = index_.lower_bound({&resource, 0}); it != index_.end() && it->first.first == &resource; ++it)
+	{
+		MarkEvicting(it->second);
+		pages.push_back(it->second);
+	}
+	Evict(lock, pages, writeBack);
+}
+
+PageCache::PageIterator PageCache::Load(std::unique_lock<std::mutex> &lock, const ChunkedResource &resource, const size_t chunk)
+{
+	const size_t size = resource.GetChunkSize(chunk);
+	lru_.push_front(Page{&resource, chunk, std::make_unique<char[]>(size), size, 0, false, State::Loading});
+	PageIterator page = lru_.begin();
+	index_[{&resource, chunk}] = page;
+	residentBytes_ += size;
+
+	// a loading chunk is neither evicted nor handed out, so it is filled without the lock
+	lock.unlock();
+	try
+	{
+		std::lock_guard<std::mutex> storeLock(resource.storeMtx_);
+		resource.store_->Read(resource.GetChunkOffset(chunk), page->data.get(), size);
+	}
+	catch (...)
+	{
+		lock.lock();
+		residentBytes_ -= size;
+		Release(page);
+		settled_.notify_all();
+		throw;
+	}
+	lock.lock();
+
+	page->state = State::Resident;
+	settled_.notify_all();
+	return page;
+}
+
+void PageCache::EvictOverBudget(std::unique_lock<std::mutex> &lock)
+{
+	if (lru_.empty())
+		return;
+
+	std::vector<PageIterator> pages;
+	PageIterator it = std::prev(lru_.end());
+	while (residentBytes_ > budget_ && it != lru_.begin())
+	{
+		PageIterator next = std::prev(it);
+		if (it->pins == 0 && it->state == State::Resident)
+		{
+			MarkEvicting(it);
+			pages.push_back(it);
+		}
+		it = next;
+	}
+	Evict(lock, pages, true);
+}
+
+void PageCache::MarkEvicting(PageIterator page)
+{
+	page->state = State::Evicting;
+	residentBytes_ -= page->size;
+}
+
+void PageCache::Evict(std::unique_lock<std::mutex> &lock, const std::vector<PageIterator> &pages, const bool writeBack)
+{
+	if (pages.empty())
+		return;
+
+	// evicting chunks are used by no other thread, so they are written back without the lock
+	lock.unlock();
+	size_t written = 0;
+	try
+	{
+		for (; written < pages.size(); ++written)
+		{
+			const Page &page = *pages[written];
+			if (!writeBack || !page.dirty)
+				continue;
+			std::lock_guard<std::mutex> storeLock(page.resource->storeMtx_);
+			page.resource->store_->Write(page.resource->GetChunkOffset(page.chunk), page.data.get(), page.size);
+		}
+	}
+	catch (...)
+	{
+		lock.lock();
+		for (size_t i = 0; i < pages.size(); ++i)
+		{
+			if (i < written)
+			{
+				Release(pages[i]);
+			}
+			else
+			{
+				pages[i]->state = State::Resident;
+				residentBytes_ += pages[i]->size;
+			}
+		}
+		settled_.notify_all();
+		throw;
+	}
+	lock.lock();
+
+	for (PageIterator page : pages)
+		Release(page);
+	settled_.notify_all();
+}
+
+void PageCache::Release(PageIterator page)
+{
+	index_.erase({page->resource, page->chunk});
+	lru_.erase(page);
+}
@@ -0,0 +1,113 @@
+#include "Resources/PoolMemoryResource.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+using resource::PoolMemoryResource;
+
+PoolMemoryResource::PoolMemoryResource(const size_t alignment, const size_t maxBlockSize, std::pmr::memory_resource *upstream)
+	: alignment_(alignment), maxBlockSize_(std::bit_ceil(maxBlockSize)), upstream_(upstream)
+{
+	if (!upstream)
+		throw std::runtime_error("PoolMemoryResource requires an upstream memory resource");
+	if (!std::has_single_bit(alignment) || alignment < sizeof(void *))
+		throw std::runtime_error("PoolMemoryResource alignment must be a power of two of at least " + std::to_string(sizeof(void *)) + " bytes");
+	if (maxBlockSize_ < alignment_)
+		throw std::runtime_error("PoolMemoryResource maximum block size must be at least its alignment");
+
+	// class k serves blocks of alignment << k bytes
+	freeLists_.assign(std::countr_zero(maxBlockSize_) - std::countr_zero(alignment_) + 1, nullptr);
+}
+
+PoolMemoryResource::~PoolMemoryResource() noexcept
+{
+	Release();
+}
+
+size_t PoolMemoryResource::GetAlignment() const
+{
+	return alignment_;
+}
+
+size_t PoolMemoryResource::GetMaxBlockSize() const
+{
+	return maxBlockSize_;
+}
+
+size_t PoolMemoryResource::GetPooledBytes() const
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return pooledBytes_;
+}
+
+void PoolMemoryResource::Release()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	for (size_t sizeClass = 0; sizeClass < freeLists_.size(); ++sizeClass)
+	{
+		while (void *block = freeLists_[sizeClass])
+		{
+			freeLists_[sizeClass] = *static_cast<void **>(block);
+			upstream_->deallocate(block, GetBlockSize(sizeClass), alignment_);
+		}
+	}
+	pooledBytes_ = 0;
+}
+
+void *PoolMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+	const size_t sizeClass = GetSizeClass(bytes, alignment);
+	if (sizeClass == freeLists_.size())
+		return upstream_->allocate(bytes, std::max(alignment, alignment_));
+
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		if (void *block = freeLists_[sizeClass])
+		{
+			freeLists_[sizeClass] = *static_cast<void **>(block);
+			pooledBytes_ -= GetBlockSize(sizeClass);
+			return block;
+		}
+	}
+
+	return upstream_->allocate(GetBlockSize(sizeClass), alignment_);
+}
+
+void PoolMemoryResource::do_deallocate(void *p, size_t bytes, size_t alignment)
+{
+	const size_t sizeClass = GetSizeClass(bytes, alignment);
+	if (sizeClass == freeLists_.size())
+	{
+		upstream_->deallocate(p, bytes, std::max(alignment, alignment_));
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	*static_cast<void **>(p) = freeLists_[sizeClass];
+	freeLists_[sizeClass] = p;
+	pooledBytes_ += GetBlockSize(sizeClass);
+}
+
+bool PoolMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+	return this == &other;
+}
+
+size_t PoolMemoryResource::GetSizeClass(const size_t bytes, const size_t alignment) const
+{
+	// over-aligned and oversized requests are not pooled
+	if (alignment > alignment_ || bytes > maxBlockSize_)
+		return freeLists_.size();
+
+	const size_t blockSize = std::bit_ceil(std::max(bytes, alignment_));
+	return std::countr_zero(blockSize) - std::countr_zero(alignment_);
+}
+
+size_t PoolMemoryResource::GetBlockSize(const size_t sizeClass) const
+{
+	return alignment_ << sizeClass;
+}
@@ -0,0 +1,117 @@
+#include "Resources/ResourceStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "Resources/DataType.h"
+
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::ResourceStats;
+
+namespace
+{
+	// elements are widened to double one block at a time to bound the scratch memory
+	const size_t SCRATCH_COUNT = 1024;
+} // end namespace anonymous
+
+ResourceStats::ResourceStats()
+	: min_(std::numeric_limits<double>::infinity()), max_(-std::numeric_limits<double>::infinity())
+{
+}
+
+ResourceStats::ResourceStats(const double min, const double max, const double sum, const uint64_t count, const uint64_t nanCount)
+	: min_(min), max_(max), sum_(sum), count_(count), nanCount_(nanCount)
+{
+}
+
+ResourceStats::~ResourceStats() noexcept = default;
+ResourceStats::ResourceStats(const ResourceStats &) = default;
+ResourceStats &ResourceStats::operator=(const ResourceStats &) = default;
+
+ResourceStats ResourceStats::Compute(const void *data, const DataType type, const size_t count)
+{
+	if (type == DataType::Unknown)
+		throw std::runtime_error("Cannot compute statistics of elements of unknown type");
+
+	const size_t elementSize = DataTypeConverter::GetSize(type);
+	const char *src = static_cast<const char *>(data);
+
+	ResourceStats stats;
+	double scratch[SCRATCH_COUNT];
+	for (size_t first = 0; first < count; first += SCRATCH_COUNT)
+	{
+		const size_t n = std::min(SCRATCH_COUNT, count - first);
+		DataTypeConverter::Convert(src + first * elementSize, type, scratch, DataType::Float64, n);
+
+		double min = stats.min_;
+		double max = stats.max_;
+		double sum = 0.0;
+		uint64_t nanCount = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double value = scratch[i];
+			if (std::isnan(value))
+			{
+				++nanCount;
+				continue;
+			}
+			min = std::min(min, value);
+			max = std::max(max, value);
+			sum += value;
+		}
+
+		stats.min_ = min;
+		stats.max_ = max;
+		stats.sum_ += sum;
+		stats.nanCount_ += nanCount;
+	}
+	stats.count_ = count;
+	return stats;
+}
+
+void ResourceStats::Merge(const ResourceStats &other)
+{
+	min_ = std::min(min_, other.min_);
+	max_ = std::max(max_, other.max_);
+	sum_ += other.sum_;
+	count_ += other.count_;
+	nanCount_ += other.nanCount_;
+}
+
+bool ResourceStats::MayContain(const double low, const double high) const
+{
+	return count_ > nanCount_ && min_ <= high && max_ >= low;
+}
+
+double ResourceStats::GetMin() const
+{
+	return min_;
+}
+
+double ResourceStats::GetMax() const
+{
+	return max_;
+}
+
+double ResourceStats::GetSum() const
+{
+	return sum_;
+}
+
+uint64_t ResourceStats::GetCount() const
+{
+	return count_;
+}
+
+uint64_t ResourceStats::GetNaNCount() const
+{
+	return nanCount_;
+}
+
+bool ResourceStats::operator==(const ResourceStats &other) const
+{
+	return min_ == other.min_ && max_ == other.max_ && sum_ == other.sum_ && count_ == other.count_ && nanCount_ == other.nanCount_;
+}
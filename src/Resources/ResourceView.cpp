@@ -0,0 +1,170 @@
+#include "Resources/ResourceView.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "Resources/IResource.h"
+#include "Resources/Layout.h"
+#include "Resources/SparseResource.h"
+
+using resource::IResource;
+using resource::LayoutType;
+using resource::ResourceView;
+using resource::SparseResource;
+
+namespace
+{
+	// the element stride of a dimension of the whole parent, as ordered by its layout
+	size_t LayoutStride(const IResource &parent, const size_t dim)
+	{
+		switch (parent.GetLayout().GetType())
+		{
+		case LayoutType::RowMajor:
+			return dim == 0 ? parent.GetRowSize() : 1;
+		case LayoutType::ColumnMajor:
+			// the first dimension varies fastest, which only maps to strides of i and j for a matrix
+			if (parent.GetRank() != 2)
+				throw std::runtime_error("ResourceView cannot address a column-major parent of rank " + std::to_string(parent.GetRank()));
+			return dim == 0 ? 1 : parent.GetColumnSize();
+		default:
+			throw std::runtime_error("ResourceView cannot address the tiles of a tiled parent resource");
+		}
+	}
+} // end namespace anonymous
+
+ResourceView::ResourceView(const IResource &parent)
+	: ResourceView(parent, 0, parent.GetColumnSize(), parent.GetRowSize(), LayoutStride(parent, 0), LayoutStride(parent, 1))
+{
+}
+
+ResourceView::ResourceView(const IResource &parent, const size_t offset, const size_t columnSize, const size_t rowSize, const size_t columnStride, const size_t rowStride)
+	: parent_(&parent), offset_(offset), extents_{columnSize, rowSize}, strides_{columnStride, rowStride}
+{
+	if (dynamic_cast<const SparseResource *>(&parent))
+		throw std::runtime_error("ResourceView cannot address the packed values of a SparseResource");
+	if (parent.GetLayout().GetType() == LayoutType::Tiled)
+		throw std::runtime_error("ResourceView cannot address the tiles of a tiled parent resource");
+	if (columnSize == 0 || rowSize == 0)
+		return;
+
+	const size_t last = offset + (columnSize - 1) * columnStride + (rowSize - 1) * rowStride;
+	if (last >= parent.GetColumnSize() * parent.GetRowSize())
+		throw std::runtime_error("ResourceView exceeds the bounds of its parent resource");
+}
+
+ResourceView::~ResourceView() noexcept = default;
+ResourceView::ResourceView(const ResourceView &) = default;
+ResourceView &ResourceView::operator=(const ResourceView &) = default;
+ResourceView::ResourceView(ResourceView &&) noexcept = default;
+ResourceView &ResourceView::operator=(ResourceView &&) noexcept = default;
+
+ResourceView ResourceView::Rows(const size_t first, const size_t count) const
+{
+	return Block(first, 0, count, GetRowSize());
+}
+
+ResourceView ResourceView::Column(const size_t j) const
+{
+	return Block(0, j, GetColumnSize(), 1);
+}
+
+ResourceView ResourceView::Block(const size_t i, const size_t j, const size_t columnSize, const size_t rowSize) const
+{
+	if (i + columnSize > GetColumnSize() || j + rowSize > GetRowSize())
+		throw std::runtime_error("Block " + std::to_string(i) + "," + std::to_string(j) + " of size " + std::to_string(columnSize) + "x" + std::to_string(rowSize) + " is out of bounds during ResourceView::Block");
+
+	return ResourceView(*parent_, offset_ + i * strides_[0] + j * strides_[1], columnSize, rowSize, strides_[0], strides_[1]);
+}
+
+const IResource &ResourceView::GetParent() const
+{
+	return *parent_;
+}
+
+size_t ResourceView::GetColumnSize() const
+{
+	return extents_[0];
+}
+
+size_t ResourceView::GetRowSize() const
+{
+	return extents_[1];
+}
+
+size_t ResourceView::GetElementSize() const
+{
+	return parent_->GetElementSize();
+}
+
+size_t ResourceView::GetOffset() const
+{
+	return offset_;
+}
+
+size_t ResourceView::GetStride(const size_t dim) const
+{
+	if (dim >= strides_.size())
+		throw std::runtime_error("Dimension " + std::to_string(dim) + " is out of bounds during ResourceView::GetStride");
+	return strides_[dim];
+}
+
+size_t ResourceView::GetByteSize() const
+{
+	return GetColumnSize() * GetRowSize() * GetElementSize();
+}
+
+bool ResourceView::IsRowContiguous() const
+{
+	return strides_[1] == 1 || GetRowSize() <= 1;
+}
+
+bool ResourceView::IsContiguous() const
+{
+	return IsRowContiguous() && (strides_[0] == GetRowSize() || GetColumnSize() <= 1);
+}
+
+const void *ResourceView::At(const size_t i, const size_t j) const
+{
+	if (i >= GetColumnSize() || j >= GetRowSize())
+		throw std::runtime_error("View indices " + std::to_string(i) + "," + std::to_string(j) + " are out of bounds");
+
+	const char *base = static_cast<const char *>(parent_->Data());
+	return base + (offset_ + i * strides_[0] + j * strides_[1]) * GetElementSize();
+}
+
+void ResourceView::CopyRow(const size_t i, char *buff) const
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during ResourceView::CopyRow");
+	if (GetRowSize() == 0)
+		return;
+
+	const size_t elementSize = GetElementSize();
+	if (IsRowContiguous())
+	{
+		std::memcpy(buff, At(i, 0), GetRowSize() * elementSize);
+		return;
+	}
+
+	for (size_t j = 0; j < GetRowSize(); ++j)
+		std::memcpy(buff + j * elementSize, At(i, j), elementSize);
+}
+
+void ResourceView::CopyTo(char *buff) const
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during ResourceView::CopyTo");
+	if (GetColumnSize() == 0 || GetRowSize() == 0)
+		return;
+
+	if (IsContiguous())
+	{
+		std::memcpy(buff, At(0, 0), GetByteSize());
+		return;
+	}
+
+	const size_t rowBytes = GetRowSize() * GetElementSize();
+	for (size_t i = 0; i < GetColumnSize(); ++i)
+		CopyRow(i, buff + i * rowBytes);
+}
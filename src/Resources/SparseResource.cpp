@@ -0,0 +1,203 @@
+#include "Resources/SparseResource.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using resource::SparseResource;
+
+namespace
+{
+	bool IsZero(const char *element, const size_t elementSize)
+	{
+		return std::all_of(element, element + elementSize, [](const char byte)
+						   { return byte == 0; });
+	}
+} // end namespace anonymous
+
+SparseResource::SparseResource(std::pmr::memory_resource *memory) : rowOffsets_(memory), columnIndices_(memory), values_(memory) {}
+SparseResource::~SparseResource() noexcept = default;
+SparseResource::SparseResource(const SparseResource &) = default;
+SparseResource &SparseResource::operator=(const SparseResource &) = default;
+SparseResource::SparseResource(SparseResource &&) noexcept = default;
+
+SparseResource &SparseResource::operator=(SparseResource &&other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	// the virtual base is moved here once rather than by a defaulted operator of every class on the way to it
+	IResource::operator=(std::move(other));
+	rowOffsets_ = std::move(other.rowOffsets_);
+	columnIndices_ = std::move(other.columnIndices_);
+	values_ = std::move(other.values_);
+	return *this;
+}
+
+void *SparseResource::Data()
+{
+	return values_.data();
+}
+
+const void *SparseResource::Data() const
+{
+	return values_.data();
+}
+
+void SparseResource::Assign(const char *buff, const size_t n)
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during SparseResource::Assign");
+
+	const size_t elementSize = GetElementSize();
+	const size_t M = GetColumnSize();
+	const size_t N = GetRowSize();
+	if (n != M * N * elementSize)
+		throw std::runtime_error("n does not match the resource dimensions during SparseResource::Assign");
+
+	std::pmr::memory_resource *memory = GetMemoryResource();
+	std::pmr::vector<size_t> rowOffsets(M + 1, 0, memory);
+	std::pmr::vector<size_t> columnIndices(memory);
+	std::pmr::vector<char> values(memory);
+	for (size_t i = 0; i < M; ++i)
+	{
+		for (size_t j = 0; j < N; ++j)
+		{
+			const char *element = buff + (i * N + j) * elementSize;
+			if (IsZero(element, elementSize))
+				continue;
+			columnIndices.push_back(j);
+			values.insert(values.end(), element, element + elementSize);
+		}
+		rowOffsets[i + 1] = columnIndices.size();
+	}
+
+	rowOffsets_ = std::move(rowOffsets);
+	columnIndices_ = std::move(columnIndices);
+	values_ = std::move(values);
+}
+
+void SparseResource::AssignSparse(const size_t *rowOffsets, const size_t *columnIndices, const char *values, const size_t nnz)
+{
+	if (!rowOffsets || (nnz > 0 && (!columnIndices || !values)))
+		throw std::runtime_error("Buffers cannot be NULL during SparseResource::AssignSparse");
+
+	const size_t M = GetColumnSize();
+	const size_t N = GetRowSize();
+	if (rowOffsets[0] != 0 || rowOffsets[M] != nnz)
+		throw std::runtime_error("Row offsets do not match the non-zero count during SparseResource::AssignSparse");
+
+	for (size_t i = 0; i < M; ++i)
+	{
+		if (rowOffsets[i] > rowOffsets[i + 1])
+			throw std::runtime_error("Row offsets are not monotonic during SparseResource::AssignSparse");
+		for (size_t k = rowOffsets[i]; k < rowOffsets[i + 1]; ++k)
+		{
+			if (columnIndices[k] >= N || (k > rowOffsets[i] && columnIndices[k] <= columnIndices[k - 1]))
+				throw std::runtime_error("Column indices are out of bounds or unsorted during SparseResource::AssignSparse");
+		}
+	}
+
+	rowOffsets_.assign(rowOffsets, rowOffsets + M + 1);
+	columnIndices_.assign(columnIndices, columnIndices + nnz);
+	values_.assign(values, values + nnz * GetElementSize());
+}
+
+void SparseResource::AssignCoordinates(const size_t *rows, const size_t *columns, const char *values, const size_t nnz)
+{
+	if (nnz > 0 && (!rows || !columns || !values))
+		throw std::runtime_error("Buffers cannot be NULL during SparseResource::AssignCoordinates");
+
+	const size_t M = GetColumnSize();
+	const size_t elementSize = GetElementSize();
+
+	// sort the coordinates in row-major order
+	std::vector<size_t> order(nnz);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [rows, columns](const size_t a, const size_t b)
+			  { return rows[a] != rows[b] ? rows[a] < rows[b] : columns[a] < columns[b]; });
+
+	std::vector<size_t> rowOffsets(M + 1, 0);
+	std::vector<size_t> columnIndices(nnz);
+	std::vector<char> packed(nnz * elementSize);
+	for (size_t k = 0; k < nnz; ++k)
+	{
+		const size_t index = order[k];
+		if (rows[index] >= M)
+			throw std::runtime_error("Row index " + std::to_string(rows[index]) + " is out of bounds during SparseResource::AssignCoordinates");
+		++rowOffsets[rows[index] + 1];
+		columnIndices[k] = columns[index];
+		std::memcpy(packed.data() + k * elementSize, values + index * elementSize, elementSize);
+	}
+	std::partial_sum(rowOffsets.begin(), rowOffsets.end(), rowOffsets.begin());
+
+	AssignSparse(rowOffsets.data(), columnIndices.data(), packed.data(), nnz);
+}
+
+size_t SparseResource::GetNonZeroCount() const
+{
+	return columnIndices_.size();
+}
+
+const std::pmr::vector<size_t> &SparseResource::GetRowOffsets() const
+{
+	return rowOffsets_;
+}
+
+const std::pmr::vector<size_t> &SparseResource::GetColumnIndices() const
+{
+	return columnIndices_;
+}
+
+std::pmr::memory_resource *SparseResource::GetMemoryResource() const
+{
+	return values_.get_allocator().resource();
+}
+
+const void *SparseResource::At(const size_t i, const size_t j) const
+{
+	if (i >= GetColumnSize() || j >= GetRowSize())
+		throw std::runtime_error("Resource indices " + std::to_string(i) + "," + std::to_string(j) + " are out of bounds");
+	if (rowOffsets_.empty())
+		return nullptr;
+
+	auto first = columnIndices_.cbegin() + rowOffsets_[i];
+	auto last = columnIndices_.cbegin() + rowOffsets_[i + 1];
+	auto found = std::lower_bound(first, last, j);
+	if (found == last || *found != j)
+		return nullptr;
+
+	return values_.data() + (found - columnIndices_.cbegin()) * GetElementSize();
+}
+
+void SparseResource::CopyToDense(char *buff) const
+{
+	if (!buff)
+		throw std::runtime_error("Buffer cannot be NULL during SparseResource::CopyToDense");
+
+	const size_t elementSize = GetElementSize();
+	const size_t N = GetRowSize();
+	std::memset(buff, 0, GetColumnSize() * N * elementSize);
+	if (rowOffsets_.empty())
+		return;
+
+	for (size_t i = 0; i < GetColumnSize(); ++i)
+	{
+		for (size_t k = rowOffsets_[i]; k < rowOffsets_[i + 1]; ++k)
+			std::memcpy(buff + (i * N + columnIndices_[k]) * elementSize, values_.data() + k * elementSize, elementSize);
+	}
+}
+
+int SparseResource::Checksum() const
+{
+	uint32_t crc = Crc32(rowOffsets_.data(), rowOffsets_.size() * sizeof(size_t));
+	crc = Crc32(columnIndices_.data(), columnIndices_.size() * sizeof(size_t), crc);
+	crc = Crc32(values_.data(), values_.size(), crc);
+	return static_cast<int>(crc);
+}
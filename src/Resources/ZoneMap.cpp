@@ -0,0 +1,171 @@
+#include "Resources/ZoneMap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Resources/DataType.h"
+#include "Resources/ResourceStats.h"
+
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::ResourceStats;
+using resource::ZoneMap;
+
+namespace
+{
+	// block size, element count
+	const size_t PREFIX_SIZE = 2 * sizeof(uint64_t);
+	// min, max, sum, count, NaN count
+	const size_t STATS_SIZE = 3 * sizeof(double) + 2 * sizeof(uint64_t);
+
+	template <typename T>
+	T ReadField(const char *buff, size_t &offset)
+	{
+		T value;
+		std::memcpy(&value, buff + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+
+	template <typename T>
+	void WriteField(std::ostream &outFile, const T value)
+	{
+		outFile.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	void WriteStats(std::ostream &outFile, const ResourceStats &stats)
+	{
+		WriteField<double>(outFile, stats.GetMin());
+		WriteField<double>(outFile, stats.GetMax());
+		WriteField<double>(outFile, stats.GetSum());
+		WriteField<uint64_t>(outFile, stats.GetCount());
+		WriteField<uint64_t>(outFile, stats.GetNaNCount());
+	}
+
+	ResourceStats ReadStats(const char *buff, size_t &offset)
+	{
+		const double min = ReadField<double>(buff, offset);
+		const double max = ReadField<double>(buff, offset);
+		const double sum = ReadField<double>(buff, offset);
+		const uint64_t count = ReadField<uint64_t>(buff, offset);
+		const uint64_t nanCount = ReadField<uint64_t>(buff, offset);
+		return ResourceStats(min, max, sum, count, nanCount);
+	}
+} // end namespace anonymous
+
+ZoneMap::ZoneMap() = default;
+ZoneMap::~ZoneMap() noexcept = default;
+ZoneMap::ZoneMap(const ZoneMap &) = default;
+ZoneMap &ZoneMap::operator=(const ZoneMap &) = default;
+ZoneMap::ZoneMap(ZoneMap &&) noexcept = default;
+ZoneMap &ZoneMap::operator=(ZoneMap &&) noexcept = default;
+
+ZoneMap ZoneMap::Build(const void *data, const DataType type, const size_t count, const size_t blockSize)
+{
+	if (blockSize == 0)
+		throw std::runtime_error("ZoneMap block size cannot be 0");
+	if (type == DataType::Unknown)
+		throw std::runtime_error("Cannot build a ZoneMap of elements of unknown type");
+
+	ZoneMap zoneMap;
+	zoneMap.blockSize_ = blockSize;
+	zoneMap.count_ = count;
+
+	const size_t elementSize = DataTypeConverter::GetSize(type);
+	const char *src = static_cast<const char *>(data);
+	for (size_t first = 0; first < count; first += blockSize)
+	{
+		zoneMap.blocks_.push_back(ResourceStats::Compute(src + first * elementSize, type, std::min(blockSize, count - first)));
+		zoneMap.total_.Merge(zoneMap.blocks_.back());
+	}
+	return zoneMap;
+}
+
+void ZoneMap::Update(const size_t block, const void *data, const DataType type)
+{
+	if (block >= blocks_.size())
+		throw std::runtime_error("ZoneMap block " + std::to_string(block) + " is out of range");
+
+	blocks_[block] = ResourceStats::Compute(data, type, std::min(blockSize_, count_ - block * blockSize_));
+
+	// the minimum and maximum cannot be retracted, so the total is merged again from the blocks
+	total_ = ResourceStats();
+	for (const ResourceStats &stats : blocks_)
+		total_.Merge(stats);
+}
+
+size_t ZoneMap::GetBlockSize() const
+{
+	return blockSize_;
+}
+
+size_t ZoneMap::GetBlockCount() const
+{
+	return blocks_.size();
+}
+
+const ResourceStats &ZoneMap::GetBlock(const size_t block) const
+{
+	if (block >= blocks_.size())
+		throw std::runtime_error("ZoneMap block " + std::to_string(block) + " is out of range");
+	return blocks_[block];
+}
+
+const ResourceStats &ZoneMap::GetTotal() const
+{
+	return total_;
+}
+
+std::vector<size_t> ZoneMap::FindBlocks(const double low, const double high) const
+{
+	std::vector<size_t> found;
+	if (!total_.MayContain(low, high))
+		return found;
+
+	for (size_t block = 0; block < blocks_.size(); ++block)
+		if (blocks_[block].MayContain(low, high))
+			found.push_back(block);
+	return found;
+}
+
+size_t ZoneMap::GetSize() const
+{
+	return PREFIX_SIZE + (1 + blocks_.size()) * STATS_SIZE;
+}
+
+void ZoneMap::Write(std::ostream &outFile) const
+{
+	WriteField<uint64_t>(outFile, blockSize_);
+	WriteField<uint64_t>(outFile, count_);
+	WriteStats(outFile, total_);
+	for (const ResourceStats &stats : blocks_)
+		WriteStats(outFile, stats);
+}
+
+ZoneMap ZoneMap::Read(const char *buff, const size_t size)
+{
+	if (!buff || size < PREFIX_SIZE + STATS_SIZE)
+		throw std::runtime_error("ZoneMap is truncated");
+
+	size_t offset = 0;
+	ZoneMap zoneMap;
+	zoneMap.blockSize_ = ReadField<uint64_t>(buff, offset);
+	zoneMap.count_ = ReadField<uint64_t>(buff, offset);
+	if (zoneMap.blockSize_ == 0)
+		throw std::runtime_error("ZoneMap block size cannot be 0");
+
+	const size_t blockCount = (zoneMap.count_ + zoneMap.blockSize_ - 1) / zoneMap.blockSize_;
+	if (blockCount > (size - PREFIX_SIZE) / STATS_SIZE - 1)
+		throw std::runtime_error("ZoneMap is truncated");
+
+	zoneMap.total_ = ReadStats(buff, offset);
+	zoneMap.blocks_.reserve(blockCount);
+	for (size_t block = 0; block < blockCount; ++block)
+		zoneMap.blocks_.push_back(ReadStats(buff, offset));
+	return zoneMap;
+}
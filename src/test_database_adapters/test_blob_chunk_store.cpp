@@ -0,0 +1,200 @@
+#include "test_database_adapters/config.h"
+
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/system/error_code.hpp>
+
+#include "test_database_adapters/ContainerResource.h"
+#include "test_database_adapters/SparseContainerResource.h"
+#include "DatabaseAdapters/BlobChunkStore.h"
+#include "DatabaseAdapters/ResourceLoader.h"
+#include "DatabaseAdapters/ResourcePersister.h"
+#include "Resources/ChunkedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/Layout.h"
+
+using boost::system::error_code;
+using database_adapters::BlobChunkStore;
+using database_adapters::ResourceLoader;
+using database_adapters::ResourcePersister;
+using resource::ChunkedResource;
+using resource::DataType;
+using resource::Layout;
+
+namespace
+{
+	const fs::path ROOT_DIR = fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY;
+	const std::string DB_NAME = "db.sqlite";
+	const fs::path DB_PATH = ROOT_DIR / DB_NAME;
+	const std::string RESOURCE_KEY = "resource";
+	const size_t M = 5;
+	const size_t N = 3;
+
+	using Resource = ContainerResource<int>;
+	using SparseResource = SparseContainerResource<int>;
+
+	struct Chunked : ChunkedResource
+	{
+		size_t GetElementSize() const override { return sizeof(int); }
+		DataType GetDataType() const override { return DataType::Int32; }
+	};
+
+	std::vector<int> Iota(const size_t count)
+	{
+		std::vector<int> values(count);
+		std::iota(values.begin(), values.end(), 0);
+		return values;
+	}
+
+	struct PersisterFixture
+	{
+		PersisterFixture()
+		{
+			RemoveDB();
+			ResourcePersister::GetInstance()->OpenDatabase(DB_PATH);
+		}
+
+		~PersisterFixture()
+		{
+			ResourcePersister::ResetInstance();
+			RemoveDB();
+		}
+
+		void RemoveDB()
+		{
+			if (fs::exists(DB_PATH))
+			{
+#if defined(__APPLE__) || defined(__MACH__)
+				error_code ec;
+				fs::permissions(DB_PATH, fs::perms::all_all, ec);
+#else
+				fs::permissions(DB_PATH, fs::perms::all, fs::perm_options::add);
+#endif
+				fs::remove(DB_PATH);
+			}
+		}
+	};
+} // end namespace anonymous
+
+TEST(BlobChunkStore, Construct)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->Persist(Resource({M, N}, Iota(M * N)), RESOURCE_KEY);
+
+	BlobChunkStore store(persister->GetDatabase(), RESOURCE_KEY);
+	EXPECT_EQ(store.GetShape(), std::vector<size_t>({M, N}));
+	EXPECT_EQ(store.GetDataType(), DataType::Int32);
+	EXPECT_EQ(store.GetSize(), M * N * sizeof(int));
+}
+
+TEST(BlobChunkStore, ConstructTensor)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->Persist(Resource({2, 3, 4}, Iota(24)), RESOURCE_KEY);
+
+	BlobChunkStore store(persister->GetDatabase(), RESOURCE_KEY);
+	EXPECT_EQ(store.GetShape(), std::vector<size_t>({2, 3, 4}));
+}
+
+TEST(BlobChunkStore, ConstructThrows)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_THROW(BlobChunkStore(persister->GetDatabase(), ""), std::runtime_error);
+	EXPECT_THROW(BlobChunkStore(persister->GetDatabase(), RESOURCE_KEY), std::runtime_error);
+
+	persister->Persist(SparseResource(2, 2, std::vector<int>({0, 1, 0, 0})), RESOURCE_KEY);
+	EXPECT_THROW(BlobChunkStore(persister->GetDatabase(), RESOURCE_KEY), std::runtime_error);
+
+	persister->Persist(Resource({2, 3, 4}, Iota(24), Layout::ColumnMajor()), "column_major");
+	EXPECT_THROW(BlobChunkStore(persister->GetDatabase(), "column_major"), std::runtime_error);
+}
+
+TEST(BlobChunkStore, ConstructThrowsOnDeltaRow)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->SetDeltaChainLength(2);
+	std::vector<int> values = Iota(64);
+	persister->Persist(Resource({16, 4}, values), RESOURCE_KEY);
+	EXPECT_NO_THROW(BlobChunkStore(persister->GetDatabase(), RESOURCE_KEY));
+
+	// a delta row has no payload to page in place
+	values[0] = -1;
+	persister->Persist(Resource({16, 4}, values), RESOURCE_KEY);
+	EXPECT_THROW(BlobChunkStore(persister->GetDatabase(), RESOURCE_KEY), std::runtime_error);
+	persister->SetDeltaChainLength(0);
+}
+
+TEST(BlobChunkStore, ReadRows)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	const std::vector<int> values = Iota(M * N);
+	persister->Persist(Resource({M, N}, values), RESOURCE_KEY);
+
+	Chunked resource;
+	resource.Open(std::make_unique<BlobChunkStore>(persister->GetDatabase(), RESOURCE_KEY), 2);
+	EXPECT_EQ(resource.GetChunkCount(), size_t(3));
+
+	std::vector<int> rows(3 * N);
+	resource.ReadRows(1, 3, reinterpret_cast<char *>(rows.data()));
+	EXPECT_EQ(rows, std::vector<int>(values.begin() + N, values.begin() + 4 * N));
+}
+
+TEST(BlobChunkStore, WriteRows)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->Persist(Resource({M, N}, Iota(M * N)), RESOURCE_KEY);
+
+	const std::vector<int> row(N, -1);
+	{
+		Chunked resource;
+		resource.Open(std::make_unique<BlobChunkStore>(persister->GetDatabase(), RESOURCE_KEY), 2);
+		resource.WriteRows(4, 1, reinterpret_cast<const char *>(row.data()));
+		resource.Close();
+	}
+
+	// the blob was updated in place
+	Chunked resource;
+	resource.Open(std::make_unique<BlobChunkStore>(persister->GetDatabase(), RESOURCE_KEY), 2);
+	std::vector<int> rows(2 * N);
+	resource.ReadRows(3, 2, reinterpret_cast<char *>(rows.data()));
+	EXPECT_EQ(rows, std::vector<int>({9, 10, 11, -1, -1, -1}));
+}
+
+TEST(BlobChunkStore, WriteRowsUpdatesStatistics)
+{
+	PersisterFixture fixture;
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->SetZoneMapBlockSize(2 * N);
+	persister->Persist(Resource({M, N}, Iota(M * N)), RESOURCE_KEY);
+	persister->SetZoneMapBlockSize(0);
+
+	const std::vector<int> row(N, 100);
+	{
+		Chunked resource;
+		resource.Open(std::make_unique<BlobChunkStore>(persister->GetDatabase(), RESOURCE_KEY), 2);
+		resource.WriteRows(4, 1, reinterpret_cast<const char *>(row.data()));
+		resource.Close();
+	}
+
+	// the new values are found and the overwritten ones are not
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->OpenDatabase(DB_PATH);
+	EXPECT_EQ(loader->FindKeys(50.0, 200.0), std::vector<std::string>({RESOURCE_KEY}));
+	const auto zoneMap = loader->LoadZoneMap(RESOURCE_KEY);
+	ASSERT_TRUE(zoneMap);
+	EXPECT_EQ(zoneMap->FindBlocks(50.0, 200.0), std::vector<size_t>({2}));
+	EXPECT_TRUE(zoneMap->FindBlocks(13.0, 14.0).empty());
+	ResourceLoader::ResetInstance();
+}
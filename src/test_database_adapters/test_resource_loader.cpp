@@ -1,6 +1,8 @@
 #include "test_database_adapters/config.h"
 
 #include <functional>
+#include <limits>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -10,14 +12,29 @@
 #include <boost/system/error_code.hpp>
 
 #include "test_database_adapters/ContainerResource.h"
+#include "test_database_adapters/SparseContainerResource.h"
 #include "DatabaseAdapters/IPersistableResource.h"
 #include "DatabaseAdapters/ResourceLoader.h"
 #include "DatabaseAdapters/ResourcePersister.h"
+#include "Resources/ArenaMemoryResource.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceStats.h"
+#include "Resources/ZoneMap.h"
 
 using boost::system::error_code;
 using database_adapters::IPersistableResource;
 using database_adapters::ResourceLoader;
 using database_adapters::ResourcePersister;
+using database_adapters::Sqlite;
+using resource::ArenaMemoryResource;
+using resource::DataType;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::Layout;
+using resource::ResourceStats;
+using resource::ZoneMap;
 
 namespace
 {
@@ -28,10 +45,17 @@ namespace
 	const int VAL = 1;
 	const std::vector<int> ARRAY_1(2, VAL);
 
+	const std::vector<int> SPARSE_MATRIX = {0, 5, 0, 0, 0, 0, 1, 0, 2};
+
 	using Resource = ContainerResource<int>;
+	using SparseResource = SparseContainerResource<int>;
 
 	auto RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<IPersistableResource>
 	{ return std::make_unique<Resource>(); };
+	auto SPARSE_RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<IPersistableResource>
+	{ return std::make_unique<SparseResource>(); };
+	auto ALLOCATING_SPARSE_RESOURCE_CONSTRUCTOR = [](std::pmr::memory_resource *memory) -> std::unique_ptr<IPersistableResource>
+	{ return std::make_unique<SparseResource>(memory); };
 
 	struct SqliteRemover
 	{
@@ -133,6 +157,292 @@ TEST(ResourceLoader, Load)
 	ResourceLoader::ResetInstance();
 }
 
+TEST(ResourceLoader, LoadSparse)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	SparseResource source(3, 3, SPARSE_MATRIX);
+	persister->Persist(source, RESOURCE_KEY);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->RegisterResource<int>(RESOURCE_KEY, SPARSE_RESOURCE_CONSTRUCTOR);
+	loader->OpenDatabase(DB_PATH);
+
+	std::unique_ptr<IPersistableResource> resource = loader->Load(RESOURCE_KEY);
+	auto sparse = dynamic_cast<SparseResource *>(resource.get());
+	ASSERT_TRUE(sparse);
+	EXPECT_EQ(sparse->GetColumnSize(), size_t(3));
+	EXPECT_EQ(sparse->GetRowSize(), size_t(3));
+	EXPECT_EQ(sparse->GetNonZeroCount(), size_t(3));
+	EXPECT_EQ(sparse->GetRowOffsets(), source.GetRowOffsets());
+	EXPECT_EQ(sparse->GetColumnIndices(), source.GetColumnIndices());
+
+	std::vector<int> dense(SPARSE_MATRIX.size());
+	sparse->CopyToDense(reinterpret_cast<char *>(dense.data()));
+	EXPECT_EQ(dense, SPARSE_MATRIX);
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadWithMemoryResource)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	SparseResource source(3, 3, SPARSE_MATRIX);
+	persister->Persist(source, RESOURCE_KEY);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->RegisterResource<int>(RESOURCE_KEY, ALLOCATING_SPARSE_RESOURCE_CONSTRUCTOR);
+	loader->OpenDatabase(DB_PATH);
+
+	ArenaMemoryResource arena;
+	std::unique_ptr<IPersistableResource> resource = loader->Load(RESOURCE_KEY, &arena);
+	auto sparse = dynamic_cast<SparseResource *>(resource.get());
+	ASSERT_TRUE(sparse);
+	EXPECT_EQ(sparse->GetMemoryResource(), &arena);
+	EXPECT_EQ(sparse->GetNonZeroCount(), size_t(3));
+	EXPECT_GT(arena.GetUsedBytes(), size_t(0));
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadSparseFromDenseRow)
+{
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+
+	ResourceLoaderFixture fixture(RESOURCE_KEY, ARRAY_1);
+	loader->UnregisterAll();
+	loader->RegisterResource<int>(RESOURCE_KEY, SPARSE_RESOURCE_CONSTRUCTOR);
+	loader->OpenDatabase(DB_PATH);
+
+	std::unique_ptr<IPersistableResource> resource = loader->Load(RESOURCE_KEY);
+	auto sparse = dynamic_cast<SparseResource *>(resource.get());
+	ASSERT_TRUE(sparse);
+	EXPECT_EQ(sparse->GetColumnSize(), size_t(1));
+	EXPECT_EQ(sparse->GetRowSize(), ARRAY_1.size());
+	EXPECT_EQ(sparse->GetNonZeroCount(), ARRAY_1.size());
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadSparseThrowsIntoDenseResource)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	SparseResource source(3, 3, SPARSE_MATRIX);
+	persister->Persist(source, RESOURCE_KEY);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	loader->OpenDatabase(DB_PATH);
+
+	EXPECT_THROW(loader->Load(RESOURCE_KEY), std::runtime_error);
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadTensor)
+{
+	SqliteRemover remover;
+
+	const std::vector<size_t> shape = {2, 2, 2};
+	const std::vector<int> values = {0, 1, 2, 3, 4, 5, 6, 7};
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	Resource source(shape, values, Layout::Tiled({1, 2, 2}));
+	persister->Persist(source, RESOURCE_KEY);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	loader->OpenDatabase(DB_PATH);
+
+	std::unique_ptr<IPersistableResource> resource = loader->Load(RESOURCE_KEY);
+	EXPECT_EQ(resource->GetShape(), shape);
+	EXPECT_EQ(resource->GetLayout(), Layout::Tiled({1, 2, 2}));
+	EXPECT_EQ(resource->GetColumnSize(), size_t(2));
+	EXPECT_EQ(resource->GetRowSize(), size_t(4));
+
+	const int *data = static_cast<const int *>(static_cast<const IPersistableResource *>(resource.get())->Data());
+	EXPECT_EQ(std::vector<int>(data, data + values.size()), values);
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadConvertsDataType)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	ContainerResource<float> source(std::vector<float>({1.5f, -2.0f, 0.25f}));
+	persister->Persist(source, RESOURCE_KEY);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->RegisterResource<double>(RESOURCE_KEY, []() -> std::unique_ptr<IPersistableResource>
+									 { return std::make_unique<ContainerResource<double>>(); });
+	loader->OpenDatabase(DB_PATH);
+
+	std::unique_ptr<IPersistableResource> resource = loader->Load(RESOURCE_KEY);
+	EXPECT_EQ(resource->GetDataType(), DataType::Float64);
+	EXPECT_EQ(resource->GetColumnSize() * resource->GetRowSize(), size_t(3));
+
+	const double *data = static_cast<const double *>(static_cast<const IPersistableResource *>(resource.get())->Data());
+	EXPECT_EQ(std::vector<double>(data, data + 3), std::vector<double>({1.5, -2.0, 0.25}));
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadDelta)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	persister->SetDeltaChainLength(4);
+	std::vector<int> values(64, VAL);
+	for (size_t version = 0; version < 3; ++version)
+	{
+		values[version * 20] = static_cast<int>(version) + 10;
+		persister->Persist(Resource({8, 8}, values), RESOURCE_KEY);
+	}
+	persister->SetDeltaChainLength(0);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	loader->OpenDatabase(DB_PATH);
+
+	// the latest row is rebuilt from the base row and every delta after it
+	std::unique_ptr<IPersistableResource> resource = loader->Load(RESOURCE_KEY);
+	EXPECT_EQ(resource->GetShape(), std::vector<size_t>({8, 8}));
+	const int *data = static_cast<const int *>(static_cast<const IPersistableResource *>(resource.get())->Data());
+	EXPECT_EQ(std::vector<int>(data, data + values.size()), values);
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadEncoded)
+{
+	SqliteRemover remover;
+
+	std::vector<double> values(100);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = static_cast<double>(i) / 8.0 - 3.0;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	persister->SetEncoding("half", Encoding(EncodingType::Float16));
+	persister->SetEncoding("quantized", Encoding(EncodingType::Int8));
+	persister->Persist(ContainerResource<double>({10, 10}, values), "half");
+	persister->Persist(ContainerResource<double>({10, 10}, values), "quantized");
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	auto constructor = []() -> std::unique_ptr<IPersistableResource>
+	{ return std::make_unique<ContainerResource<double>>(); };
+	loader->RegisterResource<double>("half", constructor);
+	loader->RegisterResource<double>("quantized", constructor);
+	loader->OpenDatabase(DB_PATH);
+
+	// both are restored to double precision within the precision of their encoding
+	for (const auto &[key, tolerance] : std::vector<std::pair<std::string, double>>({{"half", 1e-2}, {"quantized", 0.05}}))
+	{
+		std::unique_ptr<IPersistableResource> resource = loader->Load(key);
+		EXPECT_EQ(resource->GetShape(), std::vector<size_t>({10, 10}));
+		const double *data = static_cast<const double *>(static_cast<const IPersistableResource *>(resource.get())->Data());
+		for (size_t i = 0; i < values.size(); ++i)
+			EXPECT_NEAR(data[i], values[i], tolerance);
+	}
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, FindKeys)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	persister->SetZoneMapBlockSize(2);
+	persister->Persist(Resource(std::vector<int>({1, 2, 3})), "low");
+	persister->Persist(Resource(std::vector<int>({10, 20, 30})), "high");
+	persister->SetZoneMapBlockSize(0);
+	persister->Persist(Resource(std::vector<int>({1, 2, 3})), "unknown");
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->OpenDatabase(DB_PATH);
+
+	EXPECT_EQ(loader->FindKeys(2.0, 2.0), std::vector<std::string>({"low"}));
+	EXPECT_EQ(loader->FindKeys(3.0, 10.0), std::vector<std::string>({"high", "low"}));
+	EXPECT_EQ(loader->FindKeys(25.0, 100.0), std::vector<std::string>({"high"}));
+	EXPECT_TRUE(loader->FindKeys(4.0, 9.0).empty());
+
+	// infinite bounds match every resource with statistics
+	const double infinity = std::numeric_limits<double>::infinity();
+	EXPECT_EQ(loader->FindKeys(-infinity, infinity), std::vector<std::string>({"high", "low"}));
+	EXPECT_EQ(loader->FindKeys(15.0, infinity), std::vector<std::string>({"high"}));
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourceLoader, FindKeysThrowsWhenDatabaseIsNotOpen)
+{
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	EXPECT_THROW(loader->FindKeys(0.0, 1.0), std::runtime_error);
+	ResourceLoader::ResetInstance();
+}
+
+TEST(ResourceLoader, LoadZoneMap)
+{
+	SqliteRemover remover;
+
+	const std::vector<double> values = {0.5, -1.0, 7.0, 2.0, 3.5};
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	persister->OpenDatabase(DB_PATH);
+	persister->Persist(ContainerResource<double>(values), "plain");
+	persister->SetZoneMapBlockSize(2);
+	persister->Persist(ContainerResource<double>(values), RESOURCE_KEY);
+	persister->CloseDatabase();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->OpenDatabase(DB_PATH);
+
+	const boost::optional<ZoneMap> zoneMap = loader->LoadZoneMap(RESOURCE_KEY);
+	ASSERT_TRUE(zoneMap);
+	EXPECT_EQ(zoneMap->GetBlockCount(), size_t(3));
+	EXPECT_EQ(zoneMap->GetTotal(), ResourceStats(-1.0, 7.0, 12.0, 5, 0));
+	EXPECT_EQ(zoneMap->FindBlocks(5.0, 8.0), std::vector<size_t>({1}));
+
+	EXPECT_FALSE(loader->LoadZoneMap("plain"));
+	EXPECT_FALSE(loader->LoadZoneMap("missing"));
+	EXPECT_THROW(loader->LoadZoneMap(""), std::runtime_error);
+
+	ResourceLoader::ResetInstance();
+	ResourcePersister::ResetInstance();
+}
+
 TEST(ResourceLoader, LoadThrowsWhenDatabaseIsNotOpen)
 {
 	SqliteRemover remover;
@@ -176,6 +486,33 @@ TEST(ResourceLoader, OpenDatabase)
 	ResourceLoader::ResetInstance();
 }
 
+TEST(ResourceLoader, OpenDatabaseAddsNonZeroCountToLegacyTable)
+{
+	SqliteRemover remover;
+
+	Sqlite db;
+	db.Open(DB_PATH);
+	db.Execute("CREATE TABLE resources (row INTEGER PRIMARY KEY AUTOINCREMENT, resource_key TEXT NOT NULL, m INTEGER, n INTEGER, sizeof INTEGER, data BLOB);");
+	EXPECT_FALSE(db.HasColumn("resources", "nnz"));
+	db.Close();
+
+	ResourceLoader *loader = ResourceLoader::GetInstance();
+	loader->OpenDatabase(DB_PATH);
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "nnz"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "shape"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "layout"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "tile"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "dtype"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "stat_min"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "stat_max"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "zone_map"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "delta_base"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "quant_scale"));
+	EXPECT_TRUE(loader->GetDatabase().HasColumn("resources", "quant_offset"));
+
+	ResourceLoader::ResetInstance();
+}
+
 TEST(ResourceLoader, OpenDatabaseThrowsIfAlreadyOpen)
 {
 	SqliteRemover remover;
@@ -10,16 +10,24 @@
 #include <boost/system/error_code.hpp>
 
 #include "test_database_adapters/ContainerResource.h"
+#include "test_database_adapters/SparseContainerResource.h"
 #include "DatabaseAdapters/IPersistableResource.h"
 #include "DatabaseAdapters/ResourceLoader.h"
 #include "DatabaseAdapters/ResourcePersister.h"
 #include "DatabaseAdapters/SqliteBlob.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceView.h"
 
 using boost::system::error_code;
 using database_adapters::IPersistableResource;
 using database_adapters::ResourceLoader;
 using database_adapters::ResourcePersister;
 using database_adapters::SqliteBlob;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::Layout;
+using resource::ResourceView;
 
 namespace
 {
@@ -34,6 +42,7 @@ namespace
 	const std::vector<int> ARRAY_1(2, VAL);
 
 	using Resource = ContainerResource<int>;
+	using SparseResource = SparseContainerResource<int>;
 
 	auto RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<IPersistableResource>
 	{ return std::make_unique<Resource>(); };
@@ -199,6 +208,201 @@ TEST(ResourcePersister, Persist)
 	ResourcePersister::ResetInstance();
 }
 
+TEST(ResourcePersister, PersistView)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_NO_THROW(persister->OpenDatabase(DB_PATH));
+
+	// persist every other element without materializing the slice
+	Resource resource(std::vector<int>({0, 1, 2, 3, 4, 5}));
+	EXPECT_NO_THROW(persister->Persist(ResourceView(resource, 1, 1, 3, 6, 2), RESOURCE_KEY));
+
+	{
+		SqliteBlob blob(persister->GetDatabase());
+		blob.Open(TABLE_NAME, DATA_KEY, VALID_ROW);
+		std::vector<char> bytes = blob.Read(3 * sizeof(int), 0);
+		const int *values = reinterpret_cast<const int *>(bytes.data());
+		EXPECT_EQ(values[0], 1);
+		EXPECT_EQ(values[1], 3);
+		EXPECT_EQ(values[2], 5);
+	}
+
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourcePersister, PersistTensor)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_NO_THROW(persister->OpenDatabase(DB_PATH));
+
+	Resource resource({2, 3, 4}, std::vector<int>(24, VAL), Layout::ColumnMajor());
+	EXPECT_NO_THROW(persister->Persist(resource, RESOURCE_KEY));
+
+	// the shape and layout are stored alongside the flattened dimensions
+	std::vector<std::string> row;
+	std::function<int(int, char **, char **)> rowHandler =
+		[&row](int numCols, char **colValues, char **colNames)
+	{
+		for (int i = 0; i < numCols; ++i)
+			row.push_back(colValues[i] ? colValues[i] : "NULL");
+		return 0;
+	};
+	persister->GetDatabase().Execute("SELECT m, n, shape, layout, tile FROM " + TABLE_NAME + ";", rowHandler);
+	EXPECT_EQ(row, std::vector<std::string>({"2", "12", "2,3,4", "1", "NULL"}));
+
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourcePersister, PersistStatistics)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_NO_THROW(persister->OpenDatabase(DB_PATH));
+	EXPECT_EQ(persister->GetZoneMapBlockSize(), size_t(0));
+
+	// rows persisted before statistics were enabled have none
+	EXPECT_NO_THROW(persister->Persist(Resource(std::vector<int>({1, 2})), RESOURCE_KEY));
+	persister->SetZoneMapBlockSize(2);
+	EXPECT_NO_THROW(persister->Persist(Resource(std::vector<int>({-4, 9, 3})), RESOURCE_KEY));
+
+	std::vector<std::string> rows;
+	std::function<int(int, char **, char **)> rowHandler =
+		[&rows](int numCols, char **colValues, char **colNames)
+	{
+		std::string row;
+		for (int i = 0; i < numCols; ++i)
+			row += (i ? "," : "") + std::string(colValues[i] ? colValues[i] : "NULL");
+		rows.push_back(row);
+		return 0;
+	};
+	persister->GetDatabase().Execute("SELECT stat_min, stat_max, stat_sum, stat_count, stat_nan, length(zone_map) FROM " + TABLE_NAME + " ORDER BY row;", rowHandler);
+	ASSERT_EQ(rows.size(), size_t(2));
+	EXPECT_EQ(rows[0], "NULL,NULL,NULL,NULL,NULL,NULL");
+	EXPECT_EQ(rows[1], "-4.0,9.0,8.0,3,0," + std::to_string(16 + 3 * 40));
+
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourcePersister, PersistDelta)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_NO_THROW(persister->OpenDatabase(DB_PATH));
+	EXPECT_EQ(persister->GetDeltaChainLength(), size_t(0));
+	persister->SetDeltaChainLength(2);
+	EXPECT_EQ(persister->GetDeltaChainLength(), size_t(2));
+
+	// small changes are stored as deltas until the chain is full
+	std::vector<int> values(256, VAL);
+	for (size_t version = 0; version < 4; ++version)
+	{
+		values[version * 50] = -static_cast<int>(version);
+		EXPECT_NO_THROW(persister->Persist(Resource(values), RESOURCE_KEY));
+	}
+	// a change to most of the payload is stored in full
+	EXPECT_NO_THROW(persister->Persist(Resource(std::vector<int>(256, 2)), RESOURCE_KEY));
+
+	std::vector<std::string> rows;
+	std::function<int(int, char **, char **)> rowHandler =
+		[&rows](int numCols, char **colValues, char **colNames)
+	{
+		rows.push_back(std::string(colValues[0] ? colValues[0] : "NULL") + "," + colValues[1]);
+		return 0;
+	};
+	persister->GetDatabase().Execute("SELECT delta_base, length(data) < 1024 FROM " + TABLE_NAME + " ORDER BY row;", rowHandler);
+	EXPECT_EQ(rows, std::vector<std::string>({"NULL,0", "1,1", "2,1", "NULL,0", "NULL,0"}));
+
+	persister->SetDeltaChainLength(0);
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourcePersister, PersistEncoded)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_NO_THROW(persister->OpenDatabase(DB_PATH));
+	EXPECT_EQ(persister->GetEncoding(RESOURCE_KEY).GetType(), EncodingType::None);
+
+	const std::vector<float> values = {-1.0f, 0.0f, 2.5f, 4.0f};
+	persister->SetEncoding(RESOURCE_KEY, Encoding(EncodingType::Int16));
+	EXPECT_EQ(persister->GetEncoding(RESOURCE_KEY).GetType(), EncodingType::Int16);
+	EXPECT_NO_THROW(persister->Persist(ContainerResource<float>(values), RESOURCE_KEY));
+	persister->SetEncoding(RESOURCE_KEY, Encoding(EncodingType::BFloat16));
+	EXPECT_NO_THROW(persister->Persist(ContainerResource<float>(values), RESOURCE_KEY));
+	// integer resources are persisted as they are
+	EXPECT_NO_THROW(persister->Persist(Resource(std::vector<int>({1, 2, 3, 4})), RESOURCE_KEY));
+
+	std::vector<std::string> rows;
+	std::function<int(int, char **, char **)> rowHandler =
+		[&rows](int numCols, char **colValues, char **colNames)
+	{
+		std::string row;
+		for (int i = 0; i < numCols; ++i)
+			row += (i ? "," : "") + std::string(colValues[i] ? colValues[i] : "NULL");
+		rows.push_back(row);
+		return 0;
+	};
+	persister->GetDatabase().Execute("SELECT dtype, sizeof, length(data), quant_scale IS NOT NULL, quant_offset IS NOT NULL FROM " + TABLE_NAME + " ORDER BY row;", rowHandler);
+	EXPECT_EQ(rows, std::vector<std::string>({"3,2,8,1,1", "10,2,8,0,0", "5,4,16,0,0"}));
+
+	persister->SetEncoding(RESOURCE_KEY, Encoding());
+	EXPECT_EQ(persister->GetEncoding(RESOURCE_KEY).GetType(), EncodingType::None);
+	EXPECT_THROW(persister->SetEncoding("", Encoding(EncodingType::Int8)), std::runtime_error);
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourcePersister, PersistSparse)
+{
+	SqliteRemover remover;
+
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+	EXPECT_NO_THROW(persister->OpenDatabase(DB_PATH));
+
+	SparseResource resource(2, 3, std::vector<int>({0, 7, 0, 0, 0, 9}));
+	EXPECT_NO_THROW(persister->Persist(resource, RESOURCE_KEY));
+
+	// only the row offsets, column indices and non-zero values are stored
+	size_t nnz = 0;
+	size_t bytes = 0;
+	std::function<int(int, char **, char **)> rowHandler =
+		[&nnz, &bytes](int numCols, char **colValues, char **colNames)
+	{
+		nnz = std::stoull(std::string(colValues[0]));
+		bytes = std::stoull(std::string(colValues[1]));
+		return 0;
+	};
+	persister->GetDatabase().Execute("SELECT nnz, length(" + DATA_KEY + ") FROM " + TABLE_NAME + ";", rowHandler);
+	EXPECT_EQ(nnz, size_t(2));
+	EXPECT_EQ(bytes, 3 * sizeof(size_t) + 2 * sizeof(size_t) + 2 * sizeof(int));
+
+	{
+		SqliteBlob blob(persister->GetDatabase());
+		blob.Open(TABLE_NAME, DATA_KEY, VALID_ROW);
+		std::vector<char> values = blob.Read(2 * sizeof(int), 5 * sizeof(size_t));
+		EXPECT_EQ(reinterpret_cast<const int *>(values.data())[0], 7);
+		EXPECT_EQ(reinterpret_cast<const int *>(values.data())[1], 9);
+	}
+
+	ResourcePersister::ResetInstance();
+}
+
+TEST(ResourcePersister, PersistViewThrowsUsingEmptyKey)
+{
+	ResourcePersister *persister = ResourcePersister::GetInstance();
+
+	Resource resource(ARRAY_1);
+	EXPECT_THROW(persister->Persist(ResourceView(resource), ""), std::runtime_error);
+
+	ResourcePersister::ResetInstance();
+}
+
 TEST(ResourcePersister, PersistThrowsUsingEmptyKey)
 {
 	ResourcePersister *persister = ResourcePersister::GetInstance();
@@ -101,6 +101,19 @@ TEST_F(SqliteF, GetPath)
 	db.Close();
 }
 
+TEST_F(SqliteF, HasColumn)
+{
+	Sqlite db;
+	db.Open(DB_PATH);
+
+	db.Execute("CREATE TABLE " + TABLE_NAME + " (" + COLUMN_NAMES[0] + " INTEGER PRIMARY KEY AUTOINCREMENT, " + COLUMN_NAMES[1] + " TEXT NOT NULL);");
+	EXPECT_TRUE(db.HasColumn(TABLE_NAME, COLUMN_NAMES[0]));
+	EXPECT_TRUE(db.HasColumn(TABLE_NAME, COLUMN_NAMES[1]));
+	EXPECT_FALSE(db.HasColumn(TABLE_NAME, "missing"));
+	EXPECT_FALSE(db.HasColumn("missing", COLUMN_NAMES[0]));
+	db.Close();
+}
+
 TEST_F(SqliteF, IntegrationTest)
 {
 	Sqlite db;
@@ -183,6 +183,19 @@ TEST_F(SqliteBlobF, Read)
 	EXPECT_EQ(ARRAY_1[1], reinterpret_cast<const int *>(data.data())[1]);
 }
 
+TEST_F(SqliteBlobF, ReadIntoBuffer)
+{
+	SqliteBlob blob(GetDatabase());
+
+	blob.Open(TABLE_NAME, DATA_KEY, VALID_ROW);
+
+	std::vector<int> data(ARRAY_1.size());
+	EXPECT_NO_THROW(blob.Read(reinterpret_cast<char *>(data.data()), data.size() * sizeof(int), VALID_OFFSET));
+	EXPECT_EQ(ARRAY_1[0], data[0]);
+	EXPECT_EQ(ARRAY_1[1], data[1]);
+	EXPECT_THROW(blob.Read(nullptr, sizeof(int), VALID_OFFSET), std::runtime_error);
+}
+
 TEST_F(SqliteBlobF, ReadThrowsWithInvalidSize)
 {
 	SqliteBlob blob(GetDatabase());
@@ -1,5 +1,6 @@
 #include "test_entities/config.h"
 
+#include <fstream>
 #include <stdexcept>
 #include <string>
 #include "Config/filesystem.hpp"
@@ -101,3 +102,68 @@ TEST(EntityHierarchy, GetSerializationPath)
 	EXPECT_NO_THROW(hierarchy.SetSerializationPath(JSON_ROOT));
 	EXPECT_EQ(hierarchy.GetSerializationPath(), JSON_ROOT);
 }
+
+TEST(EntityHierarchy, UpdateNode)
+{
+	const fs::path jsonFile = fs::path(JSON_ROOT) / JSON_FILE;
+	const fs::path logFile = EntityHierarchy::GetLogPath(jsonFile);
+	EXPECT_EQ(logFile, fs::path(jsonFile.string() + ".log"));
+
+	EntityHierarchy hierarchy;
+	EXPECT_THROW(hierarchy.SaveUpdates(), std::runtime_error);
+	hierarchy.SetSerializationPath(jsonFile);
+
+	pt::ptree fields;
+	fields.put("name", "a");
+	hierarchy.UpdateNode(ENTITY_1A, fields, {"child"});
+	fields.clear();
+	fields.put("value", 1);
+	hierarchy.UpdateNode(ENTITY_1A + ".child", fields, {});
+
+	// the first save writes the whole structure
+	hierarchy.SaveUpdates();
+	EXPECT_TRUE(fs::exists(jsonFile));
+	EXPECT_FALSE(fs::exists(logFile));
+
+	// later changes are appended to the log
+	fields.put("value", 2);
+	hierarchy.UpdateNode(ENTITY_1A + ".child", fields, {});
+	hierarchy.SaveUpdates();
+	EXPECT_TRUE(fs::exists(logFile));
+	EXPECT_EQ(hierarchy.GetSerializationStructure().get<int>(ENTITY_1A + ".child.value"), 2);
+
+	// a line cut short by a crash is ignored
+	{
+		std::ofstream log(logFile.string(), std::ios::app);
+		log << "{\"path\":";
+	}
+	EntityHierarchy loaded;
+	loaded.LoadSerializationStructure(jsonFile);
+	EXPECT_EQ(loaded.GetSerializationStructure(), hierarchy.GetSerializationStructure());
+
+	// and dropped, so records appended after it are replayed
+	fields.put("value", 3);
+	hierarchy.UpdateNode(ENTITY_1A + ".child", fields, {});
+	hierarchy.SaveUpdates();
+	EntityHierarchy reloaded;
+	reloaded.LoadSerializationStructure(jsonFile);
+	EXPECT_EQ(reloaded.GetSerializationStructure().get<int>(ENTITY_1A + ".child.value"), 3);
+	EXPECT_EQ(reloaded.GetSerializationStructure(), hierarchy.GetSerializationStructure());
+
+	// the fields of a node are replaced and the subtrees of its members are kept
+	fields.clear();
+	fields.put("name", "b");
+	loaded.UpdateNode(ENTITY_1A, fields, {"child"});
+	EXPECT_EQ(loaded.GetSerializationStructure().get<std::string>(ENTITY_1A + ".name"), "b");
+	EXPECT_EQ(loaded.GetSerializationStructure().get<int>(ENTITY_1A + ".child.value"), 2);
+	loaded.UpdateNode(ENTITY_1A, fields, {});
+	EXPECT_FALSE(loaded.GetSerializationStructure().get_child_optional(ENTITY_1A + ".child"));
+
+	loaded.SaveSerializationStructure();
+	EXPECT_FALSE(fs::exists(logFile));
+	EntityHierarchy saved;
+	saved.LoadSerializationStructure(jsonFile);
+	EXPECT_EQ(saved.GetSerializationStructure(), loaded.GetSerializationStructure());
+
+	RemoveJSONFile(jsonFile);
+}
@@ -0,0 +1,79 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "FilesystemAdapters/AlignedFile.h"
+
+using filesystem_adapters::AlignedFile;
+
+namespace
+{
+	const fs::path ROOT_DIR = fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY;
+	const fs::path FILE_PATH = ROOT_DIR / "aligned.bin";
+
+	std::string ReadAll()
+	{
+		std::ifstream inFile(FILE_PATH.string(), std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+	}
+} // end namespace
+
+TEST(AlignedFile, AllocateBuffer)
+{
+	AlignedFile::BufferType buff = AlignedFile::AllocateBuffer(100);
+	ASSERT_TRUE(buff);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(buff.get()) % AlignedFile::ALIGNMENT, uintptr_t(0));
+}
+
+TEST(AlignedFile, RoundUp)
+{
+	EXPECT_EQ(AlignedFile::RoundUp(0), size_t(0));
+	EXPECT_EQ(AlignedFile::RoundUp(1), AlignedFile::ALIGNMENT);
+	EXPECT_EQ(AlignedFile::RoundUp(AlignedFile::ALIGNMENT), AlignedFile::ALIGNMENT);
+	EXPECT_EQ(AlignedFile::RoundUp(AlignedFile::ALIGNMENT + 1), 2 * AlignedFile::ALIGNMENT);
+}
+
+TEST(AlignedFile, ConstructThrows)
+{
+	EXPECT_THROW(AlignedFile("", false), std::runtime_error);
+	EXPECT_THROW(AlignedFile((ROOT_DIR / "missing.bin").string(), false), std::runtime_error);
+}
+
+TEST(AlignedFile, WriteRead)
+{
+	fs::create_directories(ROOT_DIR);
+
+	// direct I/O falls back to buffered I/O where it is not supported
+	for (const bool direct : {false, true})
+	{
+		const size_t size = 3 * AlignedFile::ALIGNMENT;
+		AlignedFile::BufferType buff = AlignedFile::AllocateBuffer(size);
+		for (size_t i = 0; i < size; ++i)
+			buff[i] = static_cast<char>(i % 251);
+		{
+			AlignedFile file(FILE_PATH.string(), true, direct);
+			file.Write(buff.get(), size);
+			file.Truncate(size - 10);
+			file.Close();
+			EXPECT_THROW(file.Write(buff.get(), size), std::runtime_error);
+		}
+		EXPECT_EQ(ReadAll(), std::string(buff.get(), size - 10));
+
+		AlignedFile::BufferType read = AlignedFile::AllocateBuffer(size);
+		AlignedFile file(FILE_PATH.string(), false, direct);
+		EXPECT_EQ(file.Read(read.get(), 2 * AlignedFile::ALIGNMENT), 2 * AlignedFile::ALIGNMENT);
+		EXPECT_EQ(file.Read(read.get() + 2 * AlignedFile::ALIGNMENT, AlignedFile::ALIGNMENT), AlignedFile::ALIGNMENT - 10);
+		EXPECT_EQ(file.Read(read.get(), AlignedFile::ALIGNMENT), size_t(0));
+		EXPECT_EQ(std::string(read.get(), size - 10), std::string(buff.get(), size - 10));
+	}
+
+	fs::remove(FILE_PATH);
+}
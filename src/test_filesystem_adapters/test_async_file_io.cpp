@@ -0,0 +1,76 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "FilesystemAdapters/AsyncFileIO.h"
+
+using filesystem_adapters::AsyncBackend;
+using filesystem_adapters::AsyncFileIO;
+
+namespace
+{
+	const fs::path ROOT_DIR = fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY;
+	const size_t FILE_COUNT = 10;
+
+	std::vector<std::string> FilePaths()
+	{
+		std::vector<std::string> filePaths;
+		for (size_t i = 0; i < FILE_COUNT; ++i)
+			filePaths.push_back((ROOT_DIR / ("async_" + std::to_string(i) + ".bin")).string());
+		return filePaths;
+	}
+} // end namespace
+
+TEST(AsyncFileIO, Construct)
+{
+	EXPECT_NO_THROW(AsyncFileIO());
+	EXPECT_THROW(AsyncFileIO(0), std::runtime_error);
+
+	AsyncFileIO io(8, AsyncBackend::ThreadPool);
+	EXPECT_EQ(io.GetBackend(), AsyncBackend::ThreadPool);
+	EXPECT_EQ(io.GetQueueDepth(), size_t(8));
+}
+
+TEST(AsyncFileIO, WriteBatchReadBatch)
+{
+	fs::create_directories(ROOT_DIR);
+	const std::vector<std::string> filePaths = FilePaths();
+
+	// the queue is shallower than the batch, so requests wait for free slots
+	for (const AsyncBackend backend : {AsyncBackend::IoUring, AsyncBackend::ThreadPool})
+	{
+		AsyncFileIO io(4, backend);
+
+		std::vector<std::vector<char>> data;
+		for (size_t i = 0; i < FILE_COUNT; ++i)
+			data.emplace_back(i * 1000, static_cast<char>('a' + i));
+
+		EXPECT_THROW(io.WriteBatch(filePaths, std::vector<std::vector<char>>(1)), std::runtime_error);
+		for (std::future<void> &written : io.WriteBatch(filePaths, data))
+			EXPECT_NO_THROW(written.get());
+
+		std::vector<std::future<std::vector<char>>> read = io.ReadBatch(filePaths);
+		ASSERT_EQ(read.size(), FILE_COUNT);
+		for (size_t i = 0; i < FILE_COUNT; ++i)
+			EXPECT_EQ(read[i].get(), data[i]);
+	}
+
+	for (const std::string &filePath : filePaths)
+		fs::remove(filePath);
+}
+
+TEST(AsyncFileIO, ReadThrowsOnMissingFile)
+{
+	for (const AsyncBackend backend : {AsyncBackend::IoUring, AsyncBackend::ThreadPool})
+	{
+		AsyncFileIO io(AsyncFileIO::QUEUE_DEPTH, backend);
+		std::future<std::vector<char>> read = io.Read((ROOT_DIR / "missing.bin").string());
+		EXPECT_THROW(read.get(), std::runtime_error);
+	}
+}
@@ -0,0 +1,126 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "FilesystemAdapters/DeltaLog.h"
+#include "Resources/DeltaCodec.h"
+
+using filesystem_adapters::DeltaLog;
+using resource::DeltaCodec;
+
+namespace
+{
+	const fs::path ROOT_DIR = fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY;
+	const fs::path BASE_FILE = ROOT_DIR / "resource.bin";
+	const fs::path LOG_FILE = ROOT_DIR / "resource.delta";
+
+	std::vector<char> Bytes(const std::string &text)
+	{
+		return std::vector<char>(text.cbegin(), text.cend());
+	}
+
+	std::vector<char> Delta(const std::vector<char> &base, const std::vector<char> &target)
+	{
+		return DeltaCodec::Encode(base.data(), base.size(), target.data(), target.size());
+	}
+
+	struct FileRemover
+	{
+		FileRemover()
+		{
+			fs::create_directories(ROOT_DIR);
+			std::ofstream(BASE_FILE.string(), std::ios::binary) << "version 0";
+		}
+
+		~FileRemover()
+		{
+			fs::remove(BASE_FILE);
+			fs::remove(LOG_FILE);
+		}
+	};
+} // end namespace
+
+TEST(DeltaLog, GetLogPath)
+{
+	EXPECT_EQ(DeltaLog::GetLogPath("dir/resource.bin"), "dir/resource.delta");
+	EXPECT_EQ(DeltaLog::GetLogPath("resource"), "resource.delta");
+}
+
+TEST(DeltaLog, Construct)
+{
+	FileRemover remover;
+	const DeltaLog deltaLog(BASE_FILE.string());
+	EXPECT_EQ(deltaLog.GetLength(), size_t(0));
+	EXPECT_EQ(deltaLog.ReadImage(), Bytes("version 0"));
+	EXPECT_FALSE(fs::exists(LOG_FILE));
+}
+
+TEST(DeltaLog, Append)
+{
+	FileRemover remover;
+	{
+		DeltaLog deltaLog(BASE_FILE.string());
+		deltaLog.Append(Delta(Bytes("version 0"), Bytes("version 1")));
+		deltaLog.Append(Delta(Bytes("version 1"), Bytes("version 12")));
+		EXPECT_EQ(deltaLog.GetLength(), size_t(2));
+		EXPECT_TRUE(fs::exists(LOG_FILE));
+	}
+
+	// the base image is untouched and the log is found again
+	std::ifstream inFile(BASE_FILE.string(), std::ios::binary);
+	EXPECT_EQ(std::string(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>()), "version 0");
+	const DeltaLog deltaLog(BASE_FILE.string());
+	EXPECT_EQ(deltaLog.GetLength(), size_t(2));
+	EXPECT_EQ(deltaLog.ReadImage(), Bytes("version 12"));
+}
+
+TEST(DeltaLog, AppendAfterTornRecord)
+{
+	FileRemover remover;
+	{
+		DeltaLog deltaLog(BASE_FILE.string());
+		deltaLog.Append(Delta(Bytes("version 0"), Bytes("version 1")));
+	}
+
+	// a crash in the middle of an append leaves a partial record
+	const uint64_t recordSize = 1000;
+	std::ofstream(LOG_FILE.string(), std::ios::binary | std::ios::app).write(reinterpret_cast<const char *>(&recordSize), sizeof(recordSize)) << "partial";
+
+	DeltaLog deltaLog(BASE_FILE.string());
+	EXPECT_EQ(deltaLog.GetLength(), size_t(1));
+	EXPECT_EQ(deltaLog.ReadImage(), Bytes("version 1"));
+
+	deltaLog.Append(Delta(Bytes("version 1"), Bytes("version 2")));
+	EXPECT_EQ(DeltaLog(BASE_FILE.string()).ReadImage(), Bytes("version 2"));
+}
+
+TEST(DeltaLog, Remove)
+{
+	FileRemover remover;
+	DeltaLog deltaLog(BASE_FILE.string());
+	deltaLog.Append(Delta(Bytes("version 0"), Bytes("version 1")));
+	deltaLog.Remove();
+	EXPECT_EQ(deltaLog.GetLength(), size_t(0));
+	EXPECT_FALSE(fs::exists(LOG_FILE));
+	EXPECT_EQ(deltaLog.ReadImage(), Bytes("version 0"));
+	EXPECT_NO_THROW(deltaLog.Remove());
+}
+
+TEST(DeltaLog, Throws)
+{
+	FileRemover remover;
+	std::ofstream(LOG_FILE.string(), std::ios::binary) << "not a delta log";
+	EXPECT_THROW(DeltaLog(BASE_FILE.string()), std::runtime_error);
+
+	fs::remove(LOG_FILE);
+	fs::remove(BASE_FILE);
+	EXPECT_THROW(DeltaLog(BASE_FILE.string()).ReadImage(), std::runtime_error);
+}
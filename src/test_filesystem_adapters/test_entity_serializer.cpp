@@ -13,12 +13,14 @@
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
+#include "Entities/EntityHierarchy.h"
 #include "FilesystemAdapters/ISerializableEntity.h"
 #include "FilesystemAdapters/EntitySerializer.h"
 
 namespace pt = boost::property_tree;
 
 using entity::Entity;
+using entity::EntityHierarchy;
 using filesystem_adapters::EntitySerializer;
 using filesystem_adapters::ISerializableEntity;
 
@@ -47,9 +49,17 @@ namespace
 			entity::Entity::AggregateMember(std::move(entity));
 		}
 
+		std::shared_ptr<TypeA> GetMember(const Key &key) const
+		{
+			return std::dynamic_pointer_cast<TypeA>(GetAggregatedMember(key));
+		}
+
 		void Save(pt::ptree &tree, const std::string &path) const override
 		{
 			path_ = path;
+			++saveCount_;
+			if (value_ != 0)
+				tree.put("value", value_);
 			fs::create_directories(path);
 		}
 
@@ -58,8 +68,20 @@ namespace
 			EXPECT_TRUE(fs::exists(path));
 		}
 
+		size_t GetSaveCount() const
+		{
+			return saveCount_;
+		}
+
+		void SetValue(const int value)
+		{
+			value_ = value;
+		}
+
 	private:
+		int value_{0};
 		mutable std::string path_;
+		mutable size_t saveCount_{0};
 	};
 
 	std::shared_ptr<TypeA> CreateEntity(const Key &root, const std::string &intermediate = "", const Key &leaf = "")
@@ -117,6 +139,7 @@ namespace
 				EXPECT_TRUE(fs::exists(fs::path(JSON_ROOT) / dir));
 
 			// cleanup serialization
+			fs::remove(EntityHierarchy::GetLogPath(jsonFile_));
 			fs::remove(jsonFile_);
 			EXPECT_FALSE(fs::exists(jsonFile_));
 			fs::path directories = fs::path(JSON_ROOT) / entity_->GetKey();
@@ -214,3 +237,70 @@ TEST(EntitySerializer, SerializeThrows)
 
 	EntitySerializer::ResetInstance();
 }
+
+TEST(EntitySerializer, SerializeChanged)
+{
+	EntitySerializerFixture fixture(ENTITY_1A, ENTITY_2A, ENTITY_1B);
+
+	EntitySerializer *serializer = EntitySerializer::GetInstance();
+	serializer->GetHierarchy().SetSerializationPath(fixture.GetJSONFilePath());
+	serializer->SetIncremental(true);
+	EXPECT_TRUE(serializer->GetIncremental());
+
+	std::shared_ptr<TypeA> root = fixture.GetEntity();
+	std::shared_ptr<TypeA> intermediate = root->GetMember(ENTITY_2A);
+	std::shared_ptr<TypeA> leaf = intermediate->GetMember(ENTITY_1B);
+	EXPECT_TRUE(leaf->IsDirty());
+	serializer->Serialize(*root);
+	EXPECT_FALSE(root->IsDirty());
+	EXPECT_FALSE(leaf->IsDirty());
+	EXPECT_EQ(root->GetSaveCount() + intermediate->GetSaveCount() + leaf->GetSaveCount(), size_t(3));
+
+	// clean entities are not saved again
+	serializer->Serialize(*root);
+	EXPECT_EQ(root->GetSaveCount() + intermediate->GetSaveCount() + leaf->GetSaveCount(), size_t(3));
+
+	// only the changed leaf is saved, and the hierarchy on disk follows it
+	leaf->MarkDirty();
+	serializer->Serialize(*root);
+	EXPECT_EQ(root->GetSaveCount(), size_t(1));
+	EXPECT_EQ(leaf->GetSaveCount(), size_t(2));
+
+	EntityHierarchy loaded;
+	loaded.LoadSerializationStructure(fixture.GetJSONFilePath());
+	EXPECT_EQ(loaded.GetSerializationStructure(), serializer->GetHierarchy().GetSerializationStructure());
+	EXPECT_TRUE(loaded.GetSerializationStructure().get_child_optional(ENTITY_1A + "." + ENTITY_2A + "." + ENTITY_1B));
+
+	fixture.VerifySerialization();
+
+	EntitySerializer::ResetInstance();
+}
+
+TEST(EntitySerializer, SerializeUnmarkedChange)
+{
+	EntitySerializerFixture fixture(ENTITY_1A, ENTITY_2A, ENTITY_1B);
+
+	EntitySerializer *serializer = EntitySerializer::GetInstance();
+	serializer->GetHierarchy().SetSerializationPath(fixture.GetJSONFilePath());
+	EXPECT_FALSE(serializer->GetIncremental());
+
+	std::shared_ptr<TypeA> root = fixture.GetEntity();
+	std::shared_ptr<TypeA> leaf = root->GetMember(ENTITY_2A)->GetMember(ENTITY_1B);
+	serializer->Serialize(*root);
+
+	// a field changed without MarkDirty is still saved, since every entity is saved by default
+	const std::string valuePath = ENTITY_1A + "." + ENTITY_2A + "." + ENTITY_1B + ".value";
+	leaf->SetValue(7);
+	EXPECT_FALSE(leaf->IsDirty());
+	serializer->Serialize(*root);
+	EXPECT_EQ(leaf->GetSaveCount(), size_t(2));
+
+	EntityHierarchy loaded;
+	loaded.LoadSerializationStructure(fixture.GetJSONFilePath());
+	EXPECT_EQ(loaded.GetSerializationStructure().get<int>(valuePath), 7);
+	EXPECT_FALSE(fs::exists(EntityHierarchy::GetLogPath(fixture.GetJSONFilePath())));
+
+	fixture.VerifySerialization();
+
+	EntitySerializer::ResetInstance();
+}
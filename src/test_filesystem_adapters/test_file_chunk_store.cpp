@@ -0,0 +1,162 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "test_filesystem_adapters/ContainerResource.h"
+#include "FilesystemAdapters/FileChunkStore.h"
+#include "FilesystemAdapters/ResourceDeserializer.h"
+#include "FilesystemAdapters/ResourceSerializer.h"
+#include "Resources/ChunkedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceStats.h"
+
+using filesystem_adapters::FileChunkStore;
+using filesystem_adapters::ResourceSerializer;
+using resource::ChunkedResource;
+using resource::DataType;
+using resource::Layout;
+using resource::ResourceStats;
+using Resource = ContainerResource<int>;
+
+namespace
+{
+	const std::string RESOURCE_ROOT = (fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY).string();
+	const std::string RESOURCE_KEY = "resource";
+	const fs::path RESOURCE_FILE = fs::path(RESOURCE_ROOT) / (RESOURCE_KEY + ".bin");
+	const size_t M = 7;
+	const size_t N = 3;
+
+	struct Chunked : ChunkedResource
+	{
+		size_t GetElementSize() const override { return sizeof(int); }
+		DataType GetDataType() const override { return DataType::Int32; }
+	};
+
+	std::vector<int> Iota(const size_t count)
+	{
+		std::vector<int> values(count);
+		std::iota(values.begin(), values.end(), 0);
+		return values;
+	}
+
+	struct FileRemover
+	{
+		~FileRemover()
+		{
+			ResourceSerializer::GetInstance()->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+		}
+	};
+} // end namespace
+
+TEST(FileChunkStore, Construct)
+{
+	FileRemover remover;
+	Resource resource({M, N}, Iota(M * N));
+	ResourceSerializer::GetInstance()->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	FileChunkStore store(RESOURCE_FILE.string());
+	EXPECT_EQ(store.GetShape(), std::vector<size_t>({M, N}));
+	EXPECT_EQ(store.GetDataType(), DataType::Int32);
+	EXPECT_EQ(store.GetSize(), M * N * sizeof(int));
+	EXPECT_EQ(store.GetHeader().GetSize() + store.GetSize(), fs::file_size(RESOURCE_FILE));
+}
+
+TEST(FileChunkStore, ConstructThrows)
+{
+	FileRemover remover;
+	EXPECT_THROW(FileChunkStore(""), std::runtime_error);
+	EXPECT_THROW(FileChunkStore(RESOURCE_FILE.string()), std::runtime_error);
+
+	Resource resource({2, 3, 4}, Iota(24), Layout::ColumnMajor());
+	ResourceSerializer::GetInstance()->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_THROW(FileChunkStore(RESOURCE_FILE.string()), std::runtime_error);
+}
+
+TEST(FileChunkStore, ConstructThrowsWithPendingDeltas)
+{
+	FileRemover remover;
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetDeltaChainLength(4);
+
+	Resource resource({M, N}, Iota(M * N));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	std::vector<int> values = Iota(M * N);
+	values[0] = -1;
+	resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	EXPECT_THROW(FileChunkStore(RESOURCE_FILE.string()), std::runtime_error);
+	serializer->SetDeltaChainLength(0);
+}
+
+TEST(FileChunkStore, ReadRows)
+{
+	FileRemover remover;
+	const std::vector<int> values = Iota(M * N);
+	Resource resource({M, N}, values);
+	ResourceSerializer::GetInstance()->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	Chunked chunked;
+	chunked.Open(std::make_unique<FileChunkStore>(RESOURCE_FILE.string()), 2);
+	EXPECT_EQ(chunked.GetChunkCount(), size_t(4));
+
+	std::vector<int> rows(4 * N);
+	chunked.ReadRows(3, 4, reinterpret_cast<char *>(rows.data()));
+	EXPECT_EQ(rows, std::vector<int>(values.begin() + 3 * N, values.end()));
+}
+
+TEST(FileChunkStore, WriteRows)
+{
+	FileRemover remover;
+	Resource resource({M, N}, Iota(M * N));
+	ResourceSerializer::GetInstance()->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	const std::vector<int> row(N, -1);
+	{
+		Chunked chunked;
+		chunked.Open(std::make_unique<FileChunkStore>(RESOURCE_FILE.string()), 2);
+		chunked.WriteRows(0, 1, reinterpret_cast<const char *>(row.data()));
+	}
+
+	// modified chunks were written back into the file on destruction
+	FileChunkStore store(RESOURCE_FILE.string());
+	std::vector<int> values(2 * N);
+	store.Read(0, reinterpret_cast<char *>(values.data()), values.size() * sizeof(int));
+	EXPECT_EQ(values, std::vector<int>({-1, -1, -1, 3, 4, 5}));
+	EXPECT_THROW(store.Read(store.GetSize() - 1, reinterpret_cast<char *>(values.data()), 2), std::runtime_error);
+}
+
+TEST(FileChunkStore, WriteRowsUpdatesZoneMap)
+{
+	FileRemover remover;
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetZoneMapBlockSize(2 * N);
+	Resource resource({M, N}, Iota(M * N));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	serializer->SetZoneMapBlockSize(0);
+
+	const std::vector<int> row(N, 100);
+	{
+		Chunked chunked;
+		chunked.Open(std::make_unique<FileChunkStore>(RESOURCE_FILE.string()), 2);
+		chunked.WriteRows(4, 1, reinterpret_cast<const char *>(row.data()));
+	}
+
+	// only the block of the written row is recomputed
+	FileChunkStore store(RESOURCE_FILE.string());
+	ASSERT_TRUE(store.GetHeader().HasZoneMap());
+	const auto &zoneMap = store.GetHeader().GetZoneMap();
+	EXPECT_EQ(zoneMap.GetBlock(1), ResourceStats(6.0, 11.0, 51.0, 6, 0));
+	EXPECT_EQ(zoneMap.GetBlock(2), ResourceStats(15.0, 100.0, 348.0, 6, 0));
+	EXPECT_EQ(zoneMap.GetTotal().GetMax(), 100.0);
+	EXPECT_EQ(zoneMap.FindBlocks(50.0, 200.0), std::vector<size_t>({2}));
+	EXPECT_EQ(store.GetHeader().GetSize() + store.GetSize(), fs::file_size(RESOURCE_FILE));
+}
@@ -1,12 +1,17 @@
 
 #include "test_filesystem_adapters/config.h"
 
+#include <atomic>
 #include <limits>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "test_filesystem_adapters/CompressedContainerResource.h"
 #include "test_filesystem_adapters/ContainerResource.h"
+#include "test_filesystem_adapters/SparseContainerResource.h"
 #include "FilesystemAdapters/ISerializableResource.h"
 
 using Resource = ContainerResource<int>;
@@ -63,6 +68,154 @@ TEST(Resource, Lock)
 	EXPECT_EQ(*static_cast<int *>(lockedResource.Data()), ARRAY_1[0]);
 }
 
+TEST(Resource, LockPinsCompressedResource)
+{
+	CompressedContainerResource<int> resource(BUFFER_2X2);
+	EXPECT_FALSE(resource.IsResident());
+	{
+		LockedResource lockedResource = resource.Lock();
+		EXPECT_TRUE(resource.IsResident());
+
+		resource.Evict();
+		EXPECT_TRUE(resource.IsResident());
+		EXPECT_EQ(*static_cast<const int *>(lockedResource.Data()), GT_BYTE_SIZE);
+	}
+	resource.Evict();
+	EXPECT_FALSE(resource.IsResident());
+}
+
+TEST(Resource, LockShared)
+{
+	const Resource resource(BUFFER_2X2);
+	{
+		const LockedResource first = resource.Lock();
+		const LockedResource second = resource.Lock();
+		EXPECT_TRUE(first.IsShared());
+		EXPECT_EQ(*static_cast<const int *>(second.Data()), GT_BYTE_SIZE);
+
+		EXPECT_FALSE(resource.mtx_->try_lock());
+		EXPECT_TRUE(resource.mtx_->try_lock_shared());
+		resource.mtx_->unlock_shared();
+	}
+	EXPECT_TRUE(resource.mtx_->try_lock());
+	resource.mtx_->unlock();
+}
+
+TEST(Resource, LockSharedThrowsOnWrite)
+{
+	Resource resource(BUFFER_2X2);
+	EXPECT_FALSE(resource.Lock().IsShared());
+
+	LockedResource lockedResource = resource.LockShared();
+	EXPECT_TRUE(lockedResource.IsShared());
+	EXPECT_THROW(lockedResource.Data(), std::runtime_error);
+	EXPECT_THROW(lockedResource.Assign(reinterpret_cast<const char *>(ARRAY_1.data()), sizeof(int)), std::runtime_error);
+}
+
+TEST(Resource, ReadConsistent)
+{
+	Resource resource(BUFFER_2X2);
+	std::vector<int> buffer(BUFFER_2X2.size());
+	const size_t bytes = buffer.size() * sizeof(int);
+
+	EXPECT_FALSE(resource.IsSeqlockEnabled());
+	EXPECT_EQ(resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), bytes), bytes);
+	EXPECT_EQ(buffer, BUFFER_2X2);
+
+	resource.EnableSeqlock(bytes);
+	EXPECT_TRUE(resource.IsSeqlockEnabled());
+	EXPECT_EQ(resource.GetSeqlockVersion(), uint64_t(1));
+
+	const std::vector<int> values(BUFFER_2X2.size(), VAL);
+	resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), bytes);
+	EXPECT_EQ(resource.GetSeqlockVersion(), uint64_t(2));
+	EXPECT_EQ(resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), bytes), bytes);
+	EXPECT_EQ(buffer, values);
+
+	// shared locks do not publish
+	resource.LockShared();
+	EXPECT_EQ(resource.GetSeqlockVersion(), uint64_t(2));
+
+	resource.DisableSeqlock();
+	EXPECT_FALSE(resource.IsSeqlockEnabled());
+	EXPECT_EQ(resource.GetSeqlockVersion(), uint64_t(0));
+	EXPECT_EQ(resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), bytes), bytes);
+	EXPECT_EQ(buffer, values);
+
+	// the copy is kept, so it can only be enabled again with the same capacity
+	EXPECT_THROW(resource.EnableSeqlock(2 * bytes), std::runtime_error);
+	resource.EnableSeqlock(bytes);
+	EXPECT_TRUE(resource.IsSeqlockEnabled());
+	EXPECT_EQ(resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), bytes), bytes);
+	EXPECT_EQ(buffer, values);
+}
+
+TEST(Resource, ReadConsistentFallsBackToLock)
+{
+	Resource resource(BUFFER_2X2);
+	std::vector<int> buffer(BUFFER_2X2.size());
+	const size_t bytes = buffer.size() * sizeof(int);
+
+	// the payload does not fit the seqlock
+	resource.EnableSeqlock(sizeof(int));
+	EXPECT_EQ(resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), bytes), bytes);
+	EXPECT_EQ(buffer, BUFFER_2X2);
+}
+
+TEST(Resource, ReadConsistentThrows)
+{
+	Resource resource(BUFFER_2X2);
+	int value = 0;
+	EXPECT_THROW(resource.ReadConsistent(reinterpret_cast<char *>(&value), sizeof(value)), std::runtime_error);
+
+	resource.EnableSeqlock(BUFFER_2X2.size() * sizeof(int));
+	EXPECT_THROW(resource.ReadConsistent(reinterpret_cast<char *>(&value), sizeof(value)), std::runtime_error);
+}
+
+TEST(Resource, ReadConsistentThrowsWithSparseResource)
+{
+	SparseContainerResource<int> resource(2, 2, {0, VAL, 0, 0});
+	std::vector<int> buffer(BUFFER_2X2.size());
+	const size_t bytes = buffer.size() * sizeof(int);
+
+	EXPECT_THROW(resource.EnableSeqlock(bytes), std::runtime_error);
+	EXPECT_FALSE(resource.IsSeqlockEnabled());
+	EXPECT_THROW(resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), bytes), std::runtime_error);
+
+	// writes still release the lock without publishing
+	EXPECT_NO_THROW(resource.Lock());
+}
+
+TEST(Resource, ReadConsistentConcurrentWriter)
+{
+	const size_t count = 16;
+	Resource resource(std::vector<int>(count, 0));
+	resource.EnableSeqlock(count * sizeof(int));
+
+	std::atomic<bool> done{false};
+	std::thread writer([&resource, &done, count]()
+					   {
+		for (int i = 1; i <= 1000; ++i)
+		{
+			const std::vector<int> values(count, i);
+			resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), count * sizeof(int));
+		}
+		done = true; });
+
+	// every read sees a single write, never a mix of two
+	std::vector<int> buffer(count);
+	do
+	{
+		resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), count * sizeof(int));
+		for (const int value : buffer)
+			EXPECT_EQ(value, buffer[0]);
+	} while (!done);
+	writer.join();
+
+	resource.ReadConsistent(reinterpret_cast<char *>(buffer.data()), count * sizeof(int));
+	EXPECT_EQ(buffer, std::vector<int>(count, 1000));
+}
+
 TEST(Resource, GetData)
 {
 	Resource ir(ARRAY_1);
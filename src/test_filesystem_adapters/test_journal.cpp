@@ -0,0 +1,209 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "FilesystemAdapters/Journal.h"
+#include "Resources/IResource.h"
+
+using filesystem_adapters::Journal;
+using resource::IResource;
+
+namespace
+{
+	const fs::path JOURNAL_DIR = fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY / "journal";
+	const fs::path JOURNAL_FILE = JOURNAL_DIR / "resources.wal";
+	const fs::path JOURNAL_COPY = JOURNAL_DIR / "copy.wal";
+	const size_t MAGIC_SIZE = 8;
+
+	void WriteText(const fs::path &filePath, const std::string &text)
+	{
+		std::ofstream outFile(filePath.string(), std::ios::binary | std::ios::trunc);
+		outFile << text;
+	}
+
+	std::string ReadText(const fs::path &filePath)
+	{
+		std::ifstream inFile(filePath.string(), std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+	}
+
+	void Commit(Journal &journal, const fs::path &filePath, const std::string &text)
+	{
+		journal.Write(filePath.string(), text.data(), text.size(), [&]()
+					  { WriteText(filePath, text); });
+	}
+} // end namespace
+
+TEST(Journal, Construct)
+{
+	EXPECT_THROW(Journal(""), std::runtime_error);
+
+	fs::remove_all(JOURNAL_DIR);
+	{
+		Journal journal(JOURNAL_FILE.string());
+		EXPECT_EQ(journal.GetPath(), JOURNAL_FILE.string());
+		EXPECT_EQ(journal.GetSize(), MAGIC_SIZE);
+		EXPECT_EQ(journal.GetCommitCount(), size_t(0));
+		EXPECT_EQ(journal.GetRecoveredCount(), size_t(0));
+	}
+	EXPECT_EQ(fs::file_size(JOURNAL_FILE), MAGIC_SIZE);
+
+	// files that are not journals are not replayed
+	WriteText(JOURNAL_FILE, "not a journal");
+	EXPECT_THROW(Journal(JOURNAL_FILE.string()), std::runtime_error);
+
+	fs::remove_all(JOURNAL_DIR);
+}
+
+TEST(Journal, WriteAndCheckpoint)
+{
+	fs::remove_all(JOURNAL_DIR);
+	Journal journal(JOURNAL_FILE.string());
+
+	Commit(journal, JOURNAL_DIR / "a.bin", "first");
+	Commit(journal, JOURNAL_DIR / "b.bin", "second");
+	EXPECT_EQ(ReadText(JOURNAL_DIR / "a.bin"), "first");
+	EXPECT_EQ(ReadText(JOURNAL_DIR / "b.bin"), "second");
+	EXPECT_EQ(journal.GetCommitCount(), size_t(2));
+	EXPECT_GT(journal.GetSize(), MAGIC_SIZE);
+	EXPECT_EQ(fs::file_size(JOURNAL_FILE), journal.GetSize());
+
+	journal.Remove((JOURNAL_DIR / "b.bin").string(), [&]()
+				   { fs::remove(JOURNAL_DIR / "b.bin"); });
+	EXPECT_FALSE(fs::exists(JOURNAL_DIR / "b.bin"));
+
+	// the checkpoint syncs the files, so their records are dropped
+	journal.Checkpoint();
+	EXPECT_EQ(journal.GetSize(), MAGIC_SIZE);
+	EXPECT_EQ(fs::file_size(JOURNAL_FILE), MAGIC_SIZE);
+	EXPECT_EQ(ReadText(JOURNAL_DIR / "a.bin"), "first");
+
+	EXPECT_THROW(journal.Write("", "x", 1, []() {}), std::runtime_error);
+	EXPECT_THROW(journal.Remove("", []() {}), std::runtime_error);
+	EXPECT_THROW(journal.Write((JOURNAL_DIR / "c.bin").string(), nullptr, 1, []() {}), std::runtime_error);
+
+	fs::remove_all(JOURNAL_DIR);
+}
+
+TEST(Journal, Replay)
+{
+	fs::remove_all(JOURNAL_DIR);
+	fs::create_directories(JOURNAL_DIR);
+	WriteText(JOURNAL_DIR / "removed.bin", "stale");
+	{
+		Journal journal(JOURNAL_FILE.string());
+
+		// a crash after the commits and before the files are written
+		journal.Write((JOURNAL_DIR / "a.bin").string(), "old", 3, []() {});
+		journal.Write((JOURNAL_DIR / "a.bin").string(), "new", 3, []() {});
+		journal.Remove((JOURNAL_DIR / "removed.bin").string(), []() {});
+		fs::copy_file(JOURNAL_FILE, JOURNAL_COPY);
+	}
+	EXPECT_FALSE(fs::exists(JOURNAL_DIR / "a.bin"));
+	EXPECT_TRUE(fs::exists(JOURNAL_DIR / "removed.bin"));
+
+	// a record cut short by the crash is dropped
+	{
+		std::ofstream outFile(JOURNAL_COPY.string(), std::ios::binary | std::ios::app);
+		outFile.write("\x05\x00\x00", 3);
+	}
+	fs::remove(JOURNAL_FILE);
+	fs::rename(JOURNAL_COPY, JOURNAL_FILE);
+
+	{
+		Journal journal(JOURNAL_FILE.string());
+		EXPECT_EQ(journal.GetRecoveredCount(), size_t(2));
+		EXPECT_EQ(journal.GetSize(), MAGIC_SIZE);
+	}
+	EXPECT_EQ(ReadText(JOURNAL_DIR / "a.bin"), "new");
+	EXPECT_FALSE(fs::exists(JOURNAL_DIR / "removed.bin"));
+	EXPECT_EQ(fs::file_size(JOURNAL_FILE), MAGIC_SIZE);
+
+	fs::remove_all(JOURNAL_DIR);
+}
+
+TEST(Journal, WriteWithChecksum)
+{
+	fs::remove_all(JOURNAL_DIR);
+	const std::string good = "good image";
+	const std::string bad = "bad image";
+	{
+		Journal journal(JOURNAL_FILE.string());
+
+		// the record of the first image carries the checksum it was given; the second one was given a wrong one
+		journal.Write((JOURNAL_DIR / "a.bin").string(), good.data(), good.size(), IResource::Crc32(good.data(), good.size()), []() {});
+		journal.Write((JOURNAL_DIR / "b.bin").string(), bad.data(), bad.size(), 0, []() {});
+		fs::copy_file(JOURNAL_FILE, JOURNAL_COPY);
+	}
+	fs::remove(JOURNAL_FILE);
+	fs::rename(JOURNAL_COPY, JOURNAL_FILE);
+
+	// replay stops at the record that does not match its checksum
+	{
+		Journal journal(JOURNAL_FILE.string());
+		EXPECT_EQ(journal.GetRecoveredCount(), size_t(1));
+	}
+	EXPECT_EQ(ReadText(JOURNAL_DIR / "a.bin"), good);
+	EXPECT_FALSE(fs::exists(JOURNAL_DIR / "b.bin"));
+
+	fs::remove_all(JOURNAL_DIR);
+}
+
+TEST(Journal, GroupCommit)
+{
+	fs::remove_all(JOURNAL_DIR);
+	const size_t threadCount = 8;
+	const size_t writeCount = 20;
+	{
+		// every commit passes the checkpoint size, so checkpoints run alongside the writers
+		Journal journal(JOURNAL_FILE.string(), 1);
+
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&journal, t]()
+								 {
+				for (size_t i = 0; i < writeCount; ++i)
+					Commit(journal, JOURNAL_DIR / (std::to_string(t) + ".bin"), std::to_string(i)); });
+		}
+		for (std::thread &thread : threads)
+			thread.join();
+
+		EXPECT_GE(journal.GetCommitCount(), size_t(1));
+		EXPECT_LE(journal.GetCommitCount(), threadCount * writeCount);
+		journal.WaitForCheckpoint();
+		journal.Checkpoint();
+		EXPECT_EQ(journal.GetSize(), MAGIC_SIZE);
+	}
+	for (size_t t = 0; t < threadCount; ++t)
+		EXPECT_EQ(ReadText(JOURNAL_DIR / (std::to_string(t) + ".bin")), std::to_string(writeCount - 1));
+
+	fs::remove_all(JOURNAL_DIR);
+}
+
+TEST(Journal, Flush)
+{
+	fs::remove_all(JOURNAL_DIR);
+	{
+		Journal journal(JOURNAL_FILE.string());
+		journal.Write((JOURNAL_DIR / "a.bin").string(), "journaled", 9, []() {});
+
+		// a file written outside the journal replaces the journaled image
+		WriteText(JOURNAL_DIR / "a.bin", "streamed");
+		journal.Flush((JOURNAL_DIR / "a.bin").string());
+		EXPECT_EQ(journal.GetSize(), MAGIC_SIZE);
+	}
+	Journal journal(JOURNAL_FILE.string());
+	EXPECT_EQ(journal.GetRecoveredCount(), size_t(0));
+	EXPECT_EQ(ReadText(JOURNAL_DIR / "a.bin"), "streamed");
+
+	fs::remove_all(JOURNAL_DIR);
+}
@@ -0,0 +1,225 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "test_filesystem_adapters/ContainerResource2D.h"
+#include "test_filesystem_adapters/MappedContainerResource.h"
+#include "FilesystemAdapters/ISerializableResource.h"
+#include "FilesystemAdapters/MappedResource.h"
+#include "FilesystemAdapters/ResourceDeserializer.h"
+#include "FilesystemAdapters/ResourceSerializer.h"
+
+using filesystem_adapters::ISerializableResource;
+using filesystem_adapters::MapAdvice;
+using filesystem_adapters::MapMode;
+using filesystem_adapters::ResourceDeserializer;
+using filesystem_adapters::ResourceSerializer;
+
+using Resource2D = ContainerResource2D<int>;
+using MappedResource = MappedContainerResource<int>;
+
+namespace
+{
+	const std::string RESOURCE_ROOT = (fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY).string();
+	const std::string RESOURCE_KEY = "resource";
+	const fs::path RESOURCE_FILE = fs::path(RESOURCE_ROOT) / (RESOURCE_KEY + ".bin");
+	const std::vector<std::vector<int>> INT_MATRIX = {{1, 2, 3}, {4, 5, 6}};
+	const std::vector<int> INT_VALUES = {1, 2, 3, 4, 5, 6};
+
+	auto MAPPED_RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<ISerializableResource>
+	{ return std::make_unique<MappedResource>(MapMode::CopyOnWrite); };
+
+	struct MappedResourceF : public testing::Test
+	{
+		MappedResourceF()
+		{
+			Resource2D resource(INT_MATRIX);
+			ResourceSerializer::GetInstance()->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+		}
+
+		~MappedResourceF()
+		{
+			fs::remove(RESOURCE_FILE);
+		}
+	};
+
+	std::vector<int> Values(const MappedResource &resource)
+	{
+		const int *data = static_cast<const int *>(resource.Data());
+		return std::vector<int>(data, data + resource.GetColumnSize() * resource.GetRowSize());
+	}
+} // end namespace
+
+TEST(MappedResource, Construct)
+{
+	EXPECT_NO_THROW(MappedResource());
+	MappedResource resource(MapMode::CopyOnWrite);
+	EXPECT_FALSE(resource.IsMapped());
+	EXPECT_EQ(resource.GetMode(), MapMode::CopyOnWrite);
+	EXPECT_EQ(static_cast<const MappedResource &>(resource).Data(), nullptr);
+	EXPECT_FALSE(resource.Advise(MapAdvice::WillNeed));
+}
+
+TEST_F(MappedResourceF, Map)
+{
+	MappedResource resource;
+	EXPECT_NO_THROW(resource.Map(RESOURCE_FILE.string()));
+
+	EXPECT_TRUE(resource.IsMapped());
+	EXPECT_EQ(resource.GetFilePath(), RESOURCE_FILE.string());
+	EXPECT_EQ(resource.GetColumnSize(), INT_MATRIX.size());
+	EXPECT_EQ(resource.GetRowSize(), INT_MATRIX[0].size());
+	EXPECT_EQ(Values(resource), INT_VALUES);
+	EXPECT_TRUE(resource.Advise(MapAdvice::Sequential));
+}
+
+TEST_F(MappedResourceF, MapThrows)
+{
+	MappedResource resource;
+	EXPECT_THROW(resource.Map(""), std::runtime_error);
+	EXPECT_THROW(resource.Map((fs::path(RESOURCE_ROOT) / "missing.bin").string()), std::runtime_error);
+
+	resource.Map(RESOURCE_FILE.string());
+	EXPECT_THROW(resource.Map(RESOURCE_FILE.string()), std::runtime_error);
+}
+
+TEST_F(MappedResourceF, MapThrowsOnTruncatedFile)
+{
+	fs::resize_file(RESOURCE_FILE, fs::file_size(RESOURCE_FILE) - sizeof(int));
+
+	MappedResource resource;
+	EXPECT_THROW(resource.Map(RESOURCE_FILE.string()), std::runtime_error);
+	EXPECT_FALSE(resource.IsMapped());
+}
+
+TEST_F(MappedResourceF, MapThrowsOnDataTypeMismatch)
+{
+	// the payload is int32 and cannot be reinterpreted in place
+	MappedContainerResource<float> resource;
+	EXPECT_THROW(resource.Map(RESOURCE_FILE.string()), std::runtime_error);
+	EXPECT_FALSE(resource.IsMapped());
+}
+
+TEST_F(MappedResourceF, MapThrowsWithPendingDeltas)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetDeltaChainLength(4);
+	// deltas are only kept when they are much smaller than the image
+	Resource2D resource(std::vector<std::vector<int>>(8, std::vector<int>(16, 0)));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	std::vector<int> values(8 * 16, 0);
+	values[0] = -1;
+	resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	serializer->SetDeltaChainLength(0);
+
+	// the newest version is in the delta log, not in the mapped image
+	MappedResource mapped;
+	EXPECT_THROW(mapped.Map(RESOURCE_FILE.string()), std::runtime_error);
+	EXPECT_FALSE(mapped.IsMapped());
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+}
+
+TEST_F(MappedResourceF, ReadOnly)
+{
+	MappedResource resource(MapMode::ReadOnly);
+	resource.Map(RESOURCE_FILE.string());
+
+	EXPECT_THROW(resource.Data(), std::runtime_error);
+	EXPECT_THROW(resource.Assign(reinterpret_cast<const char *>(INT_VALUES.data()), INT_VALUES.size() * sizeof(int)), std::runtime_error);
+}
+
+TEST_F(MappedResourceF, CopyOnWrite)
+{
+	MappedResource resource(MapMode::CopyOnWrite);
+	resource.Map(RESOURCE_FILE.string());
+
+	static_cast<int *>(resource.Data())[0] = 42;
+	EXPECT_EQ(Values(resource)[0], 42);
+
+	// the file is untouched
+	MappedResource other;
+	other.Map(RESOURCE_FILE.string());
+	EXPECT_EQ(Values(other), INT_VALUES);
+}
+
+TEST_F(MappedResourceF, AssignInPlace)
+{
+	MappedResource resource(MapMode::CopyOnWrite);
+	resource.Map(RESOURCE_FILE.string());
+
+	const std::vector<int> values = {6, 5, 4, 3, 2, 1};
+	resource.Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	EXPECT_TRUE(resource.IsMapped());
+	EXPECT_EQ(Values(resource), values);
+}
+
+TEST_F(MappedResourceF, AssignReplacesMapping)
+{
+	MappedResource resource(MapMode::CopyOnWrite);
+	resource.Map(RESOURCE_FILE.string());
+
+	const std::vector<int> values = {7, 8};
+	resource.Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	EXPECT_FALSE(resource.IsMapped());
+	EXPECT_TRUE(resource.GetFilePath().empty());
+	EXPECT_EQ(static_cast<const int *>(static_cast<const MappedResource &>(resource).Data())[1], 8);
+}
+
+TEST_F(MappedResourceF, Unmap)
+{
+	MappedResource resource;
+	resource.Map(RESOURCE_FILE.string());
+	resource.Unmap();
+
+	EXPECT_FALSE(resource.IsMapped());
+	EXPECT_EQ(static_cast<const MappedResource &>(resource).Data(), nullptr);
+	EXPECT_EQ(resource.GetColumnSize(), INT_MATRIX.size());
+}
+
+TEST_F(MappedResourceF, MoveConstruct)
+{
+	MappedResource source;
+	source.Map(RESOURCE_FILE.string());
+
+	MappedResource target(std::move(source));
+	EXPECT_TRUE(target.IsMapped());
+	EXPECT_EQ(Values(target), INT_VALUES);
+}
+
+TEST_F(MappedResourceF, Serialize)
+{
+	MappedResource resource;
+	resource.Map(RESOURCE_FILE.string());
+
+	// replacing the mapped file leaves the mapping intact
+	ResourceSerializer::GetInstance()->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(Values(resource), INT_VALUES);
+
+	MappedResource other;
+	other.Map(RESOURCE_FILE.string());
+	EXPECT_EQ(Values(other), INT_VALUES);
+}
+
+TEST_F(MappedResourceF, Deserialize)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	deserializer->RegisterResource<int>(RESOURCE_KEY, MAPPED_RESOURCE_CONSTRUCTOR);
+
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	auto mapped = dynamic_cast<MappedResource *>(rsrc.get());
+	ASSERT_TRUE(mapped);
+	EXPECT_TRUE(mapped->IsMapped());
+	EXPECT_EQ(mapped->GetMode(), MapMode::CopyOnWrite);
+	EXPECT_EQ(Values(*mapped), INT_VALUES);
+
+	deserializer->UnregisterAll();
+}
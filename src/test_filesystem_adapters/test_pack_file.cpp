@@ -0,0 +1,220 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Config/filesystem.hpp"
+
+#include <gtest/gtest.h>
+
+#include "FilesystemAdapters/PackFile.h"
+
+using filesystem_adapters::PackFile;
+
+namespace
+{
+	const fs::path PACK_DIR = fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY / "pack";
+
+	std::vector<char> Image(const size_t size, const char value)
+	{
+		return std::vector<char>(size, value);
+	}
+} // end namespace
+
+TEST(PackFile, Construct)
+{
+	EXPECT_THROW(PackFile(""), std::runtime_error);
+
+	fs::remove_all(PACK_DIR);
+	{
+		PackFile pack(PACK_DIR.string());
+		EXPECT_EQ(pack.GetDirectory(), PACK_DIR.string());
+		EXPECT_EQ(pack.GetSegmentCount(), size_t(1));
+		EXPECT_TRUE(pack.GetKeys().empty());
+		EXPECT_EQ(pack.GetDeadRatio(), 0.0);
+	}
+	EXPECT_TRUE(fs::exists(PACK_DIR / "0.pack"));
+
+	fs::remove_all(PACK_DIR);
+}
+
+TEST(PackFile, PutGetErase)
+{
+	fs::remove_all(PACK_DIR);
+	PackFile pack(PACK_DIR.string());
+
+	pack.Put("a", Image(100, 'a').data(), 100);
+	pack.Put("b", Image(0, 'b').data(), 0);
+	EXPECT_TRUE(pack.Contains("a"));
+	EXPECT_EQ(pack.Get("a"), Image(100, 'a'));
+	EXPECT_TRUE(pack.Get("b").empty());
+	EXPECT_EQ(pack.Find("a")->length, uint64_t(100));
+	EXPECT_FALSE(pack.Find("c"));
+
+	// a new image replaces the old one
+	pack.Put("a", Image(50, 'x').data(), 50);
+	EXPECT_EQ(pack.Get("a"), Image(50, 'x'));
+	EXPECT_GT(pack.GetDeadRatio(), 0.0);
+
+	EXPECT_TRUE(pack.Erase("a"));
+	EXPECT_FALSE(pack.Erase("a"));
+	EXPECT_FALSE(pack.Contains("a"));
+	EXPECT_THROW(pack.Get("a"), std::runtime_error);
+	EXPECT_THROW(pack.Put("", Image(1, 'a').data(), 1), std::runtime_error);
+
+	fs::remove_all(PACK_DIR);
+}
+
+TEST(PackFile, Reopen)
+{
+	fs::remove_all(PACK_DIR);
+	{
+		PackFile pack(PACK_DIR.string(), 256);
+		for (int i = 0; i < 20; ++i)
+			pack.Put("key" + std::to_string(i), Image(40, static_cast<char>(i)).data(), 40);
+		pack.Put("key3", Image(10, 'z').data(), 10);
+		pack.Erase("key4");
+		EXPECT_GT(pack.GetSegmentCount(), size_t(1));
+	}
+
+	// a record cut short by a crash is ignored
+	{
+		std::ofstream outFile((PACK_DIR / "999.pack").string(), std::ios::binary);
+		outFile.write("AZRESPAK", 8);
+		outFile.write("\x05\x00", 2);
+	}
+
+	PackFile pack(PACK_DIR.string(), 256);
+	EXPECT_EQ(pack.GetKeys().size(), size_t(19));
+	EXPECT_EQ(pack.Get("key0"), Image(40, 0));
+	EXPECT_EQ(pack.Get("key3"), Image(10, 'z'));
+	EXPECT_EQ(pack.Get("key19"), Image(40, 19));
+	EXPECT_FALSE(pack.Contains("key4"));
+
+	pack.Put("key20", Image(40, 20).data(), 40);
+	EXPECT_EQ(pack.Get("key20"), Image(40, 20));
+
+	fs::remove_all(PACK_DIR);
+}
+
+TEST(PackFile, ReopenIgnoresGarbageTail)
+{
+	fs::remove_all(PACK_DIR);
+	{
+		PackFile pack(PACK_DIR.string());
+		pack.Put("a", Image(40, 'a').data(), 40);
+	}
+
+	// a complete record for the same key whose bytes do not match its checksum, as a crash may leave behind
+	const uint64_t segmentSize = fs::file_size(PACK_DIR / "0.pack");
+	{
+		const uint32_t keySize = 1;
+		const uint32_t checksum = 0;
+		const uint64_t length = 40;
+		std::ofstream outFile((PACK_DIR / "0.pack").string(), std::ios::binary | std::ios::app);
+		outFile.write(reinterpret_cast<const char *>(&keySize), sizeof(keySize));
+		outFile.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+		outFile.write(reinterpret_cast<const char *>(&length), sizeof(length));
+		outFile.write("a", 1);
+		outFile.write(Image(40, 'x').data(), 40);
+	}
+
+	{
+		PackFile pack(PACK_DIR.string());
+		EXPECT_EQ(pack.Get("a"), Image(40, 'a'));
+		EXPECT_EQ(pack.GetDeadRatio(), 0.0);
+		EXPECT_EQ(fs::file_size(PACK_DIR / "0.pack"), segmentSize);
+		pack.Put("b", Image(10, 'b').data(), 10);
+	}
+
+	PackFile pack(PACK_DIR.string());
+	EXPECT_EQ(pack.Get("a"), Image(40, 'a'));
+	EXPECT_EQ(pack.Get("b"), Image(10, 'b'));
+
+	fs::remove_all(PACK_DIR);
+}
+
+TEST(PackFile, ThrowsOnCorruptImage)
+{
+	fs::remove_all(PACK_DIR);
+	PackFile pack(PACK_DIR.string());
+	pack.Put("a", Image(100, 'a').data(), 100);
+
+	const PackFile::Entry entry = *pack.Find("a");
+	{
+		std::fstream file((PACK_DIR / "0.pack").string(), std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(static_cast<std::streamoff>(entry.offset + 10));
+		file.put('b');
+	}
+	EXPECT_THROW(pack.Get("a"), std::runtime_error);
+
+	fs::remove_all(PACK_DIR);
+}
+
+TEST(PackFile, Compact)
+{
+	fs::remove_all(PACK_DIR);
+	{
+		PackFile pack(PACK_DIR.string(), 256);
+		for (int round = 0; round < 4; ++round)
+			for (int i = 0; i < 10; ++i)
+				pack.Put("key" + std::to_string(i), Image(40, static_cast<char>(round * 10 + i)).data(), 40);
+		pack.Erase("key0");
+
+		const size_t segmentCount = pack.GetSegmentCount();
+		EXPECT_GT(pack.GetDeadRatio(), 0.5);
+		EXPECT_EQ(pack.Compact(1.1), size_t(0));
+
+		pack.StartCompaction();
+		EXPECT_GT(pack.WaitForCompaction(), size_t(0));
+		EXPECT_EQ(pack.WaitForCompaction(), size_t(0));
+		EXPECT_LT(pack.GetSegmentCount(), segmentCount);
+		EXPECT_LT(pack.GetDeadRatio(), 0.5);
+
+		for (int i = 1; i < 10; ++i)
+			EXPECT_EQ(pack.Get("key" + std::to_string(i)), Image(40, static_cast<char>(30 + i)));
+		EXPECT_FALSE(pack.Contains("key0"));
+	}
+
+	// the compacted pack reads back the same
+	PackFile pack(PACK_DIR.string(), 256);
+	std::vector<std::string> keys = pack.GetKeys();
+	std::sort(keys.begin(), keys.end());
+	EXPECT_EQ(keys.size(), size_t(9));
+	EXPECT_EQ(keys.front(), "key1");
+	EXPECT_EQ(pack.Get("key9"), Image(40, 39));
+
+	fs::remove_all(PACK_DIR);
+}
+
+TEST(PackFile, CompactWhileWriting)
+{
+	fs::remove_all(PACK_DIR);
+	const size_t imageSize = size_t(64) << 10;
+	{
+		// the first segment holds more live records than are copied in one batch
+		PackFile pack(PACK_DIR.string(), size_t(2) << 20);
+		for (int i = 0; i < 40; ++i)
+			pack.Put("key" + std::to_string(i), Image(imageSize, static_cast<char>(i)).data(), imageSize);
+		EXPECT_GT(pack.GetSegmentCount(), size_t(1));
+
+		// writers keep going between the batches of the compaction
+		pack.StartCompaction(0.0);
+		for (int i = 0; i < 5; ++i)
+			pack.Put("key" + std::to_string(i), Image(imageSize, 'w').data(), imageSize);
+		for (int i = 40; i < 50; ++i)
+			pack.Put("key" + std::to_string(i), Image(imageSize, static_cast<char>(i)).data(), imageSize);
+		EXPECT_GT(pack.WaitForCompaction(), size_t(0));
+		EXPECT_FALSE(fs::exists(PACK_DIR / "0.pack"));
+	}
+
+	PackFile pack(PACK_DIR.string(), size_t(2) << 20);
+	EXPECT_EQ(pack.GetKeys().size(), size_t(50));
+	for (int i = 0; i < 50; ++i)
+		EXPECT_EQ(pack.Get("key" + std::to_string(i)), Image(imageSize, i < 5 ? 'w' : static_cast<char>(i)));
+
+	fs::remove_all(PACK_DIR);
+}
@@ -1,7 +1,9 @@
 #include "test_filesystem_adapters/config.h"
 
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -10,18 +12,37 @@
 
 #include <gtest/gtest.h>
 
+#include "test_filesystem_adapters/CompressedContainerResource.h"
 #include "test_filesystem_adapters/ContainerResource.h"
 #include "test_filesystem_adapters/ContainerResource2D.h"
+#include "test_filesystem_adapters/SparseContainerResource.h"
 #include "FilesystemAdapters/ISerializableResource.h"
+#include "FilesystemAdapters/PackFile.h"
 #include "FilesystemAdapters/ResourceDeserializer.h"
 #include "FilesystemAdapters/ResourceSerializer.h"
+#include "Resources/Codec.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/PoolMemoryResource.h"
 
 using filesystem_adapters::ISerializableResource;
+using filesystem_adapters::PackFile;
 using filesystem_adapters::ResourceDeserializer;
+using filesystem_adapters::ResourceHeader;
 using filesystem_adapters::ResourceSerializer;
+using resource::Codec;
+using resource::CodecType;
+using resource::DataType;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::Layout;
+using resource::PoolMemoryResource;
 
 using Resource = ContainerResource<int>;
 using Resource2D = ContainerResource2D<int>;
+using CompressedResource = CompressedContainerResource<int>;
+using SparseResource = SparseContainerResource<int>;
 
 namespace
 {
@@ -34,6 +55,12 @@ namespace
 
 	auto RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<ISerializableResource>
 	{ return std::make_unique<Resource>(); };
+	auto COMPRESSED_RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<ISerializableResource>
+	{ return std::make_unique<CompressedResource>(); };
+	auto SPARSE_RESOURCE_CONSTRUCTOR = []() -> std::unique_ptr<ISerializableResource>
+	{ return std::make_unique<SparseResource>(); };
+	auto ALLOCATING_SPARSE_RESOURCE_CONSTRUCTOR = [](std::pmr::memory_resource *memory) -> std::unique_ptr<ISerializableResource>
+	{ return std::make_unique<SparseResource>(memory); };
 	auto RESOURCE_2D_CONSTRUCTOR = []() -> std::unique_ptr<ISerializableResource>
 	{ return std::make_unique<Resource2D>(); };
 } // end namespace
@@ -217,6 +244,348 @@ TEST(ResourceDeserializer, DeserializeMatrix)
 	deserializer->UnregisterAll();
 }
 
+TEST(ResourceDeserializer, DeserializeCompressed)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	// serialize
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	CompressedResource resource(std::vector<int>(64, 3));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+
+	// deserialize into a compressed resource
+	deserializer->RegisterResource<int>(RESOURCE_KEY, COMPRESSED_RESOURCE_CONSTRUCTOR);
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	auto compressed = dynamic_cast<CompressedResource *>(rsrc.get());
+	EXPECT_TRUE(compressed);
+	EXPECT_LT(compressed->GetCompressedSize(), compressed->GetUncompressedSize());
+	EXPECT_EQ(static_cast<const int *>(compressed->Data())[63], 3);
+	EXPECT_EQ(compressed->GetRowSize(), resource.GetRowSize());
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeSparse)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	// serialize
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	const std::vector<int> dense = {0, 0, 4, 0, 0, 0, 8, 0, 0, 0, 0, 1};
+	SparseResource resource(3, 4, dense);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+
+	// deserialize into a sparse resource
+	deserializer->RegisterResource<int>(RESOURCE_KEY, SPARSE_RESOURCE_CONSTRUCTOR);
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	auto sparse = dynamic_cast<SparseResource *>(rsrc.get());
+	ASSERT_TRUE(sparse);
+	EXPECT_EQ(sparse->GetColumnSize(), size_t(3));
+	EXPECT_EQ(sparse->GetRowSize(), size_t(4));
+	EXPECT_EQ(sparse->GetNonZeroCount(), size_t(3));
+
+	std::vector<int> values(dense.size());
+	sparse->CopyToDense(reinterpret_cast<char *>(values.data()));
+	EXPECT_EQ(values, dense);
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeTensor)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	// serialize a tiled 2 x 2 x 4 volume
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	const std::vector<size_t> shape = {2, 2, 4};
+	const std::vector<int> values = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+	Resource resource(shape, values, Layout::Tiled({1, 2, 2}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+
+	// deserialize
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(rsrc->GetRank(), size_t(3));
+	EXPECT_EQ(rsrc->GetShape(), shape);
+	EXPECT_EQ(rsrc->GetLayout(), Layout::Tiled({1, 2, 2}));
+	EXPECT_EQ(rsrc->GetColumnSize(), size_t(2));
+	EXPECT_EQ(rsrc->GetRowSize(), size_t(8));
+
+	const int *data = static_cast<const int *>(static_cast<const ISerializableResource *>(rsrc.get())->Data());
+	EXPECT_EQ(std::vector<int>(data, data + values.size()), values);
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeLegacyFile)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+
+	// files written before the versioned header start with M and N
+	fs::create_directories(RESOURCE_ROOT);
+	const size_t header[2] = {1, 2};
+	const std::vector<int> values = {3, 4};
+	std::ofstream outFile(RESOURCE_FILE.string(), std::ios::binary);
+	outFile.write(reinterpret_cast<const char *>(header), sizeof(header));
+	outFile.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	outFile.close();
+
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(rsrc->GetShape(), std::vector<size_t>({1, 2}));
+	EXPECT_EQ(rsrc->GetLayout(), Layout::RowMajor());
+
+	const int *data = static_cast<const int *>(static_cast<const ISerializableResource *>(rsrc.get())->Data());
+	EXPECT_EQ(std::vector<int>(data, data + values.size()), values);
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeConvertsDataType)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	// archive in double precision
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	ContainerResource<double> resource(std::vector<size_t>({2, 2}), std::vector<double>({0.5, -1.25, 3.0, 1e-3}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	// load in single precision
+	deserializer->RegisterResource<float>(RESOURCE_KEY, []() -> std::unique_ptr<ISerializableResource>
+										  { return std::make_unique<ContainerResource<float>>(); });
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(rsrc->GetDataType(), DataType::Float32);
+	EXPECT_EQ(rsrc->GetShape(), std::vector<size_t>({2, 2}));
+
+	const float *data = static_cast<const float *>(static_cast<const ISerializableResource *>(rsrc.get())->Data());
+	EXPECT_EQ(std::vector<float>(data, data + 4), std::vector<float>({0.5f, -1.25f, 3.0f, 1e-3f}));
+
+	// narrowing to integers is rejected
+	deserializer->UnregisterAll();
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	EXPECT_THROW(deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT), std::runtime_error);
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeEncoded)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	deserializer->RegisterResource<float>(RESOURCE_KEY, []() -> std::unique_ptr<ISerializableResource>
+										  { return std::make_unique<ContainerResource<float>>(); });
+
+	std::vector<float> values(64);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = static_cast<float>(i) * 0.75f - 20.0f;
+
+	// each encoding is read back into the float resource within its precision
+	const std::vector<std::pair<EncodingType, float>> tolerances = {
+		{EncodingType::Float16, 0.01f}, {EncodingType::BFloat16, 0.1f}, {EncodingType::Int8, 0.1f}, {EncodingType::Int16, 0.001f}};
+	for (const auto &[type, tolerance] : tolerances)
+	{
+		serializer->SetEncoding(RESOURCE_KEY, Encoding(type));
+		ContainerResource<float> resource(std::vector<size_t>({8, 8}), values);
+		serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+		std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+		EXPECT_EQ(rsrc->GetShape(), std::vector<size_t>({8, 8}));
+		const float *data = static_cast<const float *>(static_cast<const ISerializableResource *>(rsrc.get())->Data());
+		for (size_t i = 0; i < values.size(); ++i)
+			EXPECT_NEAR(data[i], values[i], tolerance);
+	}
+
+	// clean up
+	serializer->SetEncoding(RESOURCE_KEY, Encoding());
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeDeltas)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetDeltaChainLength(4);
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	std::vector<int> values(128, 3);
+	Resource resource(std::vector<size_t>({8, 16}), values);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	for (size_t i = 0; i < 3; ++i)
+	{
+		values[i * 40] = static_cast<int>(i) + 100;
+		resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+		serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	}
+
+	// the latest version is rebuilt from the base image and the deltas
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(rsrc->GetShape(), std::vector<size_t>({8, 16}));
+	const int *data = static_cast<const int *>(static_cast<const ISerializableResource *>(rsrc.get())->Data());
+	EXPECT_EQ(std::vector<int>(data, data + values.size()), values);
+	EXPECT_EQ(deserializer->ReadHeader(RESOURCE_KEY, RESOURCE_ROOT).GetShape(), std::vector<size_t>({8, 16}));
+
+	// clean up
+	serializer->SetDeltaChainLength(0);
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeChunks)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	std::vector<int> values(10000);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = static_cast<int>(i);
+	Resource resource(values);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	// the key does not need to be registered, and no chunk is larger than the buffer
+	for (const bool direct : {false, true})
+	{
+		std::vector<int> streamed(values.size());
+		size_t chunkCount = 0;
+		const ResourceDeserializer::ChunkCallbackType onChunk = [&](const char *chunk, const size_t size, const size_t offset)
+		{
+			EXPECT_LE(size, size_t(4096));
+			ASSERT_LE(offset + size, streamed.size() * sizeof(int));
+			std::memcpy(reinterpret_cast<char *>(streamed.data()) + offset, chunk, size);
+			++chunkCount;
+		};
+		const ResourceHeader header = deserializer->DeserializeChunks(RESOURCE_KEY, RESOURCE_ROOT, onChunk, 4096, direct);
+		EXPECT_EQ(header.GetElementCount(), values.size());
+		EXPECT_EQ(streamed, values);
+		EXPECT_GT(chunkCount, size_t(9));
+	}
+	EXPECT_THROW(deserializer->DeserializeChunks(RESOURCE_KEY, BAD_PATH, [](const char *, const size_t, const size_t) {}), std::runtime_error);
+	EXPECT_THROW(deserializer->DeserializeChunks("", RESOURCE_ROOT, [](const char *, const size_t, const size_t) {}), std::runtime_error);
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceDeserializer, ReadHeader)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetZoneMapBlockSize(2);
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	ContainerResource<double> resource(std::vector<size_t>({2, 2}), std::vector<double>({0.5, -1.25, 3.0, 1e-3}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	// no constructor is needed to inspect the header
+	const auto header = deserializer->ReadHeader(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(header.GetShape(), std::vector<size_t>({2, 2}));
+	EXPECT_EQ(header.GetDataType(), DataType::Float64);
+	ASSERT_TRUE(header.HasZoneMap());
+	EXPECT_TRUE(header.GetZoneMap().GetTotal().MayContain(2.0, 4.0));
+	EXPECT_FALSE(header.GetZoneMap().GetTotal().MayContain(4.0, 5.0));
+	EXPECT_EQ(header.GetZoneMap().FindBlocks(2.0, 4.0), std::vector<size_t>({1}));
+
+	EXPECT_THROW(deserializer->ReadHeader("", RESOURCE_ROOT), std::runtime_error);
+	EXPECT_THROW(deserializer->ReadHeader(RESOURCE_KEY, BAD_PATH), std::runtime_error);
+
+	// clean up
+	serializer->SetZoneMapBlockSize(0);
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceDeserializer, DeserializeSparseConvertsDataType)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	SparseContainerResource<int16_t> resource(2, 2, std::vector<int16_t>({0, -7, 9, 0}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	deserializer->RegisterResource<int64_t>(RESOURCE_KEY, []() -> std::unique_ptr<ISerializableResource>
+											{ return std::make_unique<SparseContainerResource<int64_t>>(); });
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	auto sparse = dynamic_cast<SparseContainerResource<int64_t> *>(rsrc.get());
+	ASSERT_TRUE(sparse);
+
+	std::vector<int64_t> values(4);
+	sparse->CopyToDense(reinterpret_cast<char *>(values.data()));
+	EXPECT_EQ(values, std::vector<int64_t>({0, -7, 9, 0}));
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeWithMemoryResource)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	PoolMemoryResource pool;
+
+	SparseResource resource(2, 2, std::vector<int>({0, 1, 2, 0}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	deserializer->RegisterResource<int>(RESOURCE_KEY, ALLOCATING_SPARSE_RESOURCE_CONSTRUCTOR);
+
+	// staging buffers are returned to the pool, and the payload is allocated from it
+	{
+		std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT, &pool);
+		auto sparse = dynamic_cast<SparseResource *>(rsrc.get());
+		ASSERT_TRUE(sparse);
+		EXPECT_EQ(sparse->GetMemoryResource(), &pool);
+		EXPECT_EQ(sparse->GetNonZeroCount(), size_t(2));
+		EXPECT_GT(pool.GetPooledBytes(), size_t(0));
+	}
+	const size_t pooled = pool.GetPooledBytes();
+
+	// a second load reuses the pooled blocks
+	{
+		std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT, &pool);
+		EXPECT_LT(pool.GetPooledBytes(), pooled);
+	}
+	EXPECT_EQ(pool.GetPooledBytes(), pooled);
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	deserializer->UnregisterAll();
+}
+
 TEST(ResourceDeserializer, DeserializeEmptyArrayResource)
 {
 	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
@@ -293,6 +662,95 @@ TEST(ResourceDeserializer, DeserializeThrowsWithBadSerializationPath)
 	deserializer->UnregisterAll();
 }
 
+TEST(ResourceDeserializer, DeserializeThrowsOnTruncatedFile)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+
+	// empty and partial headers
+	for (const std::string &bytes : {std::string(), std::string("AZRESBIN\x02", 9)})
+	{
+		std::ofstream(RESOURCE_FILE.string(), std::ios::binary) << bytes;
+		EXPECT_THROW(deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT), std::runtime_error);
+	}
+
+	// clean up
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeThrowsOnCorruptPayload)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+
+	Resource resource(std::vector<int>({1, 2, 3, 4}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	const ResourceHeader header = deserializer->ReadHeader(RESOURCE_KEY, RESOURCE_ROOT);
+	ASSERT_TRUE(header.HasChecksum());
+	EXPECT_EQ(header.GetSize() % ResourceHeader::ALIGNMENT, size_t(0));
+
+	// flip a bit of the payload
+	{
+		std::fstream file(RESOURCE_FILE.string(), std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(static_cast<std::streamoff>(header.GetSize() + 5));
+		file.put('\x7f');
+	}
+	EXPECT_THROW(deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT), std::runtime_error);
+
+	// clean up
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeFramed)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+
+	std::vector<int> values(1000);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = static_cast<int>(i % 10);
+
+	// uncompressed files have no frames
+	Resource plain(values);
+	serializer->Serialize(plain.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_THROW(deserializer->DeserializeFrame(RESOURCE_KEY, RESOURCE_ROOT, 0), std::runtime_error);
+
+	Resource resource(values);
+	serializer->SetCodec(RESOURCE_KEY, Codec(CodecType::Zlib));
+	serializer->SetFrameSize(256);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_EQ(deserializer->ReadHeader(RESOURCE_KEY, RESOURCE_ROOT).GetFrameCount(), size_t(16));
+
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	ASSERT_EQ(rsrc->GetRowSize(), values.size());
+	EXPECT_EQ(std::memcmp(rsrc->Data(), values.data(), values.size() * sizeof(int)), 0);
+
+	// a single frame, including the short last one
+	std::vector<char> frame = deserializer->DeserializeFrame(RESOURCE_KEY, RESOURCE_ROOT, 1);
+	ASSERT_EQ(frame.size(), size_t(256));
+	EXPECT_EQ(std::memcmp(frame.data(), values.data() + 64, frame.size()), 0);
+	frame = deserializer->DeserializeFrame(RESOURCE_KEY, RESOURCE_ROOT, 15);
+	ASSERT_EQ(frame.size(), size_t(160));
+	EXPECT_EQ(std::memcmp(frame.data(), values.data() + 960, frame.size()), 0);
+	EXPECT_THROW(deserializer->DeserializeFrame(RESOURCE_KEY, RESOURCE_ROOT, 16), std::runtime_error);
+
+	// clean up
+	serializer->SetFrameSize(ResourceSerializer::FRAME_SIZE);
+	serializer->SetCodec(RESOURCE_KEY, Codec(CodecType::None));
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	deserializer->UnregisterAll();
+}
+
 TEST(ResourceDeserializer, DeserializeThrowsWithEmptyKey)
 {
 	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
@@ -349,3 +807,117 @@ TEST(ResourceDeserializer, DeserializeWhileSerializing)
 	// wait for OS to catch up
 	std::this_thread::sleep_for(std::chrono::milliseconds(1000));
 }
+
+TEST(ResourceDeserializer, DeserializeConcurrently)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	// resources in different files are written and read by many threads at once
+	const int threadCount = 8;
+	const int runCount = 20;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t)
+		threads.push_back(std::thread(
+			[serializer, deserializer, t, runCount]()
+			{
+				const std::string key = RESOURCE_KEY + std::to_string(t);
+				deserializer->RegisterResource<int>(key, RESOURCE_CONSTRUCTOR);
+				for (int i = 0; i < runCount; ++i)
+				{
+					Resource resource(std::vector<int>(64, t * runCount + i));
+					serializer->Serialize(resource.Lock(), key, RESOURCE_ROOT);
+
+					std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(key, RESOURCE_ROOT);
+					EXPECT_EQ(rsrc->GetRowSize(), size_t(64));
+					EXPECT_EQ(static_cast<int *>(rsrc->Data())[63], t * runCount + i);
+				}
+				serializer->Unserialize(key, RESOURCE_ROOT);
+				deserializer->UnregisterResource(key);
+			}));
+
+	for (auto &th : threads)
+		th.join();
+
+	for (int t = 0; t < threadCount; ++t)
+		EXPECT_FALSE(fs::exists(fs::path(RESOURCE_ROOT) / (RESOURCE_KEY + std::to_string(t) + ".bin")));
+	EXPECT_FALSE(deserializer->HasSerializationKey(RESOURCE_KEY + "0"));
+}
+
+TEST(ResourceDeserializer, DeserializePacked)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	deserializer->RegisterResource<int>(RESOURCE_KEY, RESOURCE_CONSTRUCTOR);
+	deserializer->RegisterResource<int>(RESOURCE_KEY + "2D", RESOURCE_2D_CONSTRUCTOR);
+
+	const fs::path packDir = fs::path(RESOURCE_ROOT) / "pack";
+	fs::remove_all(packDir);
+	{
+		PackFile pack(packDir.string());
+		Resource resource(std::vector<int>({1, 2, 3}));
+		Resource2D resource2D(std::vector<std::vector<int>>({{1, 2}, {3, 4}}));
+		serializer->Serialize(resource.Lock(), RESOURCE_KEY, pack);
+		serializer->Serialize(resource2D.Lock(), RESOURCE_KEY + "2D", pack);
+		EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	}
+
+	PackFile pack(packDir.string());
+	std::unique_ptr<ISerializableResource> rsrc = deserializer->Deserialize(RESOURCE_KEY, pack);
+	EXPECT_EQ(rsrc->GetRowSize(), size_t(3));
+	EXPECT_EQ(static_cast<int *>(rsrc->Data())[2], 3);
+
+	std::unique_ptr<ISerializableResource> rsrc2D = deserializer->Deserialize(RESOURCE_KEY + "2D", pack);
+	EXPECT_EQ(rsrc2D->GetShape(), std::vector<size_t>({2, 2}));
+	EXPECT_EQ(static_cast<int *>(rsrc2D->Data())[3], 4);
+
+	serializer->Unserialize(RESOURCE_KEY, pack);
+	EXPECT_THROW(deserializer->Deserialize(RESOURCE_KEY, pack), std::runtime_error);
+	EXPECT_THROW(deserializer->Deserialize("", pack), std::runtime_error);
+
+	// clean up
+	fs::remove_all(packDir);
+	deserializer->UnregisterAll();
+}
+
+TEST(ResourceDeserializer, DeserializeBatch)
+{
+	ResourceDeserializer *deserializer = ResourceDeserializer::GetInstance();
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	std::vector<std::string> keys;
+	for (int i = 0; i < 4; ++i)
+	{
+		keys.push_back(RESOURCE_KEY + std::to_string(i));
+		deserializer->RegisterResource<int>(keys.back(), RESOURCE_CONSTRUCTOR);
+		Resource resource(std::vector<int>(32, i));
+		serializer->Serialize(resource.Lock(), keys.back(), RESOURCE_ROOT);
+	}
+
+	// a file with deltas is rebuilt from them
+	serializer->SetDeltaChainLength(4);
+	Resource resource(std::vector<int>(32, 2));
+	resource.Lock().Assign(reinterpret_cast<const char *>(std::vector<int>(32, 7).data()), 32 * sizeof(int));
+	serializer->Serialize(resource.Lock(), keys[2], RESOURCE_ROOT);
+
+	std::vector<std::unique_ptr<ISerializableResource>> rsrcs = deserializer->DeserializeBatch(keys, RESOURCE_ROOT);
+	ASSERT_EQ(rsrcs.size(), keys.size());
+	for (int i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(rsrcs[i]->GetRowSize(), size_t(32));
+		EXPECT_EQ(static_cast<int *>(rsrcs[i]->Data())[31], i == 2 ? 7 : i);
+	}
+
+	EXPECT_THROW(deserializer->DeserializeBatch(std::vector<std::string>{""}, RESOURCE_ROOT), std::runtime_error);
+	EXPECT_THROW(deserializer->DeserializeBatch(keys, ""), std::runtime_error);
+
+	// clean up
+	serializer->SetDeltaChainLength(0);
+	for (const std::string &key : keys)
+		serializer->Unserialize(key, RESOURCE_ROOT);
+
+	// a missing file fails the batch
+	EXPECT_THROW(deserializer->DeserializeBatch(keys, RESOURCE_ROOT), std::runtime_error);
+
+	deserializer->UnregisterAll();
+}
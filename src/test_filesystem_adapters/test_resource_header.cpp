@@ -0,0 +1,231 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "FilesystemAdapters/ResourceHeader.h"
+#include "Resources/Codec.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/IResource.h"
+#include "Resources/Layout.h"
+#include "Resources/ZoneMap.h"
+
+using filesystem_adapters::ResourceHeader;
+using resource::CodecType;
+using resource::DataType;
+using resource::IResource;
+using resource::Layout;
+using resource::Quantization;
+using resource::ZoneMap;
+
+namespace
+{
+	const std::vector<size_t> SHAPE = {2, 4, 6};
+	const Layout TILED = Layout::Tiled({1, 2, 3});
+
+	std::string Write(const ResourceHeader &header)
+	{
+		std::ostringstream outStream(std::ios::binary);
+		header.Write(outStream);
+		return outStream.str();
+	}
+} // end namespace
+
+TEST(ResourceHeader, Construct)
+{
+	ResourceHeader header;
+	EXPECT_EQ(header.GetShape(), std::vector<size_t>({0, 0}));
+	EXPECT_EQ(header.GetLayout(), Layout::RowMajor());
+	EXPECT_EQ(header.GetElementCount(), size_t(0));
+	EXPECT_EQ(header.GetDataType(), DataType::Unknown);
+	EXPECT_EQ(header.GetVersion(), uint32_t(3));
+	EXPECT_FALSE(header.HasChecksum());
+}
+
+TEST(ResourceHeader, ConstructThrows)
+{
+	EXPECT_THROW(ResourceHeader(std::vector<size_t>()), std::runtime_error);
+	EXPECT_THROW(ResourceHeader(SHAPE, Layout::Tiled({2, 2})), std::runtime_error);
+}
+
+TEST(ResourceHeader, Write)
+{
+	const ResourceHeader header(SHAPE, TILED);
+	const std::string bytes = Write(header);
+	EXPECT_EQ(bytes.size(), header.GetSize());
+	EXPECT_EQ(bytes.substr(0, 8), "AZRESBIN");
+	EXPECT_EQ(header.GetSize() % ResourceHeader::ALIGNMENT, size_t(0));
+}
+
+TEST(ResourceHeader, Read)
+{
+	std::istringstream inStream(Write(ResourceHeader(SHAPE, TILED)) + "payload", std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inStream);
+	EXPECT_EQ(header.GetShape(), SHAPE);
+	EXPECT_EQ(header.GetLayout(), TILED);
+	EXPECT_EQ(header.GetElementCount(), size_t(48));
+
+	std::string payload;
+	inStream >> payload;
+	EXPECT_EQ(payload, "payload");
+}
+
+TEST(ResourceHeader, ReadDataType)
+{
+	std::istringstream inStream(Write(ResourceHeader(SHAPE, Layout(), DataType::Float64)), std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inStream);
+	EXPECT_EQ(header.GetDataType(), DataType::Float64);
+	EXPECT_EQ(header.GetSize() % sizeof(size_t), size_t(0));
+}
+
+TEST(ResourceHeader, ReadZoneMap)
+{
+	const std::vector<float> values = {1.0f, -4.0f, 2.5f, 8.0f, 0.0f, 3.0f};
+	ResourceHeader written({2, 3}, Layout(), DataType::Float32);
+	EXPECT_FALSE(written.HasZoneMap());
+	EXPECT_THROW(written.GetZoneMap(), std::runtime_error);
+
+	const size_t plainSize = written.GetSize();
+	const ZoneMap zoneMap = ZoneMap::Build(values.data(), DataType::Float32, values.size(), 4);
+	written.SetZoneMap(zoneMap);
+	EXPECT_GT(written.GetSize(), plainSize);
+	EXPECT_EQ(written.GetSize() % ResourceHeader::ALIGNMENT, size_t(0));
+
+	std::istringstream inStream(Write(written) + "payload", std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inStream);
+	EXPECT_EQ(header.GetSize(), written.GetSize());
+	ASSERT_TRUE(header.HasZoneMap());
+	EXPECT_EQ(header.GetZoneMap().GetTotal(), zoneMap.GetTotal());
+	EXPECT_EQ(header.GetZoneMap().GetBlockCount(), size_t(2));
+
+	std::string payload;
+	inStream >> payload;
+	EXPECT_EQ(payload, "payload");
+}
+
+TEST(ResourceHeader, ReadQuantization)
+{
+	ResourceHeader written({2, 3}, Layout(), DataType::Int8);
+	EXPECT_FALSE(written.IsQuantized());
+	EXPECT_THROW(written.GetQuantization(), std::runtime_error);
+
+	const size_t plainSize = written.GetSize();
+	written.SetQuantization(Quantization{0.5, -3.0});
+	EXPECT_GE(written.GetSize(), plainSize);
+	EXPECT_EQ(written.GetSize() % ResourceHeader::ALIGNMENT, size_t(0));
+	const std::vector<float> values(6, 1.0f);
+	written.SetZoneMap(ZoneMap::Build(values.data(), DataType::Float32, values.size(), 4));
+
+	std::istringstream inStream(Write(written) + "payload", std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inStream);
+	EXPECT_EQ(header.GetSize(), written.GetSize());
+	EXPECT_EQ(header.GetDataType(), DataType::Int8);
+	ASSERT_TRUE(header.IsQuantized());
+	EXPECT_EQ(header.GetQuantization().scale, 0.5);
+	EXPECT_EQ(header.GetQuantization().offset, -3.0);
+	ASSERT_TRUE(header.HasZoneMap());
+	EXPECT_EQ(header.GetZoneMap().GetBlockCount(), size_t(2));
+
+	std::string payload;
+	inStream >> payload;
+	EXPECT_EQ(payload, "payload");
+}
+
+TEST(ResourceHeader, ReadChecksum)
+{
+	const std::string payload = "payload";
+	ResourceHeader written(SHAPE, Layout(), DataType::Int8);
+	EXPECT_THROW(written.GetChecksum(), std::runtime_error);
+	written.SetChecksum(IResource::Crc32(payload.data(), payload.size()));
+
+	const std::string bytes = Write(written);
+	const ResourceHeader header = ResourceHeader::Read(bytes.data(), bytes.size());
+	ASSERT_TRUE(header.HasChecksum());
+	EXPECT_EQ(header.GetChecksum(), written.GetChecksum());
+	EXPECT_TRUE(header.MatchesChecksum(payload.data(), payload.size()));
+	EXPECT_FALSE(header.MatchesChecksum("paylaod", payload.size()));
+
+	// checksums continue across buffers
+	EXPECT_EQ(IResource::Crc32(payload.data() + 3, 4, IResource::Crc32(payload.data(), 3)), header.GetChecksum());
+
+	ResourceHeader cleared = header;
+	cleared.ClearChecksum();
+	EXPECT_TRUE(cleared.MatchesChecksum("paylaod", payload.size()));
+}
+
+TEST(ResourceHeader, ReadFrames)
+{
+	ResourceHeader written(SHAPE, Layout(), DataType::Int8);
+	EXPECT_FALSE(written.IsCompressed());
+	const size_t size = written.GetSize();
+	EXPECT_THROW(written.SetFrames(CodecType::None, 16, 48, {0, 10, 20, 25}), std::runtime_error);
+	EXPECT_THROW(written.SetFrames(CodecType::Zlib, 16, 48, {0, 10, 20}), std::runtime_error);
+	written.SetFrames(CodecType::Zlib, 16, 48, {0, 10, 20, 25});
+	EXPECT_GT(written.GetSize(), size);
+	EXPECT_EQ(written.GetSize() % ResourceHeader::ALIGNMENT, size_t(0));
+
+	const std::string bytes = Write(written);
+	EXPECT_EQ(bytes.size(), written.GetSize());
+	const ResourceHeader header = ResourceHeader::Read(bytes.data(), bytes.size());
+	ASSERT_TRUE(header.IsCompressed());
+	EXPECT_EQ(header.GetCodecType(), CodecType::Zlib);
+	EXPECT_EQ(header.GetFrameSize(), size_t(16));
+	EXPECT_EQ(header.GetRawSize(), size_t(48));
+	EXPECT_EQ(header.GetFrameCount(), size_t(3));
+	EXPECT_EQ(header.GetFrameOffsets(), std::vector<uint64_t>({0, 10, 20, 25}));
+	EXPECT_EQ(header.GetShape(), written.GetShape());
+}
+
+TEST(ResourceHeader, ReadThrowsOnByteOrder)
+{
+	std::string bytes = Write(ResourceHeader(SHAPE));
+	std::reverse(bytes.begin() + 8, bytes.begin() + 12);
+	EXPECT_THROW(ResourceHeader::Read(bytes.data(), bytes.size()), std::runtime_error);
+}
+
+TEST(ResourceHeader, ReadBuffer)
+{
+	const std::string bytes = Write(ResourceHeader(SHAPE, Layout::ColumnMajor()));
+	const ResourceHeader header = ResourceHeader::Read(bytes.data(), bytes.size());
+	EXPECT_EQ(header.GetShape(), SHAPE);
+	EXPECT_EQ(header.GetLayout(), Layout::ColumnMajor());
+	EXPECT_EQ(header.GetSize(), bytes.size());
+}
+
+TEST(ResourceHeader, ReadLegacy)
+{
+	const size_t legacy[2] = {3, 5};
+	std::istringstream inStream(std::string(reinterpret_cast<const char *>(legacy), sizeof(legacy)), std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inStream);
+	EXPECT_EQ(header.GetVersion(), uint32_t(0));
+	EXPECT_EQ(header.GetSize(), sizeof(legacy));
+	EXPECT_EQ(header.GetShape(), std::vector<size_t>({3, 5}));
+	EXPECT_EQ(header.GetLayout(), Layout::RowMajor());
+}
+
+TEST(ResourceHeader, ReadThrows)
+{
+	const std::string bytes = Write(ResourceHeader(SHAPE, TILED));
+
+	// truncated
+	EXPECT_THROW(ResourceHeader::Read(bytes.data(), bytes.size() - 1), std::runtime_error);
+	std::istringstream inStream(bytes.substr(0, bytes.size() - 1), std::ios::binary);
+	EXPECT_THROW(ResourceHeader::Read(inStream), std::runtime_error);
+	EXPECT_THROW(ResourceHeader::Read(bytes.data(), 4), std::runtime_error);
+
+	// unsupported versions
+	for (const uint32_t version : {uint32_t(1), uint32_t(2), uint32_t(99)})
+	{
+		std::string other = bytes;
+		std::memcpy(other.data() + 8, &version, sizeof(version));
+		EXPECT_THROW(ResourceHeader::Read(other.data(), other.size()), std::runtime_error);
+	}
+}
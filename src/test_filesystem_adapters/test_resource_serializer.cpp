@@ -1,5 +1,10 @@
 #include "test_filesystem_adapters/config.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -9,19 +14,53 @@
 
 #include "test_filesystem_adapters/ContainerResource.h"
 #include "test_filesystem_adapters/ContainerResource2D.h"
+#include "test_filesystem_adapters/SparseContainerResource.h"
+#include "FilesystemAdapters/DeltaLog.h"
+#include "FilesystemAdapters/Journal.h"
+#include "FilesystemAdapters/ResourceHeader.h"
 #include "FilesystemAdapters/ResourceSerializer.h"
+#include "Resources/Codec.h"
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceStats.h"
+#include "Resources/ResourceView.h"
 
+using filesystem_adapters::DeltaLog;
+using filesystem_adapters::Journal;
+using filesystem_adapters::ResourceHeader;
 using filesystem_adapters::ResourceSerializer;
+using resource::Codec;
+using resource::CodecType;
+using resource::DataType;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::ResourceStats;
+using resource::ResourceView;
 using Resource = ContainerResource<int>;
 using Resource2D = ContainerResource2D<int>;
+using SparseResource = SparseContainerResource<int>;
 
 namespace
 {
 	const std::string RESOURCE_ROOT = (fs::path(ROOT_FILESYSTEM) / TEST_DIRECTORY).string();
 	const std::string RESOURCE_KEY = "resource";
 	const fs::path RESOURCE_FILE = fs::path(RESOURCE_ROOT) / (RESOURCE_KEY + ".bin");
+	const fs::path DELTA_FILE = fs::path(RESOURCE_ROOT) / (RESOURCE_KEY + ".delta");
 	const std::vector<std::vector<int>> INT_VALUES(1, std::vector<int>(1, 1));
 	const std::vector<int> INT_VALUES_ARRAY(1, 1);
+	const std::vector<std::vector<int>> INT_MATRIX = {{1, 2, 3}, {4, 5, 6}};
+
+	std::vector<int> ReadResourceFile(size_t &M, size_t &N)
+	{
+		std::ifstream inFile(RESOURCE_FILE.string(), std::ios::binary);
+		const ResourceHeader header = ResourceHeader::Read(inFile);
+		M = header.GetShape()[0];
+		N = header.GetShape()[1];
+		std::vector<int> values(M * N);
+		inFile.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(int));
+		return values;
+	}
 } // end namespace
 
 TEST(ResourceSerializer, GetInstance)
@@ -63,6 +102,487 @@ TEST(ResourceSerializer, SerializeMatrix)
 	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
 }
 
+TEST(ResourceSerializer, SerializeView)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	// serialize the second column of the matrix without copying it
+	Resource2D resource(INT_MATRIX);
+	{
+		auto lock = resource.Lock();
+		EXPECT_NO_THROW(serializer->Serialize(ResourceView(resource).Column(1), RESOURCE_KEY, RESOURCE_ROOT));
+	}
+
+	// verify serialization and clean up
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+	size_t M = 0;
+	size_t N = 0;
+	std::vector<int> values = ReadResourceFile(M, N);
+	EXPECT_EQ(M, size_t(2));
+	EXPECT_EQ(N, size_t(1));
+	EXPECT_EQ(values, std::vector<int>({2, 5}));
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeViewRowBlock)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	Resource2D resource(INT_MATRIX);
+	{
+		auto lock = resource.Lock();
+		EXPECT_NO_THROW(serializer->Serialize(ResourceView(resource).Rows(1, 1), RESOURCE_KEY, RESOURCE_ROOT));
+	}
+
+	size_t M = 0;
+	size_t N = 0;
+	std::vector<int> values = ReadResourceFile(M, N);
+	EXPECT_EQ(M, size_t(1));
+	EXPECT_EQ(N, size_t(3));
+	EXPECT_EQ(values, INT_MATRIX[1]);
+	fs::remove(RESOURCE_FILE);
+}
+
+TEST(ResourceSerializer, SerializeSparse)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	SparseResource resource(2, 3, std::vector<int>({0, 7, 0, 0, 0, 9}));
+	EXPECT_NO_THROW(serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT));
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+
+	// header, non-zero count, row offsets, column indices, then only the non-zero values
+	const size_t headerSize = ResourceHeader({2, 3}).GetSize();
+	EXPECT_EQ(fs::file_size(RESOURCE_FILE), headerSize + (1 + 3 + 2) * sizeof(size_t) + 2 * sizeof(int));
+
+	std::ifstream inFile(RESOURCE_FILE.string(), std::ios::binary);
+	EXPECT_EQ(ResourceHeader::Read(inFile).GetShape(), std::vector<size_t>({2, 3}));
+	std::vector<size_t> sparse(6);
+	inFile.read(reinterpret_cast<char *>(sparse.data()), sparse.size() * sizeof(size_t));
+	EXPECT_EQ(sparse, std::vector<size_t>({2, 0, 1, 2, 1, 2}));
+	std::vector<int> values(2);
+	inFile.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(int));
+	EXPECT_EQ(values, std::vector<int>({7, 9}));
+	inFile.close();
+
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeSnapshot)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	Resource2D resource(INT_MATRIX);
+	auto snapshot = resource.CopySnapshot();
+
+	// the resource can be written while the snapshot is serialized
+	const std::vector<int> zeros(6, 0);
+	resource.Lock().Assign(reinterpret_cast<const char *>(zeros.data()), zeros.size() * sizeof(int));
+	EXPECT_NO_THROW(serializer->Serialize(*snapshot, RESOURCE_KEY, RESOURCE_ROOT));
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+
+	size_t M = 0;
+	size_t N = 0;
+	EXPECT_EQ(ReadResourceFile(M, N), std::vector<int>({1, 2, 3, 4, 5, 6}));
+	EXPECT_EQ(M, size_t(2));
+	EXPECT_EQ(N, size_t(3));
+
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeSparseSnapshot)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	SparseResource resource(2, 3, std::vector<int>({0, 7, 0, 0, 0, 9}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	std::ifstream lockedFile(RESOURCE_FILE.string(), std::ios::binary);
+	const std::string locked((std::istreambuf_iterator<char>(lockedFile)), std::istreambuf_iterator<char>());
+	lockedFile.close();
+
+	// a snapshot writes the same bytes as the locked resource
+	serializer->Serialize(*resource.CopySnapshot(), RESOURCE_KEY, RESOURCE_ROOT);
+	std::ifstream snapshotFile(RESOURCE_FILE.string(), std::ios::binary);
+	const std::string snapshot((std::istreambuf_iterator<char>(snapshotFile)), std::istreambuf_iterator<char>());
+	snapshotFile.close();
+	EXPECT_EQ(snapshot, locked);
+
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeZoneMap)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetZoneMapBlockSize(4);
+	EXPECT_EQ(serializer->GetZoneMapBlockSize(), size_t(4));
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	Resource2D resource(INT_MATRIX);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	// the payload still follows the header
+	size_t M = 0;
+	size_t N = 0;
+	EXPECT_EQ(ReadResourceFile(M, N), std::vector<int>({1, 2, 3, 4, 5, 6}));
+
+	std::ifstream inFile(RESOURCE_FILE.string(), std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inFile);
+	inFile.close();
+	ASSERT_TRUE(header.HasZoneMap());
+	EXPECT_EQ(header.GetZoneMap().GetBlockCount(), size_t(2));
+	EXPECT_EQ(header.GetZoneMap().GetTotal(), ResourceStats(1.0, 6.0, 21.0, 6, 0));
+	EXPECT_EQ(header.GetZoneMap().FindBlocks(5.5, 9.0), std::vector<size_t>({1}));
+
+	// snapshots are written with one as well
+	fs::remove(RESOURCE_FILE);
+	serializer->Serialize(*resource.CopySnapshot(), RESOURCE_KEY, RESOURCE_ROOT);
+	inFile.open(RESOURCE_FILE.string(), std::ios::binary);
+	EXPECT_TRUE(ResourceHeader::Read(inFile).HasZoneMap());
+	inFile.close();
+
+	serializer->SetZoneMapBlockSize(0);
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeEncoded)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	EXPECT_EQ(serializer->GetEncoding(RESOURCE_KEY).GetType(), EncodingType::None);
+	serializer->SetEncoding(RESOURCE_KEY, Encoding(EncodingType::Int8));
+	EXPECT_EQ(serializer->GetEncoding(RESOURCE_KEY).GetType(), EncodingType::Int8);
+	EXPECT_EQ(serializer->GetEncoding("other").GetType(), EncodingType::None);
+	serializer->SetZoneMapBlockSize(4);
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	ContainerResource<float> resource(std::vector<size_t>({4, 8}), std::vector<float>(32, 0.5f));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	// one byte per element, with the scale and offset in the header and the zone map of the original values
+	std::ifstream inFile(RESOURCE_FILE.string(), std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inFile);
+	inFile.close();
+	EXPECT_EQ(header.GetDataType(), DataType::Int8);
+	EXPECT_TRUE(header.IsQuantized());
+	ASSERT_TRUE(header.HasZoneMap());
+	EXPECT_EQ(header.GetZoneMap().GetTotal(), ResourceStats(0.5, 0.5, 16.0, 32, 0));
+	EXPECT_EQ(fs::file_size(RESOURCE_FILE), header.GetSize() + 32);
+
+	// integer resources are written as they are
+	fs::remove(RESOURCE_FILE);
+	Resource2D integers(INT_MATRIX);
+	serializer->Serialize(integers.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	size_t M = 0;
+	size_t N = 0;
+	EXPECT_EQ(ReadResourceFile(M, N), std::vector<int>({1, 2, 3, 4, 5, 6}));
+
+	serializer->SetZoneMapBlockSize(0);
+	serializer->SetEncoding(RESOURCE_KEY, Encoding());
+	EXPECT_EQ(serializer->GetEncoding(RESOURCE_KEY).GetType(), EncodingType::None);
+	EXPECT_THROW(serializer->SetEncoding("", Encoding(EncodingType::Float16)), std::runtime_error);
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeCompressed)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	EXPECT_EQ(serializer->GetCodec(RESOURCE_KEY).GetType(), CodecType::None);
+	serializer->SetCodec(RESOURCE_KEY, Codec(CodecType::Zlib));
+	EXPECT_EQ(serializer->GetCodec(RESOURCE_KEY).GetType(), CodecType::Zlib);
+	EXPECT_EQ(serializer->GetCodec("other").GetType(), CodecType::None);
+	EXPECT_EQ(serializer->GetFrameSize(), ResourceSerializer::FRAME_SIZE);
+	serializer->SetFrameSize(1000);
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	Resource resource(std::vector<int>(1024, 7));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	// 4096 bytes in frames of 1000, each compressed on its own
+	std::ifstream inFile(RESOURCE_FILE.string(), std::ios::binary);
+	const ResourceHeader header = ResourceHeader::Read(inFile);
+	inFile.close();
+	ASSERT_TRUE(header.IsCompressed());
+	EXPECT_EQ(header.GetCodecType(), CodecType::Zlib);
+	EXPECT_EQ(header.GetRawSize(), size_t(4096));
+	EXPECT_EQ(header.GetFrameCount(), size_t(5));
+	EXPECT_TRUE(header.HasChecksum());
+	EXPECT_EQ(fs::file_size(RESOURCE_FILE), header.GetSize() + header.GetFrameOffsets().back());
+	EXPECT_LT(header.GetFrameOffsets().back(), header.GetRawSize());
+
+	EXPECT_THROW(serializer->SetFrameSize(0), std::runtime_error);
+	EXPECT_THROW(serializer->SetCodec("", Codec(CodecType::Zlib)), std::runtime_error);
+	serializer->SetFrameSize(ResourceSerializer::FRAME_SIZE);
+	serializer->SetCodec(RESOURCE_KEY, Codec(CodecType::None));
+	EXPECT_EQ(serializer->GetCodec(RESOURCE_KEY).GetType(), CodecType::None);
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeSparseWithoutZoneMap)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetZoneMapBlockSize(4);
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	SparseResource resource(2, 3, std::vector<int>({0, 7, 0, 0, 0, 9}));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+
+	std::ifstream inFile(RESOURCE_FILE.string(), std::ios::binary);
+	EXPECT_FALSE(ResourceHeader::Read(inFile).HasZoneMap());
+	inFile.close();
+
+	serializer->SetZoneMapBlockSize(0);
+	fs::remove(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, SerializeDelta)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetDeltaChainLength(2);
+	EXPECT_EQ(serializer->GetDeltaChainLength(), size_t(2));
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	std::vector<int> values(256, 7);
+	Resource resource(values);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	const auto baseSize = fs::file_size(RESOURCE_FILE);
+	EXPECT_FALSE(fs::exists(DELTA_FILE));
+
+	// small changes are appended to the log and leave the base image alone
+	for (int version = 1; version <= 2; ++version)
+	{
+		values[version * 10] = -version;
+		resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+		serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+		EXPECT_EQ(DeltaLog(RESOURCE_FILE.string()).GetLength(), size_t(version));
+		EXPECT_EQ(fs::file_size(RESOURCE_FILE), baseSize);
+	}
+	EXPECT_LT(fs::file_size(DELTA_FILE), baseSize);
+
+	const std::vector<char> image = DeltaLog(RESOURCE_FILE.string()).ReadImage();
+	const ResourceHeader header = ResourceHeader::Read(image.data(), image.size());
+	const int *payload = reinterpret_cast<const int *>(image.data() + header.GetSize());
+	EXPECT_EQ(std::vector<int>(payload, payload + values.size()), values);
+
+	// a full chain starts over with a new base image
+	values[30] = -3;
+	resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(DELTA_FILE));
+	size_t M = 0;
+	size_t N = 0;
+	EXPECT_EQ(ReadResourceFile(M, N), values);
+
+	// so does a change to most of the payload
+	values[40] = -4;
+	resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_TRUE(fs::exists(DELTA_FILE));
+	const std::vector<int> changed(256, 1);
+	resource.Lock().Assign(reinterpret_cast<const char *>(changed.data()), changed.size() * sizeof(int));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(DELTA_FILE));
+	EXPECT_EQ(ReadResourceFile(M, N), changed);
+
+	serializer->SetDeltaChainLength(0);
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+}
+
+TEST(ResourceSerializer, UnserializeRemovesDeltas)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	serializer->SetDeltaChainLength(2);
+
+	std::vector<int> values(64, 7);
+	Resource resource(values);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	values[0] = 0;
+	resource.Lock().Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_TRUE(fs::exists(DELTA_FILE));
+
+	serializer->SetDeltaChainLength(0);
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	EXPECT_FALSE(fs::exists(DELTA_FILE));
+}
+
+TEST(ResourceSerializer, SerializeJournaled)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+	const fs::path journalFile = fs::path(RESOURCE_ROOT) / "resources.wal";
+	const fs::path journalCopy = fs::path(RESOURCE_ROOT) / "copy.wal";
+	fs::remove(journalFile);
+	fs::remove(journalCopy);
+
+	EXPECT_FALSE(serializer->GetJournal());
+	auto journal = std::make_shared<Journal>(journalFile.string());
+	serializer->SetJournal(journal);
+	EXPECT_EQ(serializer->GetJournal(), journal);
+
+	Resource2D resource(INT_MATRIX);
+	serializer->Serialize(resource.Lock(), RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_TRUE(fs::exists(RESOURCE_FILE));
+	EXPECT_EQ(journal->GetCommitCount(), size_t(1));
+	EXPECT_GT(journal->GetSize(), fs::file_size(RESOURCE_FILE));
+
+	// a crash that loses the unsynced file is repaired from the journal
+	fs::copy_file(journalFile, journalCopy);
+	serializer->SetJournal(nullptr);
+	journal.reset();
+	fs::remove(RESOURCE_FILE);
+	fs::remove(journalFile);
+	fs::rename(journalCopy, journalFile);
+	journal = std::make_shared<Journal>(journalFile.string());
+	EXPECT_EQ(journal->GetRecoveredCount(), size_t(1));
+	size_t M = 0;
+	size_t N = 0;
+	EXPECT_EQ(ReadResourceFile(M, N), std::vector<int>({1, 2, 3, 4, 5, 6}));
+
+	serializer->SetJournal(journal);
+	serializer->Unserialize(RESOURCE_KEY, RESOURCE_ROOT);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	EXPECT_EQ(journal->GetCommitCount(), size_t(1));
+	journal->Checkpoint();
+	EXPECT_EQ(fs::file_size(journalFile), size_t(8));
+
+	serializer->SetJournal(nullptr);
+	journal.reset();
+	fs::remove(journalFile);
+}
+
+TEST(ResourceSerializer, SerializeBatch)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	// resources in two directories, one of which does not exist yet
+	const std::string nestedRoot = (fs::path(RESOURCE_ROOT) / "batch").string();
+	std::vector<Resource> resources;
+	for (int i = 0; i < 6; ++i)
+		resources.push_back(Resource(std::vector<int>(8, i)));
+
+	std::vector<ResourceSerializer::BatchItem> items;
+	for (size_t i = 0; i < resources.size(); ++i)
+		items.push_back({&resources[i], RESOURCE_KEY + std::to_string(i), i % 2 == 0 ? RESOURCE_ROOT : nestedRoot});
+	items.push_back({&resources[0], "", RESOURCE_ROOT});
+	items.push_back({nullptr, RESOURCE_KEY, RESOURCE_ROOT});
+
+	std::vector<ResourceSerializer::BatchResult> results = serializer->SerializeBatch(items, 3);
+	ASSERT_EQ(results.size(), items.size());
+	for (size_t i = 0; i < resources.size(); ++i)
+	{
+		EXPECT_EQ(results[i].status, ResourceSerializer::BatchStatus::Written);
+		EXPECT_TRUE(results[i].error.empty());
+		EXPECT_TRUE(fs::exists(fs::path(items[i].serializationPath) / (items[i].key + ".bin")));
+	}
+	EXPECT_EQ(results[6].status, ResourceSerializer::BatchStatus::Failed);
+	EXPECT_FALSE(results[6].error.empty());
+	EXPECT_EQ(results[7].status, ResourceSerializer::BatchStatus::Failed);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	// unchanged resources are not written again
+	items.resize(resources.size());
+	results = serializer->SerializeBatch(items);
+	for (const ResourceSerializer::BatchResult &result : results)
+		EXPECT_EQ(result.status, ResourceSerializer::BatchStatus::Unchanged);
+	EXPECT_TRUE(serializer->SerializeBatch({}).empty());
+
+	// a resource listed more than once is hashed once, and every one of its items is written
+	Resource shared(std::vector<int>(8, 7));
+	std::vector<ResourceSerializer::BatchItem> sharedItems;
+	sharedItems.push_back({&shared, RESOURCE_KEY + "shared", RESOURCE_ROOT});
+	sharedItems.push_back({&shared, RESOURCE_KEY + "shared", nestedRoot});
+	sharedItems.push_back({&shared, RESOURCE_KEY + "sharedCopy", RESOURCE_ROOT});
+	results = serializer->SerializeBatch(sharedItems, 4);
+	ASSERT_EQ(results.size(), sharedItems.size());
+	for (size_t i = 0; i < sharedItems.size(); ++i)
+	{
+		EXPECT_EQ(results[i].status, ResourceSerializer::BatchStatus::Written);
+		EXPECT_TRUE(fs::exists(fs::path(sharedItems[i].serializationPath) / (sharedItems[i].key + ".bin")));
+	}
+	results = serializer->SerializeBatch(sharedItems, 4);
+	for (const ResourceSerializer::BatchResult &result : results)
+		EXPECT_EQ(result.status, ResourceSerializer::BatchStatus::Unchanged);
+
+	// clean up
+	for (const ResourceSerializer::BatchItem &item : items)
+		serializer->Unserialize(item.key, item.serializationPath);
+	for (const ResourceSerializer::BatchItem &item : sharedItems)
+		serializer->Unserialize(item.key, item.serializationPath);
+	fs::remove(nestedRoot);
+	EXPECT_FALSE(fs::exists(nestedRoot));
+}
+
+TEST(ResourceSerializer, SerializeChunks)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+
+	// the payload is produced a few elements at a time and never held in memory as a whole
+	const size_t M = 100;
+	const size_t N = 50;
+	for (const bool direct : {false, true})
+	{
+		const ResourceSerializer::ChunkProducerType produce = [](char *chunk, const size_t size, const size_t offset)
+		{
+			const size_t count = std::min({size / sizeof(int), size_t(7), M * N - offset / sizeof(int)});
+			for (size_t i = 0; i < count; ++i)
+			{
+				const int value = static_cast<int>(offset / sizeof(int) + i);
+				std::memcpy(chunk + i * sizeof(int), &value, sizeof(int));
+			}
+			return count * sizeof(int);
+		};
+		EXPECT_NO_THROW(serializer->SerializeChunks(ResourceHeader({M, N}, resource::Layout(), DataType::Int32), RESOURCE_KEY, RESOURCE_ROOT, produce, 4096, direct));
+
+		size_t rows = 0;
+		size_t columns = 0;
+		const std::vector<int> values = ReadResourceFile(rows, columns);
+		EXPECT_EQ(rows, M);
+		EXPECT_EQ(columns, N);
+		for (size_t i = 0; i < values.size(); ++i)
+			ASSERT_EQ(values[i], static_cast<int>(i));
+		EXPECT_EQ(fs::file_size(RESOURCE_FILE), ResourceHeader({M, N}, resource::Layout(), DataType::Int32).GetSize() + M * N * sizeof(int));
+	}
+
+	// payloads that do not match the header are not written
+	fs::remove(RESOURCE_FILE);
+	const ResourceSerializer::ChunkProducerType shortProduce = [](char *, const size_t size, const size_t offset)
+	{ return offset == 0 ? std::min(size, size_t(8)) : size_t(0); };
+	EXPECT_THROW(serializer->SerializeChunks(ResourceHeader({M, N}, resource::Layout(), DataType::Int32), RESOURCE_KEY, RESOURCE_ROOT, shortProduce), std::runtime_error);
+	EXPECT_FALSE(fs::exists(RESOURCE_FILE));
+	EXPECT_THROW(serializer->SerializeChunks(ResourceHeader(), "", RESOURCE_ROOT, shortProduce), std::runtime_error);
+}
+
+TEST(ResourceSerializer, SerializeSnapshotThrowsUsingEmptyKey)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	Resource resource(INT_VALUES_ARRAY);
+	EXPECT_THROW(serializer->Serialize(*resource.CopySnapshot(), "", RESOURCE_ROOT), std::runtime_error);
+}
+
+TEST(ResourceSerializer, SerializeViewThrowsUsingEmptyKey)
+{
+	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
+
+	Resource2D resource(INT_MATRIX);
+	EXPECT_THROW(serializer->Serialize(ResourceView(resource), "", RESOURCE_ROOT), std::runtime_error);
+}
+
 TEST(ResourceSerializer, SerializeThrowsUsingEmptyKey)
 {
 	ResourceSerializer *serializer = ResourceSerializer::GetInstance();
@@ -0,0 +1,91 @@
+#include "test_filesystem_adapters/config.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_filesystem_adapters/ContainerResource.h"
+#include "test_filesystem_adapters/SparseContainerResource.h"
+#include "FilesystemAdapters/ResourceSnapshot.h"
+#include "Resources/DataType.h"
+
+using filesystem_adapters::ResourceSnapshot;
+using Resource = ContainerResource<int>;
+using SparseResource = SparseContainerResource<int>;
+
+namespace
+{
+	const std::vector<int> VALUES = {1, 2, 3, 4, 5, 6};
+	const std::vector<int> OTHER_VALUES = {6, 5, 4, 3, 2, 1};
+} // end namespace
+
+TEST(ResourceSnapshot, Construct)
+{
+	const Resource resource({2, 3}, VALUES);
+	std::shared_ptr<const ResourceSnapshot> snapshot = resource.CopySnapshot();
+	ASSERT_TRUE(snapshot);
+
+	EXPECT_EQ(snapshot->GetColumnSize(), size_t(2));
+	EXPECT_EQ(snapshot->GetRowSize(), size_t(3));
+	EXPECT_EQ(snapshot->GetShape(), std::vector<size_t>({2, 3}));
+	EXPECT_EQ(snapshot->GetDataType(), resource::DataType::Int32);
+	EXPECT_EQ(snapshot->GetElementSize(), sizeof(int));
+	EXPECT_EQ(snapshot->GetSize(), VALUES.size() * sizeof(int));
+	EXPECT_FALSE(snapshot->IsSparse());
+
+	const int *data = static_cast<const int *>(snapshot->Data());
+	EXPECT_EQ(std::vector<int>(data, data + VALUES.size()), VALUES);
+}
+
+TEST(ResourceSnapshot, ConstructSparse)
+{
+	const SparseResource resource(2, 3, std::vector<int>({0, 7, 0, 0, 0, 9}));
+	std::shared_ptr<const ResourceSnapshot> snapshot = resource.CopySnapshot();
+
+	EXPECT_TRUE(snapshot->IsSparse());
+	EXPECT_EQ(snapshot->GetRowOffsets(), std::vector<size_t>({0, 1, 2}));
+	EXPECT_EQ(snapshot->GetColumnIndices(), std::vector<size_t>({1, 2}));
+	EXPECT_EQ(snapshot->GetSize(), 2 * sizeof(int));
+	EXPECT_EQ(static_cast<const int *>(snapshot->Data())[1], 9);
+}
+
+TEST(ResourceSnapshot, SharedUntilWritten)
+{
+	Resource resource(VALUES);
+	std::shared_ptr<const ResourceSnapshot> first = resource.CopySnapshot();
+	EXPECT_EQ(resource.CopySnapshot(), first);
+	EXPECT_EQ(first->GetVersion(), resource.GetVersion());
+
+	// a shared lock does not start a new version
+	resource.LockShared();
+	EXPECT_EQ(resource.CopySnapshot(), first);
+
+	resource.Lock().Assign(reinterpret_cast<const char *>(OTHER_VALUES.data()), OTHER_VALUES.size() * sizeof(int));
+	std::shared_ptr<const ResourceSnapshot> second = resource.CopySnapshot();
+	EXPECT_NE(second, first);
+	EXPECT_EQ(second->GetVersion(), first->GetVersion() + 1);
+
+	// the old version is unchanged while it is held
+	EXPECT_EQ(static_cast<const int *>(first->Data())[0], VALUES[0]);
+	EXPECT_EQ(static_cast<const int *>(second->Data())[0], OTHER_VALUES[0]);
+
+	std::weak_ptr<const ResourceSnapshot> reclaimed = first;
+	first.reset();
+	EXPECT_TRUE(reclaimed.expired());
+}
+
+TEST(ResourceSnapshot, WriterNotBlockedBySnapshot)
+{
+	Resource resource(VALUES);
+	std::shared_ptr<const ResourceSnapshot> snapshot = resource.CopySnapshot();
+
+	// a writer on another thread proceeds while the snapshot is held
+	std::thread writer([&resource]()
+					   { resource.Lock().Assign(reinterpret_cast<const char *>(OTHER_VALUES.data()), OTHER_VALUES.size() * sizeof(int)); });
+	writer.join();
+
+	EXPECT_EQ(static_cast<const int *>(snapshot->Data())[0], VALUES[0]);
+	EXPECT_EQ(static_cast<const int *>(resource.CopySnapshot()->Data())[0], OTHER_VALUES[0]);
+}
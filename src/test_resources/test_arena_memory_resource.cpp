@@ -0,0 +1,95 @@
+#include "test_resources/config.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/ArenaMemoryResource.h"
+
+using resource::ArenaMemoryResource;
+
+namespace
+{
+	const size_t ALIGNMENT = 64;
+	const size_t CHUNK_SIZE = 1024;
+
+	bool IsAligned(const void *p, const size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+	}
+} // end namespace
+
+TEST(ArenaMemoryResource, Construct)
+{
+	EXPECT_NO_THROW(ArenaMemoryResource());
+	ArenaMemoryResource arena(ALIGNMENT, CHUNK_SIZE);
+	EXPECT_EQ(arena.GetAlignment(), ALIGNMENT);
+	EXPECT_EQ(arena.GetUsedBytes(), 0);
+	EXPECT_EQ(arena.GetReservedBytes(), 0);
+}
+
+TEST(ArenaMemoryResource, ConstructThrows)
+{
+	EXPECT_THROW(ArenaMemoryResource(48), std::runtime_error);
+	EXPECT_THROW(ArenaMemoryResource(ALIGNMENT, CHUNK_SIZE, nullptr), std::runtime_error);
+}
+
+TEST(ArenaMemoryResource, Allocate)
+{
+	ArenaMemoryResource arena(ALIGNMENT, CHUNK_SIZE);
+
+	void *p = arena.allocate(10, 1);
+	void *q = arena.allocate(10, 1);
+	EXPECT_TRUE(IsAligned(p, ALIGNMENT));
+	EXPECT_TRUE(IsAligned(q, ALIGNMENT));
+	EXPECT_EQ(static_cast<char *>(q) - static_cast<char *>(p), ptrdiff_t(ALIGNMENT));
+	EXPECT_EQ(arena.GetReservedBytes(), CHUNK_SIZE);
+}
+
+TEST(ArenaMemoryResource, AllocateOverAligned)
+{
+	ArenaMemoryResource arena(ALIGNMENT, CHUNK_SIZE);
+
+	EXPECT_NE(arena.allocate(10), nullptr);
+	void *p = arena.allocate(10, 256);
+	EXPECT_TRUE(IsAligned(p, 256));
+}
+
+TEST(ArenaMemoryResource, Grow)
+{
+	ArenaMemoryResource arena(ALIGNMENT, CHUNK_SIZE);
+
+	EXPECT_NE(arena.allocate(CHUNK_SIZE), nullptr);
+	EXPECT_NE(arena.allocate(1), nullptr);
+	EXPECT_EQ(arena.GetReservedBytes(), CHUNK_SIZE + 2 * CHUNK_SIZE);
+
+	// a request larger than the next chunk gets a chunk of its own
+	EXPECT_NE(arena.allocate(100 * CHUNK_SIZE), nullptr);
+	EXPECT_EQ(arena.GetReservedBytes(), CHUNK_SIZE + 2 * CHUNK_SIZE + 100 * CHUNK_SIZE);
+}
+
+TEST(ArenaMemoryResource, Release)
+{
+	ArenaMemoryResource arena(ALIGNMENT, CHUNK_SIZE);
+
+	void *p = arena.allocate(100);
+	arena.deallocate(p, 100);
+	EXPECT_EQ(arena.GetUsedBytes(), 100);
+
+	arena.Release();
+	EXPECT_EQ(arena.GetUsedBytes(), 0);
+	EXPECT_EQ(arena.GetReservedBytes(), 0);
+
+	EXPECT_NE(arena.allocate(100), nullptr);
+	EXPECT_EQ(arena.GetReservedBytes(), CHUNK_SIZE);
+}
+
+TEST(ArenaMemoryResource, IsEqual)
+{
+	ArenaMemoryResource arena;
+	ArenaMemoryResource other;
+	EXPECT_TRUE(arena.is_equal(arena));
+	EXPECT_FALSE(arena.is_equal(other));
+}
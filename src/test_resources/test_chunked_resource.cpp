@@ -0,0 +1,232 @@
+#include "test_resources/config.h"
+
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/ChunkedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/IChunkStore.h"
+#include "Resources/PageCache.h"
+
+using resource::ChunkedResource;
+using resource::DataType;
+using resource::IChunkStore;
+using resource::PageCache;
+
+namespace
+{
+	const size_t M = 10;
+	const size_t N = 4;
+	const size_t CHUNK_ROWS = 3;
+
+	// a store over a buffer owned by the test, counting the calls that reach it
+	struct MemoryStore : IChunkStore
+	{
+		MemoryStore(std::vector<int> &payload, const std::vector<size_t> &shape, const DataType dataType = DataType::Int32)
+			: payload_(payload), shape_(shape), dataType_(dataType)
+		{
+		}
+
+		std::vector<size_t> GetShape() const override { return shape_; }
+		DataType GetDataType() const override { return dataType_; }
+		size_t GetSize() const override { return payload_.size() * sizeof(int); }
+
+		void Read(const size_t offset, char *buff, const size_t n) override
+		{
+			++reads;
+			std::memcpy(buff, reinterpret_cast<const char *>(payload_.data()) + offset, n);
+		}
+
+		void Write(const size_t offset, const char *buff, const size_t n) override
+		{
+			++writes;
+			std::memcpy(reinterpret_cast<char *>(payload_.data()) + offset, buff, n);
+		}
+
+		static inline size_t reads = 0;
+		static inline size_t writes = 0;
+
+	private:
+		std::vector<int> &payload_;
+		std::vector<size_t> shape_;
+		DataType dataType_;
+	};
+
+	struct Resource : ChunkedResource
+	{
+		size_t GetElementSize() const override { return sizeof(int); }
+		DataType GetDataType() const override { return DataType::Int32; }
+		bool UpdateChecksumProtected() { return UpdateChecksum(); }
+	};
+
+	std::vector<int> Iota()
+	{
+		std::vector<int> payload(M * N);
+		std::iota(payload.begin(), payload.end(), 0);
+		MemoryStore::reads = 0;
+		MemoryStore::writes = 0;
+		return payload;
+	}
+} // end namespace
+
+TEST(ChunkedResource, Construct)
+{
+	Resource resource;
+	EXPECT_FALSE(resource.IsOpen());
+	EXPECT_EQ(resource.GetChunkCount(), size_t(0));
+	EXPECT_THROW(resource.ReadChunk(0), std::runtime_error);
+}
+
+TEST(ChunkedResource, Open)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+
+	EXPECT_TRUE(resource.IsOpen());
+	EXPECT_EQ(resource.GetColumnSize(), M);
+	EXPECT_EQ(resource.GetRowSize(), N);
+	EXPECT_EQ(resource.GetChunkCount(), size_t(4));
+	EXPECT_EQ(resource.GetChunkSize(0), CHUNK_ROWS * N * sizeof(int));
+	EXPECT_EQ(resource.GetChunkSize(3), N * sizeof(int));
+	EXPECT_EQ(MemoryStore::reads, size_t(0));
+}
+
+TEST(ChunkedResource, OpenThrows)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	EXPECT_THROW(resource.Open(nullptr, CHUNK_ROWS), std::runtime_error);
+	EXPECT_THROW(resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), 0), std::runtime_error);
+	// shape does not match the payload
+	EXPECT_THROW(resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N + 1})), CHUNK_ROWS), std::runtime_error);
+	// element type does not match the resource
+	EXPECT_THROW(resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N}), DataType::Float32), CHUNK_ROWS), std::runtime_error);
+
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+	EXPECT_THROW(resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS), std::runtime_error);
+}
+
+TEST(ChunkedResource, ReadChunk)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+
+	EXPECT_FALSE(resource.IsResident(1));
+	{
+		std::shared_ptr<const void> chunk = resource.ReadChunk(1);
+		EXPECT_EQ(static_cast<const int *>(chunk.get())[0], int(CHUNK_ROWS * N));
+		EXPECT_TRUE(resource.IsResident(1));
+	}
+
+	// resident chunks are not read again
+	resource.ReadChunk(1);
+	EXPECT_EQ(MemoryStore::reads, size_t(1));
+	EXPECT_THROW(resource.ReadChunk(4), std::runtime_error);
+}
+
+TEST(ChunkedResource, ReadRows)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+
+	// rows 2 to 7 span three chunks
+	std::vector<int> rows(6 * N);
+	resource.ReadRows(2, 6, reinterpret_cast<char *>(rows.data()));
+	EXPECT_EQ(rows, std::vector<int>(payload.begin() + 2 * N, payload.begin() + 8 * N));
+	EXPECT_EQ(MemoryStore::reads, size_t(3));
+
+	EXPECT_THROW(resource.ReadRows(8, 3, reinterpret_cast<char *>(rows.data())), std::runtime_error);
+}
+
+TEST(ChunkedResource, WriteRows)
+{
+	std::vector<int> payload = Iota();
+	const std::vector<int> original = payload;
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+
+	const std::vector<int> values(2 * N, -1);
+	resource.WriteRows(5, 2, reinterpret_cast<const char *>(values.data()));
+
+	// modifications stay in the cache until flushed; rows 5 and 6 are in different chunks
+	EXPECT_EQ(payload, original);
+	resource.Flush();
+	EXPECT_EQ(MemoryStore::writes, size_t(2));
+	EXPECT_EQ(payload[5 * N], -1);
+	EXPECT_EQ(payload[7 * N - 1], -1);
+	EXPECT_EQ(payload[7 * N], original[7 * N]);
+
+	// clean chunks are not written again
+	resource.Flush();
+	EXPECT_EQ(MemoryStore::writes, size_t(2));
+}
+
+TEST(ChunkedResource, Assign)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+
+	const std::vector<int> values(M * N, 7);
+	resource.Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+	resource.Close();
+	EXPECT_EQ(payload, values);
+	EXPECT_FALSE(resource.IsOpen());
+
+	EXPECT_THROW(resource.Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int)), std::runtime_error);
+}
+
+TEST(ChunkedResource, Close)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+	resource.Close();
+
+	EXPECT_EQ(resource.GetColumnSize(), size_t(0));
+	EXPECT_EQ(resource.GetChunkCount(), size_t(0));
+	std::vector<int> row(N);
+	EXPECT_THROW(resource.ReadRows(0, 1, reinterpret_cast<char *>(row.data())), std::runtime_error);
+	EXPECT_THROW(resource.WriteRows(0, 1, reinterpret_cast<const char *>(row.data())), std::runtime_error);
+
+	// a closed resource can be opened with another shape
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({N, M})), CHUNK_ROWS);
+	EXPECT_EQ(resource.GetColumnSize(), N);
+}
+
+TEST(ChunkedResource, DataThrows)
+{
+	Resource resource;
+	EXPECT_THROW(resource.Data(), std::runtime_error);
+	EXPECT_THROW(static_cast<const Resource &>(resource).Data(), std::runtime_error);
+}
+
+TEST(ChunkedResource, DestructorWritesBack)
+{
+	std::vector<int> payload = Iota();
+	{
+		Resource resource;
+		resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+		static_cast<int *>(resource.WriteChunk(3).get())[0] = -1;
+	}
+	EXPECT_EQ(payload[9 * N], -1);
+}
+
+TEST(ChunkedResource, UpdateChecksum)
+{
+	std::vector<int> payload = Iota();
+	Resource resource;
+	resource.Open(std::make_unique<MemoryStore>(payload, std::vector<size_t>({M, N})), CHUNK_ROWS);
+
+	EXPECT_TRUE(resource.UpdateChecksumProtected());
+	EXPECT_FALSE(resource.UpdateChecksumProtected());
+	static_cast<int *>(resource.WriteChunk(0).get())[0] = -1;
+	EXPECT_TRUE(resource.UpdateChecksumProtected());
+}
@@ -0,0 +1,93 @@
+#include "test_resources/config.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/Codec.h"
+
+using resource::Codec;
+using resource::CodecType;
+
+namespace
+{
+	const std::vector<CodecType> CODECS = {CodecType::None, CodecType::Zlib, CodecType::LZ4, CodecType::Zstd};
+
+	std::vector<char> MakePayload()
+	{
+		std::vector<char> payload(4096);
+		for (size_t i = 0; i < payload.size(); ++i)
+			payload[i] = static_cast<char>(i % 7);
+		return payload;
+	}
+} // end namespace
+
+TEST(Codec, Construct)
+{
+	EXPECT_NO_THROW(Codec());
+	EXPECT_EQ(Codec().GetType(), CodecType::Zlib);
+	EXPECT_EQ(Codec(CodecType::None, 3).GetLevel(), 3);
+}
+
+TEST(Codec, ConstructThrowsIfUnavailable)
+{
+	for (CodecType type : CODECS)
+	{
+		if (!Codec::IsAvailable(type))
+		{
+			EXPECT_THROW(Codec codec(type), std::runtime_error);
+		}
+	}
+}
+
+TEST(Codec, IsAvailable)
+{
+	EXPECT_TRUE(Codec::IsAvailable(CodecType::None));
+	EXPECT_TRUE(Codec::IsAvailable(CodecType::Zlib));
+}
+
+TEST(Codec, GetName)
+{
+	EXPECT_EQ(Codec::GetName(CodecType::None), "none");
+	EXPECT_EQ(Codec::GetName(CodecType::Zlib), "zlib");
+	EXPECT_EQ(Codec::GetName(CodecType::LZ4), "lz4");
+	EXPECT_EQ(Codec::GetName(CodecType::Zstd), "zstd");
+}
+
+TEST(Codec, RoundTrip)
+{
+	const std::vector<char> payload = MakePayload();
+
+	for (CodecType type : CODECS)
+	{
+		if (!Codec::IsAvailable(type))
+			continue;
+
+		Codec codec(type);
+		std::vector<char> compressed = codec.Compress(payload.data(), payload.size());
+		if (type != CodecType::None)
+		{
+			EXPECT_LT(compressed.size(), payload.size());
+		}
+
+		std::vector<char> decompressed(payload.size());
+		codec.Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
+		EXPECT_EQ(decompressed, payload);
+	}
+}
+
+TEST(Codec, CompressThrowsOnNullBuffer)
+{
+	EXPECT_THROW(Codec().Compress(nullptr, 1), std::runtime_error);
+}
+
+TEST(Codec, DecompressThrowsOnSizeMismatch)
+{
+	const std::vector<char> payload = MakePayload();
+
+	Codec codec;
+	std::vector<char> compressed = codec.Compress(payload.data(), payload.size());
+	std::vector<char> decompressed(payload.size() / 2);
+	EXPECT_THROW(codec.Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()), std::runtime_error);
+}
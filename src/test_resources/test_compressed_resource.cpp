@@ -0,0 +1,181 @@
+#include "test_resources/config.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/Codec.h"
+#include "Resources/CompressedResource.h"
+#include "Resources/DecompressionCache.h"
+
+using resource::Codec;
+using resource::CodecType;
+using resource::CompressedResource;
+using resource::DecompressionCache;
+
+namespace
+{
+	const size_t SIZE = 1024;
+
+	struct Resource : CompressedResource
+	{
+		Resource() = default;
+
+		Resource(const std::vector<int> &values)
+		{
+			SetRowSize(values.size());
+			SetColumnSize(1);
+			Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+		}
+
+		size_t GetElementSize() const override
+		{
+			return sizeof(int);
+		}
+
+		bool UpdateChecksumProtected() { return UpdateChecksum(); }
+	};
+
+	const std::vector<int> VALUES(SIZE, 7);
+} // end namespace
+
+TEST(CompressedResource, Construct)
+{
+	EXPECT_NO_THROW(Resource());
+	Resource resource;
+	EXPECT_EQ(resource.GetCodec().GetType(), CodecType::Zlib);
+	EXPECT_EQ(resource.Data(), nullptr);
+}
+
+TEST(CompressedResource, Assign)
+{
+	Resource resource(VALUES);
+
+	EXPECT_EQ(resource.GetUncompressedSize(), SIZE * sizeof(int));
+	EXPECT_LT(resource.GetCompressedSize(), resource.GetUncompressedSize());
+	EXPECT_FALSE(resource.IsResident());
+}
+
+TEST(CompressedResource, AssignThrows)
+{
+	Resource resource;
+	EXPECT_THROW(resource.Assign(nullptr, 4), std::runtime_error);
+	EXPECT_THROW(resource.Assign(reinterpret_cast<const char *>(VALUES.data()), 0), std::runtime_error);
+	EXPECT_THROW(resource.Assign(reinterpret_cast<const char *>(VALUES.data()), 3), std::runtime_error);
+}
+
+TEST(CompressedResource, Data)
+{
+	const Resource resource(VALUES);
+
+	const int *data = static_cast<const int *>(resource.Data());
+	EXPECT_TRUE(resource.IsResident());
+	EXPECT_EQ(std::vector<int>(data, data + SIZE), VALUES);
+
+	resource.Evict();
+	EXPECT_FALSE(resource.IsResident());
+}
+
+TEST(CompressedResource, EvictWritesBackModifications)
+{
+	Resource resource(VALUES);
+
+	static_cast<int *>(resource.Data())[0] = 42;
+	resource.Evict();
+	EXPECT_FALSE(resource.IsResident());
+
+	EXPECT_EQ(static_cast<const Resource &>(resource).GetUncompressedSize(), SIZE * sizeof(int));
+	EXPECT_EQ(static_cast<const int *>(static_cast<const Resource &>(resource).Data())[0], 42);
+}
+
+TEST(CompressedResource, EvictWritesBackModificationsAfterFlush)
+{
+	Resource resource(VALUES);
+	const Resource &constResource = resource;
+
+	// the compressed size flushes the buffer, but the pointer taken before it can still write to it
+	int *data = static_cast<int *>(resource.Data());
+	data[0] = 42;
+	EXPECT_GT(constResource.GetCompressedSize(), size_t(0));
+	data[1] = 43;
+	resource.Evict();
+	EXPECT_FALSE(resource.IsResident());
+
+	const int *values = static_cast<const int *>(constResource.Data());
+	EXPECT_EQ(values[0], 42);
+	EXPECT_EQ(values[1], 43);
+}
+
+TEST(CompressedResource, Pin)
+{
+	Resource resource(VALUES);
+	{
+		auto pin = resource.Pin();
+		EXPECT_TRUE(resource.IsResident());
+		resource.Evict();
+		EXPECT_TRUE(resource.IsResident());
+	}
+	resource.Evict();
+	EXPECT_FALSE(resource.IsResident());
+}
+
+TEST(CompressedResource, Copy)
+{
+	Resource resource(VALUES);
+	static_cast<int *>(resource.Data())[1] = 3;
+
+	Resource copy(resource);
+	EXPECT_FALSE(copy.IsResident());
+	EXPECT_EQ(static_cast<const int *>(copy.Data())[1], 3);
+	EXPECT_EQ(copy.GetRowSize(), SIZE);
+}
+
+TEST(CompressedResource, Move)
+{
+	Resource resource(VALUES);
+	resource.Data();
+
+	Resource moved(std::move(resource));
+	EXPECT_FALSE(resource.IsResident());
+	EXPECT_EQ(moved.GetUncompressedSize(), SIZE * sizeof(int));
+	EXPECT_EQ(static_cast<const int *>(moved.Data())[0], VALUES[0]);
+}
+
+TEST(CompressedResource, MoveKeepsResidentBuffer)
+{
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Clear();
+	Resource resource(VALUES);
+	static_cast<int *>(resource.Data())[1] = 3;
+	const size_t compressedSize = resource.GetCompressedSize();
+
+	// the modified buffer is handed over instead of being compressed
+	Resource moved(std::move(resource));
+	EXPECT_TRUE(moved.IsResident());
+	EXPECT_EQ(moved.GetCompressedSize(), compressedSize);
+	EXPECT_EQ(cache->GetResidentCount(), size_t(1));
+
+	Resource assigned(VALUES);
+	assigned.Data();
+	EXPECT_EQ(cache->GetResidentCount(), size_t(2));
+	assigned = std::move(moved);
+	EXPECT_TRUE(assigned.IsResident());
+	EXPECT_EQ(cache->GetResidentCount(), size_t(1));
+	EXPECT_EQ(cache->GetResidentBytes(), SIZE * sizeof(int));
+
+	// the modification is written back when the buffer is evicted
+	assigned.Evict();
+	EXPECT_FALSE(assigned.IsResident());
+	EXPECT_EQ(static_cast<const int *>(assigned.Data())[1], 3);
+}
+
+TEST(CompressedResource, Checksum)
+{
+	Resource resource(VALUES);
+
+	EXPECT_TRUE(resource.UpdateChecksumProtected());
+	EXPECT_FALSE(resource.UpdateChecksumProtected());
+	static_cast<int *>(resource.Data())[0] = 0;
+	EXPECT_TRUE(resource.UpdateChecksumProtected());
+}
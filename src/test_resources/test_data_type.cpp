@@ -0,0 +1,147 @@
+#include "test_resources/config.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/DataType.h"
+
+using resource::DataType;
+using resource::DataTypeConverter;
+
+namespace
+{
+	template <typename From, typename To>
+	std::vector<To> Convert(const std::vector<From> &src, const DataType from, const DataType to)
+	{
+		std::vector<To> dst(src.size());
+		DataTypeConverter::Convert(src.data(), from, dst.data(), to, src.size());
+		return dst;
+	}
+} // end namespace
+
+TEST(DataTypeConverter, GetDataType)
+{
+	EXPECT_EQ(DataTypeConverter::GetDataType<int8_t>(), DataType::Int8);
+	EXPECT_EQ(DataTypeConverter::GetDataType<uint16_t>(), DataType::UInt16);
+	EXPECT_EQ(DataTypeConverter::GetDataType<const int>(), DataType::Int32);
+	EXPECT_EQ(DataTypeConverter::GetDataType<uint64_t>(), DataType::UInt64);
+	EXPECT_EQ(DataTypeConverter::GetDataType<float>(), DataType::Float32);
+	EXPECT_EQ(DataTypeConverter::GetDataType<double>(), DataType::Float64);
+	EXPECT_EQ(DataTypeConverter::GetDataType<bool>(), DataType::Unknown);
+	EXPECT_EQ(DataTypeConverter::GetDataType<long double>(), DataType::Unknown);
+}
+
+TEST(DataTypeConverter, GetSize)
+{
+	EXPECT_EQ(DataTypeConverter::GetSize(DataType::Unknown), size_t(0));
+	EXPECT_EQ(DataTypeConverter::GetSize(DataType::UInt8), size_t(1));
+	EXPECT_EQ(DataTypeConverter::GetSize(DataType::Float16), size_t(2));
+	EXPECT_EQ(DataTypeConverter::GetSize(DataType::BFloat16), size_t(2));
+	EXPECT_EQ(DataTypeConverter::GetSize(DataType::Int32), size_t(4));
+	EXPECT_EQ(DataTypeConverter::GetSize(DataType::Float64), size_t(8));
+	EXPECT_THROW(DataTypeConverter::GetSize(static_cast<DataType>(99)), std::runtime_error);
+}
+
+TEST(DataTypeConverter, GetName)
+{
+	EXPECT_EQ(DataTypeConverter::GetName(DataType::BFloat16), "bfloat16");
+	EXPECT_EQ(DataTypeConverter::GetName(DataType::Float64), "float64");
+	EXPECT_EQ(DataTypeConverter::GetName(DataType::Unknown), "unknown");
+}
+
+TEST(DataTypeConverter, IsConvertible)
+{
+	EXPECT_TRUE(DataTypeConverter::IsConvertible(DataType::Float64, DataType::Float32));
+	EXPECT_TRUE(DataTypeConverter::IsConvertible(DataType::Float32, DataType::Float16));
+	EXPECT_TRUE(DataTypeConverter::IsConvertible(DataType::BFloat16, DataType::Float64));
+	EXPECT_TRUE(DataTypeConverter::IsConvertible(DataType::Int16, DataType::Int64));
+	EXPECT_TRUE(DataTypeConverter::IsConvertible(DataType::UInt8, DataType::Int16));
+	EXPECT_TRUE(DataTypeConverter::IsConvertible(DataType::UInt32, DataType::Float32));
+
+	EXPECT_FALSE(DataTypeConverter::IsConvertible(DataType::Int64, DataType::Int32));
+	EXPECT_FALSE(DataTypeConverter::IsConvertible(DataType::Int8, DataType::UInt16));
+	EXPECT_FALSE(DataTypeConverter::IsConvertible(DataType::UInt16, DataType::Int16));
+	EXPECT_FALSE(DataTypeConverter::IsConvertible(DataType::Float32, DataType::Int32));
+	EXPECT_FALSE(DataTypeConverter::IsConvertible(DataType::Unknown, DataType::Float32));
+}
+
+TEST(DataTypeConverter, RequiresConversion)
+{
+	EXPECT_TRUE(DataTypeConverter::RequiresConversion(DataType::Float64, DataType::Float32));
+	EXPECT_FALSE(DataTypeConverter::RequiresConversion(DataType::Float32, DataType::Float32));
+	EXPECT_FALSE(DataTypeConverter::RequiresConversion(DataType::Unknown, DataType::Float32));
+	EXPECT_FALSE(DataTypeConverter::RequiresConversion(DataType::Float64, DataType::Unknown));
+}
+
+TEST(DataTypeConverter, ConvertFloat64ToFloat32)
+{
+	const std::vector<double> src = {0.0, -1.5, 0.1, 1e300};
+	const std::vector<float> dst = Convert<double, float>(src, DataType::Float64, DataType::Float32);
+	EXPECT_EQ(dst[0], 0.0f);
+	EXPECT_EQ(dst[1], -1.5f);
+	EXPECT_EQ(dst[2], 0.1f);
+	EXPECT_TRUE(std::isinf(dst[3]));
+}
+
+TEST(DataTypeConverter, ConvertFloat32ToFloat16)
+{
+	const std::vector<float> src = {1.0f, -2.0f, 0.5f, 65504.0f, 1e6f, 5.96046448e-8f, 1.0f + 1.0f / 2048.0f};
+	const std::vector<uint16_t> dst = Convert<float, uint16_t>(src, DataType::Float32, DataType::Float16);
+	EXPECT_EQ(dst[0], 0x3c00);
+	EXPECT_EQ(dst[1], 0xc000);
+	EXPECT_EQ(dst[2], 0x3800);
+	EXPECT_EQ(dst[3], 0x7bff);
+	EXPECT_EQ(dst[4], 0x7c00);
+	EXPECT_EQ(dst[5], 0x0001);
+	// halfway between two halves rounds to even
+	EXPECT_EQ(dst[6], 0x3c00);
+
+	EXPECT_TRUE(std::isnan(DataTypeConverter::HalfToFloat(DataTypeConverter::FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(DataTypeConverter, ConvertFloat16ToFloat32)
+{
+	const std::vector<uint16_t> src = {0x3c00, 0xc000, 0x0001, 0x7c00, 0x0000, 0x8000};
+	const std::vector<float> dst = Convert<uint16_t, float>(src, DataType::Float16, DataType::Float32);
+	EXPECT_EQ(dst[0], 1.0f);
+	EXPECT_EQ(dst[1], -2.0f);
+	EXPECT_EQ(dst[2], 5.96046448e-8f);
+	EXPECT_TRUE(std::isinf(dst[3]));
+	EXPECT_EQ(dst[4], 0.0f);
+	EXPECT_TRUE(std::signbit(dst[5]));
+}
+
+TEST(DataTypeConverter, ConvertFloat32ToBFloat16)
+{
+	const std::vector<float> src = {1.0f, -3.0f, 1.00390625f, 1.01171875f};
+	const std::vector<uint16_t> dst = Convert<float, uint16_t>(src, DataType::Float32, DataType::BFloat16);
+	EXPECT_EQ(dst[0], 0x3f80);
+	EXPECT_EQ(dst[1], 0xc040);
+	// halfway cases round to even
+	EXPECT_EQ(dst[2], 0x3f80);
+	EXPECT_EQ(dst[3], 0x3f82);
+
+	EXPECT_EQ(DataTypeConverter::BFloat16ToFloat(0x3f80), 1.0f);
+	EXPECT_TRUE(std::isnan(DataTypeConverter::BFloat16ToFloat(DataTypeConverter::FloatToBFloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(DataTypeConverter, ConvertIntegerWidening)
+{
+	const std::vector<int16_t> src = {-32768, -1, 0, 32767};
+	EXPECT_EQ((Convert<int16_t, int64_t>(src, DataType::Int16, DataType::Int64)), std::vector<int64_t>({-32768, -1, 0, 32767}));
+	EXPECT_EQ((Convert<int16_t, double>(src, DataType::Int16, DataType::Float64)), std::vector<double>({-32768.0, -1.0, 0.0, 32767.0}));
+
+	const std::vector<uint8_t> bytes = {0, 200, 255};
+	EXPECT_EQ((Convert<uint8_t, int32_t>(bytes, DataType::UInt8, DataType::Int32)), std::vector<int32_t>({0, 200, 255}));
+}
+
+TEST(DataTypeConverter, ConvertThrows)
+{
+	const std::vector<float> src = {1.0f};
+	EXPECT_THROW((Convert<float, int32_t>(src, DataType::Float32, DataType::Int32)), std::runtime_error);
+	EXPECT_THROW((Convert<float, float>(src, DataType::Unknown, DataType::Float32)), std::runtime_error);
+}
@@ -0,0 +1,123 @@
+#include "test_resources/config.h"
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/CompressedResource.h"
+#include "Resources/DecompressionCache.h"
+
+using resource::CompressedResource;
+using resource::DecompressionCache;
+
+namespace
+{
+	const size_t SIZE = 256;
+	const size_t BYTES = SIZE * sizeof(int);
+
+	struct Resource : CompressedResource
+	{
+		Resource(const std::vector<int> &values)
+		{
+			SetRowSize(values.size());
+			SetColumnSize(1);
+			Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+		}
+
+		size_t GetElementSize() const override
+		{
+			return sizeof(int);
+		}
+	};
+
+	struct BudgetRestorer
+	{
+		BudgetRestorer() : budget_(DecompressionCache::GetInstance()->GetBudget()) {}
+		~BudgetRestorer()
+		{
+			DecompressionCache::GetInstance()->Clear();
+			DecompressionCache::GetInstance()->SetBudget(budget_);
+		}
+
+	private:
+		size_t budget_;
+	};
+} // end namespace
+
+TEST(DecompressionCache, GetInstance)
+{
+	EXPECT_TRUE(DecompressionCache::GetInstance());
+}
+
+TEST(DecompressionCache, SetBudget)
+{
+	BudgetRestorer restorer;
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+
+	cache->SetBudget(BYTES);
+	EXPECT_EQ(cache->GetBudget(), BYTES);
+}
+
+TEST(DecompressionCache, GetResidentBytes)
+{
+	BudgetRestorer restorer;
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Clear();
+
+	Resource resource(std::vector<int>(SIZE, 1));
+	EXPECT_EQ(cache->GetResidentBytes(), size_t(0));
+	resource.Data();
+	EXPECT_EQ(cache->GetResidentBytes(), BYTES);
+	EXPECT_EQ(cache->GetResidentCount(), size_t(1));
+}
+
+TEST(DecompressionCache, EvictsLeastRecentlyUsed)
+{
+	BudgetRestorer restorer;
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Clear();
+	cache->SetBudget(2 * BYTES);
+
+	Resource a(std::vector<int>(SIZE, 1));
+	Resource b(std::vector<int>(SIZE, 2));
+	Resource c(std::vector<int>(SIZE, 3));
+
+	a.Data();
+	b.Data();
+	a.Data();
+	c.Data();
+
+	EXPECT_TRUE(a.IsResident());
+	EXPECT_FALSE(b.IsResident());
+	EXPECT_TRUE(c.IsResident());
+	EXPECT_EQ(cache->GetResidentBytes(), 2 * BYTES);
+}
+
+TEST(DecompressionCache, DoesNotEvictPinned)
+{
+	BudgetRestorer restorer;
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	cache->Clear();
+	cache->SetBudget(BYTES);
+
+	Resource a(std::vector<int>(SIZE, 1));
+	Resource b(std::vector<int>(SIZE, 2));
+
+	auto pin = a.Pin();
+	b.Data();
+
+	EXPECT_TRUE(a.IsResident());
+	EXPECT_TRUE(b.IsResident());
+	EXPECT_EQ(static_cast<const int *>(static_cast<const Resource &>(a).Data())[0], 1);
+}
+
+TEST(DecompressionCache, Clear)
+{
+	BudgetRestorer restorer;
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+
+	Resource resource(std::vector<int>(SIZE, 1));
+	resource.Data();
+	cache->Clear();
+	EXPECT_FALSE(resource.IsResident());
+	EXPECT_EQ(cache->GetResidentBytes(), size_t(0));
+}
@@ -0,0 +1,95 @@
+#include "test_resources/config.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/DeltaCodec.h"
+
+using resource::DeltaCodec;
+
+namespace
+{
+	std::vector<char> Bytes(const std::string &text)
+	{
+		return std::vector<char>(text.cbegin(), text.cend());
+	}
+
+	std::vector<char> RoundTrip(const std::vector<char> &base, const std::vector<char> &target)
+	{
+		const std::vector<char> delta = DeltaCodec::Encode(base.data(), base.size(), target.data(), target.size());
+		return DeltaCodec::Apply(base.data(), base.size(), delta.data(), delta.size());
+	}
+} // end namespace
+
+TEST(DeltaCodec, EncodeEqual)
+{
+	const std::vector<char> base = Bytes("unchanged payload");
+	const std::vector<char> delta = DeltaCodec::Encode(base.data(), base.size(), base.data(), base.size());
+	EXPECT_EQ(delta.size(), sizeof(uint64_t));
+	EXPECT_EQ(DeltaCodec::GetTargetSize(delta.data(), delta.size()), base.size());
+	EXPECT_EQ(DeltaCodec::Apply(base.data(), base.size(), delta.data(), delta.size()), base);
+}
+
+TEST(DeltaCodec, EncodeSparseChange)
+{
+	std::vector<int> base(1000);
+	for (size_t i = 0; i < base.size(); ++i)
+		base[i] = static_cast<int>(i);
+	std::vector<int> target = base;
+	target[10] = -1;
+	target[900] = -2;
+
+	const char *baseBytes = reinterpret_cast<const char *>(base.data());
+	const char *targetBytes = reinterpret_cast<const char *>(target.data());
+	const size_t size = base.size() * sizeof(int);
+	const std::vector<char> delta = DeltaCodec::Encode(baseBytes, size, targetBytes, size);
+
+	// two runs of one element each
+	EXPECT_LE(delta.size(), sizeof(uint64_t) + 2 * (2 * sizeof(uint64_t) + sizeof(int)));
+	const std::vector<char> applied = DeltaCodec::Apply(baseBytes, size, delta.data(), delta.size());
+	EXPECT_EQ(applied, std::vector<char>(targetBytes, targetBytes + size));
+}
+
+TEST(DeltaCodec, EncodeMergesNearbyRuns)
+{
+	const std::vector<char> base(64, 'a');
+	std::vector<char> target = base;
+	target[4] = 'b';
+	target[8] = 'b';
+
+	// a gap shorter than a run header costs less inside the run
+	const std::vector<char> delta = DeltaCodec::Encode(base.data(), base.size(), target.data(), target.size());
+	EXPECT_EQ(delta.size(), sizeof(uint64_t) + 2 * sizeof(uint64_t) + 5);
+	EXPECT_EQ(RoundTrip(base, target), target);
+}
+
+TEST(DeltaCodec, EncodeResize)
+{
+	const std::vector<char> base = Bytes("short");
+	const std::vector<char> longer = Bytes("short and then some");
+	EXPECT_EQ(RoundTrip(base, longer), longer);
+	EXPECT_EQ(RoundTrip(longer, base), base);
+	EXPECT_EQ(RoundTrip(std::vector<char>(), base), base);
+	EXPECT_EQ(RoundTrip(base, std::vector<char>()), std::vector<char>());
+}
+
+TEST(DeltaCodec, ApplyThrows)
+{
+	const std::vector<char> base = Bytes("base");
+	const std::vector<char> target = Bytes("bass");
+	const std::vector<char> delta = DeltaCodec::Encode(base.data(), base.size(), target.data(), target.size());
+
+	EXPECT_THROW(DeltaCodec::Apply(base.data(), base.size(), delta.data(), 4), std::runtime_error);
+	EXPECT_THROW(DeltaCodec::Apply(base.data(), base.size(), delta.data(), delta.size() - 1), std::runtime_error);
+	EXPECT_THROW(DeltaCodec::Apply(base.data(), base.size(), delta.data(), sizeof(uint64_t) + 3), std::runtime_error);
+
+	// a run past the end of the target
+	std::vector<char> corrupt = delta;
+	const uint64_t offset = 100;
+	std::memcpy(corrupt.data() + sizeof(uint64_t), &offset, sizeof(offset));
+	EXPECT_THROW(DeltaCodec::Apply(base.data(), base.size(), corrupt.data(), corrupt.size()), std::runtime_error);
+}
@@ -0,0 +1,135 @@
+#include "test_resources/config.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/DataType.h"
+#include "Resources/Encoding.h"
+
+using resource::DataType;
+using resource::Encoding;
+using resource::EncodingType;
+using resource::Quantization;
+
+namespace
+{
+	template <typename Stored, typename T>
+	std::vector<T> RoundTrip(const Encoding &encoding, const std::vector<T> &values, Quantization &quantization)
+	{
+		const DataType dataType = resource::DataTypeConverter::GetDataType<T>();
+		quantization = encoding.Fit(values.data(), dataType, values.size());
+		std::vector<Stored> stored(values.size());
+		encoding.Encode(values.data(), dataType, stored.data(), values.size(), quantization);
+
+		std::vector<T> restored(values.size());
+		Encoding::Dequantize(stored.data(), encoding.GetStoredType(dataType), restored.data(), dataType, values.size(), quantization);
+		return restored;
+	}
+} // end namespace
+
+TEST(Encoding, Construct)
+{
+	EXPECT_EQ(Encoding().GetType(), EncodingType::None);
+	EXPECT_EQ(Encoding(EncodingType::Int8).GetType(), EncodingType::Int8);
+	EXPECT_EQ(Encoding::GetName(EncodingType::BFloat16), "bfloat16");
+	EXPECT_THROW(Encoding(static_cast<EncodingType>(99)), std::runtime_error);
+}
+
+TEST(Encoding, GetStoredType)
+{
+	EXPECT_EQ(Encoding(EncodingType::Float16).GetStoredType(DataType::Float32), DataType::Float16);
+	EXPECT_EQ(Encoding(EncodingType::BFloat16).GetStoredType(DataType::Float64), DataType::BFloat16);
+	EXPECT_EQ(Encoding(EncodingType::Int8).GetStoredType(DataType::Float32), DataType::Int8);
+	EXPECT_EQ(Encoding(EncodingType::Int16).GetStoredType(DataType::Float64), DataType::Int16);
+
+	// only floating point payloads are encoded
+	EXPECT_FALSE(Encoding(EncodingType::Int8).AppliesTo(DataType::Int32));
+	EXPECT_EQ(Encoding(EncodingType::Int8).GetStoredType(DataType::Int32), DataType::Int32);
+	EXPECT_FALSE(Encoding().AppliesTo(DataType::Float32));
+	EXPECT_EQ(Encoding().GetStoredType(DataType::Float32), DataType::Float32);
+}
+
+TEST(Encoding, EncodeFloat16)
+{
+	const Encoding encoding(EncodingType::Float16);
+	EXPECT_FALSE(encoding.IsQuantized());
+
+	const std::vector<float> values = {1.0f, -2.0f, 0.5f};
+	const Quantization quantization = encoding.Fit(values.data(), DataType::Float32, values.size());
+	EXPECT_EQ(quantization.scale, 1.0);
+	EXPECT_EQ(quantization.offset, 0.0);
+
+	std::vector<uint16_t> stored(values.size());
+	encoding.Encode(values.data(), DataType::Float32, stored.data(), values.size(), quantization);
+	EXPECT_EQ(stored, std::vector<uint16_t>({0x3c00, 0xc000, 0x3800}));
+}
+
+TEST(Encoding, EncodeInt8)
+{
+	const Encoding encoding(EncodingType::Int8);
+	EXPECT_TRUE(encoding.IsQuantized());
+
+	std::vector<float> values(1000);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = std::sin(static_cast<float>(i)) * 50.0f + 10.0f;
+
+	Quantization quantization;
+	const std::vector<float> restored = RoundTrip<int8_t>(encoding, values, quantization);
+	for (size_t i = 0; i < values.size(); ++i)
+		EXPECT_NEAR(restored[i], values[i], quantization.scale / 2 + 1e-4);
+
+	// the ends of the range are exact
+	Quantization range;
+	const std::vector<float> ends = RoundTrip<int8_t>(encoding, std::vector<float>({-40.0f, 60.0f}), range);
+	EXPECT_FLOAT_EQ(ends[0], -40.0f);
+	EXPECT_FLOAT_EQ(ends[1], 60.0f);
+}
+
+TEST(Encoding, EncodeInt16)
+{
+	const Encoding encoding(EncodingType::Int16);
+	const std::vector<double> values = {-1.0, 0.25, 0.333, 1.0};
+
+	Quantization quantization;
+	const std::vector<double> restored = RoundTrip<int16_t>(encoding, values, quantization);
+	EXPECT_NEAR(quantization.scale, 2.0 / 65535.0, 1e-12);
+	for (size_t i = 0; i < values.size(); ++i)
+		EXPECT_NEAR(restored[i], values[i], quantization.scale / 2 + 1e-12);
+}
+
+TEST(Encoding, EncodeNonFinite)
+{
+	const Encoding encoding(EncodingType::Int8);
+	const float inf = std::numeric_limits<float>::infinity();
+	const std::vector<float> values = {2.0f, std::numeric_limits<float>::quiet_NaN(), inf, -inf, 4.0f};
+
+	// non-finite values do not widen the range
+	Quantization quantization;
+	const std::vector<float> restored = RoundTrip<int8_t>(encoding, values, quantization);
+	EXPECT_FLOAT_EQ(restored[0], 2.0f);
+	EXPECT_FLOAT_EQ(restored[2], 4.0f);
+	EXPECT_FLOAT_EQ(restored[3], 2.0f);
+	EXPECT_FLOAT_EQ(restored[4], 4.0f);
+	EXPECT_FLOAT_EQ(restored[1], static_cast<float>(quantization.offset));
+
+	// a constant payload has no range
+	const std::vector<float> constant = RoundTrip<int8_t>(encoding, std::vector<float>(4, 7.5f), quantization);
+	EXPECT_EQ(quantization.scale, 0.0);
+	EXPECT_EQ(constant, std::vector<float>(4, 7.5f));
+}
+
+TEST(Encoding, EncodeThrows)
+{
+	const std::vector<int> values = {1, 2};
+	std::vector<int8_t> stored(values.size());
+	EXPECT_THROW(Encoding(EncodingType::Int8).Encode(values.data(), DataType::Int32, stored.data(), values.size(), Quantization()), std::runtime_error);
+	EXPECT_THROW(Encoding().Encode(values.data(), DataType::Float32, stored.data(), values.size(), Quantization()), std::runtime_error);
+
+	std::vector<float> restored(values.size());
+	EXPECT_THROW(Encoding::Dequantize(stored.data(), DataType::Int32, restored.data(), DataType::Float32, values.size(), Quantization()), std::runtime_error);
+	EXPECT_THROW(Encoding::Dequantize(stored.data(), DataType::Int8, restored.data(), DataType::Int32, values.size(), Quantization()), std::runtime_error);
+}
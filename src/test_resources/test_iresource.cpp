@@ -1,10 +1,15 @@
 
 #include "test_resources/config.h"
 
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <gtest/gtest.h>
+#include <boost/crc.hpp>
+#include <omp.h>
 
 #include "Resources/IResource.h"
+#include "Resources/Layout.h"
 
 namespace
 {
@@ -32,6 +37,16 @@ namespace
 			SetRowSize(size);
 		}
 
+		void SetShapeProtected(const std::vector<size_t> &shape)
+		{
+			SetShape(shape);
+		}
+
+		void SetLayoutProtected(const resource::Layout &layout)
+		{
+			SetLayout(layout);
+		}
+
 		size_t GetElementSize() const override
 		{
 			return SIZE;
@@ -53,6 +68,7 @@ namespace
 
 		bool UpdateChecksumProtected() { return UpdateChecksum(); }
 		int ChecksumProtected() { return Checksum(); }
+		static uint32_t Crc32Protected(const void *buff, const size_t size, const uint32_t crc = 0) { return Crc32(buff, size, crc); }
 
 	private:
 		std::vector<int> data_;
@@ -92,6 +108,49 @@ TEST(IResource, GetRowSize)
 	EXPECT_EQ(resource.GetRowSize(), SIZE);
 }
 
+TEST(IResource, SetShape)
+{
+	Resource resource;
+	EXPECT_NO_THROW(resource.SetShapeProtected({2, 3, 4}));
+	EXPECT_EQ(resource.GetRank(), size_t(3));
+	EXPECT_EQ(resource.GetShape(), std::vector<size_t>({2, 3, 4}));
+	EXPECT_EQ(resource.GetColumnSize(), size_t(2));
+	EXPECT_EQ(resource.GetRowSize(), size_t(12));
+}
+
+TEST(IResource, SetShapeThrows)
+{
+	Resource resource;
+	EXPECT_THROW(resource.SetShapeProtected({}), std::runtime_error);
+
+	resource.SetShapeProtected({2, 3, 4});
+	EXPECT_NO_THROW(resource.SetShapeProtected({2, 3, 4}));
+	EXPECT_THROW(resource.SetShapeProtected({2, 4, 3}), std::runtime_error);
+	EXPECT_THROW(resource.SetColumnSizeProtected(3), std::runtime_error);
+}
+
+TEST(IResource, GetShape)
+{
+	Resource resource(ARRAY_1);
+	EXPECT_EQ(resource.GetRank(), size_t(2));
+	EXPECT_EQ(resource.GetShape(), std::vector<size_t>({1, ARRAY_1.size()}));
+
+	resource.SetShapeProtected({1, ARRAY_1.size()});
+	EXPECT_EQ(resource.GetRank(), size_t(2));
+}
+
+TEST(IResource, SetLayout)
+{
+	Resource resource;
+	EXPECT_EQ(resource.GetLayout(), resource::Layout::RowMajor());
+
+	resource.SetShapeProtected({4, 6});
+	EXPECT_NO_THROW(resource.SetLayoutProtected(resource::Layout::Tiled({2, 3})));
+	EXPECT_EQ(resource.GetLayout(), resource::Layout::Tiled({2, 3}));
+	EXPECT_THROW(resource.SetLayoutProtected(resource::Layout::Tiled({4, 4})), std::runtime_error);
+	EXPECT_THROW(resource.SetLayoutProtected(resource::Layout::Tiled({2, 3, 1})), std::runtime_error);
+}
+
 TEST(IResource, GetElementSize)
 {
 	Resource resource;
@@ -138,6 +197,36 @@ TEST(IResource, Checksum)
 	EXPECT_NE(ir.ChecksumProtected(), checksum);
 }
 
+TEST(IResource, Crc32)
+{
+	// large enough to be hashed in parallel, and not a whole number of segments
+	std::vector<unsigned char> bytes((size_t(1) << 25) + 12345);
+	uint32_t state = 1;
+	for (unsigned char &byte : bytes)
+	{
+		state = state * 1664525u + 1013904223u;
+		byte = static_cast<unsigned char>(state >> 24);
+	}
+
+	boost::crc_32_type expected;
+	expected.process_bytes(bytes.data(), bytes.size());
+
+	// the same as a sequential CRC-32 whatever the number of threads
+	const int threads = omp_get_max_threads();
+	for (int count : {1, 3, 8})
+	{
+		omp_set_num_threads(count);
+		EXPECT_EQ(Resource::Crc32Protected(bytes.data(), bytes.size()), expected.checksum());
+	}
+	omp_set_num_threads(threads);
+
+	// continuing from the CRC-32 of a prefix
+	const size_t split = 1000;
+	const uint32_t prefix = Resource::Crc32Protected(bytes.data(), split);
+	EXPECT_EQ(Resource::Crc32Protected(bytes.data() + split, bytes.size() - split, prefix), expected.checksum());
+	EXPECT_EQ(Resource::Crc32Protected(bytes.data(), 0), uint32_t(0));
+}
+
 TEST(IResource, GetDirty)
 {
 	Resource ir(ARRAY_1);
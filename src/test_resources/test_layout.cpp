@@ -0,0 +1,92 @@
+#include "test_resources/config.h"
+
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/Layout.h"
+
+using resource::Layout;
+using resource::LayoutType;
+
+namespace
+{
+	const std::vector<size_t> SHAPE = {2, 4};
+	const std::vector<size_t> TILE = {2, 2};
+
+	// 2 x 4 matrix in row-major order
+	const std::vector<int> ROW_MAJOR = {0, 1, 2, 3, 4, 5, 6, 7};
+	const std::vector<int> COLUMN_MAJOR = {0, 4, 1, 5, 2, 6, 3, 7};
+	const std::vector<int> TILED = {0, 1, 4, 5, 2, 3, 6, 7};
+
+	std::vector<int> Convert(const std::vector<int> &src, const Layout &from, const Layout &to, const std::vector<size_t> &shape = SHAPE)
+	{
+		std::vector<int> dst(src.size());
+		Layout::Convert(reinterpret_cast<const char *>(src.data()), from, reinterpret_cast<char *>(dst.data()), to, shape, sizeof(int));
+		return dst;
+	}
+} // end namespace
+
+TEST(Layout, Construct)
+{
+	Layout layout;
+	EXPECT_EQ(layout.GetType(), LayoutType::RowMajor);
+	EXPECT_TRUE(layout.GetTileShape().empty());
+	EXPECT_EQ(layout, Layout::RowMajor());
+}
+
+TEST(Layout, Make)
+{
+	EXPECT_EQ(Layout::Make(LayoutType::ColumnMajor), Layout::ColumnMajor());
+	EXPECT_EQ(Layout::Make(LayoutType::Tiled, TILE).GetTileShape(), TILE);
+	EXPECT_FALSE(Layout::Tiled(TILE) == Layout::Tiled({1, 2}));
+}
+
+TEST(Layout, MakeThrows)
+{
+	EXPECT_THROW(Layout::Make(LayoutType::RowMajor, TILE), std::runtime_error);
+	EXPECT_THROW(Layout::Make(LayoutType::Tiled), std::runtime_error);
+	EXPECT_THROW(Layout::Tiled({2, 0}), std::runtime_error);
+	EXPECT_THROW(Layout::Make(static_cast<LayoutType>(7)), std::runtime_error);
+}
+
+TEST(Layout, Validate)
+{
+	EXPECT_NO_THROW(Layout::RowMajor().Validate({3, 5, 7}));
+	EXPECT_NO_THROW(Layout::Tiled(TILE).Validate(SHAPE));
+	EXPECT_THROW(Layout::Tiled({2, 3}).Validate(SHAPE), std::runtime_error);
+	EXPECT_THROW(Layout::Tiled({2, 2, 2}).Validate(SHAPE), std::runtime_error);
+}
+
+TEST(Layout, GetOffset)
+{
+	EXPECT_EQ(Layout::RowMajor().GetOffset(SHAPE, {1, 2}), size_t(6));
+	EXPECT_EQ(Layout::ColumnMajor().GetOffset(SHAPE, {1, 2}), size_t(5));
+	EXPECT_EQ(Layout::Tiled(TILE).GetOffset(SHAPE, {1, 2}), size_t(6));
+	EXPECT_EQ(Layout::Tiled(TILE).GetOffset(SHAPE, {0, 2}), size_t(4));
+	EXPECT_EQ(Layout::Tiled(TILE).GetOffset(SHAPE, {1, 1}), size_t(3));
+	EXPECT_EQ(Layout::RowMajor().GetOffset({2, 3, 4}, {1, 2, 3}), size_t(23));
+	EXPECT_EQ(Layout::ColumnMajor().GetOffset({2, 3, 4}, {1, 2, 3}), size_t(23));
+	EXPECT_EQ(Layout::ColumnMajor().GetOffset({2, 3, 4}, {1, 0, 0}), size_t(1));
+}
+
+TEST(Layout, GetOffsetThrows)
+{
+	EXPECT_THROW(Layout::RowMajor().GetOffset(SHAPE, {1}), std::runtime_error);
+	EXPECT_THROW(Layout::RowMajor().GetOffset(SHAPE, {2, 0}), std::runtime_error);
+	EXPECT_THROW(Layout::Tiled({2, 3}).GetOffset(SHAPE, {0, 0}), std::runtime_error);
+}
+
+TEST(Layout, Convert)
+{
+	EXPECT_EQ(Convert(ROW_MAJOR, Layout::RowMajor(), Layout::ColumnMajor()), COLUMN_MAJOR);
+	EXPECT_EQ(Convert(COLUMN_MAJOR, Layout::ColumnMajor(), Layout::RowMajor()), ROW_MAJOR);
+	EXPECT_EQ(Convert(ROW_MAJOR, Layout::RowMajor(), Layout::Tiled(TILE)), TILED);
+	EXPECT_EQ(Convert(TILED, Layout::Tiled(TILE), Layout::ColumnMajor()), COLUMN_MAJOR);
+	EXPECT_EQ(Convert(ROW_MAJOR, Layout::RowMajor(), Layout::RowMajor()), ROW_MAJOR);
+}
+
+TEST(Layout, ConvertThrows)
+{
+	EXPECT_THROW(Convert(ROW_MAJOR, Layout::RowMajor(), Layout::Tiled({2, 3})), std::runtime_error);
+}
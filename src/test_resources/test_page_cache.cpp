@@ -0,0 +1,198 @@
+#include "test_resources/config.h"
+
+#include <cstring>
+#include <future>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/ChunkedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/IChunkStore.h"
+#include "Resources/PageCache.h"
+
+using resource::ChunkedResource;
+using resource::DataType;
+using resource::IChunkStore;
+using resource::PageCache;
+
+namespace
+{
+	const size_t M = 8;
+	const size_t N = 64;
+	const size_t CHUNK_BYTES = N * sizeof(int);
+
+	struct MemoryStore : IChunkStore
+	{
+		MemoryStore(std::vector<int> &payload) : payload_(payload) {}
+
+		std::vector<size_t> GetShape() const override { return {M, N}; }
+		DataType GetDataType() const override { return DataType::Int32; }
+		size_t GetSize() const override { return payload_.size() * sizeof(int); }
+
+		void Read(const size_t offset, char *buff, const size_t n) override
+		{
+			std::memcpy(buff, reinterpret_cast<const char *>(payload_.data()) + offset, n);
+		}
+
+		void Write(const size_t offset, const char *buff, const size_t n) override
+		{
+			std::memcpy(reinterpret_cast<char *>(payload_.data()) + offset, buff, n);
+		}
+
+	private:
+		std::vector<int> &payload_;
+	};
+
+	// a store whose reads wait until they are released
+	struct BlockingStore : MemoryStore
+	{
+		BlockingStore(std::vector<int> &payload, std::shared_future<void> release) : MemoryStore(payload), release_(release) {}
+
+		void Read(const size_t offset, char *buff, const size_t n) override
+		{
+			started.set_value();
+			release_.wait();
+			MemoryStore::Read(offset, buff, n);
+		}
+
+		std::promise<void> started;
+
+	private:
+		std::shared_future<void> release_;
+	};
+
+	// one row per chunk
+	struct Resource : ChunkedResource
+	{
+		Resource() = default;
+
+		Resource(std::vector<int> &payload)
+		{
+			Open(std::make_unique<MemoryStore>(payload), 1);
+		}
+
+		size_t GetElementSize() const override { return sizeof(int); }
+		DataType GetDataType() const override { return DataType::Int32; }
+	};
+
+	struct BudgetRestorer
+	{
+		BudgetRestorer() : budget_(PageCache::GetInstance()->GetBudget()) {}
+		~BudgetRestorer()
+		{
+			PageCache::GetInstance()->Clear();
+			PageCache::GetInstance()->SetBudget(budget_);
+		}
+
+	private:
+		size_t budget_;
+	};
+} // end namespace
+
+TEST(PageCache, GetInstance)
+{
+	EXPECT_TRUE(PageCache::GetInstance());
+}
+
+TEST(PageCache, SetBudget)
+{
+	BudgetRestorer restorer;
+	PageCache *cache = PageCache::GetInstance();
+	cache->SetBudget(CHUNK_BYTES);
+	EXPECT_EQ(cache->GetBudget(), CHUNK_BYTES);
+}
+
+TEST(PageCache, EvictsLeastRecentlyUsed)
+{
+	BudgetRestorer restorer;
+	PageCache *cache = PageCache::GetInstance();
+	cache->SetBudget(2 * CHUNK_BYTES);
+
+	std::vector<int> payload(M * N, 0);
+	Resource resource(payload);
+	resource.ReadChunk(0);
+	resource.ReadChunk(1);
+	resource.ReadChunk(0);
+	resource.ReadChunk(2);
+
+	EXPECT_EQ(cache->GetResidentCount(), size_t(2));
+	EXPECT_EQ(cache->GetResidentBytes(), 2 * CHUNK_BYTES);
+	EXPECT_TRUE(resource.IsResident(0));
+	EXPECT_FALSE(resource.IsResident(1));
+	EXPECT_TRUE(resource.IsResident(2));
+}
+
+TEST(PageCache, DoesNotEvictPinned)
+{
+	BudgetRestorer restorer;
+	PageCache *cache = PageCache::GetInstance();
+	cache->SetBudget(CHUNK_BYTES);
+
+	std::vector<int> payload(M * N, 0);
+	Resource resource(payload);
+	std::shared_ptr<const void> pinned = resource.ReadChunk(0);
+	resource.ReadChunk(1);
+	EXPECT_TRUE(resource.IsResident(0));
+
+	pinned.reset();
+	EXPECT_FALSE(resource.IsResident(0));
+}
+
+TEST(PageCache, EvictionWritesBack)
+{
+	BudgetRestorer restorer;
+	PageCache *cache = PageCache::GetInstance();
+	cache->SetBudget(CHUNK_BYTES);
+
+	std::vector<int> payload(M * N, 0);
+	Resource resource(payload);
+	static_cast<int *>(resource.WriteChunk(0).get())[0] = 5;
+	EXPECT_EQ(payload[0], 0);
+
+	resource.ReadChunk(1);
+	EXPECT_FALSE(resource.IsResident(0));
+	EXPECT_EQ(payload[0], 5);
+}
+
+TEST(PageCache, Clear)
+{
+	BudgetRestorer restorer;
+	PageCache *cache = PageCache::GetInstance();
+
+	std::vector<int> payload(M * N, 0);
+	Resource resource(payload);
+	static_cast<int *>(resource.WriteChunk(3).get())[0] = 5;
+	resource.ReadChunk(4);
+
+	cache->Clear();
+	EXPECT_FALSE(resource.IsResident(3));
+	EXPECT_FALSE(resource.IsResident(4));
+	EXPECT_EQ(payload[3 * N], 5);
+}
+
+TEST(PageCache, LoadDoesNotBlockOtherResources)
+{
+	BudgetRestorer restorer;
+
+	std::vector<int> cold(M * N, 1);
+	std::promise<void> release;
+	auto store = std::make_unique<BlockingStore>(cold, release.get_future().share());
+	std::future<void> started = store->started.get_future();
+	Resource slow;
+	slow.Open(std::move(store), 1);
+
+	std::future<int> read = std::async(std::launch::async, [&slow]()
+									   { return static_cast<const int *>(slow.ReadChunk(0).get())[0]; });
+	started.wait();
+
+	// the cold chunk is still being read, yet other resources are served
+	std::vector<int> payload(M * N, 2);
+	Resource fast(payload);
+	EXPECT_EQ(static_cast<const int *>(fast.ReadChunk(0).get())[0], 2);
+	EXPECT_FALSE(slow.IsResident(0));
+
+	release.set_value();
+	EXPECT_EQ(read.get(), 1);
+	EXPECT_TRUE(slow.IsResident(0));
+}
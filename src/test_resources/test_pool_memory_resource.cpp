@@ -0,0 +1,120 @@
+#include "test_resources/config.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/PoolMemoryResource.h"
+
+using resource::PoolMemoryResource;
+
+namespace
+{
+	const size_t ALIGNMENT = 64;
+	const size_t MAX_BLOCK_SIZE = 4096;
+
+	bool IsAligned(const void *p, const size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+	}
+} // end namespace
+
+TEST(PoolMemoryResource, Construct)
+{
+	EXPECT_NO_THROW(PoolMemoryResource());
+	PoolMemoryResource pool(ALIGNMENT, 3000);
+	EXPECT_EQ(pool.GetAlignment(), ALIGNMENT);
+	EXPECT_EQ(pool.GetMaxBlockSize(), MAX_BLOCK_SIZE);
+	EXPECT_EQ(pool.GetPooledBytes(), 0);
+}
+
+TEST(PoolMemoryResource, ConstructThrows)
+{
+	EXPECT_THROW(PoolMemoryResource(48), std::runtime_error);
+	EXPECT_THROW(PoolMemoryResource(2), std::runtime_error);
+	EXPECT_THROW(PoolMemoryResource(ALIGNMENT, 16), std::runtime_error);
+	EXPECT_THROW(PoolMemoryResource(ALIGNMENT, MAX_BLOCK_SIZE, nullptr), std::runtime_error);
+}
+
+TEST(PoolMemoryResource, Allocate)
+{
+	PoolMemoryResource pool(ALIGNMENT, MAX_BLOCK_SIZE);
+
+	for (size_t bytes : {1, 63, 64, 65, 1000, 4096, 10000})
+	{
+		void *p = pool.allocate(bytes, alignof(double));
+		EXPECT_TRUE(IsAligned(p, ALIGNMENT));
+		pool.deallocate(p, bytes, alignof(double));
+	}
+}
+
+TEST(PoolMemoryResource, AllocateOverAligned)
+{
+	PoolMemoryResource pool(ALIGNMENT, MAX_BLOCK_SIZE);
+
+	void *p = pool.allocate(100, 256);
+	EXPECT_TRUE(IsAligned(p, 256));
+	pool.deallocate(p, 100, 256);
+	EXPECT_EQ(pool.GetPooledBytes(), 0);
+}
+
+TEST(PoolMemoryResource, Recycle)
+{
+	PoolMemoryResource pool(ALIGNMENT, MAX_BLOCK_SIZE);
+
+	void *first = pool.allocate(1000);
+	pool.deallocate(first, 1000);
+	EXPECT_EQ(pool.GetPooledBytes(), 1024);
+
+	// same size class
+	void *second = pool.allocate(600);
+	EXPECT_EQ(second, first);
+	EXPECT_EQ(pool.GetPooledBytes(), 0);
+	pool.deallocate(second, 600);
+}
+
+TEST(PoolMemoryResource, OversizedIsNotPooled)
+{
+	PoolMemoryResource pool(ALIGNMENT, MAX_BLOCK_SIZE);
+
+	void *p = pool.allocate(MAX_BLOCK_SIZE + 1);
+	pool.deallocate(p, MAX_BLOCK_SIZE + 1);
+	EXPECT_EQ(pool.GetPooledBytes(), 0);
+}
+
+TEST(PoolMemoryResource, Release)
+{
+	PoolMemoryResource pool(ALIGNMENT, MAX_BLOCK_SIZE);
+
+	void *p = pool.allocate(100);
+	void *q = pool.allocate(2000);
+	pool.deallocate(p, 100);
+	pool.deallocate(q, 2000);
+	EXPECT_EQ(pool.GetPooledBytes(), 128 + 2048);
+
+	pool.Release();
+	EXPECT_EQ(pool.GetPooledBytes(), 0);
+}
+
+TEST(PoolMemoryResource, IsEqual)
+{
+	PoolMemoryResource pool;
+	PoolMemoryResource other;
+	EXPECT_TRUE(pool.is_equal(pool));
+	EXPECT_FALSE(pool.is_equal(other));
+}
+
+TEST(PoolMemoryResource, PmrVector)
+{
+	PoolMemoryResource pool(ALIGNMENT, MAX_BLOCK_SIZE);
+	{
+		std::pmr::vector<int> values(100, 7, &pool);
+		EXPECT_TRUE(IsAligned(values.data(), ALIGNMENT));
+	}
+	EXPECT_EQ(pool.GetPooledBytes(), 512);
+
+	std::pmr::vector<int> values(120, 7, &pool);
+	EXPECT_EQ(pool.GetPooledBytes(), 0);
+}
@@ -0,0 +1,238 @@
+#include "test_resources/config.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/CompressedResource.h"
+#include "Resources/DataType.h"
+#include "Resources/DecompressionCache.h"
+#include "Resources/IResource.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceExpression.h"
+#include "Resources/SparseResource.h"
+
+using resource::CompressedResource;
+using resource::DataType;
+using resource::DataTypeConverter;
+using resource::DecompressionCache;
+using resource::Elements;
+using resource::Evaluate;
+
+namespace
+{
+	const size_t M = 3;
+	const size_t N = 4;
+
+	template <typename T>
+	struct Resource : resource::IResource
+	{
+		Resource(const size_t rows = M, const size_t columns = N) : data_(rows * columns)
+		{
+			SetColumnSize(rows);
+			SetRowSize(columns);
+			for (size_t i = 0; i < data_.size(); ++i)
+				data_[i] = static_cast<T>(i);
+		}
+
+		size_t GetElementSize() const override
+		{
+			return sizeof(T);
+		}
+
+		DataType GetDataType() const override
+		{
+			return DataTypeConverter::GetDataType<T>();
+		}
+
+		void *Data() override
+		{
+			return data_.data();
+		}
+
+		const void *Data() const override
+		{
+			return data_.data();
+		}
+
+		void Assign(const char *buff, const size_t n) override
+		{
+		}
+
+		const std::vector<T> &Values() const
+		{
+			return data_;
+		}
+
+		void SetLayoutProtected(const resource::Layout &layout)
+		{
+			SetLayout(layout);
+		}
+
+	private:
+		std::vector<T> data_;
+	};
+
+	struct Compressed : CompressedResource
+	{
+		Compressed(const int value)
+		{
+			const std::vector<int> values(M * N, value);
+			SetColumnSize(M);
+			SetRowSize(N);
+			Assign(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+		}
+
+		size_t GetElementSize() const override
+		{
+			return sizeof(int);
+		}
+
+		DataType GetDataType() const override
+		{
+			return DataType::Int32;
+		}
+	};
+
+	struct Sparse : resource::SparseResource
+	{
+		size_t GetElementSize() const override
+		{
+			return sizeof(double);
+		}
+	};
+} // end namespace
+
+TEST(ResourceExpression, Evaluate)
+{
+	const Resource<double> a;
+	const Resource<double> b;
+	const Resource<double> c;
+	Resource<double> result;
+	EXPECT_NO_THROW(Evaluate<double>(result, Elements<double>(a) * 2.0 + Elements<double>(b) - Elements<double>(c) / 4.0));
+
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_DOUBLE_EQ(result.Values()[i], 2.0 * i + i - i / 4.0);
+}
+
+TEST(ResourceExpression, EvaluateScalar)
+{
+	const Resource<int> a;
+	Resource<int> result;
+	Evaluate<int>(result, 10 - Elements<int>(a) * 3 + 1);
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_EQ(result.Values()[i], 10 - 3 * static_cast<int>(i) + 1);
+
+	Evaluate<int>(result, -Elements<int>(a));
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_EQ(result.Values()[i], -static_cast<int>(i));
+
+	// a scalar-only expression fills the target
+	Evaluate<int>(result, resource::ScalarOperand<int>(7) * 2);
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_EQ(result.Values()[i], 14);
+}
+
+TEST(ResourceExpression, EvaluateMixedTypes)
+{
+	const Resource<int> a;
+	const Resource<float> b;
+	Resource<double> result;
+	Evaluate<double>(result, Elements<int>(a) + Elements<float>(b) / 2.0f);
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_DOUBLE_EQ(result.Values()[i], i + i / 2.0);
+}
+
+TEST(ResourceExpression, EvaluateInPlace)
+{
+	Resource<float> a;
+	const Resource<float> b;
+	Evaluate<float>(a, Elements<float>(a) * Elements<float>(b) + 1.0f);
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_FLOAT_EQ(a.Values()[i], float(i) * float(i) + 1.0f);
+}
+
+TEST(ResourceExpression, EvaluateCompressed)
+{
+	DecompressionCache *cache = DecompressionCache::GetInstance();
+	const size_t budget = cache->GetBudget();
+	cache->Clear();
+
+	// the budget holds a single payload, so each acquire would evict the others unless they are pinned
+	cache->SetBudget(M * N * sizeof(int));
+	const Compressed a(2);
+	const Compressed b(3);
+	Compressed result(0);
+	Evaluate<int>(result, Elements<int>(a) * Elements<int>(b) + 1);
+
+	const int *values = static_cast<const int *>(static_cast<const Compressed &>(result).Data());
+	for (size_t i = 0; i < M * N; ++i)
+		EXPECT_EQ(values[i], 7);
+
+	cache->SetBudget(budget);
+}
+
+TEST(ResourceExpression, EvaluateParallel)
+{
+	const size_t rows = 512;
+	const size_t columns = 256;
+	const Resource<float> a(rows, columns);
+	const Resource<float> b(rows, columns);
+	Resource<float> serial(rows, columns);
+	Resource<float> parallel(rows, columns);
+
+	const auto expression = Elements<float>(a) * 0.5f - Elements<float>(b) * Elements<float>(b);
+	Evaluate<float>(serial, expression);
+	Evaluate<float>(parallel, expression, true);
+	EXPECT_EQ(serial.Values(), parallel.Values());
+}
+
+TEST(ResourceExpression, ElementsThrows)
+{
+	const Resource<float> a;
+	EXPECT_THROW(Elements<double>(a), std::runtime_error);
+	EXPECT_THROW(Elements<int32_t>(a), std::runtime_error);
+
+	const Sparse sparse;
+	EXPECT_THROW(Elements<double>(sparse), std::runtime_error);
+}
+
+TEST(ResourceExpression, EvaluateThrows)
+{
+	const Resource<double> a;
+	const Resource<double> b(M + 1, N);
+	EXPECT_THROW(Elements<double>(a) + Elements<double>(b), std::runtime_error);
+
+	Resource<double> result(M + 1, N);
+	EXPECT_THROW(Evaluate<double>(result, Elements<double>(a) * 2.0), std::runtime_error);
+	EXPECT_THROW(Evaluate<float>(result, Elements<double>(b) * 2.0), std::runtime_error);
+}
+
+TEST(ResourceExpression, ShapeMismatchThrows)
+{
+	// the same number of elements, transposed
+	const Resource<double> a(2, 3);
+	const Resource<double> b(3, 2);
+	EXPECT_THROW(Elements<double>(a) + Elements<double>(b), std::runtime_error);
+
+	Resource<double> result(3, 2);
+	EXPECT_THROW(Evaluate<double>(result, Elements<double>(a) * 2.0), std::runtime_error);
+	EXPECT_NO_THROW(Evaluate<double>(result, Elements<double>(b) * 2.0));
+}
+
+TEST(ResourceExpression, LayoutMismatchThrows)
+{
+	Resource<double> a(2, 3);
+	Resource<double> b(2, 3);
+	b.SetLayoutProtected(resource::Layout::ColumnMajor());
+	EXPECT_THROW(Elements<double>(a) - Elements<double>(b), std::runtime_error);
+	EXPECT_THROW(Evaluate<double>(a, -Elements<double>(b)), std::runtime_error);
+
+	// operands of one layout combine position by position
+	Resource<double> c(2, 3);
+	c.SetLayoutProtected(resource::Layout::ColumnMajor());
+	Evaluate<double>(c, Elements<double>(b) - Elements<double>(c));
+	for (double value : c.Values())
+		EXPECT_EQ(value, 0.0);
+}
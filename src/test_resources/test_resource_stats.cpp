@@ -0,0 +1,98 @@
+#include "test_resources/config.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/DataType.h"
+#include "Resources/ResourceStats.h"
+
+using resource::DataType;
+using resource::ResourceStats;
+
+namespace
+{
+	const double NaN = std::numeric_limits<double>::quiet_NaN();
+} // end namespace
+
+TEST(ResourceStats, Construct)
+{
+	const ResourceStats stats;
+	EXPECT_EQ(stats.GetCount(), uint64_t(0));
+	EXPECT_EQ(stats.GetNaNCount(), uint64_t(0));
+	EXPECT_EQ(stats.GetSum(), 0.0);
+	EXPECT_GT(stats.GetMin(), stats.GetMax());
+	EXPECT_FALSE(stats.MayContain(-1e300, 1e300));
+}
+
+TEST(ResourceStats, Compute)
+{
+	const std::vector<int16_t> values = {4, -7, 12, 0, 3};
+	const ResourceStats stats = ResourceStats::Compute(values.data(), DataType::Int16, values.size());
+	EXPECT_EQ(stats.GetMin(), -7.0);
+	EXPECT_EQ(stats.GetMax(), 12.0);
+	EXPECT_EQ(stats.GetSum(), 12.0);
+	EXPECT_EQ(stats.GetCount(), uint64_t(5));
+	EXPECT_EQ(stats.GetNaNCount(), uint64_t(0));
+}
+
+TEST(ResourceStats, ComputeSkipsNaN)
+{
+	const std::vector<double> values = {NaN, 2.5, NaN, -1.0};
+	const ResourceStats stats = ResourceStats::Compute(values.data(), DataType::Float64, values.size());
+	EXPECT_EQ(stats.GetMin(), -1.0);
+	EXPECT_EQ(stats.GetMax(), 2.5);
+	EXPECT_EQ(stats.GetSum(), 1.5);
+	EXPECT_EQ(stats.GetCount(), uint64_t(4));
+	EXPECT_EQ(stats.GetNaNCount(), uint64_t(2));
+
+	const std::vector<double> nans(3, NaN);
+	EXPECT_FALSE(ResourceStats::Compute(nans.data(), DataType::Float64, nans.size()).MayContain(-1e300, 1e300));
+}
+
+TEST(ResourceStats, ComputeLargePayload)
+{
+	// spans several conversion blocks
+	std::vector<float> values(5000);
+	for (size_t i = 0; i < values.size(); ++i)
+		values[i] = static_cast<float>(i);
+	const ResourceStats stats = ResourceStats::Compute(values.data(), DataType::Float32, values.size());
+	EXPECT_EQ(stats.GetMin(), 0.0);
+	EXPECT_EQ(stats.GetMax(), 4999.0);
+	EXPECT_EQ(stats.GetSum(), 4999.0 * 5000.0 / 2.0);
+	EXPECT_EQ(stats.GetCount(), uint64_t(5000));
+}
+
+TEST(ResourceStats, ComputeThrows)
+{
+	const std::vector<char> bytes(4, 0);
+	EXPECT_THROW(ResourceStats::Compute(bytes.data(), DataType::Unknown, bytes.size()), std::runtime_error);
+}
+
+TEST(ResourceStats, Merge)
+{
+	const std::vector<int> first = {1, 5};
+	const std::vector<int> second = {-3, 2};
+	ResourceStats stats = ResourceStats::Compute(first.data(), DataType::Int32, first.size());
+	stats.Merge(ResourceStats::Compute(second.data(), DataType::Int32, second.size()));
+
+	const std::vector<int> all = {1, 5, -3, 2};
+	EXPECT_EQ(stats, ResourceStats::Compute(all.data(), DataType::Int32, all.size()));
+
+	// merging nothing changes nothing
+	const ResourceStats before = stats;
+	stats.Merge(ResourceStats());
+	EXPECT_EQ(stats, before);
+}
+
+TEST(ResourceStats, MayContain)
+{
+	const ResourceStats stats(2.0, 8.0, 20.0, 4, 0);
+	EXPECT_TRUE(stats.MayContain(0.0, 2.0));
+	EXPECT_TRUE(stats.MayContain(3.0, 4.0));
+	EXPECT_TRUE(stats.MayContain(8.0, 100.0));
+	EXPECT_FALSE(stats.MayContain(-5.0, 1.5));
+	EXPECT_FALSE(stats.MayContain(8.5, 9.0));
+}
@@ -0,0 +1,195 @@
+#include "test_resources/config.h"
+
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/IResource.h"
+#include "Resources/Layout.h"
+#include "Resources/ResourceView.h"
+
+using resource::ResourceView;
+
+namespace
+{
+	const size_t M = 3;
+	const size_t N = 4;
+
+	struct Resource : resource::IResource
+	{
+		Resource() : data_(M * N)
+		{
+			SetColumnSize(M);
+			SetRowSize(N);
+			for (size_t i = 0; i < data_.size(); ++i)
+				data_[i] = static_cast<int>(i);
+		}
+
+		size_t GetElementSize() const override
+		{
+			return sizeof(int);
+		}
+
+		void *Data() override
+		{
+			return data_.data();
+		}
+
+		const void *Data() const override
+		{
+			return data_.data();
+		}
+
+		void Assign(const char *buff, const size_t n) override
+		{
+		}
+
+		void SetLayoutProtected(const resource::Layout &layout)
+		{
+			SetLayout(layout);
+		}
+
+	private:
+		std::vector<int> data_;
+	};
+} // end namespace
+
+TEST(ResourceView, Construct)
+{
+	Resource resource;
+	EXPECT_NO_THROW(ResourceView view(resource));
+}
+
+TEST(ResourceView, ConstructThrowsOutOfBounds)
+{
+	Resource resource;
+	EXPECT_THROW(ResourceView(resource, 1, M, N, N, 1), std::runtime_error);
+}
+
+TEST(ResourceView, GetSizes)
+{
+	Resource resource;
+	ResourceView view(resource);
+
+	EXPECT_EQ(view.GetColumnSize(), M);
+	EXPECT_EQ(view.GetRowSize(), N);
+	EXPECT_EQ(view.GetElementSize(), sizeof(int));
+	EXPECT_EQ(view.GetByteSize(), M * N * sizeof(int));
+	EXPECT_EQ(view.GetOffset(), size_t(0));
+	EXPECT_EQ(view.GetStride(0), N);
+	EXPECT_EQ(view.GetStride(1), size_t(1));
+	EXPECT_THROW(view.GetStride(2), std::runtime_error);
+	EXPECT_EQ(&view.GetParent(), &resource);
+}
+
+TEST(ResourceView, Get)
+{
+	Resource resource;
+	ResourceView view(resource);
+
+	EXPECT_EQ(view.Get<int>(1, 2), int(N + 2));
+	EXPECT_THROW(view.Get<int>(M, 0), std::runtime_error);
+	EXPECT_THROW(view.Get<double>(0, 0), std::runtime_error);
+}
+
+TEST(ResourceView, Rows)
+{
+	Resource resource;
+	ResourceView view = ResourceView(resource).Rows(1, 2);
+
+	EXPECT_EQ(view.GetColumnSize(), size_t(2));
+	EXPECT_EQ(view.GetRowSize(), N);
+	EXPECT_TRUE(view.IsContiguous());
+	EXPECT_EQ(view.Get<int>(0, 0), int(N));
+	EXPECT_THROW(ResourceView(resource).Rows(2, 2), std::runtime_error);
+}
+
+TEST(ResourceView, Column)
+{
+	Resource resource;
+	ResourceView view = ResourceView(resource).Column(3);
+
+	EXPECT_EQ(view.GetColumnSize(), M);
+	EXPECT_EQ(view.GetRowSize(), size_t(1));
+	EXPECT_TRUE(view.IsRowContiguous());
+	EXPECT_FALSE(view.IsContiguous());
+	for (size_t i = 0; i < M; ++i)
+		EXPECT_EQ(view.Get<int>(i, 0), int(i * N + 3));
+}
+
+TEST(ResourceView, Block)
+{
+	Resource resource;
+	ResourceView view = ResourceView(resource).Block(1, 1, 2, 2);
+
+	EXPECT_TRUE(view.IsRowContiguous());
+	EXPECT_FALSE(view.IsContiguous());
+	EXPECT_EQ(view.Get<int>(0, 0), int(N + 1));
+	EXPECT_EQ(view.Get<int>(1, 1), int(2 * N + 2));
+
+	ResourceView nested = view.Block(1, 1, 1, 1);
+	EXPECT_EQ(nested.Get<int>(0, 0), int(2 * N + 2));
+}
+
+TEST(ResourceView, StridedView)
+{
+	Resource resource;
+	// every other column of every row
+	ResourceView view(resource, 0, M, N / 2, N, 2);
+
+	EXPECT_FALSE(view.IsRowContiguous());
+	EXPECT_EQ(view.Get<int>(2, 1), int(2 * N + 2));
+}
+
+TEST(ResourceView, ColumnMajorParent)
+{
+	Resource resource;
+	resource.SetLayoutProtected(resource::Layout::ColumnMajor());
+	ResourceView view(resource);
+
+	// element (i, j) of a column-major parent is stored at i + j * M
+	EXPECT_EQ(view.GetStride(0), size_t(1));
+	EXPECT_EQ(view.GetStride(1), M);
+	EXPECT_FALSE(view.IsRowContiguous());
+	EXPECT_EQ(view.Get<int>(1, 2), int(1 + 2 * M));
+
+	ResourceView rows = view.Rows(1, 2);
+	EXPECT_EQ(rows.Get<int>(1, 3), int(2 + 3 * M));
+
+	std::vector<int> buff(N);
+	rows.CopyRow(0, reinterpret_cast<char *>(buff.data()));
+	for (size_t j = 0; j < N; ++j)
+		EXPECT_EQ(buff[j], int(1 + j * M));
+}
+
+TEST(ResourceView, TiledParentThrows)
+{
+	Resource resource;
+	resource.SetLayoutProtected(resource::Layout::Tiled({1, 2}));
+	EXPECT_THROW(ResourceView view(resource), std::runtime_error);
+	EXPECT_THROW(ResourceView(resource, 0, M, N, N, 1), std::runtime_error);
+}
+
+TEST(ResourceView, CopyRow)
+{
+	Resource resource;
+	ResourceView view(resource, 0, M, N / 2, N, 2);
+
+	std::vector<int> row(N / 2);
+	view.CopyRow(1, reinterpret_cast<char *>(row.data()));
+	EXPECT_EQ(row[0], int(N));
+	EXPECT_EQ(row[1], int(N + 2));
+	EXPECT_THROW(view.CopyRow(0, nullptr), std::runtime_error);
+}
+
+TEST(ResourceView, CopyTo)
+{
+	Resource resource;
+	ResourceView view = ResourceView(resource).Column(1);
+
+	std::vector<int> column(M);
+	view.CopyTo(reinterpret_cast<char *>(column.data()));
+	for (size_t i = 0; i < M; ++i)
+		EXPECT_EQ(column[i], int(i * N + 1));
+	EXPECT_THROW(view.CopyTo(nullptr), std::runtime_error);
+}
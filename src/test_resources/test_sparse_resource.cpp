@@ -0,0 +1,200 @@
+#include "test_resources/config.h"
+
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/ArenaMemoryResource.h"
+#include "Resources/ResourceView.h"
+#include "Resources/SparseResource.h"
+
+using resource::ArenaMemoryResource;
+using resource::ResourceView;
+using resource::SparseResource;
+
+namespace
+{
+	const size_t M = 3;
+	const size_t N = 4;
+
+	// rows: {0,5,0,0}, {0,0,0,0}, {1,0,0,2}
+	const std::vector<int> DENSE = {0, 5, 0, 0, 0, 0, 0, 0, 1, 0, 0, 2};
+	const std::pmr::vector<size_t> ROW_OFFSETS = {0, 1, 1, 3};
+	const std::pmr::vector<size_t> COLUMN_INDICES = {1, 0, 3};
+	const std::vector<int> VALUES = {5, 1, 2};
+
+	struct Resource : SparseResource
+	{
+		Resource(const size_t m = M, const size_t n = N, std::pmr::memory_resource *memory = std::pmr::get_default_resource()) : SparseResource(memory)
+		{
+			SetColumnSize(m);
+			SetRowSize(n);
+		}
+
+		size_t GetElementSize() const override
+		{
+			return sizeof(int);
+		}
+
+		bool UpdateChecksumProtected() { return UpdateChecksum(); }
+	};
+
+	const char *Bytes(const std::vector<int> &values)
+	{
+		return reinterpret_cast<const char *>(values.data());
+	}
+} // end namespace
+
+TEST(SparseResource, Construct)
+{
+	EXPECT_NO_THROW(Resource());
+	Resource resource;
+	EXPECT_EQ(resource.GetNonZeroCount(), 0);
+	EXPECT_EQ(resource.At(2, 3), nullptr);
+}
+
+TEST(SparseResource, Assign)
+{
+	Resource resource;
+	resource.Assign(Bytes(DENSE), DENSE.size() * sizeof(int));
+
+	EXPECT_EQ(resource.GetNonZeroCount(), VALUES.size());
+	EXPECT_EQ(resource.GetRowOffsets(), ROW_OFFSETS);
+	EXPECT_EQ(resource.GetColumnIndices(), COLUMN_INDICES);
+
+	const int *data = static_cast<const int *>(resource.Data());
+	EXPECT_EQ(std::vector<int>(data, data + VALUES.size()), VALUES);
+}
+
+TEST(SparseResource, AssignThrows)
+{
+	Resource resource;
+	EXPECT_THROW(resource.Assign(nullptr, DENSE.size() * sizeof(int)), std::runtime_error);
+	EXPECT_THROW(resource.Assign(Bytes(DENSE), sizeof(int)), std::runtime_error);
+}
+
+TEST(SparseResource, AssignSparse)
+{
+	Resource resource;
+	resource.AssignSparse(ROW_OFFSETS.data(), COLUMN_INDICES.data(), Bytes(VALUES), VALUES.size());
+
+	EXPECT_EQ(resource.GetNonZeroCount(), VALUES.size());
+	EXPECT_EQ(*static_cast<const int *>(resource.At(0, 1)), 5);
+	EXPECT_EQ(*static_cast<const int *>(resource.At(2, 0)), 1);
+	EXPECT_EQ(*static_cast<const int *>(resource.At(2, 3)), 2);
+	EXPECT_EQ(resource.At(1, 1), nullptr);
+}
+
+TEST(SparseResource, AssignSparseThrows)
+{
+	Resource resource;
+
+	const std::vector<size_t> badOffsets = {0, 2, 1, 3};
+	EXPECT_THROW(resource.AssignSparse(badOffsets.data(), COLUMN_INDICES.data(), Bytes(VALUES), VALUES.size()), std::runtime_error);
+
+	const std::vector<size_t> badIndices = {1, 3, 0};
+	EXPECT_THROW(resource.AssignSparse(ROW_OFFSETS.data(), badIndices.data(), Bytes(VALUES), VALUES.size()), std::runtime_error);
+
+	const std::vector<size_t> outOfBounds = {4, 0, 3};
+	EXPECT_THROW(resource.AssignSparse(ROW_OFFSETS.data(), outOfBounds.data(), Bytes(VALUES), VALUES.size()), std::runtime_error);
+
+	EXPECT_THROW(resource.AssignSparse(ROW_OFFSETS.data(), COLUMN_INDICES.data(), Bytes(VALUES), VALUES.size() - 1), std::runtime_error);
+}
+
+TEST(SparseResource, AssignCoordinates)
+{
+	const std::vector<size_t> rows = {2, 0, 2};
+	const std::vector<size_t> columns = {3, 1, 0};
+	const std::vector<int> values = {2, 5, 1};
+
+	Resource resource;
+	resource.AssignCoordinates(rows.data(), columns.data(), Bytes(values), values.size());
+
+	EXPECT_EQ(resource.GetRowOffsets(), ROW_OFFSETS);
+	EXPECT_EQ(resource.GetColumnIndices(), COLUMN_INDICES);
+	const int *data = static_cast<const int *>(resource.Data());
+	EXPECT_EQ(std::vector<int>(data, data + VALUES.size()), VALUES);
+}
+
+TEST(SparseResource, AssignCoordinatesThrows)
+{
+	const std::vector<size_t> rows = {M};
+	const std::vector<size_t> columns = {0};
+	const std::vector<int> values = {1};
+
+	Resource resource;
+	EXPECT_THROW(resource.AssignCoordinates(rows.data(), columns.data(), Bytes(values), 1), std::runtime_error);
+
+	const std::vector<size_t> duplicateRows = {0, 0};
+	const std::vector<size_t> duplicateColumns = {1, 1};
+	const std::vector<int> duplicateValues = {1, 2};
+	EXPECT_THROW(resource.AssignCoordinates(duplicateRows.data(), duplicateColumns.data(), Bytes(duplicateValues), 2), std::runtime_error);
+}
+
+TEST(SparseResource, AtThrows)
+{
+	Resource resource;
+	EXPECT_THROW(resource.At(M, 0), std::runtime_error);
+	EXPECT_THROW(resource.At(0, N), std::runtime_error);
+}
+
+TEST(SparseResource, CopyToDense)
+{
+	Resource resource;
+	resource.AssignSparse(ROW_OFFSETS.data(), COLUMN_INDICES.data(), Bytes(VALUES), VALUES.size());
+
+	std::vector<int> dense(M * N, -1);
+	resource.CopyToDense(reinterpret_cast<char *>(dense.data()));
+	EXPECT_EQ(dense, DENSE);
+}
+
+TEST(SparseResource, CopyConstruct)
+{
+	Resource source;
+	source.Assign(Bytes(DENSE), DENSE.size() * sizeof(int));
+
+	Resource target(source);
+	EXPECT_EQ(target.GetRowOffsets(), source.GetRowOffsets());
+	EXPECT_EQ(target.GetColumnIndices(), source.GetColumnIndices());
+	EXPECT_NE(target.Data(), source.Data());
+}
+
+TEST(SparseResource, MoveConstruct)
+{
+	Resource source;
+	source.Assign(Bytes(DENSE), DENSE.size() * sizeof(int));
+
+	Resource target(std::move(source));
+	EXPECT_EQ(target.GetNonZeroCount(), VALUES.size());
+	EXPECT_EQ(target.GetRowOffsets(), ROW_OFFSETS);
+}
+
+TEST(SparseResource, UpdateChecksum)
+{
+	Resource resource;
+	resource.Assign(Bytes(DENSE), DENSE.size() * sizeof(int));
+	EXPECT_TRUE(resource.UpdateChecksumProtected());
+	EXPECT_FALSE(resource.UpdateChecksumProtected());
+
+	*static_cast<int *>(resource.Data()) = 6;
+	EXPECT_TRUE(resource.UpdateChecksumProtected());
+}
+
+TEST(SparseResource, MemoryResource)
+{
+	ArenaMemoryResource arena;
+	Resource resource(M, N, &arena);
+	EXPECT_EQ(resource.GetMemoryResource(), &arena);
+
+	resource.Assign(Bytes(DENSE), DENSE.size() * sizeof(int));
+	EXPECT_GE(arena.GetUsedBytes(), (ROW_OFFSETS.size() + COLUMN_INDICES.size()) * sizeof(size_t) + VALUES.size() * sizeof(int));
+	EXPECT_EQ(resource.GetRowOffsets().get_allocator().resource(), &arena);
+}
+
+TEST(SparseResource, ViewThrows)
+{
+	Resource resource;
+	EXPECT_THROW(ResourceView{resource}, std::runtime_error);
+}
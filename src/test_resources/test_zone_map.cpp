@@ -0,0 +1,105 @@
+#include "test_resources/config.h"
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Resources/DataType.h"
+#include "Resources/ResourceStats.h"
+#include "Resources/ZoneMap.h"
+
+using resource::DataType;
+using resource::ResourceStats;
+using resource::ZoneMap;
+
+namespace
+{
+	// three blocks of four, the last one short
+	const std::vector<int> VALUES = {0, 1, 2, 3, 10, 11, 12, 13, 20, 21};
+	const size_t BLOCK_SIZE = 4;
+
+	std::string Write(const ZoneMap &zoneMap)
+	{
+		std::ostringstream outStream(std::ios::binary);
+		zoneMap.Write(outStream);
+		return outStream.str();
+	}
+} // end namespace
+
+TEST(ZoneMap, Construct)
+{
+	const ZoneMap zoneMap;
+	EXPECT_EQ(zoneMap.GetBlockCount(), size_t(0));
+	EXPECT_EQ(zoneMap.GetTotal().GetCount(), uint64_t(0));
+	EXPECT_TRUE(zoneMap.FindBlocks(-1e300, 1e300).empty());
+}
+
+TEST(ZoneMap, Build)
+{
+	const ZoneMap zoneMap = ZoneMap::Build(VALUES.data(), DataType::Int32, VALUES.size(), BLOCK_SIZE);
+	EXPECT_EQ(zoneMap.GetBlockSize(), BLOCK_SIZE);
+	ASSERT_EQ(zoneMap.GetBlockCount(), size_t(3));
+	EXPECT_EQ(zoneMap.GetBlock(1), ResourceStats(10.0, 13.0, 46.0, 4, 0));
+	EXPECT_EQ(zoneMap.GetBlock(2), ResourceStats(20.0, 21.0, 41.0, 2, 0));
+	EXPECT_EQ(zoneMap.GetTotal(), ResourceStats::Compute(VALUES.data(), DataType::Int32, VALUES.size()));
+	EXPECT_THROW(zoneMap.GetBlock(3), std::runtime_error);
+}
+
+TEST(ZoneMap, BuildThrows)
+{
+	EXPECT_THROW(ZoneMap::Build(VALUES.data(), DataType::Int32, VALUES.size(), 0), std::runtime_error);
+	EXPECT_THROW(ZoneMap::Build(VALUES.data(), DataType::Unknown, VALUES.size(), BLOCK_SIZE), std::runtime_error);
+}
+
+TEST(ZoneMap, FindBlocks)
+{
+	const ZoneMap zoneMap = ZoneMap::Build(VALUES.data(), DataType::Int32, VALUES.size(), BLOCK_SIZE);
+	EXPECT_EQ(zoneMap.FindBlocks(11.0, 11.0), std::vector<size_t>({1}));
+	EXPECT_EQ(zoneMap.FindBlocks(2.0, 20.0), std::vector<size_t>({0, 1, 2}));
+	EXPECT_TRUE(zoneMap.FindBlocks(4.0, 9.0).empty());
+	EXPECT_TRUE(zoneMap.FindBlocks(30.0, 40.0).empty());
+}
+
+TEST(ZoneMap, Update)
+{
+	std::vector<int> values = VALUES;
+	ZoneMap zoneMap = ZoneMap::Build(values.data(), DataType::Int32, values.size(), BLOCK_SIZE);
+
+	// lowering the maximum of the last block retracts the total maximum
+	values[8] = 5;
+	values[9] = 6;
+	zoneMap.Update(2, values.data() + 8, DataType::Int32);
+	EXPECT_EQ(zoneMap.GetBlock(2), ResourceStats(5.0, 6.0, 11.0, 2, 0));
+	EXPECT_EQ(zoneMap.GetTotal(), ResourceStats::Compute(values.data(), DataType::Int32, values.size()));
+	EXPECT_TRUE(zoneMap.FindBlocks(20.0, 21.0).empty());
+
+	EXPECT_THROW(zoneMap.Update(3, values.data(), DataType::Int32), std::runtime_error);
+}
+
+TEST(ZoneMap, WriteRead)
+{
+	const std::vector<double> values = {0.5, -2.0, 7.25, 1e10, -1e-10};
+	const ZoneMap zoneMap = ZoneMap::Build(values.data(), DataType::Float64, values.size(), 2);
+	const std::string bytes = Write(zoneMap);
+	EXPECT_EQ(bytes.size(), zoneMap.GetSize());
+	EXPECT_EQ(bytes.size() % sizeof(uint64_t), size_t(0));
+
+	const ZoneMap read = ZoneMap::Read(bytes.data(), bytes.size());
+	EXPECT_EQ(read.GetBlockSize(), size_t(2));
+	ASSERT_EQ(read.GetBlockCount(), zoneMap.GetBlockCount());
+	for (size_t block = 0; block < read.GetBlockCount(); ++block)
+		EXPECT_EQ(read.GetBlock(block), zoneMap.GetBlock(block));
+	EXPECT_EQ(read.GetTotal(), zoneMap.GetTotal());
+}
+
+TEST(ZoneMap, ReadThrows)
+{
+	const ZoneMap zoneMap = ZoneMap::Build(VALUES.data(), DataType::Int32, VALUES.size(), BLOCK_SIZE);
+	const std::string bytes = Write(zoneMap);
+	EXPECT_THROW(ZoneMap::Read(bytes.data(), bytes.size() - 1), std::runtime_error);
+	EXPECT_THROW(ZoneMap::Read(bytes.data(), 8), std::runtime_error);
+	EXPECT_THROW(ZoneMap::Read(nullptr, bytes.size()), std::runtime_error);
+}